@@ -24,10 +24,19 @@
 
 #include "AppDelegate.h"
 #include "MenuScene.h"
+#include "GameFont.h"
+#include "GameRandom.h"
+#include <chrono>
+#include <random>
 //#include "HelloWorldScene.h"
 
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
+// #define RUN_RENDER_BENCHMARK 1
+
+#if RUN_RENDER_BENCHMARK
+#include "RenderBenchScene.h"
+#endif
 
 #if USE_AUDIO_ENGINE && USE_SIMPLE_AUDIO_ENGINE
 #error "Don't use AudioEngine and SimpleAudioEngine at the same time. Please just select one in your game!"
@@ -48,6 +57,8 @@ static cocos2d::Size smallResolutionSize = cocos2d::Size(960, 640);
 static cocos2d::Size mediumResolutionSize = cocos2d::Size(1280, 720);
 static cocos2d::Size largeResolutionSize = cocos2d::Size(1920, 1080);
 static const float kWindowScale = 2.0f;
+// 游戏逻辑（时间、移动、怪物 AI、钓鱼物理）的模拟频率，与渲染帧率无关
+static const float kSimulationTickRate = 60.0f;
 
 AppDelegate::AppDelegate()
 {
@@ -102,6 +113,35 @@ bool AppDelegate::applicationDidFinishLaunching() {
     // set FPS. the default value is 1.0/60 if you don't call this
     director->setAnimationInterval(1.0f / 60);
 
+    // fixedUpdate runs at a constant rate; slow frames catch up with up to 5 steps per frame
+    director->getScheduler()->setFixedTimeStep(1.0f / kSimulationTickRate);
+    director->getScheduler()->setMaxFixedStepsPerFrame(5);
+
+    // every launch plays a different sequence; fixed seeds are only for the headless bench and tests.
+    // The clock is mixed in because random_device is deterministic on some toolchains
+    std::random_device randomDevice;
+    auto clockSeed = static_cast<uint32_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    GameRandom::getInstance()->setSeed(randomDevice() ^ clockSeed);
+
+    // asset_manifest.txt is generated at build time; when present, resource lookups skip the disk
+    FileUtils::getInstance()->loadAssetManifest("asset_manifest.txt");
+
+    // resources.pak is packed at build time (GAME_PACK_RESOURCES); it is mapped, not read, so assets page in on first use
+    FileUtils::getInstance()->addResourceArchive("resources.pak");
+
+    // async texture loads decode on all cores; uploads are spread out at up to 4 ms per frame
+    director->getTextureCache()->setAsyncUploadBudget(0.004f);
+
+    // use the GPU-compressed textures the build converted for this GPU, if any
+    auto configuration = Configuration::getInstance();
+    const char* textureVariant = configuration->supportsS3TC() ? "dxt"
+                               : configuration->supportsETC2() ? "etc2"
+                               : "fallback";
+    director->getTextureCache()->loadCompressedTextureMap(StringUtils::format("compressed_textures_%s.txt", textureVariant));
+
+    // UI layers use integer global Z (1000/2000/...), let the renderer bucket them instead of sorting
+    director->getRenderer()->setZOrderBucketing(true);
+
     // Set the design resolution
     glview->setDesignResolutionSize(designResolutionSize.width, designResolutionSize.height, ResolutionPolicy::SHOW_ALL);
     auto frameSize = glview->getFrameSize();
@@ -126,11 +166,22 @@ bool AppDelegate::applicationDidFinishLaunching() {
         director->setContentScaleFactor(MIN(smallResolutionSize.height/designResolutionSize.height, smallResolutionSize.width/designResolutionSize.width));
     }
 
+    // glyph atlases are built after the content scale factor is known, it sizes the letter definitions
+    GameFont::preloadGlyphs();
+    // the director resets on exit; save the glyph list before the atlases are purged
+    director->getEventDispatcher()->addCustomEventListener(Director::EVENT_RESET, [](EventCustom*) {
+        GameFont::saveGlyphCache();
+    });
+
     register_all_packages();
 
     // create a scene. it's an autorelease object
    // auto scene = HelloWorldScene::createScene();
+#if RUN_RENDER_BENCHMARK
+    auto scene = RenderBenchScene::createScene();
+#else
     auto scene = MenuScene::createScene(); // <--- 改回 MenuScene    // run
+#endif
     director->runWithScene(scene);
 
     return true;
@@ -140,6 +191,9 @@ bool AppDelegate::applicationDidFinishLaunching() {
 void AppDelegate::applicationDidEnterBackground() {
     Director::getInstance()->stopAnimation();
 
+    // mobile apps are usually killed in the background without a reset
+    GameFont::saveGlyphCache();
+
 #if USE_AUDIO_ENGINE
     AudioEngine::pauseAll();
 #elif USE_SIMPLE_AUDIO_ENGINE
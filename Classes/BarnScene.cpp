@@ -1,4 +1,5 @@
 #include "BarnScene.h"
+#include "GameFont.h"
 #include "MapLayer.h"
 #include "Player.h"
 #include "InventoryManager.h"
@@ -150,6 +151,7 @@ bool BarnScene::init()
     initToolbarUI();
 
     scheduleUpdate();
+    scheduleFixedUpdate();
     return true;
 }
 
@@ -247,24 +249,24 @@ void BarnScene::initUI()
     topBar->setPosition(Vec2(origin.x, origin.y + visibleSize.height));
     uiLayer_->addChild(topBar, 0);
 
-    timeLabel_ = Label::createWithSystemFont("Day 1, 06:00", "Arial", 24);
+    timeLabel_ = GameFont::createLabel("Day 1, 06:00", 24);
     timeLabel_->setAnchorPoint(Vec2(0, 0.5f));
     timeLabel_->setPosition(Vec2(origin.x + 20.0f, origin.y + visibleSize.height - 30.0f));
     timeLabel_->setColor(Color3B::WHITE);
     uiLayer_->addChild(timeLabel_, 1);
 
-    moneyLabel_ = Label::createWithSystemFont("Gold: 0", "Arial", 24);
+    moneyLabel_ = GameFont::createLabel("Gold: 0", 24);
     moneyLabel_->setAnchorPoint(Vec2(1, 0.5f));
     moneyLabel_->setPosition(Vec2(origin.x + visibleSize.width - 20.0f, origin.y + visibleSize.height - 30.0f));
     moneyLabel_->setColor(Color3B(255, 215, 0));
     uiLayer_->addChild(moneyLabel_, 1);
 
-    actionLabel_ = Label::createWithSystemFont("", "Arial", 20);
+    actionLabel_ = GameFont::createLabel("", 20);
     actionLabel_->setPosition(Vec2(origin.x + visibleSize.width / 2, origin.y + 90));
     actionLabel_->setColor(Color3B::WHITE);
     uiLayer_->addChild(actionLabel_, 1);
 
-    auto helpLabel = Label::createWithSystemFont("B: Bag | ENTER: Exit", "Arial", 14);
+    auto helpLabel = GameFont::createLabel("B: Bag | ENTER: Exit", 14);
     helpLabel->setPosition(Vec2(origin.x + visibleSize.width / 2, origin.y + 20));
     helpLabel->setColor(Color3B(200, 200, 200));
     uiLayer_->addChild(helpLabel, 1);
@@ -366,7 +368,7 @@ void BarnScene::initToolbarUI()
         }
         toolbarIcons_.push_back(icon);
 
-        auto countLabel = Label::createWithSystemFont("", "Arial", 14);
+        auto countLabel = GameFont::createLabel("", 14);
         countLabel->setAnchorPoint(Vec2(1, 0));
         countLabel->setPosition(Vec2(kToolbarSlotSize - 4.0f, 4.0f));
         countLabel->setColor(Color3B::WHITE);
@@ -483,21 +485,24 @@ void BarnScene::selectItemByIndex(int idx)
     refreshToolbarUI();
 }
 
-void BarnScene::update(float delta)
+void BarnScene::fixedUpdate(float step)
 {
     auto tm = TimeManager::getInstance();
     if (tm)
     {
-        tm->update(delta);
+        tm->update(step);
         if (tm->isMidnight())
         {
+            unscheduleFixedUpdate();
             if (inventory_) inventory_->removeMoney(200);
             showActionMessage("Passed out...", Color3B::RED);
             Director::getInstance()->replaceScene(TransitionFade::create(1.0f, HouseScene::createScene(true)));
-            return;
         }
     }
+}
 
+void BarnScene::update(float delta)
+{
     updateCamera();
     updateUI();
 
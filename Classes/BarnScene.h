@@ -15,6 +15,7 @@ public:
     static BarnScene* createScene();
     virtual bool init() override;
     virtual void update(float delta) override;
+    virtual void fixedUpdate(float step) override;
 
 private:
     MapLayer* mapLayer_{ nullptr };
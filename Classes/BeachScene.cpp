@@ -1,4 +1,5 @@
 #include "BeachScene.h"
+#include "GameFont.h"
 #include "MapLayer.h"
 #include "Player.h"
 #include "InventoryUI.h"
@@ -9,6 +10,7 @@
 #include "SkillManager.h"
 #include "EnergyBar.h"
 #include "Fish.h"
+#include "GameRandom.h"
 #include <algorithm>
 
 USING_NS_CC;
@@ -193,6 +195,7 @@ bool BeachScene::init(InventoryManager* inventory, int dayCount, float accumulat
     initToolbarUI();
 
     scheduleUpdate();
+    scheduleFixedUpdate();
     return true;
 }
 
@@ -256,24 +259,24 @@ void BeachScene::initUI()
     topBar->setPosition(Vec2(origin.x, origin.y + visibleSize.height));
     uiLayer_->addChild(topBar, 0);
 
-    timeLabel_ = Label::createWithSystemFont("Day 1, 06:00", "Arial", 24);
+    timeLabel_ = GameFont::createLabel("Day 1, 06:00", 24);
     timeLabel_->setAnchorPoint(Vec2(0, 0.5f));
     timeLabel_->setPosition(Vec2(origin.x + 20.0f, origin.y + visibleSize.height - 30.0f));
     timeLabel_->setColor(Color3B::WHITE);
     uiLayer_->addChild(timeLabel_, 1);
 
-    moneyLabel_ = Label::createWithSystemFont("Gold: 0", "Arial", 24);
+    moneyLabel_ = GameFont::createLabel("Gold: 0", 24);
     moneyLabel_->setAnchorPoint(Vec2(1, 0.5f));
     moneyLabel_->setPosition(Vec2(origin.x + visibleSize.width - 20.0f, origin.y + visibleSize.height - 30.0f));
     moneyLabel_->setColor(Color3B(255, 215, 0));
     uiLayer_->addChild(moneyLabel_, 1);
 
-    actionLabel_ = Label::createWithSystemFont("", "Arial", 20);
+    actionLabel_ = GameFont::createLabel("", 20);
     actionLabel_->setPosition(Vec2(origin.x + visibleSize.width / 2, origin.y + 90));
     actionLabel_->setColor(Color3B::WHITE);
     uiLayer_->addChild(actionLabel_, 1);
 
-    auto helpLabel = Label::createWithSystemFont("B: Bag | ESC: Back to Farm", "Arial", 14);
+    auto helpLabel = GameFont::createLabel("B: Bag | ESC: Back to Farm", 14);
     helpLabel->setPosition(Vec2(origin.x + visibleSize.width / 2, origin.y + 20));
     helpLabel->setColor(Color3B(200, 200, 200));
     uiLayer_->addChild(helpLabel, 1);
@@ -422,7 +425,7 @@ void BeachScene::initToolbarUI()
         }
         toolbarIcons_.push_back(icon);
 
-        auto countLabel = Label::createWithSystemFont("", "Arial", 14);
+        auto countLabel = GameFont::createLabel("", 14);
         countLabel->setAnchorPoint(Vec2(1, 0));
         countLabel->setPosition(Vec2(kToolbarSlotSize - 4.0f, 4.0f));
         countLabel->setColor(Color3B::WHITE);
@@ -554,15 +557,6 @@ void BeachScene::update(float delta)
             camera->getPositionY() - visibleSize.height / 2 + 110));
     }
 
-    accumulatedSeconds_ += delta;
-    if (accumulatedSeconds_ >= secondsPerDay_)
-    {
-        if (inventory_) inventory_->removeMoney(200);
-        showActionMessage("Passed out...", Color3B::RED);
-        Director::getInstance()->replaceScene(TransitionFade::create(1.0f, HouseScene::createScene(true)));
-        return;
-    }
-
     if (exitCooldown_ > 0.0f)
     {
         exitCooldown_ -= delta;
@@ -573,6 +567,18 @@ void BeachScene::update(float delta)
     }
 }
 
+void BeachScene::fixedUpdate(float step)
+{
+    accumulatedSeconds_ += step;
+    if (accumulatedSeconds_ >= secondsPerDay_)
+    {
+        unscheduleFixedUpdate();
+        if (inventory_) inventory_->removeMoney(200);
+        showActionMessage("Passed out...", Color3B::RED);
+        Director::getInstance()->replaceScene(TransitionFade::create(1.0f, HouseScene::createScene(true)));
+    }
+}
+
 void BeachScene::updateCamera()
 {
     if (!player_)
@@ -787,7 +793,7 @@ void BeachScene::onMouseUp(Event* event)
         fishingState_ = FishingState::WAITING;
         if (chargeBarBg_) chargeBarBg_->setVisible(false);
 
-        waitTimer_ = CCRANDOM_0_1() * 3.0f + 1.0f;
+        waitTimer_ = GameRandom::getInstance()->nextFloat() * 3.0f + 1.0f;
         if (player_) player_->startFishingCast();
         CCLOG("Casting rod! Power: %.2f. Waiting...", chargePower_);
     }
@@ -851,7 +857,7 @@ void BeachScene::startFishing()
     };
     
     // 简单随机逻辑（后续可根据天气时间细化）
-    int idx = cocos2d::random(0, (int)seaFish.size() - 1);
+    int idx = GameRandom::getInstance()->nextInt(0, (int)seaFish.size() - 1);
     fishToCatch = seaFish[idx];
     
     Fish* fishObj = Fish::createByType(fishToCatch);
@@ -15,6 +15,7 @@ public:
     static BeachScene* createScene(InventoryManager* inventory, int dayCount = 1, float accumulatedSeconds = 0.0f);
     virtual bool init(InventoryManager* inventory, int dayCount, float accumulatedSeconds);
     virtual void update(float delta) override;
+    virtual void fixedUpdate(float step) override;
 
 private:
     MapLayer* mapLayer_{ nullptr };
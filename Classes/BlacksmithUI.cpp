@@ -1,10 +1,11 @@
 #include "BlacksmithUI.h"
+#include "GameFont.h"
 #include "InventoryManager.h"
 
 USING_NS_CC;
 
 static void review_alert_label(Node* parent, std::string text, Vec2 pos) {
-    auto label = Label::createWithSystemFont(text, "Arial", 12);
+    auto label = GameFont::createLabel(text, 12);
     label->setPosition(pos);
     label->setColor(Color3B::RED);
     parent->addChild(label);
@@ -60,13 +61,13 @@ bool BlacksmithUI::init()
     panel_->addChild(border, 1);
 
     // 标题
-    auto title = Label::createWithSystemFont("Blacksmith Shop", "Arial", 24);
+    auto title = GameFont::createLabel("Blacksmith Shop", 24);
     title->setPosition(Vec2(panelW / 2, panelH - 30));
     title->setColor(Color3B(255, 200, 100));
     panel_->addChild(title, 2);
 
     // 关闭按钮
-    auto closeLabel = Label::createWithSystemFont("[ X ]", "Arial", 20);
+    auto closeLabel = GameFont::createLabel("[ X ]", 20);
     auto closeItem = MenuItemLabel::create(closeLabel, [this](Ref* sender) {
         close();
         });
@@ -77,9 +78,9 @@ bool BlacksmithUI::init()
     panel_->addChild(menu, 2);
 
     // --- TABS ---
-    auto btnRepair = MenuItemLabel::create(Label::createWithSystemFont("Repair", "Arial", 20), [this](Ref*){ switchMode(Mode::Repair); });
+    auto btnRepair = MenuItemLabel::create(GameFont::createLabel("Repair", 20), [this](Ref*){ switchMode(Mode::Repair); });
     btnRepair->setPosition(Vec2(80, panelH - 60)); // Moved left
-    auto btnShop = MenuItemLabel::create(Label::createWithSystemFont("Shop", "Arial", 20), [this](Ref*){ switchMode(Mode::Shop); });
+    auto btnShop = MenuItemLabel::create(GameFont::createLabel("Shop", 20), [this](Ref*){ switchMode(Mode::Shop); });
     btnShop->setPosition(Vec2(160, panelH - 60));
     
     auto tabMenu = Menu::create(btnRepair, btnShop, nullptr);
@@ -153,20 +154,20 @@ void BlacksmithUI::refreshList()
             }
             
             // Name
-            auto nameLabel = Label::createWithSystemFont(item.name, "Arial", 18);
+            auto nameLabel = GameFont::createLabel(item.name, 18);
             nameLabel->setAnchorPoint(Vec2(0, 0.5f));
             nameLabel->setPosition(Vec2(70, -20));
             itemNode->addChild(nameLabel);
             
             // Price
-            auto priceLabel = Label::createWithSystemFont(StringUtils::format("%d G", item.price), "Arial", 14);
+            auto priceLabel = GameFont::createLabel(StringUtils::format("%d G", item.price), 14);
             priceLabel->setAnchorPoint(Vec2(0, 0.5f));
             priceLabel->setPosition(Vec2(70, -40));
             priceLabel->setColor(Color3B::YELLOW);
             itemNode->addChild(priceLabel);
             
             // Buy Button
-            auto buyLabel = Label::createWithSystemFont("Buy", "Arial", 16);
+            auto buyLabel = GameFont::createLabel("Buy", 16);
             auto buyBtn = MenuItemLabel::create(buyLabel, [this, item](Ref*){
                  this->onBuyClicked(item.type, item.price);
             });
@@ -220,22 +221,22 @@ void BlacksmithUI::refreshList()
 
             // 2. 名称和耐久
             std::string name = InventoryManager::getItemName(slot.type);
-            auto nameLabel = Label::createWithSystemFont(name, "Arial", 18);
+            auto nameLabel = GameFont::createLabel(name, 18);
             nameLabel->setAnchorPoint(Vec2(0, 0.5f));
             nameLabel->setPosition(Vec2(70, -20));
             itemNode->addChild(nameLabel);
 
-            auto durLabel = Label::createWithSystemFont(
+            auto durLabel = GameFont::createLabel(
                 StringUtils::format("Durability: %d/%d", slot.durability, slot.maxDurability),
-                "Arial", 14);
+                14);
             durLabel->setAnchorPoint(Vec2(0, 0.5f));
             durLabel->setPosition(Vec2(70, -40));
             durLabel->setColor(Color3B(200, 200, 200));
             itemNode->addChild(durLabel);
 
             // 3. 修复按钮
-            auto btnLabel = Label::createWithSystemFont(
-                StringUtils::format("Repair (%dg)", cost), "Arial", 10); // Font size increased by implementation but kept logical
+            auto btnLabel = GameFont::createLabel(
+                StringUtils::format("Repair (%dg)", cost), 10); // Font size increased by implementation but kept logical
             // Note: Menu Label
             
             auto repairBtn = MenuItemLabel::create(btnLabel, [this, i, cost, &slot](Ref* sender) { // Capture slot by ref is dangerous if vector resizes! Capture by index 'i'.
@@ -279,7 +280,7 @@ void BlacksmithUI::refreshList()
 
     if (!hasItems)
     {
-        auto label = Label::createWithSystemFont("All tools are in good condition!", "Arial", 18);
+        auto label = GameFont::createLabel("All tools are in good condition!", 18);
         label->setPosition(Vec2(250, -100));
         label->setColor(Color3B::YELLOW);
         listNode_->addChild(label);
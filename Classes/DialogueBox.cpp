@@ -1,4 +1,5 @@
 ﻿#include "DialogueBox.h"
+#include "GameFont.h"
 
 USING_NS_CC;
 
@@ -36,7 +37,7 @@ bool DialogueBox::init(Npc* npc) {
     }
 
     // Label
-    dialogue_label_ = Label::createWithSystemFont("", "Arial", 28);
+    dialogue_label_ = GameFont::createTextLabel("", 28);
     dialogue_label_->setDimensions(480, 160); // Reduced width for left panel
     // Align text to the center of left panel (even further left as requested)
     dialogue_label_->setPosition(Vec2(-250, 0));
@@ -103,7 +104,7 @@ bool DialogueBox::init(Npc* npc) {
     opt1Bg->drawSolidRect(Vec2(-75, -25), Vec2(75, 25), Color4F(0.5f, 0.5f, 0.5f, 1.0f));
     opt1Bg->setPosition(Vec2(-80, 0));
     choice_node_->addChild(opt1Bg);
-    option1_label_ = Label::createWithSystemFont("Option 1", "Arial", 24); // Larger font
+    option1_label_ = GameFont::createLabel("Option 1", 24); // Larger font
     option1_label_->setPosition(Vec2(-80, 0));
     option1_label_->setTextColor(Color4B::BLACK);
     choice_node_->addChild(option1_label_);
@@ -113,7 +114,7 @@ bool DialogueBox::init(Npc* npc) {
     opt2Bg->drawSolidRect(Vec2(-75, -25), Vec2(75, 25), Color4F(0.5f, 0.5f, 0.5f, 1.0f));
     opt2Bg->setPosition(Vec2(80, 0));
     choice_node_->addChild(opt2Bg);
-    option2_label_ = Label::createWithSystemFont("Option 2", "Arial", 24); // Larger font
+    option2_label_ = GameFont::createLabel("Option 2", 24); // Larger font
     option2_label_->setPosition(Vec2(80, 0));
     option2_label_->setTextColor(Color4B::BLACK);
     choice_node_->addChild(option2_label_);
@@ -1,4 +1,5 @@
 #include "ElevatorUI.h"
+#include "GameFont.h"
 
 USING_NS_CC;
 
@@ -85,7 +86,7 @@ void ElevatorUI::createPanel()
     this->addChild(panelNode, 1);
 
     // 标题
-    titleLabel_ = Label::createWithSystemFont("Enter Floor Number", "Arial", 28);
+    titleLabel_ = GameFont::createLabel("Enter Floor Number", 28);
     titleLabel_->setPosition(Vec2(center.x, center.y + 160));
     titleLabel_->setColor(Color3B::YELLOW);
     this->addChild(titleLabel_, 2);
@@ -96,18 +97,18 @@ void ElevatorUI::createPanel()
     inputBg->setPosition(Vec2(center.x, center.y + 110));
     this->addChild(inputBg, 2);
 
-    inputLabel_ = Label::createWithSystemFont("", "Arial", 32);
+    inputLabel_ = GameFont::createLabel("", 32);
     inputLabel_->setPosition(Vec2(center.x, center.y + 110));
     inputLabel_->setColor(Color3B::WHITE);
     this->addChild(inputLabel_, 3);
 
     // 提示
-    auto hintLabel = Label::createWithSystemFont("Type number (0-5) then ENTER", "Arial", 16);
+    auto hintLabel = GameFont::createLabel("Type number (0-5) then ENTER", 16);
     hintLabel->setPosition(Vec2(center.x, center.y - 140));
     hintLabel->setColor(Color3B::GRAY);
     this->addChild(hintLabel, 2);
     
-    auto escLabel = Label::createWithSystemFont("Press ESC to Exit", "Arial", 14);
+    auto escLabel = GameFont::createLabel("Press ESC to Exit", 14);
     escLabel->setPosition(Vec2(center.x, center.y - 170));
     escLabel->setColor(Color3B::RED);
     this->addChild(escLabel, 2);
@@ -131,7 +132,7 @@ void ElevatorUI::createFloorButtons()
     // 仅显示列表信息，不再是按钮（或者作为不可点击的列表展示）
     for (int i = 0; i < 6; ++i)
     {
-        auto label = Label::createWithSystemFont(floorNames[i], "Arial", 20);
+        auto label = GameFont::createLabel(floorNames[i], 20);
         label->setColor(Color3B::WHITE);
         label->setAnchorPoint(Vec2(0, 0.5));
         
@@ -4,6 +4,7 @@
 #include "cocos2d.h"
 #undef log
 #include "EnergyBar.h"
+#include "GameFont.h"
 
 USING_NS_CC;
 
@@ -38,7 +39,7 @@ bool EnergyBar::init(Player* player)
     this->addChild(barNode_, 1);
 
     // 标签 (E)
-    auto label = Label::createWithSystemFont("E", "Arial", 16);
+    auto label = GameFont::createLabel("E", 16);
     label->setPosition(Vec2(0, -15));
     this->addChild(label, 2);
 
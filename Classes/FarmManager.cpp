@@ -23,21 +23,45 @@ FarmManager* FarmManager::create(MapLayer* mapLayer)
     return nullptr;
 }
 
-std::string FarmManager::getCropTextureName(int cropId, int stage) const
+FarmManager* FarmManager::createHeadless(const Size& mapSizeTiles)
 {
-    std::string name;
-    switch (cropId)
+    FarmManager* mgr = new (std::nothrow) FarmManager();
+    if (mgr)
+    {
+        mgr->headless_ = true;
+        mgr->mapSizeTiles_ = mapSizeTiles;
+    }
+    if (mgr && mgr->init(nullptr))
     {
-    case 0: name = "turnip";     break;
-    case 1: name = "potato";     break;
-    case 2: name = "corn";       break;
-    case 3: name = "strawberry"; break;
-    case 4: name = "pumpkin";    break;
-    case 5: name = "blueberry";  break;
-    default: name = "turnip";    break;
+        mgr->autorelease();
+        return mgr;
     }
-    int imgNum = stage + 1;
-    return StringUtils::format("crops/%s%d.png", name.c_str(), imgNum);
+    CC_SAFE_DELETE(mgr);
+    return nullptr;
+}
+
+const std::string& FarmManager::getCropTextureName(int cropId, int stage) const
+{
+    // 纹理路径只拼一次：每帧重绘作物时直接返回引用，不再格式化字符串
+    static const char* const kCropNames[] = { "turnip", "potato", "corn", "strawberry", "pumpkin", "blueberry" };
+    static const int kCropCount = sizeof(kCropNames) / sizeof(kCropNames[0]);
+    static const std::vector<std::string> kTextureNames = [] {
+        std::vector<std::string> names;
+        names.reserve(kCropCount * FarmTileStore::kMaxStages);
+        for (int crop = 0; crop < kCropCount; ++crop)
+        {
+            for (int stage = 0; stage < FarmTileStore::kMaxStages; ++stage)
+            {
+                names.push_back(StringUtils::format("crops/%s%d.png", kCropNames[crop], stage + 1));
+            }
+        }
+        return names;
+    }();
+
+    // 未知作物按萝卜显示，阶段超出范围时使用最后一张图
+    if (cropId < 0 || cropId >= kCropCount) cropId = 0;
+    stage = std::min(std::max(stage, 0), FarmTileStore::kMaxStages - 1);
+    return kTextureNames[cropId * FarmTileStore::kMaxStages + stage];
 }
 
 bool FarmManager::init(MapLayer* mapLayer)
@@ -50,10 +74,18 @@ bool FarmManager::init(MapLayer* mapLayer)
         tileSize_ = mapLayer_->getTileSize();
     }
     initCropDefs();
-    tiles_.resize(static_cast<size_t>(mapSizeTiles_.width * mapSizeTiles_.height));
+    tiles_.setGrowthTable(buildGrowthTable());
+    tiles_.reset(static_cast<int>(mapSizeTiles_.width), static_cast<int>(mapSizeTiles_.height));
+
+    // 无界面模式只保留农田数据
+    if (headless_)
+        return true;
+
     overlay_ = DrawNode::create();
     this->addChild(overlay_, 5);
     cropLayer_ = Node::create();
+    // 作物和土壤精灵数量多，子节点的世界变换交给并行变换遍历计算
+    cropLayer_->setParallelTransformEnabled(true);
     this->addChild(cropLayer_, 10);
 
     Vec2 binPos(24, 15);
@@ -63,7 +95,10 @@ bool FarmManager::init(MapLayer* mapLayer)
         storageChests_.push_back(shippingBin_);
     }
 
-    this->scheduleUpdate();
+    // 农场在场时由时间轮在午夜结算；不在场期间错过的天数在第一帧补算
+    // （等场景设置好价格和收入回调后再卖交易箱）
+    midnightTimer_ = TimeManager::getInstance()->scheduleDaily(0, 0, [this](int day) { progressDay(day); });
+    this->scheduleOnce([this](float) { catchUpMissedDays(); }, 0.0f, "farm_catch_up");
     
     // Attempt to load saved farm state
     // This is crucial when reloading the scene (e.g. after sleeping/passing out)
@@ -71,28 +106,12 @@ bool FarmManager::init(MapLayer* mapLayer)
     if (SaveManager::getInstance()->hasSaveFile() && SaveManager::getInstance()->loadGame(saveData))
     {
         CCLOG("FarmManager: Loading saved tiles...");
-        for (const auto& tileData : saveData.farmTiles)
-        {
-            if (isValidTile(Vec2(tileData.x, tileData.y)))
-            {
-               int idx = tileData.y * mapSizeTiles_.width + tileData.x;
-               auto& tile = tiles_[idx];
-               tile.tilled = tileData.tilled;
-               tile.watered = tileData.watered;
-               tile.hasCrop = tileData.hasCrop;
-               tile.cropId = tileData.cropId;
-               tile.stage = tileData.stage;
-               tile.progressDays = tileData.progressDays;
-               
-               if (tile.hasCrop && tile.watered) {
-                   CCLOG("Loaded WATERED crop at (%d, %d), Stage: %d, Progress: %d", 
-                       tileData.x, tileData.y, tile.stage, tile.progressDays);
-               }
-            }
-        }
+        loadSaveData(saveData.farmTiles); // 内部会重绘覆盖层
+    }
+    else
+    {
+        redrawOverlay();
     }
-
-    redrawOverlay();
     return true;
 }
 
@@ -107,115 +126,92 @@ void FarmManager::initCropDefs()
     crops_[5] = {5, "Blueberry", {1, 2, 2}, 110};
 }
 
-void FarmManager::progressDay()
+FarmTileStore::GrowthTable FarmManager::buildGrowthTable() const
 {
-    // Update TimeManager's record first
-    auto tm = TimeManager::getInstance();
-    if (tm) {
-        tm->setLastFarmUpdateDay(tm->getDay());
-    }
-
-    if (shippingBin_ && priceFunction_) {
-        int totalEarnings = 0;
-        auto inv = shippingBin_->getInventory();
-        auto& slots = inv->getAllSlots();
-        for (const auto& slot : slots) {
-            if (!slot.isEmpty()) {
-                int price = priceFunction_(slot.type);
-                if (price > 0) totalEarnings += price * slot.count;
-            }
+    // 与 getCropDef 一致：未定义的作物 ID 使用兜底定义，0xFF 对应 -1
+    FarmTileStore::GrowthTable table;
+    for (int cropId = 0; cropId < 256; ++cropId)
+    {
+        auto def = getCropDef(cropId == 0xFF ? -1 : cropId);
+        for (int stage = 0; stage < FarmTileStore::kMaxStages; ++stage)
+        {
+            // 0 表示已成熟；定义里 0 天的阶段和原来一样按 1 天处理
+            int days = stage < (int)def.stageDays.size() ? std::max(def.stageDays[stage], 1) : 0;
+            table.stageDays[cropId][stage] = static_cast<uint8_t>(std::min(days, 255));
         }
-        inv->clear();
-        if (totalEarnings > 0 && earningsCallback_) earningsCallback_(totalEarnings);
     }
+    return table;
+}
 
-    for (auto& tile : tiles_)
+FarmManager::~FarmManager()
+{
+    if (midnightTimer_)
     {
-        if (tile.hasCrop && tile.watered)
-        {
-            auto def = getCropDef(tile.cropId);
-            if (tile.stage < (int)def.stageDays.size())
-            {
-                tile.progressDays++;
-                if (tile.progressDays >= def.stageDays[tile.stage])
-                {
-                    tile.stage++;
-                    tile.progressDays = 0;
-                }
-            }
-        }
-        tile.watered = false;
+        TimeManager::getInstance()->cancelTimer(midnightTimer_);
     }
+}
+
+void FarmManager::progressDay(int day)
+{
+    // day 是午夜之后的新一天，记录农场已经结算到这一天
+    TimeManager::getInstance()->setLastFarmUpdateDay(day);
+    simulateDay();
+}
+
+void FarmManager::simulateDay()
+{
+    sellShippedItems();
+    growCrops();
     redrawOverlay();
 }
 
-void FarmManager::update(float delta)
+void FarmManager::sellShippedItems()
+{
+    if (!shippingBin_ || !priceFunction_)
+        return;
+
+    int totalEarnings = 0;
+    auto inv = shippingBin_->getInventory();
+    auto& slots = inv->getAllSlots();
+    for (const auto& slot : slots) {
+        if (!slot.isEmpty()) {
+            int price = priceFunction_(slot.type);
+            if (price > 0) totalEarnings += price * slot.count;
+        }
+    }
+    inv->clear();
+    if (totalEarnings > 0 && earningsCallback_) earningsCallback_(totalEarnings);
+}
+
+void FarmManager::growCrops()
+{
+    tiles_.advanceDay();
+}
+
+void FarmManager::catchUpMissedDays()
 {
     // Catch-up logic for saved games or scene transitions
     auto tm = TimeManager::getInstance();
-    if (tm) {
-        int currentDay = tm->getDay();
-        int lastUpdate = tm->getLastFarmUpdateDay();
-        
-        // If this is the very first run (lastUpdate == 0), just sync it
-        if (lastUpdate == 0) {
-            tm->setLastFarmUpdateDay(currentDay);
-        }
-            // Missed some days! Catch up.
-            int daysMissed = currentDay - lastUpdate;
-            CCLOG("FarmManager catching up: %d days", daysMissed);
-            
-            // Prevent recursive updates to LastFarmUpdateDay inside the loop
-            // We just want to run the logic N times.
-            for (int i = 0; i < daysMissed; ++i) {
-                // Manually run the logic usually found in progressDay
-                // But without the TimeManager update part which ruins the loop
-                
-                // 1. Shipping Bin
-                if (shippingBin_ && priceFunction_) {
-                    int totalEarnings = 0;
-                    auto inv = shippingBin_->getInventory();
-                    auto& slots = inv->getAllSlots();
-                    for (const auto& slot : slots) {
-                        if (!slot.isEmpty()) {
-                            int price = priceFunction_(slot.type);
-                            if (price > 0) totalEarnings += price * slot.count;
-                        }
-                    }
-                    inv->clear();
-                    if (totalEarnings > 0 && earningsCallback_) earningsCallback_(totalEarnings);
-                }
-
-                // 2. Crop Growth
-                for (auto& tile : tiles_)
-                {
-                    if (tile.hasCrop && tile.watered)
-                    {
-                        CCLOG("Catch-up: Processing WATERED crop at (%d, %d) for day skip", tile.x, tile.y);
-                        auto def = getCropDef(tile.cropId);
-                        if (tile.stage < (int)def.stageDays.size())
-                        {
-                            tile.progressDays++;
-                            CCLOG("  Grew! Progress: %d -> %d", tile.progressDays-1, tile.progressDays);
-                            if (tile.progressDays >= def.stageDays[tile.stage])
-                            {
-                                tile.stage++;
-                                tile.progressDays = 0;
-                                CCLOG("  Stage UP! New Stage: %d", tile.stage);
-                            }
-                        }
-                    }
-                    else if (tile.hasCrop) {
-                         // CCLOG("Catch-up: Crop at (%d, %d) is NOT watered. Skipping growth.", tile.x, tile.y);
-                    }
-                    tile.watered = false; // Reset water daily
-                }
-            }
-            
-            // Finally update the timestamp to current
-            tm->setLastFarmUpdateDay(currentDay);
-            redrawOverlay();
+    int currentDay = tm->getDay();
+    int lastUpdate = tm->getLastFarmUpdateDay();
+
+    // If this is the very first run (lastUpdate == 0), just sync it
+    if (lastUpdate == 0) {
+        tm->setLastFarmUpdateDay(currentDay);
+        return;
     }
+
+    // Missed some days while the farm was not loaded
+    int daysMissed = currentDay - lastUpdate;
+    if (daysMissed <= 0) return;
+    CCLOG("FarmManager catching up: %d days", daysMissed);
+    for (int i = 0; i < daysMissed; ++i) {
+        sellShippedItems();
+        growCrops();
+    }
+
+    tm->setLastFarmUpdateDay(currentDay);
+    redrawOverlay();
 }
 
 int FarmManager::getHour() const { return TimeManager::getInstance()->getHour(); }
@@ -225,10 +221,11 @@ FarmManager::ActionResult FarmManager::tillTile(const Vec2& tileCoord)
 {
     ActionResult result{false, "", -1};
     if (!isValidTile(tileCoord)) return result;
-    auto& tile = tiles_[static_cast<size_t>(tileCoord.y * mapSizeTiles_.width + tileCoord.x)];
+    auto tile = getTile(tileCoord);
     if (tile.hasCrop) return result;
     tile.tilled = true;
     tile.watered = false;
+    setTile(tileCoord, tile);
     result.success = true;
     redrawOverlay();
     return result;
@@ -238,7 +235,7 @@ FarmManager::ActionResult FarmManager::plantSeed(const Vec2& tileCoord, int crop
 {
     ActionResult result{false, "", -1};
     if (!isValidTile(tileCoord)) return result;
-    auto& tile = tiles_[static_cast<size_t>(tileCoord.y * mapSizeTiles_.width + tileCoord.x)];
+    auto tile = getTile(tileCoord);
     if (!tile.tilled || tile.hasCrop) return result;
     CropDef def = getCropDef(cropId);
     tile.hasCrop = true;
@@ -246,6 +243,7 @@ FarmManager::ActionResult FarmManager::plantSeed(const Vec2& tileCoord, int crop
     tile.stage = 0;
     tile.progressDays = 0;
     tile.watered = false;
+    setTile(tileCoord, tile);
     result.success = true;
     redrawOverlay();
     return result;
@@ -255,9 +253,10 @@ FarmManager::ActionResult FarmManager::waterTile(const Vec2& tileCoord)
 {
     ActionResult result{false, "", -1};
     if (!isValidTile(tileCoord)) return result;
-    auto& tile = tiles_[static_cast<size_t>(tileCoord.y * mapSizeTiles_.width + tileCoord.x)];
+    auto tile = getTile(tileCoord);
     if (!tile.tilled) return result;
     tile.watered = true;
+    setTile(tileCoord, tile);
     result.success = true;
     redrawOverlay();
     return result;
@@ -267,7 +266,7 @@ FarmManager::ActionResult FarmManager::harvestTile(const Vec2& tileCoord)
 {
     ActionResult result{false, "", -1};
     if (!isValidTile(tileCoord)) return result;
-    auto& tile = tiles_[static_cast<size_t>(tileCoord.y * mapSizeTiles_.width + tileCoord.x)];
+    auto tile = getTile(tileCoord);
     if (!tile.hasCrop || !isMature(tile)) return result;
     result.cropId = tile.cropId;
     tile.hasCrop = false;
@@ -275,6 +274,7 @@ FarmManager::ActionResult FarmManager::harvestTile(const Vec2& tileCoord)
     tile.stage = 0;
     tile.progressDays = 0;
     tile.watered = false;
+    setTile(tileCoord, tile);
     result.success = true;
     redrawOverlay();
     return result;
@@ -286,6 +286,16 @@ bool FarmManager::isValidTile(const Vec2& tileCoord) const
         tileCoord.x < mapSizeTiles_.width && tileCoord.y < mapSizeTiles_.height;
 }
 
+FarmManager::FarmTile FarmManager::getTile(const Vec2& tileCoord) const
+{
+    return tiles_.get(static_cast<int>(tileCoord.x), static_cast<int>(tileCoord.y));
+}
+
+void FarmManager::setTile(const Vec2& tileCoord, const FarmTile& tile)
+{
+    tiles_.store(static_cast<int>(tileCoord.x), static_cast<int>(tileCoord.y), tile);
+}
+
 FarmManager::CropDef FarmManager::getCropDef(int cropId) const
 {
     auto it = crops_.find(cropId);
@@ -303,7 +313,7 @@ bool FarmManager::isMature(const FarmTile& tile) const
 bool FarmManager::isTileClearForPlacement(const Vec2& tileCoord) const
 {
     if (!isValidTile(tileCoord)) return false;
-    auto& tile = tiles_[static_cast<size_t>(tileCoord.y * mapSizeTiles_.width + tileCoord.x)];
+    auto tile = getTile(tileCoord);
     if (tile.hasCrop || tile.tilled) return false;
     if (mapLayer_ && mapLayer_->hasCollisionAt(tileCoord)) return false;
     if (getStorageChestAt(tileCoord)) return false;
@@ -339,61 +349,96 @@ void FarmManager::removeStorageChest(StorageChest* chest)
 
 void FarmManager::forceRedraw() { redrawOverlay(); }
 
-void FarmManager::setAllTiles(const std::vector<FarmTile>& tiles)
+void FarmManager::collectSaveData(std::vector<SaveManager::SaveData::FarmTileData>& out) const
+{
+    tiles_.forEach([&out](int x, int y, const FarmTile& tile)
+    {
+        // 只保存有状态的瓦片
+        if (!tile.tilled && !tile.hasCrop) return;
+        SaveManager::SaveData::FarmTileData tileData;
+        tileData.x = x;
+        tileData.y = y;
+        tileData.tilled = tile.tilled;
+        tileData.watered = tile.watered;
+        tileData.hasCrop = tile.hasCrop;
+        tileData.cropId = tile.cropId;
+        tileData.stage = tile.stage;
+        tileData.progressDays = tile.progressDays;
+        out.push_back(tileData);
+    });
+}
+
+void FarmManager::loadSaveData(const std::vector<SaveManager::SaveData::FarmTileData>& tiles)
 {
-    if (tiles.size() != tiles_.size()) tiles_.resize(tiles.size());
-    tiles_ = tiles;
+    tiles_.clear();
+    for (const auto& tileData : tiles)
+    {
+        if (!isValidTile(Vec2(tileData.x, tileData.y))) continue;
+        if (!tileData.tilled && !tileData.hasCrop) continue;
+
+        FarmTile tile;
+        tile.tilled = tileData.tilled;
+        tile.watered = tileData.watered;
+        tile.hasCrop = tileData.hasCrop;
+        tile.cropId = tileData.cropId;
+        tile.stage = tileData.stage;
+        tile.progressDays = tileData.progressDays;
+        tiles_.store(tileData.x, tileData.y, tile);
+    }
     redrawOverlay();
 }
 
 void FarmManager::redrawOverlay()
 {
+    if (headless_) return;
     overlay_->clear();
     cropLayer_->removeAllChildren();
     if (!mapLayer_) return;
     float halfW = tileSize_.width / 2.0f;
     float halfH = tileSize_.height / 2.0f;
-    for (int y = 0; y < mapSizeTiles_.height; ++y)
+    tiles_.forEach([&](int x, int y, const FarmTile& tile)
     {
-        for (int x = 0; x < mapSizeTiles_.width; ++x)
+        if (!tile.tilled) return;
+        Vec2 tileCoord(static_cast<float>(x), static_cast<float>(y));
+        Vec2 center = mapLayer_->tileCoordToPosition(tileCoord);
+        auto soilSprite = Sprite::create("soil.png");
+        if (soilSprite)
         {
-            const auto& tile = tiles_[static_cast<size_t>(y * mapSizeTiles_.width + x)];
-            if (!tile.tilled) continue;
-            Vec2 tileCoord(static_cast<float>(x), static_cast<float>(y));
-            Vec2 center = mapLayer_->tileCoordToPosition(tileCoord);
-            auto soilSprite = Sprite::create("soil.png");
-            if (soilSprite)
-            {
-                soilSprite->getTexture()->setAliasTexParameters();
-                soilSprite->setScale(soilSprite->getContentSize().height <= 16.0f ? 2.0f : 1.0f);
-                soilSprite->setPosition(center);
-                if (tile.watered) soilSprite->setColor(Color3B(180, 180, 255));
-                cropLayer_->addChild(soilSprite, 0);
-            }
-            else
-            {
-                Vec2 bl(center.x - halfW + 1.5f, center.y - halfH + 1.5f);
-                Vec2 tr(center.x + halfW - 1.5f, center.y + halfH - 1.5f);
-                overlay_->drawSolidRect(bl, tr, kTilledColor);
-                if (tile.watered) overlay_->drawSolidRect(bl, tr, Color4F(0.0f, 0.0f, 0.5f, 0.3f));
-            }
-            if (tile.hasCrop)
+            soilSprite->getTexture()->setAliasTexParameters();
+            soilSprite->setScale(soilSprite->getContentSize().height <= 16.0f ? 2.0f : 1.0f);
+            soilSprite->setPosition(center);
+            if (tile.watered) soilSprite->setColor(Color3B(180, 180, 255));
+            cropLayer_->addChild(soilSprite, 0);
+        }
+        else
+        {
+            Vec2 bl(center.x - halfW + 1.5f, center.y - halfH + 1.5f);
+            Vec2 tr(center.x + halfW - 1.5f, center.y + halfH - 1.5f);
+            overlay_->drawSolidRect(bl, tr, kTilledColor);
+            if (tile.watered) overlay_->drawSolidRect(bl, tr, Color4F(0.0f, 0.0f, 0.5f, 0.3f));
+        }
+        if (tile.hasCrop)
+        {
+            auto sprite = Sprite::create(getCropTextureName(tile.cropId, tile.stage));
+            if (sprite)
             {
-                auto sprite = Sprite::create(getCropTextureName(tile.cropId, tile.stage));
-                if (sprite)
-                {
-                    sprite->getTexture()->setAliasTexParameters();
-                    sprite->setScale(sprite->getContentSize().height <= 16.0f ? 2.0f : 1.0f);
-                    sprite->setPosition(center);
-                    cropLayer_->addChild(sprite, 1);
-                }
+                sprite->getTexture()->setAliasTexParameters();
+                sprite->setScale(sprite->getContentSize().height <= 16.0f ? 2.0f : 1.0f);
+                sprite->setPosition(center);
+                cropLayer_->addChild(sprite, 1);
             }
         }
-    }
+    });
 }
 
 int FarmManager::getDayCount() const { return TimeManager::getInstance()->getDay(); }
-void FarmManager::setDayCount(int dayCount) { TimeManager::getInstance()->setDayCount(dayCount); }
+void FarmManager::setDayCount(int dayCount)
+{
+    // 读档时农田状态就是存档当天的状态，不需要补算
+    auto tm = TimeManager::getInstance();
+    tm->setDayCount(dayCount);
+    tm->setLastFarmUpdateDay(dayCount);
+}
 float FarmManager::getDayProgress() const
 {
     auto tm = TimeManager::getInstance();
@@ -9,6 +9,9 @@
 #include "ShippingBin.h"
 #include <functional>
 #include "InventoryManager.h" // Needed for ItemType
+#include "SaveManager.h"
+#include "FarmTileStore.h"
+#include "TimeManager.h"
 
 class MapLayer;
 
@@ -16,21 +19,14 @@ class MapLayer;
  * @brief 管理农田状态（耕地、浇水、作物生长）并绘制覆盖层
  *
  * - 使用 TMX 地图尺寸自动匹配瓦片
- * - 简单的时间推进：默认每 5 秒+1 天，浇水的作物会前进生长阶段
+ * - 每天午夜由 TimeManager 时间轮回调结算，浇水的作物会前进生长阶段
  * - 提供耕地、种植、浇水、收获的动作接口
+ * - 瓦片按 16x16 分块稀疏存储，只有耕过的区域占用内存
  */
 class FarmManager : public cocos2d::Node
 {
 public:
-    struct FarmTile
-    {
-        bool tilled = false;
-        bool watered = false;
-        bool hasCrop = false;
-        int cropId = -1;
-        int stage = 0;            // 当前生长阶段索引
-        int progressDays = 0;     // 当前阶段已积累的天数
-    };
+    using FarmTile = ::FarmTile;
 
     struct ActionResult
     {
@@ -40,8 +36,17 @@ public:
     };
 
     static FarmManager* create(MapLayer* mapLayer);
+
+    /**
+     * @brief 创建无界面农场，用于模拟和基准测试
+     *
+     * 不创建覆盖层、作物精灵和交易箱，不读取存档，也不注册时间轮回调，
+     * 因此不需要 OpenGL 上下文。由调用方通过 simulateDay() 推进时间。
+     * @param mapSizeTiles 农田尺寸（瓦片）
+     */
+    static FarmManager* createHeadless(const cocos2d::Size& mapSizeTiles);
+    virtual ~FarmManager();
     virtual bool init(MapLayer* mapLayer);
-    virtual void update(float delta) override;
 
     int getHour() const;
     int getMinute() const;
@@ -51,6 +56,11 @@ public:
     ActionResult plantSeed(const cocos2d::Vec2& tileCoord, int cropId = 0);
     ActionResult waterTile(const cocos2d::Vec2& tileCoord);
     ActionResult harvestTile(const cocos2d::Vec2& tileCoord);
+
+    /**
+     * @brief 结算一天：交易箱收入、已浇水作物生长一天、清除浇水状态
+     */
+    void simulateDay();
    
 
     int getDayCount() const;
@@ -58,14 +68,19 @@ public:
     void forceRedraw();
 
     /**
-     * @brief 获取所有农田状态（用于存档）
+     * @brief 获取农田瓦片存储（只包含有状态的瓦片）
+     */
+    const FarmTileStore& getTiles() const { return tiles_; }
+
+    /**
+     * @brief 导出有状态的瓦片（用于存档）
      */
-    std::vector<FarmTile> getAllTiles() const { return tiles_; }
+    void collectSaveData(std::vector<SaveManager::SaveData::FarmTileData>& out) const;
 
     /**
-     * @brief 设置所有农田状态（用于加载存档）
+     * @brief 用存档数据替换所有农田状态（用于加载存档）
      */
-    void setAllTiles(const std::vector<FarmTile>& tiles);
+    void loadSaveData(const std::vector<SaveManager::SaveData::FarmTileData>& tiles);
 
     /**
      * @brief 市场/交易箱相关回调
@@ -102,9 +117,15 @@ private:
     };
 
     void initCropDefs();
-    void progressDay();
+    FarmTileStore::GrowthTable buildGrowthTable() const;
+    void progressDay(int day);
+    void catchUpMissedDays();
+    void sellShippedItems();
+    void growCrops();
     void redrawOverlay();
     bool isValidTile(const cocos2d::Vec2& tileCoord) const;
+    FarmTile getTile(const cocos2d::Vec2& tileCoord) const;
+    void setTile(const cocos2d::Vec2& tileCoord, const FarmTile& tile);
     CropDef getCropDef(int cropId) const;
     bool isMature(const FarmTile& tile) const;
 
@@ -119,15 +140,17 @@ private:
     // int dayCount_; // Removed, use TimeManager
 
 
-    std::vector<FarmTile> tiles_;
+    FarmTileStore tiles_;
     std::unordered_map<int, CropDef> crops_;
     std::vector<StorageChest*> storageChests_;
     ShippingBin* shippingBin_{ nullptr };
+    bool headless_{ false };
+    TimeManager::TimerId midnightTimer_{ 0 };
     
     PriceFunction priceFunction_;
     EarningsCallback earningsCallback_;
     
-    std::string getCropTextureName(int cropId, int stage) const;
+    const std::string& getCropTextureName(int cropId, int stage) const;
 };
 
 #endif // __FARM_MANAGER_H__
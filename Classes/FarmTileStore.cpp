@@ -0,0 +1,162 @@
+#include "FarmTileStore.h"
+#include <algorithm>
+#include <cstring>
+
+FarmTileStore::FarmTileStore()
+{
+    std::memset(&growth_, 0, sizeof(growth_));
+}
+
+void FarmTileStore::reset(int width, int height)
+{
+    width_ = width > 0 ? width : 0;
+    height_ = height > 0 ? height : 0;
+    chunksPerRow_ = (width_ + kChunkSize - 1) / kChunkSize;
+    int chunkRows = (height_ + kChunkSize - 1) / kChunkSize;
+    directory_.assign(static_cast<size_t>(chunksPerRow_ * chunkRows), -1);
+    chunks_.clear();
+}
+
+void FarmTileStore::clear()
+{
+    std::fill(directory_.begin(), directory_.end(), -1);
+    chunks_.clear();
+}
+
+void FarmTileStore::setGrowthTable(const GrowthTable& table)
+{
+    growth_ = table;
+    for (auto& chunk : chunks_)
+    {
+        for (int local = 0; local < kTilesPerChunk; ++local)
+        {
+            chunk->threshold[local] = testBit(chunk->hasCrop, local)
+                ? thresholdFor(chunk->cropId[local], chunk->stage[local]) : 0;
+        }
+    }
+}
+
+const FarmTileStore::Chunk* FarmTileStore::findChunk(int x, int y) const
+{
+    if (!isValid(x, y))
+        return nullptr;
+    int slot = directory_[chunkIndex(x, y)];
+    return slot < 0 ? nullptr : chunks_[slot].get();
+}
+
+bool FarmTileStore::contains(int x, int y) const
+{
+    const Chunk* chunk = findChunk(x, y);
+    return chunk && testBit(chunk->occupancy, localIndex(x, y));
+}
+
+FarmTile FarmTileStore::get(int x, int y) const
+{
+    const Chunk* chunk = findChunk(x, y);
+    int local = localIndex(x, y);
+    if (!chunk || !testBit(chunk->occupancy, local))
+        return FarmTile();
+    return unpack(*chunk, local);
+}
+
+FarmTile FarmTileStore::unpack(const Chunk& chunk, int local)
+{
+    FarmTile tile;
+    tile.tilled = testBit(chunk.tilled, local);
+    tile.watered = testBit(chunk.watered, local);
+    tile.hasCrop = testBit(chunk.hasCrop, local);
+    tile.cropId = chunk.cropId[local] == 0xFF ? -1 : chunk.cropId[local];
+    tile.stage = chunk.stage[local];
+    tile.progressDays = chunk.progress[local];
+    return tile;
+}
+
+void FarmTileStore::store(int x, int y, const FarmTile& tile)
+{
+    int& slot = directory_[chunkIndex(x, y)];
+    if (slot < 0)
+    {
+        std::unique_ptr<Chunk> chunk(new Chunk());
+        std::memset(chunk->cropId, 0xFF, sizeof(chunk->cropId));
+        chunk->originX = (x / kChunkSize) * kChunkSize;
+        chunk->originY = (y / kChunkSize) * kChunkSize;
+        slot = static_cast<int>(chunks_.size());
+        chunks_.push_back(std::move(chunk));
+    }
+
+    Chunk& chunk = *chunks_[slot];
+    int local = localIndex(x, y);
+    assignBit(chunk.occupancy, local, true);
+    assignBit(chunk.tilled, local, tile.tilled);
+    assignBit(chunk.watered, local, tile.watered);
+    assignBit(chunk.hasCrop, local, tile.hasCrop);
+    chunk.cropId[local] = static_cast<uint8_t>(tile.cropId);
+    chunk.stage[local] = static_cast<uint8_t>(std::min(std::max(tile.stage, 0), 255));
+    chunk.progress[local] = static_cast<uint8_t>(std::min(std::max(tile.progressDays, 0), 255));
+    chunk.threshold[local] = tile.hasCrop ? thresholdFor(chunk.cropId[local], chunk.stage[local]) : 0;
+}
+
+uint8_t FarmTileStore::thresholdFor(uint8_t cropId, uint8_t stage) const
+{
+    return stage < kMaxStages ? growth_.stageDays[cropId][stage] : 0;
+}
+
+void FarmTileStore::advanceDay()
+{
+    for (auto& chunk : chunks_)
+    {
+        advanceChunk(*chunk);
+    }
+}
+
+void FarmTileStore::advanceChunk(Chunk& chunk) const
+{
+    for (int word = 0; word < kMaskWords; ++word)
+    {
+        // 整组 64 格都没有浇过水的作物时直接跳过
+        uint64_t active = chunk.hasCrop[word] & chunk.watered[word];
+        if (!active)
+            continue;
+
+        uint8_t* progress = chunk.progress + word * 64;
+        uint8_t* stage = chunk.stage + word * 64;
+        const uint8_t* threshold = chunk.threshold + word * 64;
+
+        uint8_t lane[64];
+        for (int i = 0; i < 64; ++i)
+        {
+            lane[i] = static_cast<uint8_t>(0 - ((active >> i) & 1));
+        }
+
+        // 无分支的逐字节运算：grow/done 为 0x00 或 0xFF
+        uint8_t done[64];
+        for (int i = 0; i < 64; ++i)
+        {
+            uint8_t grow = lane[i] & static_cast<uint8_t>(0 - (threshold[i] != 0));
+            uint8_t next = static_cast<uint8_t>(progress[i] + (grow & 1));
+            uint8_t finished = grow & static_cast<uint8_t>(0 - (next >= threshold[i]));
+            progress[i] = next & static_cast<uint8_t>(~finished);
+            stage[i] = static_cast<uint8_t>(stage[i] + (finished & 1));
+            done[i] = finished;
+        }
+
+        // 只有进入下一阶段的作物需要查表更新阈值
+        for (int i = 0; i < 64; ++i)
+        {
+            if (done[i])
+            {
+                int local = word * 64 + i;
+                chunk.threshold[local] = thresholdFor(chunk.cropId[local], chunk.stage[local]);
+            }
+        }
+    }
+
+    std::memset(chunk.watered, 0, sizeof(chunk.watered));
+}
+
+size_t FarmTileStore::getTileCount() const
+{
+    size_t count = 0;
+    forEach([&count](int, int, const FarmTile&) { ++count; });
+    return count;
+}
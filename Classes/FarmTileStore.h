@@ -0,0 +1,191 @@
+#ifndef __FARM_TILE_STORE_H__
+#define __FARM_TILE_STORE_H__
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief 单个农田瓦片的状态（解包后的视图，存储时按位压缩）
+ */
+struct FarmTile
+{
+    bool tilled = false;
+    bool watered = false;
+    bool hasCrop = false;
+    int cropId = -1;
+    int stage = 0;            // 当前生长阶段索引
+    int progressDays = 0;     // 当前阶段已积累的天数
+};
+
+/**
+ * @brief 分块稀疏的农田瓦片存储
+ *
+ * 地图按 16x16 分块，某块第一次耕地时才分配；每块用 256 位占用掩码
+ * 记录哪些瓦片有状态。遍历只访问已分配的块和掩码中置位的瓦片，
+ * 内存和遍历开销随耕种面积增长，而不是随地图面积增长。
+ * 整张地图只保留一个块目录（每块一个下标）。
+ *
+ * 块内按结构数组存放：耕地/浇水/作物三个位集，作物 ID、阶段、进度
+ * 和当前阶段所需天数各一个字节数组。每天的生长由 advanceDay() 一次
+ * 完成，按 64 格一组做无分支的字节运算，编译器可以直接向量化。
+ */
+class FarmTileStore
+{
+public:
+    static const int kChunkSize = 16;
+    static const int kMaxStages = 4;
+
+    /**
+     * @brief 作物生长表：stageDays[作物][阶段] 为该阶段需要的天数，0 表示已成熟
+     *
+     * 作物 ID 按字节存储，未知作物 ID（包括 -1）也有对应的行。
+     */
+    struct GrowthTable
+    {
+        uint8_t stageDays[256][kMaxStages];
+    };
+
+    FarmTileStore();
+
+    /**
+     * @brief 清空所有瓦片并设置地图尺寸（瓦片）
+     */
+    void reset(int width, int height);
+
+    /**
+     * @brief 清空所有瓦片，保留地图尺寸
+     */
+    void clear();
+
+    /**
+     * @brief 设置作物生长表，已有瓦片的阈值会重新计算
+     */
+    void setGrowthTable(const GrowthTable& table);
+
+    bool isValid(int x, int y) const
+    {
+        return x >= 0 && y >= 0 && x < width_ && y < height_;
+    }
+
+    /**
+     * @brief 瓦片是否有状态
+     */
+    bool contains(int x, int y) const;
+
+    /**
+     * @brief 读取瓦片，没有状态的瓦片返回默认值
+     */
+    FarmTile get(int x, int y) const;
+
+    /**
+     * @brief 写入瓦片，所在块不存在时分配，并标记为已占用
+     * @note 调用方需保证坐标有效
+     */
+    void store(int x, int y, const FarmTile& tile);
+
+    /**
+     * @brief 结算一天：已浇水且未成熟的作物前进一天，然后清除所有浇水状态
+     */
+    void advanceDay();
+
+    /**
+     * @brief 遍历所有有状态的瓦片
+     * @param fn 回调 fn(int x, int y, const FarmTile& tile)
+     */
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (const auto& chunk : chunks_)
+        {
+            for (int word = 0; word < kMaskWords; ++word)
+            {
+                uint64_t bits = chunk->occupancy[word];
+                while (bits)
+                {
+                    int local = word * 64 + lowestSetBit(bits);
+                    bits &= bits - 1;
+                    fn(chunk->originX + local % kChunkSize, chunk->originY + local / kChunkSize, unpack(*chunk, local));
+                }
+            }
+        }
+    }
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    size_t getChunkCount() const { return chunks_.size(); }
+    size_t getTileCount() const;
+
+private:
+    static const int kTilesPerChunk = kChunkSize * kChunkSize;
+    static const int kMaskWords = kTilesPerChunk / 64;
+
+    struct Chunk
+    {
+        int originX;
+        int originY;
+        uint64_t occupancy[kMaskWords];
+        uint64_t tilled[kMaskWords];
+        uint64_t watered[kMaskWords];
+        uint64_t hasCrop[kMaskWords];
+        uint8_t cropId[kTilesPerChunk];      // -1 存为 0xFF
+        uint8_t stage[kTilesPerChunk];
+        uint8_t progress[kTilesPerChunk];
+        uint8_t threshold[kTilesPerChunk];   // 当前阶段需要的天数，0 表示不再生长
+    };
+
+    static int lowestSetBit(uint64_t bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanForward(&index, static_cast<unsigned long>(bits)))
+            return static_cast<int>(index);
+        _BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+        return static_cast<int>(index) + 32;
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+
+    static bool testBit(const uint64_t* bits, int local)
+    {
+        return (bits[local / 64] >> (local % 64)) & 1;
+    }
+
+    static void assignBit(uint64_t* bits, int local, bool value)
+    {
+        uint64_t mask = uint64_t(1) << (local % 64);
+        if (value)
+            bits[local / 64] |= mask;
+        else
+            bits[local / 64] &= ~mask;
+    }
+
+    static FarmTile unpack(const Chunk& chunk, int local);
+    uint8_t thresholdFor(uint8_t cropId, uint8_t stage) const;
+    void advanceChunk(Chunk& chunk) const;
+    const Chunk* findChunk(int x, int y) const;
+
+    int chunkIndex(int x, int y) const
+    {
+        return (y / kChunkSize) * chunksPerRow_ + (x / kChunkSize);
+    }
+
+    static int localIndex(int x, int y)
+    {
+        return (y % kChunkSize) * kChunkSize + (x % kChunkSize);
+    }
+
+    int width_ = 0;
+    int height_ = 0;
+    int chunksPerRow_ = 0;
+    std::vector<int> directory_;                    // 块目录：每块在 chunks_ 中的下标，-1 表示未分配
+    std::vector<std::unique_ptr<Chunk>> chunks_;    // 已分配的块，按分配顺序
+    GrowthTable growth_;
+};
+
+#endif // __FARM_TILE_STORE_H__
@@ -10,11 +10,13 @@ class Fish {
 public:
     virtual ~Fish() {}
     virtual ItemType getType() const = 0;
-    virtual std::string getName() const = 0;
-    virtual int getBasePrice() const = 0;
-    virtual float getDifficulty() const = 0; // 0.1 (easy) to 1.0 (hard)
-    virtual float getMovementFrequency() const = 0; // How fast it changes target
-    virtual bool isSaltwater() const = 0;
+
+    // 数值来自 ItemRegistry，子类只需给出物品类型和出现条件
+    virtual std::string getName() const { return ItemRegistry::get(getType()).name; }
+    virtual int getBasePrice() const { return ItemRegistry::get(getType()).basePrice; }
+    virtual float getDifficulty() const { return ItemRegistry::get(getType()).fish.difficulty; } // 0.1 (easy) to 1.0 (hard)
+    virtual float getMovementFrequency() const { return ItemRegistry::get(getType()).fish.movementFrequency; } // How fast it changes target
+    virtual bool isSaltwater() const { return ItemRegistry::get(getType()).fish.saltwater; }
     
     // 环境检查
     virtual bool canSpawn(int hour, int season, int weather) const {
@@ -28,33 +30,18 @@ public:
 class AnchovyFish : public Fish {
 public:
     ItemType getType() const override { return ItemType::ITEM_Anchovy; }
-    std::string getName() const override { return "Anchovy"; }
-    int getBasePrice() const override { return 30; }
-    float getDifficulty() const override { return 0.2f; }
-    float getMovementFrequency() const override { return 1.5f; }
-    bool isSaltwater() const override { return true; }
 };
 
 // 鲤鱼 - Carp (淡水, 极易)
 class CarpFish : public Fish {
 public:
     ItemType getType() const override { return ItemType::ITEM_Carp; }
-    std::string getName() const override { return "Carp"; }
-    int getBasePrice() const override { return 30; }
-    float getDifficulty() const override { return 0.1f; }
-    float getMovementFrequency() const override { return 2.0f; }
-    bool isSaltwater() const override { return false; }
 };
 
 // 鳗鱼 - Eel (海水/淡水雨夜, 困难)
 class EelFish : public Fish {
 public:
     ItemType getType() const override { return ItemType::ITEM_Eel; }
-    std::string getName() const override { return "Eel"; }
-    int getBasePrice() const override { return 85; }
-    float getDifficulty() const override { return 0.7f; }
-    float getMovementFrequency() const override { return 0.8f; }
-    bool isSaltwater() const override { return true; }
     bool canSpawn(int hour, int season, int weather) const override {
         // 典型雨天或深夜
         return (weather == (int)MarketState::Weather::HeavyRain || hour >= 18 || hour <= 6);
@@ -65,33 +52,18 @@ public:
 class FlounderFish : public Fish {
 public:
     ItemType getType() const override { return ItemType::ITEM_Flounder; }
-    std::string getName() const override { return "Flounder"; }
-    int getBasePrice() const override { return 50; }
-    float getDifficulty() const override { return 0.4f; }
-    float getMovementFrequency() const override { return 1.2f; }
-    bool isSaltwater() const override { return true; }
 };
 
 // 大口黑鲈 - Largemouth Bass (淡水, 中等)
 class LargemouthBassFish : public Fish {
 public:
     ItemType getType() const override { return ItemType::ITEM_Largemouth_Bass; }
-    std::string getName() const override { return "Largemouth Bass"; }
-    int getBasePrice() const override { return 100; }
-    float getDifficulty() const override { return 0.5f; }
-    float getMovementFrequency() const override { return 1.0f; }
-    bool isSaltwater() const override { return false; }
 };
 
 // 河豚 - Pufferfish (海水晴午, 极难)
 class PufferfishFish : public Fish {
 public:
     ItemType getType() const override { return ItemType::ITEM_Pufferfish; }
-    std::string getName() const override { return "Pufferfish"; }
-    int getBasePrice() const override { return 200; }
-    float getDifficulty() const override { return 0.9f; }
-    float getMovementFrequency() const override { return 0.5f; }
-    bool isSaltwater() const override { return true; }
     bool canSpawn(int hour, int season, int weather) const override {
         return (weather == (int)MarketState::Weather::Sunny && hour >= 12 && hour <= 16);
     }
@@ -101,11 +73,6 @@ public:
 class RainbowTroutFish : public Fish {
 public:
     ItemType getType() const override { return ItemType::ITEM_Rainbow_Trout; }
-    std::string getName() const override { return "Rainbow Trout"; }
-    int getBasePrice() const override { return 65; }
-    float getDifficulty() const override { return 0.6f; }
-    float getMovementFrequency() const override { return 0.9f; }
-    bool isSaltwater() const override { return false; }
     bool canSpawn(int hour, int season, int weather) const override {
         return (weather == (int)MarketState::Weather::Sunny);
     }
@@ -115,22 +82,12 @@ public:
 class SturgeonFish : public Fish {
 public:
     ItemType getType() const override { return ItemType::ITEM_Sturgeon; }
-    std::string getName() const override { return "Sturgeon"; }
-    int getBasePrice() const override { return 200; }
-    float getDifficulty() const override { return 1.0f; }
-    float getMovementFrequency() const override { return 0.4f; }
-    bool isSaltwater() const override { return true; } 
 };
 
 // 罗非鱼 - Tilapia (海水, 中等)
 class TilapiaFish : public Fish {
 public:
     ItemType getType() const override { return ItemType::ITEM_Tilapia; }
-    std::string getName() const override { return "Tilapia"; }
-    int getBasePrice() const override { return 75; }
-    float getDifficulty() const override { return 0.4f; }
-    float getMovementFrequency() const override { return 1.3f; }
-    bool isSaltwater() const override { return true; }
 };
 
 #endif // __FISH_H__
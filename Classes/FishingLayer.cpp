@@ -1,7 +1,9 @@
 #include "FishingLayer.h"
+#include "GameFont.h"
 #include "SkillManager.h"
 #include "Fish.h"
 #include "InventoryManager.h"
+#include "GameRandom.h"
 
 FishingLayer* FishingLayer::create(Fish* fish)
 {
@@ -40,6 +42,8 @@ bool FishingLayer::init(Fish* fish)
     
     fishPosition_ = 0.2f;
     barPosition_ = 0.1f;
+    prevFishPosition_ = fishPosition_;
+    prevBarPosition_ = barPosition_;
     
     // 物理参数
     barSpeed_ = 0.0f;
@@ -62,6 +66,7 @@ bool FishingLayer::init(Fish* fish)
     initInput();
 
     this->scheduleUpdate();
+    this->scheduleFixedUpdate();
 
     return true;
 }
@@ -174,11 +179,30 @@ void FishingLayer::initInput()
 
 void FishingLayer::update(float delta)
 {
+    // 在最近两个模拟步之间插值，帧率低于模拟频率时也保持平滑
+    float alpha = _scheduler->getFixedStepAlpha();
+    if (greenBar_)
+    {
+        float pos = prevBarPosition_ + (barPosition_ - prevBarPosition_) * alpha;
+        greenBar_->setPosition(Vec2(20, pos * barHeight_));
+    }
+    if (fishSprite_)
+    {
+        float pos = prevFishPosition_ + (fishPosition_ - prevFishPosition_) * alpha;
+        fishSprite_->setPosition(Vec2(20, pos * barHeight_));
+    }
+}
+
+void FishingLayer::fixedUpdate(float step)
+{
+    prevBarPosition_ = barPosition_;
+    prevFishPosition_ = fishPosition_;
+
     if (isGameOver_) return;
 
-    updateBarPhysics(delta);
-    updateFishMovement(delta);
-    updateProgress(delta);
+    updateBarPhysics(step);
+    updateFishMovement(step);
+    updateProgress(step);
 }
 
 void FishingLayer::updateBarPhysics(float delta)
@@ -209,11 +233,6 @@ void FishingLayer::updateBarPhysics(float delta)
             if (std::abs(barSpeed_) < 0.5f) barSpeed_ = 0;
         }
     }
-
-    if (greenBar_)
-    {
-        greenBar_->setPosition(Vec2(20, barPosition_ * barHeight_)); 
-    }
 }
 
 void FishingLayer::updateFishMovement(float delta)
@@ -224,11 +243,11 @@ void FishingLayer::updateFishMovement(float delta)
         // 难度越高，移动范围越广
         float range = 0.5f + (currentFish_ ? currentFish_->getDifficulty() * 0.4f : 0.2f);
         float offset = (1.0f - range) / 2.0f;
-        fishTargetPos_ = CCRANDOM_0_1() * range + offset;
+        fishTargetPos_ = GameRandom::getInstance()->nextFloat() * range + offset;
 
         // 难度越高，停留时间越短
         float baseFreq = currentFish_ ? currentFish_->getMovementFrequency() : 1.5f;
-        moveTimer_ = (CCRANDOM_0_1() * 1.5f + 0.5f) / baseFreq;
+        moveTimer_ = (GameRandom::getInstance()->nextFloat() * 1.5f + 0.5f) / baseFreq;
     }
 
     // 难度越高，移动速度越快
@@ -250,11 +269,6 @@ void FishingLayer::updateFishMovement(float delta)
     {
         fishPosition_ -= smooth;
     }
-
-    if (fishSprite_)
-    {
-        fishSprite_->setPosition(Vec2(20, fishPosition_ * barHeight_));
-    }
 }
 
 void FishingLayer::updateProgress(float delta)
@@ -308,7 +322,7 @@ void FishingLayer::finishFishing(bool success)
     if (isGameOver_) return;
     isGameOver_ = true;
 
-    auto label = Label::createWithSystemFont(success ? "PERFECT!" : "MISS", "Arial", 48);
+    auto label = GameFont::createLabel(success ? "PERFECT!" : "MISS", 48);
     label->setPosition(Director::getInstance()->getVisibleSize() / 2);
     label->setColor(success ? Color3B::YELLOW : Color3B::RED);
     this->addChild(label, 10);
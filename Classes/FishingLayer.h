@@ -13,7 +13,10 @@ class FishingLayer : public Layer
 public:
     static FishingLayer* create(Fish* fish);
     virtual bool init(Fish* fish);
-    void update(float delta);
+    // 每帧：按插值位置摆放绿条和鱼
+    void update(float delta) override;
+    // 固定步长：绿条物理、鱼的移动和捕获进度
+    void fixedUpdate(float step) override;
 
     // 设置回调
     void setFinishCallback(std::function<void(bool)> callback);
@@ -38,6 +41,7 @@ private:
     
     // Physics
     float barPosition_; // 0.0 - 1.0 (relative to barBottom)
+    float prevBarPosition_; // 上一个模拟步的位置，用于插值
     float barSpeed_;
     float gravity_;
     float thrust_;
@@ -45,6 +49,7 @@ private:
     
     // Fish
     float fishPosition_; // 0.0 - 1.0
+    float prevFishPosition_;
     float fishSpeed_;
     float fishTargetPos_;
     float moveTimer_;
@@ -0,0 +1,93 @@
+#include "GameFont.h"
+#include "2d/CCFontAtlasCache.h"
+
+USING_NS_CC;
+
+const char* const GameFont::kFontFile = "fonts/arial.ttf";
+const char* const GameFont::kCjkFontFile = "fonts/cjk.ttf";
+
+namespace {
+    const char* const kSystemFontName = "Arial";
+    const char* const kGlyphCacheFile = "glyph_cache.txt";
+
+    bool fontExists(const char* fontFile)
+    {
+        return FileUtils::getInstance()->isFileExist(fontFile);
+    }
+
+    /**
+     * @brief 距离场字体配置：各字号共用按 Label::DistanceFieldFontSize 生成的一份图集，绘制时缩放
+     */
+    TTFConfig distanceFieldConfig(const char* fontFile, float fontSize)
+    {
+        return TTFConfig(fontFile, fontSize, GlyphCollection::DYNAMIC, nullptr, true);
+    }
+}
+
+Label* GameFont::createLabel(const std::string& text, float fontSize, const Size& dimensions,
+                             TextHAlignment hAlignment, TextVAlignment vAlignment)
+{
+    static const bool hasFont = fontExists(kFontFile);
+    if (hasFont)
+    {
+        auto label = Label::createWithTTF(distanceFieldConfig(kFontFile, fontSize), text, hAlignment);
+        if (label)
+        {
+            label->setDimensions(dimensions.width, dimensions.height);
+            label->setVerticalAlignment(vAlignment);
+            return label;
+        }
+    }
+    return Label::createWithSystemFont(text, kSystemFontName, fontSize, dimensions, hAlignment, vAlignment);
+}
+
+Label* GameFont::createTextLabel(const std::string& text, float fontSize)
+{
+    static const bool hasCjkFont = fontExists(kCjkFontFile);
+    if (hasCjkFont)
+    {
+        auto label = Label::createWithTTF(distanceFieldConfig(kCjkFontFile, fontSize), text);
+        if (label)
+        {
+            return label;
+        }
+    }
+    return Label::createWithSystemFont(text, kSystemFontName, fontSize);
+}
+
+void GameFont::preloadGlyphs()
+{
+    int loaded = FontAtlasCache::loadGlyphCache(glyphCachePath());
+    if (loaded > 0)
+    {
+        CCLOG("GameFont: rebuilt %d glyph atlases from cache", loaded);
+        return;
+    }
+
+    if (!fontExists(kFontFile))
+    {
+        return;
+    }
+    std::string ascii;
+    for (char c = 0x20; c < 0x7f; ++c)
+    {
+        ascii.push_back(c);
+    }
+    // 所有字号共用一份距离场图集，预生成一次即可
+    TTFConfig config = distanceFieldConfig(kFontFile, Label::DistanceFieldFontSize);
+    FontAtlasCache::preloadFontAtlasTTF(&config, ascii);
+}
+
+void GameFont::saveGlyphCache()
+{
+    int saved = FontAtlasCache::saveGlyphCache(glyphCachePath());
+    if (saved < 0)
+    {
+        CCLOG("GameFont: failed to save glyph cache");
+    }
+}
+
+std::string GameFont::glyphCachePath()
+{
+    return FileUtils::getInstance()->getWritablePath() + kGlyphCacheFile;
+}
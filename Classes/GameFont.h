@@ -0,0 +1,53 @@
+#ifndef __GAME_FONT_H__
+#define __GAME_FONT_H__
+
+#include "cocos2d.h"
+#include <string>
+
+/**
+ * @brief 游戏统一字体
+ *
+ * 所有界面文字都用同一个 TTF 字体创建距离场（SDF）标签：任何字号都共用 FontAtlas 里
+ * 按 Label::DistanceFieldFontSize 生成的一份字形图集，绘制时缩放，描边和发光由着色器完成。
+ * 不再像系统字体那样每个标签、每次改字都生成一张整段文字的纹理，改分辨率或缩放也不用重新栅格化。
+ * 没有描边、发光和阴影的标签以 QuadCommand 提交，图集页、文字颜色和缩放相同的相邻标签合并为一次绘制。
+ *
+ * 字形缓存：退出或切到后台时把各图集里已有的字体、字号和字符写到可写目录，
+ * 下次启动先按缓存把这些字形栅格化进图集，进入场景时不再逐字现场生成。
+ */
+class GameFont
+{
+public:
+    /**
+     * @brief 创建界面标签（fonts/arial.ttf 距离场字体，字体缺失时退回系统字体）
+     */
+    static cocos2d::Label* createLabel(const std::string& text, float fontSize,
+                                       const cocos2d::Size& dimensions = cocos2d::Size::ZERO,
+                                       cocos2d::TextHAlignment hAlignment = cocos2d::TextHAlignment::LEFT,
+                                       cocos2d::TextVAlignment vAlignment = cocos2d::TextVAlignment::TOP);
+
+    /**
+     * @brief 创建可能包含中文的标签（对话框等）
+     *
+     * 提供了 fonts/cjk.ttf 时用它生成字形图集，否则退回系统字体，由系统负责中文字形。
+     */
+    static cocos2d::Label* createTextLabel(const std::string& text, float fontSize);
+
+    /**
+     * @brief 启动时调用：按上次保存的字形缓存重建图集，没有缓存时预生成 ASCII 字形
+     */
+    static void preloadGlyphs();
+
+    /**
+     * @brief 把当前图集里的字形列表写入可写目录
+     */
+    static void saveGlyphCache();
+
+    static const char* const kFontFile;
+    static const char* const kCjkFontFile;
+
+private:
+    static std::string glyphCachePath();
+};
+
+#endif // __GAME_FONT_H__
@@ -0,0 +1,47 @@
+#include "GameRandom.h"
+
+namespace {
+GameRandom s_defaultRandom;
+GameRandom* s_random = nullptr;
+}
+
+GameRandom* GameRandom::getInstance()
+{
+    return s_random ? s_random : &s_defaultRandom;
+}
+
+void GameRandom::setInstance(GameRandom* random)
+{
+    s_random = random;
+}
+
+GameRandom::GameRandom(uint32_t seed)
+    : engine_(seed)
+    , seed_(seed)
+{
+}
+
+void GameRandom::setSeed(uint32_t seed)
+{
+    seed_ = seed;
+    engine_.seed(seed);
+}
+
+int GameRandom::nextInt(int bound)
+{
+    if (bound <= 0)
+        return 0;
+    return static_cast<int>(engine_() % static_cast<uint32_t>(bound));
+}
+
+int GameRandom::nextInt(int minValue, int maxValue)
+{
+    if (maxValue <= minValue)
+        return minValue;
+    return minValue + nextInt(maxValue - minValue + 1);
+}
+
+float GameRandom::nextFloat()
+{
+    return static_cast<float>(engine_() >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,60 @@
+#ifndef __GAME_RANDOM_H__
+#define __GAME_RANDOM_H__
+
+#include <cstdint>
+#include <random>
+
+/**
+ * @brief 游戏随机数发生器
+ *
+ * 职责：
+ * - 替代全局 rand()，所有游戏逻辑的随机数都从这里取
+ * - 可设置种子，同一种子得到完全相同的随机序列（无界面模拟、回放、测试）
+ * - 可注入：setInstance() 替换全局实例，例如给每个模拟使用独立的发生器
+ * - 默认种子固定，游戏启动时由 AppDelegate 用随机种子重新设置
+ */
+class GameRandom
+{
+public:
+    /**
+     * @brief 获取当前使用的随机数发生器
+     */
+    static GameRandom* getInstance();
+
+    /**
+     * @brief 注入随机数发生器，传 nullptr 恢复默认实例
+     * @param random 调用方负责其生命周期
+     */
+    static void setInstance(GameRandom* random);
+
+    explicit GameRandom(uint32_t seed = kDefaultSeed);
+
+    /**
+     * @brief 重新设置种子
+     */
+    void setSeed(uint32_t seed);
+    uint32_t getSeed() const { return seed_; }
+
+    /**
+     * @brief 返回 [0, bound) 内的整数，bound <= 0 时返回 0
+     */
+    int nextInt(int bound);
+
+    /**
+     * @brief 返回 [minValue, maxValue] 内的整数
+     */
+    int nextInt(int minValue, int maxValue);
+
+    /**
+     * @brief 返回 [0, 1) 内的浮点数
+     */
+    float nextFloat();
+
+    static const uint32_t kDefaultSeed = 5489u;
+
+private:
+    std::mt19937 engine_;
+    uint32_t seed_;
+};
+
+#endif // __GAME_RANDOM_H__
@@ -1,4 +1,5 @@
 ﻿#include "GameScene.h"
+#include "GameFont.h"
 #include "MenuScene.h"
 #include "HouseScene.h"
 #include "HouseScene.h"
@@ -22,6 +23,8 @@
 #include <unordered_set>
 #include "EnergyBar.h"
 #include "QuantityPopup.h"
+#include "TexturePreloader.h"
+#include "GameRandom.h"
 
 USING_NS_CC;
 
@@ -104,6 +107,24 @@ Scene* GameScene::createScene()
 
 }
 
+GameScene::~GameScene()
+{
+    if (marketTimer_)
+    {
+        TimeManager::getInstance()->cancelTimer(marketTimer_);
+    }
+    if (autosaveTimer_)
+    {
+        TimeManager::getInstance()->cancelTimer(autosaveTimer_);
+    }
+}
+
+void GameScene::onExit()
+{
+    TexturePreloader::cancel(TexturePreloader::groupFor(this));
+    Scene::onExit();
+}
+
 bool GameScene::init()
 
 {
@@ -171,6 +192,13 @@ bool GameScene::init()
 
     // 启动更新
     this->scheduleUpdate();
+    this->scheduleFixedUpdate();
+
+    // 后台解码从农场能去到的地图的图块集，进入时直接命中纹理缓存
+    std::string preloadGroup = TexturePreloader::groupFor(this);
+    TexturePreloader::preloadMap("map/Mines/1.tmx", TexturePreloader::Priority::BACKGROUND, preloadGroup);
+    TexturePreloader::preloadMap("map/beachMap.tmx", TexturePreloader::Priority::BACKGROUND, preloadGroup);
+    TexturePreloader::preloadMap("map/Barn.tmx", TexturePreloader::Priority::BACKGROUND, preloadGroup);
 
     CCLOG("Game Scene initialized successfully!");
 
@@ -410,7 +438,7 @@ void GameScene::initUI()
 
     // ===== 时间显示 =====
 
-    timeLabel_ = Label::createWithSystemFont("Day 1 (auto +1 every 5s)", "Arial", 24);
+    timeLabel_ = GameFont::createLabel("Day 1 (auto +1 every 5s)", 24);
 
     timeLabel_->setAnchorPoint(Vec2(0, 0.5));
 
@@ -428,7 +456,7 @@ void GameScene::initUI()
 
     // ===== 金币显示 =====
 
-    moneyLabel_ = Label::createWithSystemFont("Gold: 500", "Arial", 24);
+    moneyLabel_ = GameFont::createLabel("Gold: 500", 24);
 
     moneyLabel_->setAnchorPoint(Vec2(1, 0.5));
 
@@ -446,7 +474,7 @@ void GameScene::initUI()
 
     // ===== 位置显示（调试用）=====
 
-    positionLabel_ = Label::createWithSystemFont("Position: (0, 0) | Tile: (0, 0)", "Arial", 18);
+    positionLabel_ = GameFont::createLabel("Position: (0, 0) | Tile: (0, 0)", 18);
 
     positionLabel_->setPosition(Vec2(
 
@@ -462,9 +490,9 @@ void GameScene::initUI()
 
     // ===== 操作提示 =====
 
-    auto hint = Label::createWithSystemFont(
+    auto hint = GameFont::createLabel(
         "1-8: Switch item | J: Use | K: Water | B: Inventory | E: Skills | P: Market | M: Mine | ESC: Menu",
-        "Arial", 18
+        18
     );
 
     hint->setPosition(Vec2(
@@ -481,7 +509,7 @@ void GameScene::initUI()
 
     // ===== 农场操作提示 =====
 
-    actionLabel_ = Label::createWithSystemFont("", "Arial", 20);
+    actionLabel_ = GameFont::createLabel("", 20);
 
     actionLabel_->setPosition(Vec2(
 
@@ -496,7 +524,7 @@ void GameScene::initUI()
     uiLayer_->addChild(actionLabel_, 1);
 
     // ===== 当前物品显示 =====
-    itemLabel_ = Label::createWithSystemFont("Current item: Hoe (1-8 to switch)", "Arial", 18);
+    itemLabel_ = GameFont::createLabel("Current item: Hoe (1-8 to switch)", 18);
     itemLabel_->setAnchorPoint(Vec2(0, 0.5f));
     itemLabel_->setPosition(Vec2(
         origin.x + 20,
@@ -577,6 +605,9 @@ void GameScene::initWeather()
 
         updateWeather();
 
+        // 新的一天开始时重新定价，不再逐帧比较天数
+        marketTimer_ = TimeManager::getInstance()->scheduleDaily(6, 0, [this](int) { updateWeather(); });
+
         CCLOG("WeatherManager initialized");
 
     }
@@ -868,19 +899,22 @@ void GameScene::update(float delta)
     updateFishingState(delta);
 
     checkBeachEntrance();
+}
 
+void GameScene::fixedUpdate(float step)
+{
     // [New] Time / Fatigue Check
     auto tm = TimeManager::getInstance();
-    tm->update(delta); // Update global time
+    tm->update(step); // Update global time
 
     if (tm->isMidnight()) // Midnight
     {
-         // Prevent multiple triggers if already passing out (scene replacement stops update anyway)
+         // 停止模拟步，避免同一帧内追帧时重复触发
+         unscheduleFixedUpdate();
          CCLOG("It's midnight! Passing out...");
          if (inventory_) inventory_->removeMoney(200);
          showActionMessage("Passed out...", Color3B::RED);
          Director::getInstance()->replaceScene(TransitionFade::create(1.0f, HouseScene::createScene(true)));
-         return;
     }
 }
 
@@ -1164,7 +1198,7 @@ void GameScene::handleFarmAction(bool waterOnly)
                             {
                                 int extraCount = 0;
                                 float bonusChance = SkillManager::getInstance()->getAgricultureBonusChance();
-                                if (bonusChance > 0.0f && CCRANDOM_0_1() < bonusChance)
+                                if (bonusChance > 0.0f && GameRandom::getInstance()->nextFloat() < bonusChance)
                                 {
                                     if (inventory_->addItem(harvestItem, 1))
                                         extraCount = 1;
@@ -1172,12 +1206,12 @@ void GameScene::handleFarmAction(bool waterOnly)
                                 if (extraCount > 0)
                                 {
                                     result.message = StringUtils::format("Harvested %s (+%d)",
-                                        InventoryManager::getItemName(harvestItem).c_str(), 1 + extraCount);
+                                        InventoryManager::getItemName(harvestItem), 1 + extraCount);
                                 }
                                 else
                                 {
                                     result.message = StringUtils::format("Harvested %s (+1)",
-                                        InventoryManager::getItemName(harvestItem).c_str());
+                                        InventoryManager::getItemName(harvestItem));
                                 }
                                 if (inventoryUI_) inventoryUI_->refresh();
                             }
@@ -1340,7 +1374,7 @@ void GameScene::handleFarmAction(bool waterOnly)
                     if (result.success && inventory_) {
                         inventory_->removeItem(current, 1);
                         player_->consumeEnergy(2.0f);
-                        result.message = StringUtils::format("Planted %s (-1)", InventoryManager::getItemName(current).c_str());
+                        result.message = StringUtils::format("Planted %s (-1)", InventoryManager::getItemName(current));
                         if (inventoryUI_) inventoryUI_->refresh();
                         SkillManager::getInstance()->recordAction(SkillManager::SkillType::Agriculture);
                     }
@@ -1704,7 +1738,7 @@ void GameScene::playTreeShakeAnimation(Sprite* treeSprite) {
     auto camera = this->getDefaultCamera();
     Vec3 camPos = camera->getPosition3D();
 
-    auto hitLabel = Label::createWithSystemFont("CHOP!", "Arial", 30);
+    auto hitLabel = GameFont::createLabel("CHOP!", 30);
     hitLabel->setPosition(Vec2(
         treeSprite->getPosition().x,
         treeSprite->getPosition().y + 120
@@ -1752,7 +1786,7 @@ void GameScene::playTreeFallAnimation(TreeChopData* chopData) {
     auto spawnAnim = Spawn::create(rotateSeq, moveRight, scaleSeq, fadeSeq, nullptr);
 
     // 文字特效
-    auto timberLabel = Label::createWithSystemFont("TIMBER!", "Arial", 40);
+    auto timberLabel = GameFont::createLabel("TIMBER!", 40);
     timberLabel->setPosition(Vec2(treeSprite->getPosition().x, treeSprite->getPosition().y + 150));
     timberLabel->setColor(Color3B(255, 200, 50));
     this->addChild(timberLabel, 200);
@@ -1797,7 +1831,7 @@ void GameScene::playTreeFallAnimation(TreeChopData* chopData) {
         }
 
         // 4. 掉落物品
-        int woodCount = 3 + (rand() % 3);
+        int woodCount = 3 + GameRandom::getInstance()->nextInt(3);
         spawnItem(ItemType::Wood, stumpPos, woodCount);
 
         // 5. 数据记录
@@ -1853,8 +1887,8 @@ void GameScene::spawnItem(ItemType type, const Vec2& position, int count) {
 
     // 显示数量标签
     if (count > 1) {
-        auto countLabel = Label::createWithSystemFont(
-            StringUtils::format("+%d", count), "Arial", 20);
+        auto countLabel = GameFont::createLabel(
+            StringUtils::format("+%d", count), 20);
         countLabel->setPosition(Vec2(position.x, position.y + 40));
         countLabel->setColor(Color3B(255, 255, 100));
         this->addChild(countLabel, 51);
@@ -1866,7 +1900,7 @@ void GameScene::spawnItem(ItemType type, const Vec2& position, int count) {
     }
 
     // TODO: 实际游戏中应该将物品添加到背包系统
-    CCLOG("Collected %d x %s", count, getItemName(type).c_str());
+    CCLOG("Collected %d x %s", count, InventoryManager::getItemName(type));
 }
 
 void GameScene::updateChopping(float delta) {
@@ -2049,7 +2083,7 @@ void GameScene::initToolbarUI()
         }
         toolbarIcons_.push_back(icon);
 
-        auto countLabel = Label::createWithSystemFont("", "Arial", 14);
+        auto countLabel = GameFont::createLabel("", 14);
         countLabel->setAnchorPoint(Vec2(1, 0));
         countLabel->setPosition(Vec2(kToolbarSlotSize - 4.0f, 4.0f));
         countLabel->setColor(Color3B::WHITE);
@@ -2335,7 +2369,7 @@ void GameScene::onMouseUp(Event* event)
             if (chargeBarBg_) chargeBarBg_->setVisible(false);
             
             // Wait 1.0 - 4.0s
-            waitTimer_ = CCRANDOM_0_1() * 3.0f + 1.0f;
+            waitTimer_ = GameRandom::getInstance()->nextFloat() * 3.0f + 1.0f;
             if (player_) player_->startFishingCast();
             CCLOG("Casting rod! Power: %.2f. Waiting...", chargePower_);
         }
@@ -2396,7 +2430,7 @@ void GameScene::startFishing()
         ItemType::ITEM_Carp, ItemType::ITEM_Largemouth_Bass, ItemType::ITEM_Rainbow_Trout, ItemType::ITEM_Eel
     };
     
-    int idx = cocos2d::random(0, (int)freshFish.size() - 1);
+    int idx = GameRandom::getInstance()->nextInt(0, (int)freshFish.size() - 1);
     ItemType typeToCatch = freshFish[idx];
     Fish* fishObj = Fish::createByType(typeToCatch);
 
@@ -2860,6 +2894,7 @@ void GameScene::saveGame()
     if (SaveManager::getInstance()->saveGame(data))
     {
         CCLOG("✓ Game saved successfully!");
+        armAutosave();
         // 显示保存成功提示
         showActionMessage("Game Saved!", Color3B::GREEN);
     }
@@ -2870,6 +2905,27 @@ void GameScene::saveGame()
     }
 }
 
+void GameScene::armAutosave()
+{
+    // 新游戏和昏倒后重建的场景不加载存档，农场是空的；
+    // 只有加载过存档或保存过的场景才自动存档，否则会把空农场写进已有的存档
+    if (!autosaveTimer_)
+    {
+        // 每个整点自动存档，每次只追加一个很小的增量检查点
+        autosaveTimer_ = TimeManager::getInstance()->scheduleHourly(0, [this](int) { autosave(); });
+    }
+}
+
+void GameScene::autosave()
+{
+    // 自动存档不提示，只在失败时告诉玩家
+    if (!SaveManager::getInstance()->saveGame(collectSaveData()))
+    {
+        CCLOG("✗ Autosave failed!");
+        showActionMessage("Autosave Failed!", Color3B::RED);
+    }
+}
+
 void GameScene::loadGame()
 {
     CCLOG("========================================");
@@ -2882,6 +2938,7 @@ void GameScene::loadGame()
     {
         CCLOG("✓ Game loaded successfully from file!");
         applySaveData(data);
+        armAutosave();
 
         // 延迟显示消息，确保 UI 已初始化
         if (actionLabel_)
@@ -2950,35 +3007,7 @@ SaveManager::SaveData GameScene::collectSaveData()
     // 保存农作物数据
     if (farmManager_)
     {
-        const auto& farmTiles = farmManager_->getAllTiles();
-        Size mapSize = farmManager_->getMapSize();
-
-        for (int y = 0; y < mapSize.height; y++)
-        {
-            for (int x = 0; x < mapSize.width; x++)
-            {
-                int index = y * mapSize.width + x;
-                if (index >= farmTiles.size())
-                    continue;
-
-                const auto& tile = farmTiles[index];
-
-                // 只保存有状态的瓦片
-                if (tile.tilled || tile.hasCrop)
-                {
-                    SaveManager::SaveData::FarmTileData tileData;
-                    tileData.x = x;
-                    tileData.y = y;
-                    tileData.tilled = tile.tilled;
-                    tileData.watered = tile.watered;
-                    tileData.hasCrop = tile.hasCrop;
-                    tileData.cropId = tile.cropId;
-                    tileData.stage = tile.stage;
-                    tileData.progressDays = tile.progressDays;
-                    data.farmTiles.push_back(tileData);
-                }
-            }
-        }
+        farmManager_->collectSaveData(data.farmTiles);
         CCLOG("Saving %zu farm tiles", data.farmTiles.size());
 
         // 保存储物箱数据
@@ -3025,6 +3054,9 @@ SaveManager::SaveData GameScene::collectSaveData()
         CCLOG("Saving %zu skills", data.skills.size());
     }
 
+    // 保存矿洞楼层数据（本周已开过的宝箱）
+    MineScene::collectSaveData(data.mineFloors);
+
     return data;
 }
 
@@ -3066,6 +3098,11 @@ void GameScene::applySaveData(const SaveManager::SaveData& data)
         for (size_t i = 0; i < data.inventory.slots.size() && i < inventory_->getSlotCount(); i++)
         {
             const auto& slotData = data.inventory.slots[i];
+            if (!ItemRegistry::isValid(slotData.type))
+            {
+                CCLOG("  Slot %zu skipped: unknown item type %d", i, slotData.type);
+                continue;
+            }
             if (slotData.type != static_cast<int>(ItemType::ITEM_NONE) && slotData.count > 0)
             {
                 ItemType type = static_cast<ItemType>(slotData.type);
@@ -3096,26 +3133,7 @@ void GameScene::applySaveData(const SaveManager::SaveData& data)
     if (farmManager_)
     {
         CCLOG("Restoring farm tiles...");
-        // 获取当前地图尺寸
-        Size mapSize = farmManager_->getMapSize();
-        std::vector<FarmManager::FarmTile> tiles(mapSize.width * mapSize.height);
-
-        // 应用保存的瓦片数据
-        for (const auto& tileData : data.farmTiles)
-        {
-            int index = tileData.y * mapSize.width + tileData.x;
-            if (index >= 0 && index < tiles.size())
-            {
-                tiles[index].tilled = tileData.tilled;
-                tiles[index].watered = tileData.watered;
-                tiles[index].hasCrop = tileData.hasCrop;
-                tiles[index].cropId = tileData.cropId;
-                tiles[index].stage = tileData.stage;
-                tiles[index].progressDays = tileData.progressDays;
-            }
-        }
-
-        farmManager_->setAllTiles(tiles);
+        farmManager_->loadSaveData(data.farmTiles);
         CCLOG("✓ Farm tiles restored: %zu tiles", data.farmTiles.size());
 
         // 恢复储物箱数据
@@ -3127,7 +3145,7 @@ void GameScene::applySaveData(const SaveManager::SaveData& data)
                 // 恢复箱子里的物品
                 for (size_t i = 0; i < chestData.slots.size() && i < chest->getInventory()->getSlotCount(); ++i) {
                     const auto& slot = chestData.slots[i];
-                    if (slot.type != (int)ItemType::ITEM_NONE && slot.count > 0) {
+                    if (slot.type != (int)ItemType::ITEM_NONE && ItemRegistry::isValid(slot.type) && slot.count > 0) {
                         chest->getInventory()->setSlot(i, (ItemType)slot.type, slot.count);
                     }
                 }
@@ -3153,6 +3171,9 @@ void GameScene::applySaveData(const SaveManager::SaveData& data)
         CCLOG("✓ Skills restored: %zu skills", data.skills.size());
     }
 
+    // 恢复矿洞楼层数据
+    MineScene::loadSaveData(data.mineFloors, data.dayCount);
+
     CCLOG("========================================");
     CCLOG("✓ Save data applied successfully!");
     CCLOG("========================================");
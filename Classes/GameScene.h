@@ -46,6 +46,8 @@ public:
      */
     static cocos2d::Scene* createScene(bool loadFromSave);
 
+    virtual ~GameScene();
+
     /**
      * @brief 初始化
      */
@@ -63,6 +65,17 @@ public:
      */
     virtual void update(float delta) override;
 
+    /**
+     * @brief 固定步长更新（游戏时间和午夜检查）
+     * @param step 模拟步长
+     */
+    virtual void fixedUpdate(float step) override;
+
+    /**
+     * @brief 离开场景时取消尚未完成的纹理预加载
+     */
+    virtual void onExit() override;
+
     CREATE_FUNC(GameScene);
 
 private:
@@ -269,6 +282,8 @@ private:
     ItemType getItemTypeForCropId(int cropId) const;
 
     int lastWeatherDay_ = 0;
+    TimeManager::TimerId marketTimer_ = 0;   // 每天 6:00 刷新天气和市场价格
+    TimeManager::TimerId autosaveTimer_ = 0; // 每个整点自动存档（加载或保存过存档后才启用）
 
     // ==========================================
     // 砍树系统 (New Architecture from GameScene1)
@@ -342,6 +357,16 @@ private:
      */
     void saveGame();
 
+    /**
+     * @brief 启用每个游戏整点的自动存档（场景加载或保存过存档后调用）
+     */
+    void armAutosave();
+
+    /**
+     * @brief 自动存档，成功时不显示提示
+     */
+    void autosave();
+
     /**
      * @brief 加载游戏
      */
@@ -1,4 +1,5 @@
 #include "HouseScene.h"
+#include "GameFont.h"
 #include "FarmManager.h"
 #include "Player.h"
 #include "GameScene.h"
@@ -42,6 +43,7 @@ bool HouseScene::init(bool isPassedOut)
     initControls();
     initUI();
     this->scheduleUpdate();
+    this->scheduleFixedUpdate();
 
     // 初始化背包引用
     inventory_ = InventoryManager::getInstance();
@@ -76,7 +78,7 @@ void HouseScene::initUI()
     auto visibleSize = Director::getInstance()->getVisibleSize();
     Vec2 origin = Director::getInstance()->getVisibleOrigin();
 
-    timeLabel_ = Label::createWithSystemFont("Time: --:--", "Arial", 24);
+    timeLabel_ = GameFont::createLabel("Time: --:--", 24);
     timeLabel_->setPosition(Vec2(origin.x + visibleSize.width * 0.5f, origin.y + visibleSize.height - 30));
     timeLabel_->setColor(Color3B::WHITE);
     this->addChild(timeLabel_, 10);
@@ -264,6 +266,14 @@ void HouseScene::initPlayer()
 }
 
 void HouseScene::update(float delta)
+{
+    if (!player_ || !background_)
+        return;
+
+    updateUI();
+}
+
+void HouseScene::fixedUpdate(float step)
 {
     if (!player_ || !background_)
         return;
@@ -272,7 +282,7 @@ void HouseScene::update(float delta)
     auto tm = TimeManager::getInstance();
     if (tm) {
         float speedMultiplier = isSleeping_ ? 40.0f : 1.0f; // Fast forward if sleeping
-        tm->update(delta * speedMultiplier);
+        tm->update(step * speedMultiplier);
 
         // Auto Wake Up at 6:00 AM
         if (isSleeping_ && tm->getHour() == 6)
@@ -298,9 +308,6 @@ void HouseScene::update(float delta)
         }
     }
 
-    
-    updateUI();
-
     if (isSleeping_) return; // Lock movement when sleeping
 
     Rect bounds = background_->getBoundingBox();
@@ -313,10 +320,11 @@ void HouseScene::update(float delta)
     float minY = bounds.getMinY() + halfH + margin;
     float maxY = bounds.getMaxY() - halfH - margin;
 
-    Vec2 pos = player_->getPosition();
-    pos.x = clampf(pos.x, minX, maxX);
-    pos.y = clampf(pos.y, minY, maxY);
-    player_->setPosition(pos);
+    // 只在越界时修正模拟位置，不打断插值
+    Vec2 pos = player_->getSimulationPosition();
+    Vec2 clamped(clampf(pos.x, minX, maxX), clampf(pos.y, minY, maxY));
+    if (clamped != pos)
+        player_->setPosition(clamped);
 }
 
 void HouseScene::initControls()
@@ -435,6 +443,7 @@ void HouseScene::onKeyPressed(EventKeyboard::KeyCode keyCode, Event* event)
         if (tm) {
              // Stop updating THIS scene so we don't trigger wakeUp() here
              this->unscheduleUpdate();
+             this->unscheduleFixedUpdate();
              
              tm->skipToNextMorning();
              // Reload scene (as passed out/sleeping)
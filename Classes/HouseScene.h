@@ -15,6 +15,7 @@ public:
     virtual bool init() override;
     virtual bool init(bool isPassedOut);
     virtual void update(float delta) override;
+    virtual void fixedUpdate(float step) override;
 
     CREATE_FUNC(HouseScene);
 
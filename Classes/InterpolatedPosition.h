@@ -0,0 +1,38 @@
+#ifndef __INTERPOLATED_POSITION_H__
+#define __INTERPOLATED_POSITION_H__
+
+#include "cocos2d.h"
+
+/**
+ * @brief 固定步长模拟下的插值位置
+ *
+ * 模拟位置只在 fixedUpdate 中推进，渲染帧按 Scheduler::getFixedStepAlpha()
+ * 在上一步和当前步之间插值，帧率和模拟频率不一致时移动仍然平滑。
+ */
+struct InterpolatedPosition
+{
+    cocos2d::Vec2 previous;        // 上一个模拟步的位置
+    cocos2d::Vec2 current;         // 当前模拟步的位置
+
+    /**
+     * @brief 直接跳到指定位置（传送、初始化、击退），不做插值
+     */
+    void snap(const cocos2d::Vec2& position)
+    {
+        previous = position;
+        current = position;
+    }
+
+    /**
+     * @brief 每个模拟步开始时调用，保存上一步的位置
+     */
+    void beginStep() { previous = current; }
+
+    /**
+     * @brief 获取渲染位置
+     * @param alpha 当前帧在两个模拟步之间的比例 [0, 1]
+     */
+    cocos2d::Vec2 lerp(float alpha) const { return previous.lerp(current, alpha); }
+};
+
+#endif // __INTERPOLATED_POSITION_H__
@@ -122,7 +122,7 @@ bool InventoryManager::addItem(ItemType itemType, int count)
 
                 if (count <= 0)
                 {
-                    CCLOG("Added %s (stacked)", getItemName(itemType).c_str());
+                    CCLOG("Added %s (stacked)", getItemName(itemType));
                     return true;
                 }
             }
@@ -135,7 +135,7 @@ bool InventoryManager::addItem(ItemType itemType, int count)
         int emptySlot = findEmptySlot();
         if (emptySlot == -1)
         {
-            CCLOG("Inventory full! Cannot add %s", getItemName(itemType).c_str());
+            CCLOG("Inventory full! Cannot add %s", getItemName(itemType));
             return false;
         }
 
@@ -145,7 +145,7 @@ bool InventoryManager::addItem(ItemType itemType, int count)
         slots_[emptySlot].count = addCount;
         count -= addCount;
 
-        CCLOG("Added %d x %s to slot %d", addCount, getItemName(itemType).c_str(), emptySlot);
+        CCLOG("Added %d x %s to slot %d", addCount, getItemName(itemType), emptySlot);
     }
 
     return true;
@@ -159,7 +159,7 @@ bool InventoryManager::removeItem(ItemType itemType, int count /*= 1*/)
     // 先检查是否有足够的物品
     if (!hasItem(itemType, count))
     {
-        CCLOG("Not enough %s to remove", getItemName(itemType).c_str());
+        CCLOG("Not enough %s to remove", getItemName(itemType));
         return false;
     }
 
@@ -183,7 +183,7 @@ bool InventoryManager::removeItem(ItemType itemType, int count /*= 1*/)
         }
     }
 
-    CCLOG("Removed %d x %s", count, getItemName(itemType).c_str());
+    CCLOG("Removed %d x %s", count, getItemName(itemType));
     return true;
 }
 
@@ -301,18 +301,18 @@ bool InventoryManager::decreaseDurability(int slotIndex, int amount)
         if (defMax > 0) {
             slot.maxDurability = defMax;
             slot.durability = defMax;
-            CCLOG("Restored legacy tool durability for %s", getItemName(slot.type).c_str());
+            CCLOG("Restored legacy tool durability for %s", getItemName(slot.type));
         } else {
             return false; // Not a tool
         }
     }
 
     slot.durability -= amount;
-    CCLOG("Tool %s durability: %d/%d", getItemName(slot.type).c_str(), slot.durability, slot.maxDurability);
+    CCLOG("Tool %s durability: %d/%d", getItemName(slot.type), slot.durability, slot.maxDurability);
 
     if (slot.durability <= 0)
     {
-        CCLOG("Tool %s broke!", getItemName(slot.type).c_str());
+        CCLOG("Tool %s broke!", getItemName(slot.type));
         slot.clear();
         return true; // Broke
     }
@@ -333,35 +333,6 @@ bool InventoryManager::repairSlot(int slotIndex)
     return true;
 }
 
-int InventoryManager::getDefaultMaxDurability(ItemType type)
-{
-    switch (type)
-    {
-    case ItemType::Hoe:
-    case ItemType::WateringCan:
-    case ItemType::Scythe:
-    case ItemType::Axe:
-    case ItemType::Pickaxe:
-    case ItemType::FishingRod:
-        return 50; // 初始工具 50 次耐久
-    case ItemType::ITEM_WoodenSword:
-        return 100;
-    case ItemType::ITEM_IronSword:
-        return 200;
-    case ItemType::ITEM_GoldSword:
-        return 300;
-    case ItemType::ITEM_DiamondSword:
-        return 1000;
-    default:
-        return -1;
-    }
-}
-
-bool InventoryManager::isTool(ItemType type)
-{
-    return getDefaultMaxDurability(type) != -1;
-}
-
 int InventoryManager::findEmptySlot() const
 {
     for (int i = 0; i < (int)slots_.size(); ++i)
@@ -382,174 +353,6 @@ int InventoryManager::findItemSlot(ItemType itemType) const
     return -1;
 }
 
-// ========== 静态物品信息函数 ==========
-
-std::string InventoryManager::getItemName(ItemType itemType)
-{
-    switch (itemType)
-    {
-    case ItemType::ITEM_NONE: return "Empty";
-    case ItemType::Hoe: return "Hoe";
-    case ItemType::WateringCan: return "Watering Can";
-    case ItemType::Scythe: return "Scythe";
-    case ItemType::Axe: return "Axe";
-    case ItemType::Pickaxe: return "Pickaxe";
-    case ItemType::FishingRod: return "Fishing Rod";
-    case ItemType::SeedTurnip: return "Turnip Seed";
-    case ItemType::SeedPotato: return "Potato Seed";
-    case ItemType::SeedCorn: return "Corn Seed";
-    case ItemType::SeedTomato: return "Tomato Seed";
-    case ItemType::SeedPumpkin: return "Pumpkin Seed";
-    case ItemType::SeedBlueberry: return "Blueberry Seed";
-    case ItemType::Wood: return "Wood";
-    case ItemType::Turnip: return "Turnip";
-    case ItemType::Potato: return "Potato";
-    case ItemType::Corn: return "Corn";
-    case ItemType::Tomato: return "Tomato";
-    case ItemType::Pumpkin: return "Pumpkin";
-    case ItemType::Blueberry: return "Blueberry";
-    case ItemType::Fish: return "Fish";
-    // 矿石
-    case ItemType::CopperOre: return "Copper Ore";
-    case ItemType::IronOre: return "Iron Ore";
-    case ItemType::SilverOre: return "Silver Ore";
-    case ItemType::GoldOre: return "Gold Ore";
-    case ItemType::DiamondOre: return "Diamond Ore";
-    // 武器
-    case ItemType::ITEM_WoodenSword: return "Wooden Sword";
-    case ItemType::ITEM_IronSword: return "Iron Sword";
-    case ItemType::ITEM_GoldSword: return "Gold Sword";
-    case ItemType::ITEM_DiamondSword: return "Diamond Sword";
-    // 鱼类
-            case ItemType::ITEM_Anchovy: return "Anchovy";
-            case ItemType::ITEM_Carp: return "Carp";
-            case ItemType::ITEM_Eel: return "Eel";
-            case ItemType::ITEM_Flounder: return "Flounder";
-            case ItemType::ITEM_Largemouth_Bass: return "Largemouth Bass";
-            case ItemType::ITEM_Pufferfish: return "Pufferfish";
-            case ItemType::ITEM_Rainbow_Trout: return "Rainbow Trout";
-            case ItemType::ITEM_Sturgeon: return "Sturgeon";
-            case ItemType::ITEM_Tilapia: return "Tilapia";
-    default: return "Unknown";
-    }
-}
-
-std::string InventoryManager::getItemDescription(ItemType itemType)
-{
-    switch (itemType)
-    {
-    case ItemType::Hoe: return "Tills soil for planting";
-    case ItemType::WateringCan: return "Waters crops";
-    case ItemType::Scythe: return "Harvests mature crops";
-    case ItemType::Axe: return "Chops down trees";
-    case ItemType::Pickaxe: return "Mines rocks";
-    case ItemType::FishingRod: return "Catches fish";
-    case ItemType::SeedTurnip: return "Grows into turnip";
-    case ItemType::SeedPotato: return "Grows into potato";
-    case ItemType::SeedCorn: return "Grows into corn";
-    case ItemType::SeedTomato: return "Grows into tomato";
-    case ItemType::SeedPumpkin: return "Grows into pumpkin";
-    case ItemType::SeedBlueberry: return "Grows into blueberry";
-    case ItemType::Wood: return "Crafting material";
-    case ItemType::Turnip: return "Fresh turnip";
-    case ItemType::Potato: return "Fresh potato";
-    case ItemType::Corn: return "Fresh corn";
-    case ItemType::Tomato: return "Fresh tomato";
-    case ItemType::Pumpkin: return "Fresh pumpkin";
-    case ItemType::Blueberry: return "Fresh blueberry";
-    case ItemType::Fish: return "Fresh fish";
-    // 矿石
-    case ItemType::CopperOre: return "Common ore, worth 50 gold";
-    case ItemType::IronOre: return "Sturdy ore, worth 100 gold";
-    case ItemType::SilverOre: return "Valuable ore, worth 150 gold";
-    case ItemType::GoldOre: return "Precious ore, worth 500 gold";
-    case ItemType::DiamondOre: return "Rare gem, worth 1000 gold";
-    // 武器
-    case ItemType::ITEM_WoodenSword: return "Basic sword, 10 attack";
-    case ItemType::ITEM_IronSword: return "Sturdy sword, 25 attack";
-    case ItemType::ITEM_GoldSword: return "Elegant sword, 40 attack";
-    case ItemType::ITEM_DiamondSword: return "Legendary sword, 60 attack";
-    // 鱼类
-            case ItemType::ITEM_Anchovy: return "A small saltwater fish.";
-            case ItemType::ITEM_Carp: return "A common pond fish.";
-            case ItemType::ITEM_Eel: return "A long, slippery fish.";
-            case ItemType::ITEM_Flounder: return "A flat sea fish.";
-            case ItemType::ITEM_Largemouth_Bass: return "A popular freshwater game fish.";
-            case ItemType::ITEM_Pufferfish: return "Can inflate itself when threatened.";
-            case ItemType::ITEM_Rainbow_Trout: return "A colorful freshwater fish.";
-            case ItemType::ITEM_Sturgeon: return "An ancient, valuable fish.";
-            case ItemType::ITEM_Tilapia: return "A common tropical fish.";
-    default: return "";
-    }
-}
-
-std::string InventoryManager::getItemIconPath(ItemType itemType)
-{
-    switch (itemType)
-    {
-    case ItemType::Hoe: return "tools/hoe.png";
-    case ItemType::WateringCan: return "tools/kettle.png";
-    case ItemType::Scythe: return "tools/scythe.png";
-    case ItemType::Axe: return "tools/axe.png";
-    case ItemType::Pickaxe: return "tools/pickaxe.png";
-    case ItemType::Fish: return "tools/fish.png";
-    // 鱼类
-        case ItemType::ITEM_Anchovy: return "fish/Anchovy.png";
-        case ItemType::ITEM_Carp: return "fish/Carp.png";
-        case ItemType::ITEM_Eel: return "fish/Eel.png";
-        case ItemType::ITEM_Flounder: return "fish/Flounder.png";
-        case ItemType::ITEM_Largemouth_Bass: return "fish/Largemouth_Bass.png";
-        case ItemType::ITEM_Pufferfish: return "fish/Pufferfish.png";
-        case ItemType::ITEM_Rainbow_Trout: return "fish/Rainbow_Trout.png";
-        case ItemType::ITEM_Sturgeon: return "fish/Sturgeon.png";
-        case ItemType::ITEM_Tilapia: return "fish/Tilapia.png";
-    case ItemType::CopperOre: return "";
-    case ItemType::IronOre: return "";
-    case ItemType::SilverOre: return "";
-    case ItemType::GoldOre: return "";
-    case ItemType::DiamondOre: return "";
-    case ItemType::FishingRod: return "tools/fishingRod.png";
-    case ItemType::SeedTurnip: return "tools/carrotSeed.png";
-    case ItemType::SeedPotato: return "tools/dogbaneSeed.png";
-    case ItemType::SeedCorn: return "tools/cornSeed.png";
-    case ItemType::SeedTomato: return "tools/carrotSeed.png";
-    case ItemType::SeedPumpkin: return "tools/dogbaneSeed.png";
-    case ItemType::SeedBlueberry: return "tools/cornSeed.png";
-    default: return "";
-    }
-}
-
-bool InventoryManager::isStackable(ItemType itemType)
-{
-    // 工具不可堆叠
-    if (itemType == ItemType::Hoe || itemType == ItemType::WateringCan ||
-        itemType == ItemType::Scythe || itemType == ItemType::Axe ||
-        itemType == ItemType::Pickaxe || itemType == ItemType::FishingRod)
-    {
-        return false;
-    }
-
-    // 武器不可堆叠
-    if (itemType == ItemType::ITEM_WoodenSword || itemType == ItemType::ITEM_IronSword ||
-        itemType == ItemType::ITEM_GoldSword || itemType == ItemType::ITEM_DiamondSword)
-    {
-        return false;
-    }
-
-    // 其他物品可堆叠
-    return true;
-}
-
-int InventoryManager::getMaxStack(ItemType itemType)
-{
-    // 工具只能1个
-    if (!isStackable(itemType))
-        return 1;
-
-    // 其他物品最多 64 个
-    return 64;
-}
-
 int InventoryManager::getSelectedSlotIndex() const
 {
     return selectedSlotIndex_;
@@ -2,59 +2,11 @@
 #define __INVENTORY_MANAGER_H__
 
 #include "cocos2d.h"
+#include "ItemRegistry.h"
 #include <array>
 #include <vector>
 #include <string>
 
-/**
- * @brief 物品类型枚举（与 GameScene 中保持一致）
- */
-enum class ItemType
-{
-    ITEM_NONE = -1,
-    Hoe = 0,
-    WateringCan,
-    Scythe,
-    Axe,
-    Pickaxe,
-    FishingRod,
-    SeedTurnip,
-    SeedPotato,
-    SeedCorn,
-    SeedTomato,
-    SeedPumpkin,
-    SeedBlueberry,
-    Wood,
-    Turnip,
-    Potato,
-    Corn,
-    Tomato,
-    Pumpkin,
-    Blueberry,
-    Fish,
-    // 矿石类型
-    CopperOre,      // 铜矿石
-    IronOre,        // 铁矿石
-    SilverOre,      // 银矿石
-    GoldOre,        // 金矿石
-    DiamondOre,     // 钻石矿石
-    // 武器类型
-    ITEM_WoodenSword,    // 木剑
-    ITEM_IronSword,      // 铁剑
-    ITEM_GoldSword,      // 金剑
-    ITEM_DiamondSword,   // 钻石剑
-    // 鱼类 [New]
-    ITEM_Anchovy,        // 鳀鱼
-    ITEM_Carp,           // 鲤鱼
-    ITEM_Eel,            // 鳗鱼
-    ITEM_Flounder,       // 比目鱼
-    ITEM_Largemouth_Bass,// 大口黑鲈
-    ITEM_Pufferfish,     // 河豚
-    ITEM_Rainbow_Trout,  // 虹鳟鱼
-    ITEM_Sturgeon,       // 鲟鱼
-    ITEM_Tilapia         // 罗非鱼
-};
-
 /**
  * @brief 背包管理器类
  *
@@ -199,33 +151,35 @@ public:
      * @param itemType 物品类型
      * @return 物品名称
      */
-    static std::string getItemName(ItemType itemType);
+    static const char* getItemName(ItemType itemType) { return ItemRegistry::get(itemType).name; }
 
     /**
      * @brief 获取物品描述
      * @param itemType 物品类型
      * @return 物品描述
      */
-    static std::string getItemDescription(ItemType itemType);
+    static const char* getItemDescription(ItemType itemType) { return ItemRegistry::get(itemType).description; }
 
     /**
-     * @brief Get item icon resource path (empty if unavailable).
+     * @brief 获取物品图标路径
+     * @param itemType 物品类型
+     * @return 图标路径，没有图标时为空字符串
      */
-    static std::string getItemIconPath(ItemType itemType);
+    static const char* getItemIconPath(ItemType itemType) { return ItemRegistry::get(itemType).iconPath; }
 
     /**
      * @brief 获取物品是否可堆叠
      * @param itemType 物品类型
      * @return 是否可堆叠
      */
-    static bool isStackable(ItemType itemType);
+    static bool isStackable(ItemType itemType) { return ItemRegistry::get(itemType).maxStack > 1; }
 
     /**
      * @brief 获取物品最大堆叠数
      * @param itemType 物品类型
      * @return 最大堆叠数
      */
-    static int getMaxStack(ItemType itemType);
+    static int getMaxStack(ItemType itemType) { return ItemRegistry::get(itemType).maxStack; }
 
     /**
      * @brief 清空背包
@@ -250,12 +204,12 @@ public:
     /**
      * @brief 获取指定类型的默认最大耐久度
      */
-    static int getDefaultMaxDurability(ItemType type);
+    static int getDefaultMaxDurability(ItemType type) { return ItemRegistry::get(type).maxDurability; }
 
     /**
      * @brief 检查物品是否是工具
      */
-    static bool isTool(ItemType type);
+    static bool isTool(ItemType type) { return ItemRegistry::get(type).maxDurability != -1; }
 
 
 
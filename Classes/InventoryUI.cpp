@@ -1,4 +1,5 @@
 #include "InventoryUI.h"
+#include "GameFont.h"
 #include "InventoryManager.h"
 #include "QuantityPopup.h"
 #include "MarketState.h"
@@ -113,20 +114,20 @@ void InventoryUI::initPanel()
     panel_->addChild(border, 0);
 
     // 标题
-    titleLabel_ = Label::createWithSystemFont("Inventory", "Arial", 32);
+    titleLabel_ = GameFont::createLabel("Inventory", 32);
     titleLabel_->setPosition(Vec2(panelWidth / 2, panelHeight - 40));
     titleLabel_->setColor(Color3B(255, 235, 200));
     panel_->addChild(titleLabel_, 1);
 
     // 金币显示
-    moneyLabel_ = Label::createWithSystemFont("Gold: 500", "Arial", 24);
+    moneyLabel_ = GameFont::createLabel("Gold: 500", 24);
     moneyLabel_->setAnchorPoint(Vec2(1, 0.5f));
     moneyLabel_->setPosition(Vec2(panelWidth - 20, panelHeight - 40));
     moneyLabel_->setColor(Color3B(255, 215, 0));
     panel_->addChild(moneyLabel_, 1);
 
     // 物品信息显示（底部）
-    infoLabel_ = Label::createWithSystemFont("", "Arial", 18);
+    infoLabel_ = GameFont::createLabel("", 18);
     infoLabel_->setPosition(Vec2(panelWidth / 2, 30));
     infoLabel_->setColor(Color3B(200, 200, 200));
     panel_->addChild(infoLabel_, 1);
@@ -163,7 +164,7 @@ void InventoryUI::initSlots()
             slot.icon = nullptr;
 
             // 创建数量标签
-            slot.countLabel = Label::createWithSystemFont("", "Arial", 16);
+            slot.countLabel = GameFont::createLabel("", 16);
             slot.countLabel->setAnchorPoint(Vec2(1, 0));
             slot.countLabel->setPosition(Vec2(SLOT_SIZE - 5, 5));
             slot.countLabel->setColor(Color3B::WHITE);
@@ -205,7 +206,7 @@ void InventoryUI::initControls()
     auto visibleSize = Director::getInstance()->getVisibleSize();
 
     // 关闭按钮提示
-    auto hint = Label::createWithSystemFont("Press ESC or B to close", "Arial", 18);
+    auto hint = GameFont::createLabel("Press ESC or B to close", 18);
     hint->setPosition(Vec2(visibleSize.width / 2, 30));
     hint->setColor(Color3B(150, 150, 150));
     this->addChild(hint, 2);
@@ -349,7 +350,7 @@ cocos2d::Sprite* InventoryUI::createItemIcon(const InventoryManager::ItemSlot& s
             }
         }
 
-        auto label = Label::createWithSystemFont(abbreviation, "Arial", 14);
+        auto label = GameFont::createLabel(abbreviation, 14);
         label->setPosition(Vec2(iconSize / 2, iconSize / 2));
         label->setColor(Color3B::WHITE);
         icon->addChild(label, 1);
@@ -434,9 +435,9 @@ void InventoryUI::onSlotClicked(int slotIndex)
         {
             std::string info = StringUtils::format(
                 "%s x%d - %s",
-                InventoryManager::getItemName(newSlot.type).c_str(),
+                InventoryManager::getItemName(newSlot.type),
                 newSlot.count,
-                InventoryManager::getItemDescription(newSlot.type).c_str()
+                InventoryManager::getItemDescription(newSlot.type)
             );
             infoLabel_->setString(info);
         }
@@ -467,9 +468,9 @@ void InventoryUI::onSlotClicked(int slotIndex)
             {
                 std::string info = StringUtils::format(
                     "%s x%d - %s",
-                    InventoryManager::getItemName(slot.type).c_str(),
+                    InventoryManager::getItemName(slot.type),
                     slot.count,
-                    InventoryManager::getItemDescription(slot.type).c_str()
+                    InventoryManager::getItemDescription(slot.type)
                 );
                 infoLabel_->setString(info);
             }
@@ -574,69 +575,8 @@ void InventoryUI::close()
 
 cocos2d::Color3B InventoryUI::getItemColor(ItemType itemType) const
 {
-    switch (itemType)
-    {
-    // 工具 - 棕色系
-    case ItemType::Hoe:
-    case ItemType::WateringCan:
-    case ItemType::Scythe:
-    case ItemType::Axe:
-    case ItemType::Pickaxe:
-        return Color3B(139, 90, 43);
-
-    // 钓鱼竿 - 蓝色
-    case ItemType::FishingRod:
-        return Color3B(70, 130, 180);
-
-    // 种子 - 绿色系
-    case ItemType::SeedTurnip:
-    case ItemType::SeedPotato:
-    case ItemType::SeedCorn:
-    case ItemType::SeedTomato:
-    case ItemType::SeedPumpkin:
-    case ItemType::SeedBlueberry:
-        return Color3B(34, 139, 34);
-
-    // 农作物 - 橙色/红色系
-    case ItemType::Turnip:
-    case ItemType::Potato:
-        return Color3B(210, 180, 140);
-    case ItemType::Corn:
-        return Color3B(255, 215, 0);
-    case ItemType::Tomato:
-        return Color3B(220, 20, 60);
-    case ItemType::Pumpkin:
-        return Color3B(255, 117, 24);
-    case ItemType::Blueberry:
-        return Color3B(65, 105, 225);
-
-    // 木材 - 深棕色
-    case ItemType::Wood:
-        return Color3B(101, 67, 33);
-
-    // 鱼 - 银色
-    case ItemType::Fish:
-    case ItemType::ITEM_Anchovy:
-    case ItemType::ITEM_Carp:
-    case ItemType::ITEM_Eel:
-    case ItemType::ITEM_Flounder:
-    case ItemType::ITEM_Largemouth_Bass:
-    case ItemType::ITEM_Pufferfish:
-    case ItemType::ITEM_Rainbow_Trout:
-    case ItemType::ITEM_Sturgeon:
-    case ItemType::ITEM_Tilapia:
-        return Color3B(192, 192, 192);
-
-    // 矿石
-    case ItemType::CopperOre: return Color3B(210, 105, 30);  // Chocolate orange
-    case ItemType::IronOre: return Color3B(112, 128, 144);    // Slate grey
-    case ItemType::SilverOre: return Color3B(224, 224, 224);  // Bright silver
-    case ItemType::GoldOre: return Color3B(255, 215, 0);     // Gold
-    case ItemType::DiamondOre: return Color3B(0, 255, 255);  // Cyan/Aqua
-
-    default:
-        return Color3B(128, 128, 128);
-    }
+    unsigned int color = ItemRegistry::get(itemType).color;
+    return Color3B((color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
 }
 
 void InventoryUI::handleTransfer()
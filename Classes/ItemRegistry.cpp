@@ -0,0 +1,7 @@
+#include "ItemRegistry.h"
+
+// C++11 要求被 ODR 使用的 constexpr 静态成员在类外定义
+constexpr WeaponTraits ItemRegistry::kNoWeapon;
+constexpr FishTraits ItemRegistry::kNoFish;
+constexpr ItemTraits ItemRegistry::kUnknown;
+constexpr ItemTraits ItemRegistry::kTraits[];
@@ -0,0 +1,229 @@
+#ifndef __ITEM_REGISTRY_H__
+#define __ITEM_REGISTRY_H__
+
+/**
+ * @brief 物品类型枚举（与 GameScene 中保持一致）
+ */
+enum class ItemType
+{
+    ITEM_NONE = -1,
+    Hoe = 0,
+    WateringCan,
+    Scythe,
+    Axe,
+    Pickaxe,
+    FishingRod,
+    SeedTurnip,
+    SeedPotato,
+    SeedCorn,
+    SeedTomato,
+    SeedPumpkin,
+    SeedBlueberry,
+    Wood,
+    Turnip,
+    Potato,
+    Corn,
+    Tomato,
+    Pumpkin,
+    Blueberry,
+    Fish,
+    // 矿石类型
+    CopperOre,      // 铜矿石
+    IronOre,        // 铁矿石
+    SilverOre,      // 银矿石
+    GoldOre,        // 金矿石
+    DiamondOre,     // 钻石矿石
+    // 武器类型
+    ITEM_WoodenSword,    // 木剑
+    ITEM_IronSword,      // 铁剑
+    ITEM_GoldSword,      // 金剑
+    ITEM_DiamondSword,   // 钻石剑
+    // 鱼类 [New]
+    ITEM_Anchovy,        // 鳀鱼
+    ITEM_Carp,           // 鲤鱼
+    ITEM_Eel,            // 鳗鱼
+    ITEM_Flounder,       // 比目鱼
+    ITEM_Largemouth_Bass,// 大口黑鲈
+    ITEM_Pufferfish,     // 河豚
+    ITEM_Rainbow_Trout,  // 虹鳟鱼
+    ITEM_Sturgeon,       // 鲟鱼
+    ITEM_Tilapia         // 罗非鱼
+};
+
+/**
+ * @brief 物品分类
+ */
+enum class ItemCategory
+{
+    None,
+    Tool,       // 工具
+    Seed,       // 种子（商店出售）
+    Material,   // 材料
+    Crop,       // 农作物（商店收购）
+    Fish,       // 鱼（商店收购）
+    Ore,        // 矿石（商店以固定价格收购）
+    Weapon      // 武器
+};
+
+/**
+ * @brief 武器属性（非武器为默认值）
+ */
+struct WeaponTraits
+{
+    int attackPower;
+    float attackRange;
+    float attackSpeed;
+    const char* spritePath;
+};
+
+/**
+ * @brief 鱼类属性（非鱼类为默认值）
+ */
+struct FishTraits
+{
+    float difficulty;           // 0.1 (easy) to 1.0 (hard)
+    float movementFrequency;    // How fast it changes target
+    bool saltwater;
+};
+
+/**
+ * @brief 单个物品的全部静态数据
+ */
+struct ItemTraits
+{
+    ItemType type;
+    const char* name;
+    const char* description;
+    const char* iconPath;       // 空字符串表示没有图标
+    ItemCategory category;
+    int maxStack;               // 1 表示不可堆叠
+    int maxDurability;          // -1 表示没有耐久度
+    int basePrice;              // 种子为商店售价，作物/鱼/矿石为收购价，武器为估价
+    unsigned int color;         // 0xRRGGBB，缺少图标时的占位色
+    WeaponTraits weapon;
+    FishTraits fish;
+};
+
+/**
+ * @brief 编译期物品数据表
+ *
+ * 职责：
+ * - 按 ItemType 下标保存所有物品的名称、图标、堆叠、耐久、分类和价格
+ * - 统一原本分散在 InventoryManager、Weapon、Fish、MarketState 中的物品数据
+ *
+ * 查询是 O(1) 的数组访问，不分配内存，也可以在编译期使用。
+ * 新增 ItemType 时必须在 kTraits 的对应位置添加一行，顺序由 static_assert 检查。
+ */
+class ItemRegistry
+{
+public:
+    /**
+     * @brief 获取物品数据
+     * @param type 物品类型，不在数据表中时返回名为 "Unknown" 的空物品
+     */
+    static constexpr const ItemTraits& get(ItemType type)
+    {
+        return isValid(static_cast<int>(type))
+            ? kTraits[static_cast<int>(type) - static_cast<int>(ItemType::ITEM_NONE)]
+            : kUnknown;
+    }
+
+    /**
+     * @brief 检查整数是否是数据表中的物品类型（存档等外部数据可能越界）
+     */
+    static constexpr bool isValid(int type)
+    {
+        return type >= static_cast<int>(ItemType::ITEM_NONE)
+            && type < static_cast<int>(ItemType::ITEM_NONE) + getCount();
+    }
+
+    /**
+     * @brief 数据表条目数（包含 ITEM_NONE）
+     */
+    static constexpr int getCount()
+    {
+        return static_cast<int>(sizeof(kTraits) / sizeof(kTraits[0]));
+    }
+
+    /**
+     * @brief 检查从 index 开始的条目是否按 ItemType 顺序排列
+     */
+    static constexpr bool isInOrder(int index)
+    {
+        return index >= getCount()
+            || (static_cast<int>(kTraits[index].type) == index + static_cast<int>(ItemType::ITEM_NONE) && isInOrder(index + 1));
+    }
+
+private:
+    static constexpr WeaponTraits kNoWeapon = { 0, 0.0f, 1.0f, "" };
+    static constexpr FishTraits kNoFish = { 0.0f, 0.0f, false };
+    static constexpr ItemTraits kUnknown = { ItemType::ITEM_NONE, "Unknown", "", "", ItemCategory::None, 64, -1, 0, 0x808080, kNoWeapon, kNoFish };
+
+    static constexpr ItemTraits kTraits[] = {
+        { ItemType::ITEM_NONE, "Empty", "", "", ItemCategory::None, 64, -1, 0, 0x808080, kNoWeapon, kNoFish },
+        // 工具
+        { ItemType::Hoe, "Hoe", "Tills soil for planting", "tools/hoe.png", ItemCategory::Tool, 1, 50, 0, 0x8B5A2B, kNoWeapon, kNoFish },
+        { ItemType::WateringCan, "Watering Can", "Waters crops", "tools/kettle.png", ItemCategory::Tool, 1, 50, 0, 0x8B5A2B, kNoWeapon, kNoFish },
+        { ItemType::Scythe, "Scythe", "Harvests mature crops", "tools/scythe.png", ItemCategory::Tool, 1, 50, 0, 0x8B5A2B, kNoWeapon, kNoFish },
+        { ItemType::Axe, "Axe", "Chops down trees", "tools/axe.png", ItemCategory::Tool, 1, 50, 0, 0x8B5A2B, kNoWeapon, kNoFish },
+        { ItemType::Pickaxe, "Pickaxe", "Mines rocks", "tools/pickaxe.png", ItemCategory::Tool, 1, 50, 0, 0x8B5A2B, kNoWeapon, kNoFish },
+        { ItemType::FishingRod, "Fishing Rod", "Catches fish", "tools/fishingRod.png", ItemCategory::Tool, 1, 50, 0, 0x4682B4, kNoWeapon, kNoFish },
+        // 种子
+        { ItemType::SeedTurnip, "Turnip Seed", "Grows into turnip", "tools/carrotSeed.png", ItemCategory::Seed, 64, -1, 20, 0x228B22, kNoWeapon, kNoFish },
+        { ItemType::SeedPotato, "Potato Seed", "Grows into potato", "tools/dogbaneSeed.png", ItemCategory::Seed, 64, -1, 30, 0x228B22, kNoWeapon, kNoFish },
+        { ItemType::SeedCorn, "Corn Seed", "Grows into corn", "tools/cornSeed.png", ItemCategory::Seed, 64, -1, 40, 0x228B22, kNoWeapon, kNoFish },
+        { ItemType::SeedTomato, "Tomato Seed", "Grows into tomato", "tools/carrotSeed.png", ItemCategory::Seed, 64, -1, 35, 0x228B22, kNoWeapon, kNoFish },
+        { ItemType::SeedPumpkin, "Pumpkin Seed", "Grows into pumpkin", "tools/dogbaneSeed.png", ItemCategory::Seed, 64, -1, 60, 0x228B22, kNoWeapon, kNoFish },
+        { ItemType::SeedBlueberry, "Blueberry Seed", "Grows into blueberry", "tools/cornSeed.png", ItemCategory::Seed, 64, -1, 45, 0x228B22, kNoWeapon, kNoFish },
+        // 材料
+        { ItemType::Wood, "Wood", "Crafting material", "", ItemCategory::Material, 64, -1, 0, 0x654321, kNoWeapon, kNoFish },
+        // 农作物
+        { ItemType::Turnip, "Turnip", "Fresh turnip", "", ItemCategory::Crop, 64, -1, 60, 0xD2B48C, kNoWeapon, kNoFish },
+        { ItemType::Potato, "Potato", "Fresh potato", "", ItemCategory::Crop, 64, -1, 80, 0xD2B48C, kNoWeapon, kNoFish },
+        { ItemType::Corn, "Corn", "Fresh corn", "", ItemCategory::Crop, 64, -1, 120, 0xFFD700, kNoWeapon, kNoFish },
+        { ItemType::Tomato, "Tomato", "Fresh tomato", "", ItemCategory::Crop, 64, -1, 90, 0xDC143C, kNoWeapon, kNoFish },
+        { ItemType::Pumpkin, "Pumpkin", "Fresh pumpkin", "", ItemCategory::Crop, 64, -1, 180, 0xFF7518, kNoWeapon, kNoFish },
+        { ItemType::Blueberry, "Blueberry", "Fresh blueberry", "", ItemCategory::Crop, 64, -1, 110, 0x4169E1, kNoWeapon, kNoFish },
+        { ItemType::Fish, "Fish", "Fresh fish", "tools/fish.png", ItemCategory::Fish, 64, -1, 50, 0xC0C0C0, kNoWeapon, kNoFish },
+        // 矿石
+        { ItemType::CopperOre, "Copper Ore", "Common ore, worth 50 gold", "", ItemCategory::Ore, 64, -1, 20, 0xD2691E, kNoWeapon, kNoFish },
+        { ItemType::IronOre, "Iron Ore", "Sturdy ore, worth 100 gold", "", ItemCategory::Ore, 64, -1, 50, 0x708090, kNoWeapon, kNoFish },
+        { ItemType::SilverOre, "Silver Ore", "Valuable ore, worth 150 gold", "", ItemCategory::Ore, 64, -1, 100, 0xE0E0E0, kNoWeapon, kNoFish },
+        { ItemType::GoldOre, "Gold Ore", "Precious ore, worth 500 gold", "", ItemCategory::Ore, 64, -1, 250, 0xFFD700, kNoWeapon, kNoFish },
+        { ItemType::DiamondOre, "Diamond Ore", "Rare gem, worth 1000 gold", "", ItemCategory::Ore, 64, -1, 500, 0x00FFFF, kNoWeapon, kNoFish },
+        // 武器
+        { ItemType::ITEM_WoodenSword, "Wooden Sword", "Basic sword, 10 attack", "", ItemCategory::Weapon, 1, 100, 50, 0x808080,
+          { 10, 50.0f, 1.0f, "weapons/wooden_sword.png" }, kNoFish },
+        { ItemType::ITEM_IronSword, "Iron Sword", "Sturdy sword, 25 attack", "", ItemCategory::Weapon, 1, 200, 150, 0x808080,
+          { 25, 55.0f, 0.9f, "weapons/iron_sword.png" }, kNoFish },
+        { ItemType::ITEM_GoldSword, "Gold Sword", "Elegant sword, 40 attack", "", ItemCategory::Weapon, 1, 300, 400, 0x808080,
+          { 40, 60.0f, 0.8f, "weapons/gold_sword.png" }, kNoFish },
+        { ItemType::ITEM_DiamondSword, "Diamond Sword", "Legendary sword, 60 attack", "", ItemCategory::Weapon, 1, 1000, 1000, 0x808080,
+          { 60, 65.0f, 0.7f, "weapons/diamond_sword.png" }, kNoFish },
+        // 鱼类
+        { ItemType::ITEM_Anchovy, "Anchovy", "A small saltwater fish.", "fish/Anchovy.png", ItemCategory::Fish, 64, -1, 30, 0xC0C0C0,
+          kNoWeapon, { 0.2f, 1.5f, true } },
+        { ItemType::ITEM_Carp, "Carp", "A common pond fish.", "fish/Carp.png", ItemCategory::Fish, 64, -1, 30, 0xC0C0C0,
+          kNoWeapon, { 0.1f, 2.0f, false } },
+        { ItemType::ITEM_Eel, "Eel", "A long, slippery fish.", "fish/Eel.png", ItemCategory::Fish, 64, -1, 85, 0xC0C0C0,
+          kNoWeapon, { 0.7f, 0.8f, true } },
+        { ItemType::ITEM_Flounder, "Flounder", "A flat sea fish.", "fish/Flounder.png", ItemCategory::Fish, 64, -1, 50, 0xC0C0C0,
+          kNoWeapon, { 0.4f, 1.2f, true } },
+        { ItemType::ITEM_Largemouth_Bass, "Largemouth Bass", "A popular freshwater game fish.", "fish/Largemouth_Bass.png", ItemCategory::Fish, 64, -1, 100, 0xC0C0C0,
+          kNoWeapon, { 0.5f, 1.0f, false } },
+        { ItemType::ITEM_Pufferfish, "Pufferfish", "Can inflate itself when threatened.", "fish/Pufferfish.png", ItemCategory::Fish, 64, -1, 200, 0xC0C0C0,
+          kNoWeapon, { 0.9f, 0.5f, true } },
+        { ItemType::ITEM_Rainbow_Trout, "Rainbow Trout", "A colorful freshwater fish.", "fish/Rainbow_Trout.png", ItemCategory::Fish, 64, -1, 65, 0xC0C0C0,
+          kNoWeapon, { 0.6f, 0.9f, false } },
+        { ItemType::ITEM_Sturgeon, "Sturgeon", "An ancient, valuable fish.", "fish/Sturgeon.png", ItemCategory::Fish, 64, -1, 200, 0xC0C0C0,
+          kNoWeapon, { 1.0f, 0.4f, true } },
+        { ItemType::ITEM_Tilapia, "Tilapia", "A common tropical fish.", "fish/Tilapia.png", ItemCategory::Fish, 64, -1, 75, 0xC0C0C0,
+          kNoWeapon, { 0.4f, 1.3f, true } }
+    };
+};
+
+static_assert(ItemRegistry::getCount() == static_cast<int>(ItemType::ITEM_Tilapia) - static_cast<int>(ItemType::ITEM_NONE) + 1,
+              "ItemRegistry::kTraits must have one entry per ItemType");
+static_assert(ItemRegistry::isInOrder(0), "ItemRegistry::kTraits must be ordered by ItemType");
+
+#endif // __ITEM_REGISTRY_H__
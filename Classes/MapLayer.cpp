@@ -88,7 +88,17 @@ bool MapLayer::loadTMXMap(const std::string& tmxFile)
         CCLOG("Tree layer loaded.");
     }
 
-    // 5. 打印调试信息
+    // 5. 地图图块基本不变，按 32x32 分块缓存为静态顶点缓冲，只重建被修改的块
+    for (auto child : tmxMap_->getChildren())
+    {
+        auto layer = dynamic_cast<TMXLayer*>(child);
+        if (layer)
+        {
+            layer->setStaticChunkMode(true);
+        }
+    }
+
+    // 6. 打印调试信息
     Size mapSize = tmxMap_->getMapSize();
     Size tileSize = tmxMap_->getTileSize();
     CCLOG("Map loaded: %s", tmxFile.c_str());
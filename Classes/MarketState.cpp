@@ -19,40 +19,22 @@ void MarketState::buildDefaultGoods()
     buyGoods_.clear();
     sellGoods_.clear();
 
-    // Seeds (buy)
-    buyGoods_.push_back({ItemType::SeedTurnip, 20, 20});
-    buyGoods_.push_back({ItemType::SeedPotato, 30, 30});
-    buyGoods_.push_back({ItemType::SeedCorn, 40, 40});
-    buyGoods_.push_back({ItemType::SeedTomato, 35, 35});
-    buyGoods_.push_back({ItemType::SeedPumpkin, 60, 60});
-    buyGoods_.push_back({ItemType::SeedBlueberry, 45, 45});
-
-    // Crops (sell)
-    sellGoods_.push_back({ItemType::Turnip, 60, 60});
-    sellGoods_.push_back({ItemType::Potato, 80, 80});
-    sellGoods_.push_back({ItemType::Corn, 120, 120});
-    sellGoods_.push_back({ItemType::Tomato, 90, 90});
-    sellGoods_.push_back({ItemType::Pumpkin, 180, 180});
-    sellGoods_.push_back({ItemType::Blueberry, 110, 110});
-
-    // Fish
-    sellGoods_.push_back({ItemType::Fish, 50, 50});
-    sellGoods_.push_back({ItemType::ITEM_Anchovy, 30, 30});
-    sellGoods_.push_back({ItemType::ITEM_Carp, 30, 30});
-    sellGoods_.push_back({ItemType::ITEM_Eel, 85, 85});
-    sellGoods_.push_back({ItemType::ITEM_Flounder, 50, 50});
-    sellGoods_.push_back({ItemType::ITEM_Largemouth_Bass, 100, 100});
-    sellGoods_.push_back({ItemType::ITEM_Pufferfish, 200, 200});
-    sellGoods_.push_back({ItemType::ITEM_Rainbow_Trout, 65, 65});
-    sellGoods_.push_back({ItemType::ITEM_Sturgeon, 200, 200});
-    sellGoods_.push_back({ItemType::ITEM_Tilapia, 75, 75});
-
-    // Ores (Fixed Prices)
-    sellGoods_.push_back({ItemType::CopperOre, 20, 20});
-    sellGoods_.push_back({ItemType::IronOre, 50, 50});
-    sellGoods_.push_back({ItemType::SilverOre, 100, 100});
-    sellGoods_.push_back({ItemType::GoldOre, 250, 250});
-    sellGoods_.push_back({ItemType::DiamondOre, 500, 500});
+    // 商品和基础价格来自 ItemRegistry，按分类排列：种子(买)，作物、鱼、矿石(卖)
+    const ItemCategory sellCategories[] = { ItemCategory::Crop, ItemCategory::Fish, ItemCategory::Ore };
+    for (int i = 0; i < ItemRegistry::getCount(); ++i) {
+        const ItemTraits& traits = ItemRegistry::get(static_cast<ItemType>(i + static_cast<int>(ItemType::ITEM_NONE)));
+        if (traits.category == ItemCategory::Seed) {
+            buyGoods_.push_back({traits.type, traits.basePrice, traits.basePrice});
+        }
+    }
+    for (ItemCategory category : sellCategories) {
+        for (int i = 0; i < ItemRegistry::getCount(); ++i) {
+            const ItemTraits& traits = ItemRegistry::get(static_cast<ItemType>(i + static_cast<int>(ItemType::ITEM_NONE)));
+            if (traits.category == category) {
+                sellGoods_.push_back({traits.type, traits.basePrice, traits.basePrice});
+            }
+        }
+    }
 }
 
 void MarketState::updatePrices(int dayCount)
@@ -97,11 +79,7 @@ void MarketState::adjustGoodPrice(MarketGood& good) const
     int price = good.basePrice;
 
     // Fixed price items (Ores) - do not fluctuate
-    if (good.itemType == ItemType::CopperOre ||
-        good.itemType == ItemType::IronOre ||
-        good.itemType == ItemType::SilverOre ||
-        good.itemType == ItemType::GoldOre ||
-        good.itemType == ItemType::DiamondOre)
+    if (ItemRegistry::get(good.itemType).category == ItemCategory::Ore)
     {
         good.currentPrice = price;
         return;
@@ -1,4 +1,5 @@
 #include "MarketUI.h"
+#include "GameFont.h"
 #include "FarmManager.h"
 #include "InventoryManager.h"
 #include "MarketState.h"
@@ -78,41 +79,41 @@ void MarketUI::initPanel()
     border->setLineWidth(3);
     panel_->addChild(border, 0);
 
-    auto title = Label::createWithSystemFont("Market", "Arial", 32);
+    auto title = GameFont::createLabel("Market", 32);
     title->setPosition(Vec2(panelWidth / 2, panelHeight - 35));
     title->setColor(Color3B(255, 235, 200));
     panel_->addChild(title, 1);
 
-    dayLabel_ = Label::createWithSystemFont("Day: 1", "Arial", 18);
+    dayLabel_ = GameFont::createLabel("Day: 1", 18);
     dayLabel_->setAnchorPoint(Vec2(0, 0.5f));
     dayLabel_->setPosition(Vec2(20, panelHeight - 35));
     dayLabel_->setColor(Color3B(200, 200, 200));
     panel_->addChild(dayLabel_, 1);
 
-    seasonLabel_ = Label::createWithSystemFont("Season: Spring", "Arial", 16);
+    seasonLabel_ = GameFont::createLabel("Season: Spring", 16);
     seasonLabel_->setAnchorPoint(Vec2(0, 0.5f));
     seasonLabel_->setPosition(Vec2(20, panelHeight - 60));
     seasonLabel_->setColor(Color3B(200, 200, 200));
     panel_->addChild(seasonLabel_, 1);
 
-    weatherLabel_ = Label::createWithSystemFont("Weather: Sunny", "Arial", 16);
+    weatherLabel_ = GameFont::createLabel("Weather: Sunny", 16);
     weatherLabel_->setAnchorPoint(Vec2(0, 0.5f));
     weatherLabel_->setPosition(Vec2(20, panelHeight - 80));
     weatherLabel_->setColor(Color3B(200, 200, 200));
     panel_->addChild(weatherLabel_, 1);
 
-    moneyLabel_ = Label::createWithSystemFont("Gold: 0", "Arial", 24);
+    moneyLabel_ = GameFont::createLabel("Gold: 0", 24);
     moneyLabel_->setAnchorPoint(Vec2(1, 0.5f));
     moneyLabel_->setPosition(Vec2(panelWidth - 20, panelHeight - 35));
     moneyLabel_->setColor(Color3B(255, 215, 0));
     panel_->addChild(moneyLabel_, 1);
 
-    infoLabel_ = Label::createWithSystemFont("", "Arial", 18);
+    infoLabel_ = GameFont::createLabel("", 18);
     infoLabel_->setPosition(Vec2(panelWidth / 2, 55));
     infoLabel_->setColor(Color3B(200, 200, 200));
     panel_->addChild(infoLabel_, 1);
 
-    statusLabel_ = Label::createWithSystemFont("", "Arial", 18);
+    statusLabel_ = GameFont::createLabel("", 18);
     statusLabel_->setPosition(Vec2(panelWidth / 2, 30));
     statusLabel_->setColor(Color3B(255, 235, 200));
     panel_->addChild(statusLabel_, 1);
@@ -127,7 +128,7 @@ void MarketUI::initLists()
     float listTop = panelHeight - 125.0f;
     float rowHeight = 28.0f;
 
-    buyTitle_ = Label::createWithSystemFont("Items for Sale", "Arial", 20);
+    buyTitle_ = GameFont::createLabel("Items for Sale", 20);
     buyTitle_->setAnchorPoint(Vec2(0.5f, 0.5f));
     buyTitle_->setPosition(Vec2(centerX, panelHeight - 100));
     buyTitle_->setColor(Color3B(220, 220, 220));
@@ -143,7 +144,7 @@ void MarketUI::initLists()
 
     for (size_t i = 0; i < buyGoods.size(); ++i)
     {
-        auto label = Label::createWithSystemFont("", "Arial", 18);
+        auto label = GameFont::createLabel("", 18);
         label->setAnchorPoint(Vec2(0.5f, 0.5f));
         label->setPosition(Vec2(centerX, listTop - rowHeight * i));
         panel_->addChild(label, 1);
@@ -155,9 +156,8 @@ void MarketUI::initLists()
 
 void MarketUI::initControls()
 {
-    auto hint = Label::createWithSystemFont(
+    auto hint = GameFont::createLabel(
         "Up/Down: Select  Left/Right: Switch  Enter: Trade  P/Esc: Close",
-        "Arial",
         16
     );
     hint->setPosition(Vec2(panel_->getContentSize().width / 2, 10));
@@ -1,4 +1,5 @@
 #include "MenuScene.h"
+#include "GameFont.h"
 #include "GameScene.h"
 #include "SaveManager.h"
 #include "SimpleAudioEngine.h"
@@ -301,7 +302,7 @@ void MenuScene::continueGameCallback(Ref* sender)
         ));
         this->addChild(messageBg, 100);
 
-        auto label = Label::createWithSystemFont("No saved game found!", "Arial", 36);
+        auto label = GameFont::createLabel("No saved game found!", 36);
         label->setPosition(visibleSize.width / 2, visibleSize.height / 2);
         label->setColor(Color3B(255, 255, 100));
         label->enableShadow(Color4B(0, 0, 0, 255), Size(2, -2), 0);
@@ -339,7 +340,7 @@ void MenuScene::coopCallback(Ref* sender)
     ));
     this->addChild(messageBg, 100);
 
-    auto label = Label::createWithSystemFont("Co-op Coming Soon!", "Arial", 36);
+    auto label = GameFont::createLabel("Co-op Coming Soon!", 36);
     label->setPosition(visibleSize.width / 2, visibleSize.height / 2);
     label->setColor(Color3B(120, 220, 120));
     label->enableShadow(Color4B(0, 0, 0, 255), Size(2, -2), 0);
@@ -1,4 +1,5 @@
 #include "MineScene.h"
+#include "GameFont.h"
 #include "MineLayer.h"
 #include "Player.h"
 #include "InventoryManager.h"
@@ -14,6 +15,8 @@
 #include "EnergyBar.h"
 #include "HouseScene.h"
 #include "TimeManager.h"
+#include "GameRandom.h"
+#include "TexturePreloader.h"
 
 
 USING_NS_CC;
@@ -48,7 +51,8 @@ namespace
 }
 
 // 定义静态成员
-std::map<int, int> MineScene::openedChestsPerWeek_;
+std::map<int, int> MineScene::openedChestFloors_;
+TimeManager::TimerId MineScene::chestResetTimer_ = 0;
 
 MineScene* MineScene::createScene(InventoryManager* inventory, int currentFloor)
 {
@@ -107,6 +111,12 @@ bool MineScene::init(InventoryManager* inventory, int currentFloor)
     initCamera();
     initUI();
     initControls();
+
+    // 多核设备上怪物 AI 交给工作线程，必须在生成第一只怪物之前创建
+    if (mineLayer_ && MonsterSimulation::isSupported())
+    {
+        monsterSimulation_.reset(new MonsterSimulation(mineLayer_, Director::getInstance()->getScheduler()->getFixedTimeStep()));
+    }
     initMonsters();
     initChests();
     initElevator(); // [New]
@@ -116,11 +126,24 @@ bool MineScene::init(InventoryManager* inventory, int currentFloor)
 
     // 启动更新
     this->scheduleUpdate();
+    this->scheduleFixedUpdate();
+
+    // 后台解码下一层和农场的图块集，切换场景时直接命中纹理缓存
+    int nextFloor = currentFloor_ + 1 > 5 ? 1 : currentFloor_ + 1;
+    std::string preloadGroup = TexturePreloader::groupFor(this);
+    TexturePreloader::preloadMap(StringUtils::format("map/Mines/%d.tmx", nextFloor), TexturePreloader::Priority::PREFETCH, preloadGroup);
+    TexturePreloader::preloadMap("map/farm.tmx", TexturePreloader::Priority::BACKGROUND, preloadGroup);
 
     CCLOG("Mine Scene initialized successfully!");
     return true;
 }
 
+void MineScene::onExit()
+{
+    TexturePreloader::cancel(TexturePreloader::groupFor(this));
+    Scene::onExit();
+}
+
 void MineScene::initMap()
 {
     CCLOG("Initializing mine map...");
@@ -396,7 +419,7 @@ void MineScene::initUI()
 
     // 层数显示
     std::string floorStr = StringUtils::format("Floor: %d", currentFloor_);
-    floorLabel_ = Label::createWithSystemFont(floorStr, "Arial", 20);
+    floorLabel_ = GameFont::createLabel(floorStr, 20);
     floorLabel_->setAnchorPoint(Vec2(0, 0.5));
     floorLabel_->setPosition(Vec2(origin.x + 20, origin.y + visibleSize.height - 20));
     floorLabel_->setColor(Color3B::YELLOW);
@@ -408,7 +431,7 @@ void MineScene::initUI()
     if (tm) {
          timeStr = StringUtils::format("Day %d, %02d:%02d", tm->getDay(), tm->getHour(), tm->getMinute());
     }
-    auto timeLabel = Label::createWithSystemFont(timeStr, "Arial", 20);
+    auto timeLabel = GameFont::createLabel(timeStr, 20);
     timeLabel->setName("TimeLabel"); // Give it a name to find update later
     timeLabel->setPosition(Vec2(origin.x + visibleSize.width / 2, origin.y + visibleSize.height - 20));
     timeLabel->setColor(Color3B::WHITE);
@@ -416,28 +439,28 @@ void MineScene::initUI()
 
 
     // 当前物品
-    itemLabel_ = Label::createWithSystemFont("Tool: None", "Arial", 18);
+    itemLabel_ = GameFont::createLabel("Tool: None", 18);
     itemLabel_->setAnchorPoint(Vec2(1, 0.5));
     itemLabel_->setPosition(Vec2(origin.x + visibleSize.width - 20, origin.y + visibleSize.height - 20));
     itemLabel_->setColor(Color3B::WHITE);
     uiLayer_->addChild(itemLabel_, 1);
 
     // 添加操作提示
-    auto tipLabel = Label::createWithSystemFont("(Keys 1-8 to switch)", "Arial", 12);
+    auto tipLabel = GameFont::createLabel("(Keys 1-8 to switch)", 12);
     tipLabel->setAnchorPoint(Vec2(1, 0.5));
     tipLabel->setPosition(Vec2(origin.x + visibleSize.width - 20, origin.y + visibleSize.height - 40));
     tipLabel->setColor(Color3B::GRAY);
     uiLayer_->addChild(tipLabel, 1);
 
     // 操作提示
-    actionLabel_ = Label::createWithSystemFont("", "Arial", 24);
+    actionLabel_ = GameFont::createLabel("", 24);
     actionLabel_->setPosition(Vec2(origin.x + visibleSize.width / 2, origin.y + 100));
     actionLabel_->setColor(Color3B::WHITE);
     uiLayer_->addChild(actionLabel_, 1);
 
     // 帮助提示
-    auto helpLabel = Label::createWithSystemFont(
-        "WASD: Move | J: Attack/Mine | M: Elevator | ENTER: Stairs", "Arial", 14);
+    auto helpLabel = GameFont::createLabel(
+        "WASD: Move | J: Attack/Mine | M: Elevator | ENTER: Stairs", 14);
     helpLabel->setPosition(Vec2(origin.x + visibleSize.width / 2, origin.y + 20));
     helpLabel->setColor(Color3B(200, 200, 200));
     uiLayer_->addChild(helpLabel, 1);
@@ -466,7 +489,7 @@ void MineScene::initMonsters()
     monsters_.clear();
 
     // 怪物太多？减少到每层最多只有两只
-    int initialCount = 1 + (rand() % 2); // 1 or 2
+    int initialCount = 1 + GameRandom::getInstance()->nextInt(2); // 1 or 2
     if (currentFloor_ > 5) initialCount = 2; // 后期固定2只
 
     for (int i = 0; i < initialCount; ++i)
@@ -534,7 +557,7 @@ void MineScene::initElevator()
                            Color4F(0.55f, 0.45f, 0.30f, 0.7f));
 
         // 简洁的"M"标识（不用完整MINE，更精致）
-        auto label = Label::createWithSystemFont("M", "Arial", 10, Size::ZERO,
+        auto label = GameFont::createLabel("M", 10, Size::ZERO,
                                                  TextHAlignment::CENTER, TextVAlignment::CENTER);
         label->setPosition(Vec2(0, size + 8));
         label->setColor(Color3B(220, 180, 100));
@@ -560,24 +583,61 @@ void MineScene::initElevator()
     this->addChild(elevatorSprite_, 5);
 }
 
+namespace {
+    const int kChestResetHour = 6;
+
+    // 宝箱在每周第 1、8、15... 天的 6:00 重置，当天 6:00 之前仍属于上一周
+    int chestWeek(int day, int hour)
+    {
+        int resetDay = hour < kChestResetHour ? day - 1 : day;
+        return resetDay > 0 ? (resetDay - 1) / 7 : 0;
+    }
+}
+
+void MineScene::collectSaveData(std::vector<SaveManager::SaveData::MineFloorData>& out)
+{
+    for (const auto& opened : openedChestFloors_)
+    {
+        SaveManager::SaveData::MineFloorData floorData;
+        floorData.floor = opened.first;
+        floorData.chestOpenedWeek = opened.second;
+        out.push_back(floorData);
+    }
+}
+
+void MineScene::loadSaveData(const std::vector<SaveManager::SaveData::MineFloorData>& floors, int dayCount)
+{
+    int week = chestWeek(dayCount, TimeManager::getInstance()->getHour());
+    openedChestFloors_.clear();
+    for (const auto& floorData : floors)
+    {
+        if (floorData.chestOpenedWeek == week)
+        {
+            openedChestFloors_[floorData.floor] = floorData.chestOpenedWeek;
+        }
+    }
+}
+
 void MineScene::initChests()
 {
     chests_.clear();
 
+    // 第一次进矿洞时注册每周重置（第 1、8、15... 天）
+    auto tm = TimeManager::getInstance();
+    if (!tm->isTimerPending(chestResetTimer_))
+    {
+        int nextWeekDay = (chestWeek(tm->getDay(), tm->getHour()) + 1) * 7 + 1;
+        chestResetTimer_ = tm->scheduleEvery(nextWeekDay, kChestResetHour, 0, 7, [](int) { openedChestFloors_.clear(); });
+    }
+
     // 宝箱数量：至多一个，甚至不刷
     // 设定 40% 的概率出现一个宝箱
-    int chestCount = (rand() % 100 < 40) ? 1 : 0;
+    int chestCount = (GameRandom::getInstance()->nextInt(100) < 40) ? 1 : 0;
 
     if (chestCount > 0)
     {
         // 1. 检查这一周这一层的宝箱是否已经开过
-        int dayCount = 1;
-        if (TimeManager::getInstance()) dayCount = TimeManager::getInstance()->getDay();
-        int currentWeek = (dayCount - 1) / 7 + 1;
-
-
-        if (openedChestsPerWeek_.count(currentFloor_) > 0 &&
-            openedChestsPerWeek_[currentFloor_] == currentWeek)
+        if (openedChestFloors_.count(currentFloor_) > 0)
         {
             // 这一周已经开过了，直接不生成，避免玩家重复进出刷宝箱或看到已开箱子
             return;
@@ -610,24 +670,32 @@ void MineScene::update(float delta)
         energyBar->setPosition(Vec2(camera->getPositionX() + visibleSize.width / 2 - 50,
             camera->getPositionY() - visibleSize.height / 2 + 110));
     }
-    updateMonsters(delta);
+
+    // 更新时间显示
+    auto tm = TimeManager::getInstance();
+    if (tm && uiLayer_) {
+        auto label = dynamic_cast<Label*>(uiLayer_->getChildByName("TimeLabel"));
+        if (label) {
+            label->setString(StringUtils::format("Day %d, %02d:%02d", tm->getDay(), tm->getHour(), tm->getMinute()));
+        }
+    }
+}
+
+void MineScene::fixedUpdate(float step)
+{
+    syncMonsterSimulation();
+    updateMonsters(step);
 
     // 1. 模拟时间流逝
     auto tm = TimeManager::getInstance();
     if (tm) {
-        tm->update(delta);
-        
-        // Update Time Label
-        if (uiLayer_) {
-            auto label = dynamic_cast<Label*>(uiLayer_->getChildByName("TimeLabel"));
-            if (label) {
-                label->setString(StringUtils::format("Day %d, %02d:%02d", tm->getDay(), tm->getHour(), tm->getMinute()));
-            }
-        }
+        tm->update(step);
 
         // 2. 检查是否到达午夜
         if (tm->isMidnight())
         {
+            // 停止模拟步，避免同一帧内追帧时重复触发
+            unscheduleFixedUpdate();
             CCLOG("It's midnight! Passing out...");
             if (inventory_) inventory_->removeMoney(200);
             showActionMessage("Passed out...", Color3B::RED);
@@ -640,6 +708,7 @@ void MineScene::update(float delta)
     // 3. 检查生命值 (死亡逻辑)
     if (player_ && player_->getHp() <= 0)
     {
+        unscheduleFixedUpdate();
         CCLOG("Player died in mine!");
         if (inventory_) inventory_->removeMoney(200);
         showActionMessage("You died...", Color3B::RED);
@@ -650,21 +719,63 @@ void MineScene::update(float delta)
     // 攻击冷却
     if (currentAttackCooldown_ > 0)
     {
-        currentAttackCooldown_ -= delta;
+        currentAttackCooldown_ -= step;
     }
 
     // 随机生成怪物
-    monsterSpawnTimer_ += delta;
+    monsterSpawnTimer_ += step;
     if (monsterSpawnTimer_ > 10.0f) // 每10秒检查一次生成
     {
         monsterSpawnTimer_ = 0;
-        if (monsters_.size() < 15 && rand() % 100 < getMonsterSpawnChance() * 100)
+        if (monsters_.size() < 15 && GameRandom::getInstance()->nextInt(100) < getMonsterSpawnChance() * 100)
         {
             spawnMonster();
         }
     }
 }
 
+void MineScene::syncMonsterSimulation()
+{
+    if (!monsterSimulation_ || !player_) return;
+
+    monsterSimulation_->setPlayerPosition(player_->getSimulationPosition());
+
+    // 应用最新快照（工作线程可能比主线程多走或少走一步，只取最新一份）
+    const MonsterSimulation::Snapshot* snapshot = monsterSimulation_->acquireSnapshot();
+    if (snapshot)
+    {
+        for (const auto& view : snapshot->monsters)
+        {
+            for (auto monster : monsters_)
+            {
+                if (monster->getSimulationId() == view.id)
+                {
+                    // 击退后工作线程还没收到传送时发布的快照仍是旧位置，跳过
+                    if (!monster->isDead() && !monsterSimulation_->isStale(view))
+                        monster->applySimulatedPosition(view.position);
+                    break;
+                }
+            }
+        }
+    }
+
+    // 攻击事件在主线程结算，伤害和受击动画仍由 Monster/Player 处理
+    monsterAttacks_.clear();
+    monsterSimulation_->drainAttacks(monsterAttacks_);
+    for (const auto& attack : monsterAttacks_)
+    {
+        for (auto monster : monsters_)
+        {
+            if (monster->getSimulationId() == attack.id)
+            {
+                if (!monster->isDead())
+                    monster->applyAttack(player_);
+                break;
+            }
+        }
+    }
+}
+
 void MineScene::updateCamera()
 {
     if (!player_) return;
@@ -741,7 +852,7 @@ void MineScene::updateUI()
         auto visibleSize = Director::getInstance()->getVisibleSize();
         Vec2 origin = Director::getInstance()->getVisibleOrigin();
 
-        healthLabel_ = Label::createWithSystemFont("HP: 100/100", "Arial", 20);
+        healthLabel_ = GameFont::createLabel("HP: 100/100", 20);
         healthLabel_->setAnchorPoint(Vec2(0, 0.5));
         healthLabel_->setPosition(Vec2(origin.x + 20, origin.y + visibleSize.height - 50));
         healthLabel_->setColor(Color3B::RED);
@@ -767,7 +878,7 @@ void MineScene::updateMonsters(float delta)
             // 我们只需要从列表中移除引用
             // TODO: 掉落战利品
             int dropChance = 30 + currentFloor_ * 5;
-            if (rand() % 100 < dropChance)
+            if (GameRandom::getInstance()->nextInt(100) < dropChance)
             {
                 // 掉落
                 // GameScene::spawnItem(ItemType::Coal, monster->getPosition(), 1); 
@@ -775,6 +886,10 @@ void MineScene::updateMonsters(float delta)
                 // 可以添加一个 ItemNode 类来在场景中显示掉落物
             }
 
+            if (monsterSimulation_ && monster->isExternallySimulated())
+            {
+                monsterSimulation_->removeMonster(monster->getSimulationId());
+            }
             it = monsters_.erase(it);
         }
         else
@@ -783,7 +898,10 @@ void MineScene::updateMonsters(float delta)
             // 我们这里只需要检查碰撞伤害
             if (player_ && !player_->isInvulnerable())
             {
-                float dist = player_->getPosition().distance(monster->getPosition());
+                // 距离、方向和击退都按模拟位置算，显示位置可能落后一步
+                const Vec2& playerSimPos = player_->getSimulationPosition();
+                const Vec2& monsterSimPos = monster->getSimulationPosition();
+                float dist = playerSimPos.distance(monsterSimPos);
                 if (dist < 30.0f) // 碰撞范围
                 {
                     // 玩家受伤
@@ -792,9 +910,9 @@ void MineScene::updateMonsters(float delta)
                     // 刷新UI
                     updateUI();
                     // 简单击退
-                    Vec2 pushDir = player_->getPosition() - monster->getPosition();
+                    Vec2 pushDir = playerSimPos - monsterSimPos;
                     pushDir.normalize();
-                    player_->setPosition(player_->getPosition() + pushDir * 20.0f);
+                    player_->setPosition(playerSimPos + pushDir * 20.0f);
 
                     showActionMessage("Ouch!", Color3B::RED);
                 }
@@ -930,7 +1048,7 @@ void MineScene::initToolbarUI()
         }
         toolbarIcons_.push_back(icon);
 
-        auto countLabel = Label::createWithSystemFont("", "Arial", 14);
+        auto countLabel = GameFont::createLabel("", 14);
         countLabel->setAnchorPoint(Vec2(1, 0));
         countLabel->setPosition(Vec2(kToolbarSlotSize - 4.0f, 4.0f));
         countLabel->setColor(Color3B::WHITE);
@@ -1099,6 +1217,12 @@ void MineScene::executeMining(const Vec2& tileCoord)
         if (!result.message.empty()) {
             showActionMessage(result.message, Color3B::GREEN);
         }
+
+        // 矿物被挖掉后通知怪物线程更新可行走网格
+        if (monsterSimulation_)
+        {
+            monsterSimulation_->setTileWalkable(tileCoord, mineLayer_->isWalkable(mineLayer_->tileCoordToPosition(tileCoord)));
+        }
     }
 }
 
@@ -1253,10 +1377,14 @@ void MineScene::handleAttackAction()
             monster->takeDamage(attackDamage);
             hit = true;
 
-            // 击退
-            Vec2 knockback = monster->getPosition() - playerPos;
+            // 击退：方向和落点都按模拟位置算
+            Vec2 knockback = monster->getSimulationPosition() - player_->getSimulationPosition();
             knockback.normalize();
-            monster->setPosition(monster->getPosition() + knockback * 30.0f);
+            monster->setPosition(monster->getSimulationPosition() + knockback * 30.0f);
+            if (monsterSimulation_ && monster->isExternallySimulated())
+            {
+                monsterSimulation_->teleportMonster(monster->getSimulationId(), monster->getPosition());
+            }
         }
     }
 
@@ -1286,11 +1414,9 @@ void MineScene::handleChestInteraction()
                 {
                     showActionMessage(result.message, Color3B::YELLOW);
 
-                    // 记录开启状态（按周记录持久化）
-                    int dayCount = 1;
-                    if (TimeManager::getInstance()) dayCount = TimeManager::getInstance()->getDay();
-                    int currentWeek = (dayCount - 1) / 7 + 1;
-                    openedChestsPerWeek_[currentFloor_] = currentWeek;
+                    // 记录开启状态和所在的周（每周重置）
+                    auto tm = TimeManager::getInstance();
+                    openedChestFloors_[currentFloor_] = chestWeek(tm->getDay(), tm->getHour());
 
                 }
             }
@@ -1467,7 +1593,7 @@ void MineScene::spawnMonster()
     Monster* monster = nullptr;
 
     // 根据楼层决定生成的怪物类型
-    int roll = rand() % 100;
+    int roll = GameRandom::getInstance()->nextInt(100);
 
     // 僵尸生成概率随楼层增加
     int zombieChance = (currentFloor_ - 1) * 20;
@@ -1491,6 +1617,13 @@ void MineScene::spawnMonster()
         this->addChild(monster, 10);
         monsters_.push_back(monster);
 
+        if (monsterSimulation_)
+        {
+            monster->setSimulationId(nextMonsterId_++);
+            monsterSimulation_->addMonster({ monster->getSimulationId(), pos,
+                monster->getMoveSpeed(), monster->getAttackRange(), monster->getAttackCooldown() });
+        }
+
         CCLOG("Spawned %s at (%.1f, %.1f)", monster->getMonsterName().c_str(), pos.x, pos.y);
     }
 }
@@ -1515,8 +1648,8 @@ Vec2 MineScene::getRandomWalkablePosition() const
 
     for (int i = 0; i < maxAttempts; ++i)
     {
-        float x = (rand() % (int)mapSize.width);
-        float y = (rand() % (int)mapSize.height);
+        float x = GameRandom::getInstance()->nextInt((int)mapSize.width);
+        float y = GameRandom::getInstance()->nextInt((int)mapSize.height);
         Vec2 pos(x, y);
 
         if (mineLayer_->isWalkable(pos))
@@ -1541,7 +1674,7 @@ void MineScene::initWishingWell()
     if (currentFloor_ % 5 != 0) return;
 
     // 增加概率 (例如 50%)
-    if (rand() % 100 < 50) return;
+    if (GameRandom::getInstance()->nextInt(100) < 50) return;
 
     // 在地图上找一个位置放置许愿池
     Vec2 pos = getRandomWalkablePosition();
@@ -1557,7 +1690,7 @@ void MineScene::initWishingWell()
     this->addChild(wishingWell_, 5); // 与宝箱同层
 
     // 提示文字
-    auto label = Label::createWithSystemFont("Wishing Well\n(Press K)", "Arial", 12);
+    auto label = GameFont::createLabel("Wishing Well\n(Press K)", 12);
     label->setPosition(Vec2(0, 30));
     label->setAlignment(TextHAlignment::CENTER);
     wishingWell_->addChild(label);
@@ -1596,22 +1729,22 @@ void MineScene::handleWishAction()
         ));
 
         // 随机奖励
-        int randVal = rand() % 100;
+        int randVal = GameRandom::getInstance()->nextInt(100);
         if (randVal < 30) // 30% 啥也没有
         {
             showActionMessage("The well is silent...", Color3B::GRAY);
         }
         else if (randVal < 70) // 40% 金币 / 回血
         {
-            if (rand() % 2 == 0)
+            if (GameRandom::getInstance()->nextInt(2) == 0)
             {
-                int gold = 50 + rand() % 151; // 50-200
+                int gold = 50 + GameRandom::getInstance()->nextInt(151); // 50-200
                 inventory_->addMoney(gold);
                 showActionMessage(StringUtils::format("Well grants %d Gold!", gold), Color3B::YELLOW);
             }
             else
             {
-                int heal = 20 + rand() % 31; // 20-50
+                int heal = 20 + GameRandom::getInstance()->nextInt(31); // 20-50
                 player_->heal(heal);
                 showActionMessage("You feel refreshed!", Color3B::GREEN);
             }
@@ -1620,7 +1753,7 @@ void MineScene::handleWishAction()
         {
             // 随机给个矿石或更稀有的
             ItemType rewards[] = { ItemType::GoldOre, ItemType::ITEM_DiamondSword, ItemType::ITEM_GoldSword };
-            ItemType reward = rewards[rand() % 3];
+            ItemType reward = rewards[GameRandom::getInstance()->nextInt(3)];
 
             // 如果是武器且已有，折算成钱
             if ((reward == ItemType::ITEM_DiamondSword || reward == ItemType::ITEM_GoldSword) && inventory_->hasItem(reward, 1))
@@ -1633,7 +1766,7 @@ void MineScene::handleWishAction()
             {
                 if (inventory_->addItem(reward, 1))
                 {
-                    showActionMessage(StringUtils::format("Received %s!", InventoryManager::getItemName(reward).c_str()), Color3B::MAGENTA);
+                    showActionMessage(StringUtils::format("Received %s!", InventoryManager::getItemName(reward)), Color3B::MAGENTA);
                 }
                 else
                 {
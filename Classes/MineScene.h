@@ -5,9 +5,14 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
+#include <memory>
 #include "ElevatorUI.h"
 
 #include "InventoryManager.h"
+#include "MonsterSimulation.h"
+#include "SaveManager.h"
+#include "TimeManager.h"
 
 // 前向声明
 class MineLayer;
@@ -58,6 +63,27 @@ public:
      */
     virtual void update(float delta) override;
 
+    /**
+     * @brief 固定步长更新：游戏时间、怪物 AI、冷却和刷怪
+     */
+    virtual void fixedUpdate(float step) override;
+
+    /**
+     * @brief 离开场景时取消尚未完成的纹理预加载
+     */
+    virtual void onExit() override;
+
+    /**
+     * @brief 收集本周已开过宝箱的楼层，写入存档
+     */
+    static void collectSaveData(std::vector<SaveManager::SaveData::MineFloorData>& out);
+
+    /**
+     * @brief 从存档恢复本周已开过宝箱的楼层
+     * @param dayCount 存档中的天数，不属于这一周的记录已过每周重置，直接丢弃
+     */
+    static void loadSaveData(const std::vector<SaveManager::SaveData::MineFloorData>& floors, int dayCount);
+
 private:
     // 地图层
     MineLayer* mineLayer_;
@@ -119,6 +145,16 @@ private:
     std::vector<Monster*> monsters_;
     float monsterSpawnTimer_;
 
+    // 怪物 AI 工作线程，多核设备上启用，否则怪物在 Monster::fixedUpdate 中本地模拟
+    std::unique_ptr<MonsterSimulation> monsterSimulation_;
+    int nextMonsterId_ = 0;
+    std::vector<MonsterSimulation::AttackEvent> monsterAttacks_;
+
+    /**
+     * @brief 与怪物工作线程交换数据：发送玩家位置，应用最新快照和攻击事件
+     */
+    void syncMonsterSimulation();
+
     // ========== 时间系统 ==========
     // ========== 时间系统 ==========
     // float accumulatedSeconds_;     // Removed
@@ -261,9 +297,9 @@ private:
      */
     cocos2d::Vec2 getRandomWalkablePosition() const;
 
-    // 静态持久化数据：记录每一层宝箱最后一次被开启的周数
-    // key: floor, value: week
-    static std::map<int, int> openedChestsPerWeek_;
+    // 静态持久化数据：本周已经开过宝箱的楼层 -> 开箱时所在的周，每周第一天 6:00 由时间轮清空
+    static std::map<int, int> openedChestFloors_;
+    static TimeManager::TimerId chestResetTimer_;
 };
 
 #endif // __MINE_SCENE_H__
\ No newline at end of file
@@ -1,9 +1,52 @@
 #include "MiningManager.h"
 #include "SkillManager.h"
+#include "GameRandom.h"
 #include <algorithm>
 
 USING_NS_CC;
 
+namespace {
+// 注意：这里的 GID 需要根据你的 tileset 实际情况调整
+// 这里使用示例 GID，你需要在 Tiled 中查看实际的 GID 值
+const MiningManager::MineralDef kMineralDefs[] = {
+    // 名称           敲击次数  掉落物品                掉落数量  经验
+    { "Stone",        1,       ItemType::ITEM_NONE,   0, 0,    1 },
+    { "Copper Ore",   3,       ItemType::CopperOre,   1, 3,    5 },
+    { "Iron Ore",     4,       ItemType::IronOre,     1, 2,    8 },
+    { "Silver Ore",   5,       ItemType::SilverOre,   1, 2,    10 },
+    { "Gold Ore",     8,       ItemType::GoldOre,     1, 1,    20 },
+    { "Diamond Ore",  10,      ItemType::DiamondOre,  1, 1,    50 }
+};
+
+// GID 区间 -> kMineralDefs 下标 + 1
+struct MineralGidRange
+{
+    int firstGid;
+    int lastGid;
+    uint16_t mineral;
+};
+
+const MineralGidRange kMineralGidRanges[] = {
+    // 石头（普通）- GID 138-141 (mine.tmx) 以及 1001 (旧定义)
+    { 138, 141, 1 },
+    { 1001, 1001, 1 },
+    // 铜矿石 - 覆盖 289 偏移后的范围 (例如 local 586 -> gid 875)
+    // 同时也保留之前的 521-555 兼容老地图
+    { 870, 880, 2 },
+    { 521, 555, 2 },
+    // 铁矿石 - 289 偏移范围
+    { 881, 890, 3 },
+    { 750, 770, 3 },
+    // 银矿石 - 289 偏移范围 (local 620-630 -> gid 900-920 约略)
+    { 900, 920, 4 },
+    { 574, 608, 4 },
+    // 金矿石 - GID 649-723
+    { 649, 723, 5 },
+    // 钻石矿 - GID 800-810
+    { 800, 810, 6 }
+};
+}
+
 MiningManager* MiningManager::create(MineLayer* mineLayer, InventoryManager* inventory)
 {
     MiningManager* ret = new (std::nothrow) MiningManager();
@@ -20,6 +63,22 @@ MiningManager* MiningManager::create(MineLayer* mineLayer, InventoryManager* inv
     }
 }
 
+MiningManager* MiningManager::createHeadless(const Size& mapSizeTiles, InventoryManager* inventory)
+{
+    MiningManager* ret = new (std::nothrow) MiningManager();
+    if (ret && ret->Node::init() && inventory)
+    {
+        ret->mineLayer_ = nullptr;
+        ret->inventory_ = inventory;
+        ret->miningExp_ = 0;
+        ret->initProgressGrid(mapSizeTiles);
+        ret->autorelease();
+        return ret;
+    }
+    delete ret;
+    return nullptr;
+}
+
 bool MiningManager::init(MineLayer* mineLayer, InventoryManager* inventory)
 {
     if (!Node::init())
@@ -28,6 +87,8 @@ bool MiningManager::init(MineLayer* mineLayer, InventoryManager* inventory)
     mineLayer_ = mineLayer;
     inventory_ = inventory;
     miningExp_ = 0;
+    gridWidth_ = 0;
+    gridHeight_ = 0;
 
     if (!mineLayer_ || !inventory_)
     {
@@ -35,123 +96,45 @@ bool MiningManager::init(MineLayer* mineLayer, InventoryManager* inventory)
         return false;
     }
 
-    // 初始化矿物定义
-    initMineralDefs();
+    // 初始化本层挖掘进度
+    initProgressGrid(mineLayer_->getMapSizeInTiles());
 
     CCLOG("MiningManager initialized");
     return true;
 }
 
-void MiningManager::initMineralDefs()
+const std::vector<uint16_t>& MiningManager::getMineralIndexTable()
 {
-    // 注意：这里的 GID 需要根据你的 tileset 实际情况调整
-    // 这里使用示例 GID，你需要在 Tiled 中查看实际的 GID 值
-
-    // 石头（普通）- GID 138-141 (mine.tmx) 以及 1001 (旧定义)
-    std::vector<int> stoneGids = { 138, 139, 140, 141, 1001 };
-    for (int gid : stoneGids) {
-        mineralDefs_[gid] = MineralDef{
-            gid,
-            "Stone",
-            1,                      // 1次敲击
-            ItemType::ITEM_NONE,         // 不掉落物品
-            0, 0,
-            1                       // 1点经验
-        };
-    }
-
-    // 铜矿石 - 覆盖 289 偏移后的范围 (例如 local 586 -> gid 875)
-    // 同时也保留之前的 521-555 兼容老地图
-    for (int gid = 870; gid <= 880; ++gid) {
-        mineralDefs_[gid] = MineralDef{
-            gid,
-            "Copper Ore",
-            3,
-            ItemType::CopperOre,
-            1, 3,
-            5
-        };
-    }
-    for (int gid = 521; gid <= 555; ++gid) {
-        mineralDefs_[gid] = MineralDef{
-            gid,
-            "Copper Ore",
-            3,
-            ItemType::CopperOre,
-            1, 3,
-            5
-        };
-    }
-
-    // 铁矿石 - 289 偏移范围
-    for (int gid = 881; gid <= 890; ++gid) {
-        mineralDefs_[gid] = MineralDef{
-            gid,
-            "Iron Ore",
-            4,
-            ItemType::IronOre,
-            1, 2,
-            8
-        };
-    }
-    for (int gid = 750; gid <= 770; ++gid) {
-        mineralDefs_[gid] = MineralDef{
-            gid,
-            "Iron Ore",
-            4,
-            ItemType::IronOre,
-            1, 2,
-            8
-        };
-    }
-
-    // 银矿石 - 289 偏移范围 (local 620-630 -> gid 900-920 约略)
-    for (int gid = 900; gid <= 920; ++gid) {
-        mineralDefs_[gid] = MineralDef{
-            gid,
-            "Silver Ore",
-            5,
-            ItemType::SilverOre,
-            1, 2,
-            10
-        };
-    }
-    for (int gid = 574; gid <= 608; ++gid) {
-        mineralDefs_[gid] = MineralDef{
-            gid,
-            "Silver Ore",
-            5,
-            ItemType::SilverOre,
-            1, 2,
-            10
-        };
-    }
+    static const std::vector<uint16_t> table = [] {
+        std::vector<uint16_t> result;
+        for (const auto& range : kMineralGidRanges)
+        {
+            if ((int)result.size() <= range.lastGid)
+                result.resize(range.lastGid + 1, 0);
+            std::fill(result.begin() + range.firstGid, result.begin() + range.lastGid + 1, range.mineral);
+        }
+        CCLOG("Mineral definitions initialized: %d GIDs", (int)result.size());
+        return result;
+    }();
+    return table;
+}
 
-    // 金矿石 - GID 649-723
-    for (int gid = 649; gid <= 723; ++gid) {
-        mineralDefs_[gid] = MineralDef{
-            gid,
-            "Gold Ore",
-            8,
-            ItemType::GoldOre,
-            1, 1,
-            20
-        };
-    }
+void MiningManager::initProgressGrid(const Size& mapSizeTiles)
+{
+    gridWidth_ = static_cast<int>(mapSizeTiles.width);
+    gridHeight_ = static_cast<int>(mapSizeTiles.height);
 
-    // 钻石矿 - GID 800-810
-    for (int gid = 800; gid <= 810; ++gid) {
-        mineralDefs_[gid] = MineralDef{
-            gid,
-            "Diamond Ore",
-            10,
-            ItemType::DiamondOre,
-            1, 1,
-            50
-        };
-    }
+    MineralProgress idle = { 0, 0 };
+    progressGrid_.assign(static_cast<size_t>(gridWidth_ * gridHeight_), idle);
+}
 
-    CCLOG("Mineral definitions initialized: %d types", (int)mineralDefs_.size());
+int MiningManager::getGridIndex(const Vec2& tileCoord) const
+{
+    int x = static_cast<int>(tileCoord.x);
+    int y = static_cast<int>(tileCoord.y);
+    if (x < 0 || x >= gridWidth_ || y < 0 || y >= gridHeight_)
+        return -1;
+    return y * gridWidth_ + x;
 }
 
 MiningManager::MiningResult MiningManager::mineTile(const Vec2& tileCoord)
@@ -176,79 +159,82 @@ MiningManager::MiningResult MiningManager::mineTile(const Vec2& tileCoord)
         return { true, "" }; // 不提示通用消息
     }
 
-    // 生成瓦片键
-    long long key = getTileKey(tileCoord);
+    int index = getGridIndex(tileCoord);
+    if (index < 0)
+    {
+        return { false, "No mineral here" };
+    }
 
-    // 查找或创建进度
-    auto it = activeMinings_.find(key);
-    if (it == activeMinings_.end())
+    int remaining = applyHit(index, *mineralDef);
+    if (remaining == 0)
     {
-        // 新矿物，创建进度
-        MineralProgress progress;
-        progress.tileCoord = tileCoord;
-        progress.hitCount = 1;
-        int hitReduction = SkillManager::getInstance()->getMiningHitReduction();
-        progress.requiredHits = std::max(1, mineralDef->hitPoints - hitReduction);
-        activeMinings_[key] = progress;
+        // 破坏矿物
+        mineLayer_->clearMineralAt(tileCoord);
+        mineLayer_->clearCollisionAt(tileCoord);
+        return { true, finishMineral(tileCoord, *mineralDef) };
+    }
 
-        if (progress.requiredHits <= 1)
-        {
-            // 一次就破坏
-            mineLayer_->clearMineralAt(tileCoord);
-            mineLayer_->clearCollisionAt(tileCoord);
-            std::string dropMsg = dropItems(tileCoord, *mineralDef);
-            activeMinings_.erase(key);
-            SkillManager::getInstance()->recordAction(SkillManager::SkillType::Mining);
-            addExp(mineralDef->expReward);
-            
-            if (!dropMsg.empty()) {
-                return { true, dropMsg };
-            } else {
-                return { true, "" };
-            }
-        }
-        else
-        {
-            return { true, "Mining... (" + std::to_string(progress.requiredHits - 1) + " more)" };
-        }
+    return { true, "Mining... (" + std::to_string(remaining) + " more)" };
+}
+
+MiningManager::MiningResult MiningManager::simulateHit(const Vec2& tileCoord, int gid)
+{
+    const MineralDef* mineralDef = getMineralDef(gid);
+    if (!mineralDef)
+    {
+        return { true, "" };
     }
-    else
+
+    int index = getGridIndex(tileCoord);
+    if (index < 0)
     {
-        // 继续敲击
-        it->second.hitCount++;
+        return { false, "No mineral here" };
+    }
 
-        if (it->second.hitCount >= it->second.requiredHits)
-        {
-            // 破坏矿物
-            mineLayer_->clearMineralAt(tileCoord);
-            mineLayer_->clearCollisionAt(tileCoord);
-            std::string dropMsg = dropItems(tileCoord, *mineralDef);
-            activeMinings_.erase(it);
-            SkillManager::getInstance()->recordAction(SkillManager::SkillType::Mining);
-            addExp(mineralDef->expReward);
-            
-            if (!dropMsg.empty()) {
-                return { true, dropMsg };
-            } else {
-                return { true, "" };
-            }
-        }
-        else
-        {
-            int remaining = it->second.requiredHits - it->second.hitCount;
-            return { true, "Mining... (" + std::to_string(remaining) + " more)" };
-        }
+    int remaining = applyHit(index, *mineralDef);
+    if (remaining == 0)
+    {
+        return { true, finishMineral(tileCoord, *mineralDef) };
+    }
+
+    return { true, "Mining... (" + std::to_string(remaining) + " more)" };
+}
+
+int MiningManager::applyHit(int index, const MineralDef& mineralDef)
+{
+    MineralProgress& progress = progressGrid_[index];
+    if (progress.hitCount == 0)
+    {
+        // 新矿物，创建进度
+        int hitReduction = SkillManager::getInstance()->getMiningHitReduction();
+        progress.requiredHits = static_cast<uint8_t>(std::max(1, mineralDef.hitPoints - hitReduction));
+    }
+    progress.hitCount++;
+
+    if (progress.hitCount >= progress.requiredHits)
+    {
+        progress.hitCount = 0;
+        return 0;
     }
+    return progress.requiredHits - progress.hitCount;
+}
+
+std::string MiningManager::finishMineral(const Vec2& tileCoord, const MineralDef& mineralDef)
+{
+    std::string dropMsg = dropItems(tileCoord, mineralDef);
+    SkillManager::getInstance()->recordAction(SkillManager::SkillType::Mining);
+    addExp(mineralDef.expReward);
+    return dropMsg;
 }
 
 const MiningManager::MineralDef* MiningManager::getMineralDef(int gid) const
 {
-    auto it = mineralDefs_.find(gid);
-    if (it != mineralDefs_.end())
+    const auto& table = getMineralIndexTable();
+    if (gid < 0 || gid >= (int)table.size() || table[gid] == 0)
     {
-        return &it->second;
+        return nullptr;
     }
-    return nullptr;
+    return &kMineralDefs[table[gid] - 1];
 }
 
 void MiningManager::addExp(int exp)
@@ -257,13 +243,6 @@ void MiningManager::addExp(int exp)
     CCLOG("Mining exp: %d (+%d)", miningExp_, exp);
 }
 
-long long MiningManager::getTileKey(const Vec2& tileCoord) const
-{
-    int x = static_cast<int>(tileCoord.x);
-    int y = static_cast<int>(tileCoord.y);
-    return (static_cast<long long>(y) << 32) | (static_cast<unsigned long long>(x) & 0xffffffffULL);
-}
-
 std::string MiningManager::dropItems(const Vec2& tileCoord, const MineralDef& mineralDef)
 {
     if (mineralDef.dropItem == ItemType::ITEM_NONE)
@@ -273,7 +252,7 @@ std::string MiningManager::dropItems(const Vec2& tileCoord, const MineralDef& mi
     int dropCount = mineralDef.dropMinCount;
     if (mineralDef.dropMaxCount > mineralDef.dropMinCount)
     {
-        dropCount += rand() % (mineralDef.dropMaxCount - mineralDef.dropMinCount + 1);
+        dropCount += GameRandom::getInstance()->nextInt(mineralDef.dropMaxCount - mineralDef.dropMinCount + 1);
     }
 
     // 添加到背包
@@ -282,9 +261,9 @@ std::string MiningManager::dropItems(const Vec2& tileCoord, const MineralDef& mi
         bool added = inventory_->addItem(mineralDef.dropItem, dropCount);
         if (added)
         {
-            std::string itemName = InventoryManager::getItemName(mineralDef.dropItem);
-            CCLOG("Collected %d x %s", dropCount, itemName.c_str());
-            return StringUtils::format("Found %d %s!", dropCount, itemName.c_str());
+            const char* itemName = InventoryManager::getItemName(mineralDef.dropItem);
+            CCLOG("Collected %d x %s", dropCount, itemName);
+            return StringUtils::format("Found %d %s!", dropCount, itemName);
         }
         else
         {
@@ -4,8 +4,9 @@
 #include "cocos2d.h"
 #include "MineLayer.h"
 #include "InventoryManager.h"
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 /**
  * @brief 挖矿管理器
@@ -23,8 +24,7 @@ public:
      */
     struct MineralDef
     {
-        int id;                    // 矿物ID
-        std::string name;          // 名称
+        const char* name;          // 名称
         int hitPoints;             // 需要敲击次数
         ItemType dropItem;         // 掉落物品类型
         int dropMinCount;          // 最小掉落数量
@@ -48,6 +48,15 @@ public:
      */
     static MiningManager* create(MineLayer* mineLayer, InventoryManager* inventory);
 
+    /**
+     * @brief 创建无地图的挖矿管理器，用于模拟和基准测试
+     *
+     * 只维护挖掘进度和掉落，配合 simulateHit() 使用
+     * @param mapSizeTiles 矿层尺寸（瓦片）
+     * @param inventory 背包管理器引用
+     */
+    static MiningManager* createHeadless(const cocos2d::Size& mapSizeTiles, InventoryManager* inventory);
+
     /**
      * @brief 初始化
      */
@@ -59,6 +68,13 @@ public:
      */
     MiningResult mineTile(const cocos2d::Vec2& tileCoord);
 
+    /**
+     * @brief 不经过地图，直接对指定矿物敲击一次
+     * @param tileCoord 瓦片坐标
+     * @param gid 该位置的矿物 GID
+     */
+    MiningResult simulateHit(const cocos2d::Vec2& tileCoord, int gid);
+
     /**
      * @brief 获取矿物信息
      * @param gid 矿物 GID
@@ -80,28 +96,44 @@ private:
     InventoryManager* inventory_;                    // 背包管理器引用
     int miningExp_;                                  // 挖矿经验
 
-    // 矿物进度追踪
+    // 矿物进度追踪，hitCount 为 0 表示该格没有正在挖掘的矿物
     struct MineralProgress
     {
-        cocos2d::Vec2 tileCoord;
-        int hitCount;              // 已敲击次数
-        int requiredHits;          // 需要的总次数
+        uint8_t hitCount;          // 已敲击次数
+        uint8_t requiredHits;      // 需要的总次数
     };
 
-    std::unordered_map<long long, MineralProgress> activeMinings_;  // 正在挖掘的矿物
+    // 本层每个瓦片一项，按 y * 宽 + x 排列
+    std::vector<MineralProgress> progressGrid_;
+    int gridWidth_;
+    int gridHeight_;
 
-    // 矿物定义数据库
-    std::unordered_map<int, MineralDef> mineralDefs_;
+    /**
+     * @brief 获取 GID -> 矿物下标表（所有实例共享）
+     *
+     * 下标从 1 开始指向矿物定义数组，0 表示该 GID 不是已知矿物
+     */
+    static const std::vector<uint16_t>& getMineralIndexTable();
+
+    /**
+     * @brief 按本层地图大小初始化挖掘进度网格
+     */
+    void initProgressGrid(const cocos2d::Size& mapSizeTiles);
+
+    /**
+     * @brief 获取瓦片在进度网格中的下标，越界返回 -1
+     */
+    int getGridIndex(const cocos2d::Vec2& tileCoord) const;
 
     /**
-     * @brief 初始化矿物定义
+     * @brief 敲击一次并返回剩余次数，0 表示矿物已被破坏
      */
-    void initMineralDefs();
+    int applyHit(int index, const MineralDef& mineralDef);
 
     /**
-     * @brief 生成哈希键（用于追踪矿物位置）
+     * @brief 矿物破坏后的结算：掉落、技能记录和经验
      */
-    long long getTileKey(const cocos2d::Vec2& tileCoord) const;
+    std::string finishMineral(const cocos2d::Vec2& tileCoord, const MineralDef& mineralDef);
 
     /**
      * @brief 掉落物品
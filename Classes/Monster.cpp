@@ -1,4 +1,5 @@
 #include "Monster.h"
+#include "GameFont.h"
 #include "Player.h"
 #include "MineLayer.h"
 
@@ -38,6 +39,7 @@ bool Monster::init(int floorLevel)
 
     // 启动更新
     this->scheduleUpdate();
+    this->scheduleFixedUpdate();
 
     return true;
 }
@@ -102,7 +104,7 @@ void Monster::initDisplay()
     }
 
     // 血条显示
-    hpLabel_ = Label::createWithSystemFont("", "Arial", 10);
+    hpLabel_ = GameFont::createLabel("", 10);
     hpLabel_->setPosition(Vec2(0, 20));
     hpLabel_->setColor(Color3B::RED);
     this->addChild(hpLabel_, 1);
@@ -112,20 +114,55 @@ void Monster::initDisplay()
 
 void Monster::update(float delta)
 {
+    if (isDead())
+        return;
+
+    // 显示位置在最近两个模拟步之间插值；直接调用基类的浮点版本，不经过会重置模拟状态的重写
+    Vec2 displayPosition = body_.lerp(_scheduler->getFixedStepAlpha());
+    Sprite::setPosition(displayPosition.x, displayPosition.y);
+
+    // 更新血条
+    updateHpDisplay();
+}
+
+void Monster::fixedUpdate(float step)
+{
+    // 外部模拟时位置和冷却都由 MonsterSimulation 推进
+    if (isExternallySimulated())
+        return;
+
+    body_.beginStep();
+
     if (isDead())
         return;
 
     // 更新攻击冷却
     if (currentAttackCooldown_ > 0)
     {
-        currentAttackCooldown_ -= delta;
+        currentAttackCooldown_ -= step;
     }
 
     // AI逻辑
-    updateAI(delta);
+    updateAI(step);
+}
 
-    // 更新血条
-    updateHpDisplay();
+void Monster::applySimulatedPosition(const Vec2& position)
+{
+    body_.beginStep();
+    body_.current = position;
+}
+
+// Node::setPosition(Vec2) 会转调虚函数 setPosition(x, y)，两个重写都只调用基类的浮点版本
+void Monster::setPosition(const Vec2& position)
+{
+    body_.snap(position);
+    Sprite::setPosition(position.x, position.y);
+}
+
+void Monster::setPosition(float x, float y)
+{
+    body_.snap(Vec2(x, y));
+    Sprite::setPosition(x, y);
 }
 
 void Monster::updateAI(float delta)
@@ -133,8 +170,8 @@ void Monster::updateAI(float delta)
     if (!targetPlayer_ || isDead())
         return;
 
-    Vec2 playerPos = targetPlayer_->getPosition();
-    Vec2 myPos = this->getPosition();
+    Vec2 playerPos = targetPlayer_->getSimulationPosition();
+    Vec2 myPos = body_.current;
     float distance = myPos.distance(playerPos);
 
     // 如果在攻击范围内，尝试攻击
@@ -154,7 +191,7 @@ void Monster::updateAI(float delta)
 
 void Monster::moveTowards(const Vec2& targetPos, float delta)
 {
-    Vec2 myPos = this->getPosition();
+    Vec2 myPos = body_.current;
     Vec2 direction = targetPos - myPos;
     if (direction.length() > 0)
     {
@@ -177,7 +214,7 @@ void Monster::moveTowards(const Vec2& targetPos, float delta)
         // 2. 检查是否可行走
         if (mapLayer_->isWalkable(newPos))
         {
-            this->setPosition(newPos);
+            body_.current = newPos;
         }
         else
         {
@@ -185,21 +222,21 @@ void Monster::moveTowards(const Vec2& targetPos, float delta)
             Vec2 newPosX = myPos + Vec2(direction.x * moveSpeed_ * delta, 0);
             if (mapLayer_->isWalkable(newPosX))
             {
-                this->setPosition(newPosX);
+                body_.current = newPosX;
             }
             else
             {
                 Vec2 newPosY = myPos + Vec2(0, direction.y * moveSpeed_ * delta);
                 if (mapLayer_->isWalkable(newPosY))
                 {
-                    this->setPosition(newPosY);
+                    body_.current = newPosY;
                 }
             }
         }
     }
     else
     {
-        this->setPosition(newPos);
+        body_.current = newPos;
     }
 
 }
@@ -235,14 +272,22 @@ void Monster::attackPlayer(Player* player)
     if (!player || currentAttackCooldown_ > 0)
         return;
 
+    applyAttack(player);
+
+    // 重置攻击冷却
+    currentAttackCooldown_ = attackCooldown_;
+}
+
+void Monster::applyAttack(Player* player)
+{
+    if (!player || isDead())
+        return;
+
     CCLOG("%s attacks player for %d damage!", name_.c_str(), attackPower_);
 
     // 对玩家造成伤害
     player->takeDamage(attackPower_);
 
-    // 重置攻击冷却
-    currentAttackCooldown_ = attackCooldown_;
-
     // 攻击动画（简单的缩放效果）
     auto attackAnim = Sequence::create(
         ScaleTo::create(0.1f, 1.2f),
@@ -2,6 +2,7 @@
 #define __MONSTER_H__
 
 #include "cocos2d.h"
+#include "InterpolatedPosition.h"
 #include <string>
 
 // 前向声明
@@ -35,10 +36,26 @@ public:
     bool init(int floorLevel);
 
     /**
-     * @brief 每帧更新
+     * @brief 每帧更新：插值后的显示位置和血条
      */
     virtual void update(float delta) override;
 
+    /**
+     * @brief 固定步长更新：攻击冷却和 AI 移动
+     */
+    virtual void fixedUpdate(float step) override;
+
+    /**
+     * @brief 设置位置（生成、击退），同时重置模拟位置，不做插值
+     */
+    virtual void setPosition(const cocos2d::Vec2& position) override;
+    virtual void setPosition(float x, float y) override;
+
+    /**
+     * @brief 获取模拟位置（最近一个模拟步的结果，显示位置可能落后不到一步）
+     */
+    const cocos2d::Vec2& getSimulationPosition() const { return body_.current; }
+
     // ========== 战斗相关 ==========
 
     /**
@@ -57,12 +74,21 @@ public:
      */
     virtual void attackPlayer(Player* player);
 
+    /**
+     * @brief 执行一次攻击（伤害和动画），不检查冷却
+     *
+     * 冷却由外部模拟（MonsterSimulation）负责时使用
+     */
+    void applyAttack(Player* player);
+
     // ========== 属性获取 ==========
 
     int getHp() const { return hp_; }
     int getMaxHp() const { return maxHp_; }
     int getAttackPower() const { return attackPower_; }
     float getAttackRange() const { return attackRange_; }
+    float getAttackCooldown() const { return attackCooldown_; }
+    float getMoveSpeed() const { return moveSpeed_; }
     std::string getMonsterName() const { return name_; }
 
     // ========== AI相关 ==========
@@ -77,6 +103,20 @@ public:
      */
     void setMapLayer(MineLayer* mapLayer) { mapLayer_ = mapLayer; }
 
+    // ========== 外部模拟 ==========
+
+    /**
+     * @brief 设置外部模拟编号，>= 0 时 AI 由工作线程计算，本节点只显示结果
+     */
+    void setSimulationId(int id) { simulationId_ = id; }
+    int getSimulationId() const { return simulationId_; }
+    bool isExternallySimulated() const { return simulationId_ >= 0; }
+
+    /**
+     * @brief 应用外部模拟的新位置，显示位置从当前模拟位置插值过去
+     */
+    void applySimulatedPosition(const cocos2d::Vec2& position);
+
     // ========== 贴图预留接口 ==========
 
     /**
@@ -102,6 +142,8 @@ protected:
     // AI相关
     Player* targetPlayer_;
     MineLayer* mapLayer_;
+    InterpolatedPosition body_;            // 模拟位置
+    int simulationId_{ -1 };               // 外部模拟编号，-1 表示本地模拟
 
     // 显示相关
     cocos2d::DrawNode* displayNode_;       // 临时显示用
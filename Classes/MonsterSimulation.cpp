@@ -0,0 +1,350 @@
+#include "MonsterSimulation.h"
+#include "MineLayer.h"
+#include <chrono>
+
+USING_NS_CC;
+
+namespace {
+// 主线程超过这么多步没有发送玩家位置（暂停、切到后台、场景切换）时停止推进怪物，
+// 避免恢复时一次性收到大量攻击
+const uint32_t kMaxTicksWithoutInput = 10;
+}
+
+bool MonsterSimulation::isSupported()
+{
+    return std::thread::hardware_concurrency() > 1;
+}
+
+MonsterSimulation::MonsterSimulation(MineLayer* mineLayer, float step)
+    : gridWidth_(0)
+    , gridHeight_(0)
+    , tick_(0)
+    , lastInputTick_(0)
+    , step_(step)
+    , lockFree_(false)
+    , inbox_(std::make_shared<MainThreadInbox>())
+    , teleportSequence_(0)
+    , running_(false)
+{
+    // 在主线程把地形拷贝成网格，工作线程之后不再访问 TMX
+    if (mineLayer)
+    {
+        Size mapSize = mineLayer->getMapSizeInTiles();
+        tileSize_ = mineLayer->getTileSize();
+        gridWidth_ = static_cast<int>(mapSize.width);
+        gridHeight_ = static_cast<int>(mapSize.height);
+        mapPixelSize_ = mineLayer->getMapSize();
+
+        walkable_.assign(static_cast<size_t>(gridWidth_ * gridHeight_), 0);
+        for (int y = 0; y < gridHeight_; ++y)
+        {
+            for (int x = 0; x < gridWidth_; ++x)
+            {
+                Vec2 center = mineLayer->tileCoordToPosition(Vec2(x, y));
+                walkable_[y * gridWidth_ + x] = mineLayer->isWalkable(center) ? 1 : 0;
+            }
+        }
+    }
+
+    lockFree_ = commands_.isLockFree() && attacks_.isLockFree() && snapshots_.isLockFree();
+    if (!lockFree_)
+    {
+        CCLOG("MonsterSimulation: atomics are not lock-free, delivering through performFunctionInCocosThread");
+    }
+
+    running_ = true;
+    thread_ = std::thread(&MonsterSimulation::run, this);
+}
+
+MonsterSimulation::~MonsterSimulation()
+{
+    running_ = false;
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+// ========== 主线程命令 ==========
+
+void MonsterSimulation::pushCommand(const Command& command)
+{
+    // 先补发之前没放进去的命令，保证顺序
+    size_t sent = 0;
+    while (sent < pendingCommands_.size() && commands_.push(pendingCommands_[sent]))
+        ++sent;
+    pendingCommands_.erase(pendingCommands_.begin(), pendingCommands_.begin() + sent);
+
+    if (!pendingCommands_.empty() || !commands_.push(command))
+    {
+        pendingCommands_.push_back(command);
+    }
+}
+
+void MonsterSimulation::addMonster(const MonsterSpec& spec)
+{
+    pushCommand({ CommandType::Add, spec, false, 0 });
+}
+
+void MonsterSimulation::removeMonster(int id)
+{
+    MonsterSpec spec = { id, Vec2::ZERO, 0.0f, 0.0f, 0.0f };
+    pushCommand({ CommandType::Remove, spec, false, 0 });
+    sentTeleports_.erase(id);
+}
+
+void MonsterSimulation::teleportMonster(int id, const Vec2& position)
+{
+    MonsterSpec spec = { id, position, 0.0f, 0.0f, 0.0f };
+    uint32_t sequence = ++teleportSequence_;
+    sentTeleports_[id] = sequence;
+    pushCommand({ CommandType::Teleport, spec, false, sequence });
+}
+
+void MonsterSimulation::setPlayerPosition(const Vec2& position)
+{
+    MonsterSpec spec = { -1, position, 0.0f, 0.0f, 0.0f };
+    pushCommand({ CommandType::PlayerPosition, spec, false, 0 });
+}
+
+void MonsterSimulation::setTileWalkable(const Vec2& tileCoord, bool walkable)
+{
+    MonsterSpec spec = { -1, tileCoord, 0.0f, 0.0f, 0.0f };
+    pushCommand({ CommandType::TileWalkable, spec, walkable, 0 });
+}
+
+// ========== 主线程读取 ==========
+
+const MonsterSimulation::Snapshot* MonsterSimulation::acquireSnapshot()
+{
+    if (lockFree_)
+    {
+        return snapshots_.acquire();
+    }
+    if (inbox_->hasSnapshot)
+    {
+        inbox_->hasSnapshot = false;
+        return &inbox_->snapshot;
+    }
+    return nullptr;
+}
+
+bool MonsterSimulation::isStale(const MonsterView& view) const
+{
+    auto it = sentTeleports_.find(view.id);
+    return it != sentTeleports_.end() && view.teleportSequence < it->second;
+}
+
+void MonsterSimulation::drainAttacks(std::vector<AttackEvent>& out)
+{
+    AttackEvent event;
+    while (attacks_.pop(event))
+    {
+        out.push_back(event);
+    }
+    if (!inbox_->attacks.empty())
+    {
+        out.insert(out.end(), inbox_->attacks.begin(), inbox_->attacks.end());
+        inbox_->attacks.clear();
+    }
+}
+
+// ========== 工作线程 ==========
+
+void MonsterSimulation::run()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto stepDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(step_));
+    auto nextTick = Clock::now();
+
+    while (running_)
+    {
+        tick();
+
+        nextTick += stepDuration;
+        auto now = Clock::now();
+        if (now - nextTick > stepDuration * 5)
+        {
+            // 落后太多（例如调试断点）时不再追赶
+            nextTick = now;
+        }
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+void MonsterSimulation::tick()
+{
+    Command command;
+    while (commands_.pop(command))
+    {
+        applyCommand(command);
+    }
+
+    if (tick_ - lastInputTick_ > kMaxTicksWithoutInput)
+        return;
+
+    for (auto& monster : monsters_)
+    {
+        updateMonster(monster);
+    }
+
+    ++tick_;
+    publishSnapshot();
+}
+
+void MonsterSimulation::applyCommand(const Command& command)
+{
+    switch (command.type)
+    {
+    case CommandType::Add:
+        monsters_.push_back({ command.spec, 0.0f, 0 });
+        break;
+    case CommandType::Remove:
+        for (auto it = monsters_.begin(); it != monsters_.end(); ++it)
+        {
+            if (it->spec.id == command.spec.id)
+            {
+                monsters_.erase(it);
+                break;
+            }
+        }
+        break;
+    case CommandType::Teleport:
+        for (auto& monster : monsters_)
+        {
+            if (monster.spec.id == command.spec.id)
+            {
+                monster.spec.position = command.spec.position;
+                monster.teleportSequence = command.sequence;
+                break;
+            }
+        }
+        break;
+    case CommandType::PlayerPosition:
+        playerPosition_ = command.spec.position;
+        lastInputTick_ = tick_;
+        break;
+    case CommandType::TileWalkable:
+    {
+        int x = static_cast<int>(command.spec.position.x);
+        int y = static_cast<int>(command.spec.position.y);
+        if (x >= 0 && x < gridWidth_ && y >= 0 && y < gridHeight_)
+        {
+            walkable_[y * gridWidth_ + x] = command.walkable ? 1 : 0;
+        }
+        break;
+    }
+    }
+}
+
+void MonsterSimulation::updateMonster(MonsterState& monster)
+{
+    // 与 Monster::updateAI / moveTowards 相同的规则
+    if (monster.cooldown > 0)
+    {
+        monster.cooldown -= step_;
+    }
+
+    Vec2 myPos = monster.spec.position;
+    float distance = myPos.distance(playerPosition_);
+    if (distance <= monster.spec.attackRange)
+    {
+        if (monster.cooldown <= 0)
+        {
+            monster.cooldown = monster.spec.attackCooldown;
+            postAttack(monster.spec.id);
+        }
+        return;
+    }
+
+    Vec2 direction = playerPosition_ - myPos;
+    if (direction.length() > 0)
+    {
+        direction.normalize();
+    }
+
+    float distanceStep = monster.spec.moveSpeed * step_;
+    Vec2 newPos = myPos + direction * distanceStep;
+    if (newPos.x < 0 || newPos.x > mapPixelSize_.width ||
+        newPos.y < 0 || newPos.y > mapPixelSize_.height)
+    {
+        return; // 超出地图边界，不移动
+    }
+
+    if (isWalkable(newPos))
+    {
+        monster.spec.position = newPos;
+        return;
+    }
+
+    // 滑墙：尝试只移动 X 或 Y
+    Vec2 newPosX = myPos + Vec2(direction.x * distanceStep, 0);
+    if (isWalkable(newPosX))
+    {
+        monster.spec.position = newPosX;
+        return;
+    }
+    Vec2 newPosY = myPos + Vec2(0, direction.y * distanceStep);
+    if (isWalkable(newPosY))
+    {
+        monster.spec.position = newPosY;
+    }
+}
+
+bool MonsterSimulation::isWalkable(const Vec2& position) const
+{
+    if (gridWidth_ == 0 || gridHeight_ == 0)
+        return true;
+
+    // 与 MapLayer::positionToTileCoord 相同的换算
+    int x = static_cast<int>(position.x / tileSize_.width);
+    int y = static_cast<int>((gridHeight_ * tileSize_.height - position.y) / tileSize_.height);
+    if (x < 0 || x >= gridWidth_ || y < 0 || y >= gridHeight_)
+        return false;
+    return walkable_[y * gridWidth_ + x] != 0;
+}
+
+void MonsterSimulation::publishSnapshot()
+{
+    if (lockFree_)
+    {
+        Snapshot& snapshot = snapshots_.writeBuffer();
+        snapshot.tick = tick_;
+        snapshot.monsters.clear();
+        for (const auto& monster : monsters_)
+        {
+            snapshot.monsters.push_back({ monster.spec.id, monster.spec.position, monster.teleportSequence });
+        }
+        snapshots_.publish();
+        return;
+    }
+
+    // 回退：拷贝一份交给主线程
+    Snapshot snapshot;
+    snapshot.tick = tick_;
+    snapshot.monsters.reserve(monsters_.size());
+    for (const auto& monster : monsters_)
+    {
+        snapshot.monsters.push_back({ monster.spec.id, monster.spec.position, monster.teleportSequence });
+    }
+    std::shared_ptr<MainThreadInbox> inbox = inbox_;
+    Director::getInstance()->getScheduler()->performFunctionInCocosThread([inbox, snapshot]() {
+        inbox->snapshot = snapshot;
+        inbox->hasSnapshot = true;
+    });
+}
+
+void MonsterSimulation::postAttack(int id)
+{
+    AttackEvent event = { id };
+    if (lockFree_ && attacks_.push(event))
+    {
+        return;
+    }
+
+    // 回退：队列满或原子操作不是无锁时通过调度器投递，事件不会丢失
+    std::shared_ptr<MainThreadInbox> inbox = inbox_;
+    Director::getInstance()->getScheduler()->performFunctionInCocosThread([inbox, event]() {
+        inbox->attacks.push_back(event);
+    });
+}
@@ -0,0 +1,182 @@
+#ifndef __MONSTER_SIMULATION_H__
+#define __MONSTER_SIMULATION_H__
+
+#include "cocos2d.h"
+#include "SpscHandoff.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class MineLayer;
+
+/**
+ * @brief 矿洞怪物 AI 的工作线程模拟
+ *
+ * 职责：
+ * - 在独立线程上按固定步长推进怪物追踪、滑墙和攻击判定，不访问任何 Node
+ * - 主线程通过无锁队列发送命令（生成、移除、击退、玩家位置、地形变化）
+ * - 每步结束发布一份不可变快照（三缓冲），主线程取最新一份更新怪物节点
+ * - 攻击事件走无锁队列；队列满或平台原子操作不是无锁时，
+ *   退回 Scheduler::performFunctionInCocosThread 投递到主线程
+ *
+ * 地形在创建时从 MineLayer 拷贝成可行走网格，工作线程只读这份拷贝。
+ */
+class MonsterSimulation
+{
+public:
+    /**
+     * @brief 怪物的模拟参数
+     */
+    struct MonsterSpec
+    {
+        int id;
+        cocos2d::Vec2 position;
+        float moveSpeed;
+        float attackRange;
+        float attackCooldown;
+    };
+
+    /**
+     * @brief 快照中的怪物状态
+     */
+    struct MonsterView
+    {
+        int id;
+        cocos2d::Vec2 position;
+        uint32_t teleportSequence;      // 生成这份状态时已应用的最近一次传送的序号
+    };
+
+    /**
+     * @brief 一个模拟步的快照
+     */
+    struct Snapshot
+    {
+        uint32_t tick = 0;
+        std::vector<MonsterView> monsters;
+    };
+
+    /**
+     * @brief 怪物发起攻击
+     */
+    struct AttackEvent
+    {
+        int id;
+    };
+
+    /**
+     * @brief 当前设备是否适合开启工作线程（多核）
+     */
+    static bool isSupported();
+
+    /**
+     * @brief 从矿层拷贝可行走网格并启动工作线程
+     * @param mineLayer 矿洞地图层（只在构造时读取）
+     * @param step 模拟步长（秒）
+     */
+    MonsterSimulation(MineLayer* mineLayer, float step);
+    ~MonsterSimulation();
+
+    // ========== 主线程命令 ==========
+
+    void addMonster(const MonsterSpec& spec);
+    void removeMonster(int id);
+    void teleportMonster(int id, const cocos2d::Vec2& position);
+    void setPlayerPosition(const cocos2d::Vec2& position);
+    void setTileWalkable(const cocos2d::Vec2& tileCoord, bool walkable);
+
+    // ========== 主线程读取 ==========
+
+    /**
+     * @brief 取最新快照，自上次调用后没有新快照时返回 nullptr
+     */
+    const Snapshot* acquireSnapshot();
+
+    /**
+     * @brief 快照中的位置是否早于主线程最近一次传送（击退）该怪物
+     *
+     * 传送在主线程立即生效，工作线程还没处理这条命令时发布的快照仍是旧位置，应用它会把怪物拉回去。
+     */
+    bool isStale(const MonsterView& view) const;
+
+    /**
+     * @brief 取出所有待处理的攻击事件
+     */
+    void drainAttacks(std::vector<AttackEvent>& out);
+
+private:
+    enum class CommandType : uint8_t
+    {
+        Add,
+        Remove,
+        Teleport,
+        PlayerPosition,
+        TileWalkable
+    };
+
+    struct Command
+    {
+        CommandType type;
+        MonsterSpec spec;           // Add/Teleport 使用 id 和 position，TileWalkable 用 position 存瓦片坐标
+        bool walkable;
+        uint32_t sequence;          // Teleport 的序号
+    };
+
+    struct MonsterState
+    {
+        MonsterSpec spec;
+        float cooldown;
+        uint32_t teleportSequence;
+    };
+
+    /**
+     * @brief 回退通道：只在主线程访问，由 performFunctionInCocosThread 的回调写入
+     *
+     * 用 shared_ptr 持有，模拟对象销毁后尚未执行的回调仍然安全。
+     */
+    struct MainThreadInbox
+    {
+        std::vector<AttackEvent> attacks;
+        Snapshot snapshot;
+        bool hasSnapshot = false;
+    };
+
+    void pushCommand(const Command& command);
+    void run();
+    void tick();
+    void applyCommand(const Command& command);
+    void updateMonster(MonsterState& monster);
+    bool isWalkable(const cocos2d::Vec2& position) const;
+    void publishSnapshot();
+    void postAttack(int id);
+
+    // 可行走网格（构造后只有工作线程修改）
+    std::vector<uint8_t> walkable_;
+    int gridWidth_;
+    int gridHeight_;
+    cocos2d::Size tileSize_;
+    cocos2d::Size mapPixelSize_;
+
+    // 工作线程状态
+    std::vector<MonsterState> monsters_;
+    cocos2d::Vec2 playerPosition_;
+    uint32_t tick_;
+    uint32_t lastInputTick_;                    // 最近一次收到玩家位置的步数
+    float step_;
+
+    // 线程间通道
+    SpscQueue<Command, 1024> commands_;
+    SpscQueue<AttackEvent, 256> attacks_;
+    SnapshotBuffer<Snapshot> snapshots_;
+    bool lockFree_;
+    std::shared_ptr<MainThreadInbox> inbox_;
+    std::vector<Command> pendingCommands_;      // 主线程：队列满时暂存的命令
+    uint32_t teleportSequence_;                 // 主线程：最近一次传送的序号
+    std::unordered_map<int, uint32_t> sentTeleports_;  // 主线程：每个怪物最近一次传送的序号
+
+    std::atomic<bool> running_;
+    std::thread thread_;
+};
+
+#endif // __MONSTER_SIMULATION_H__
@@ -1,4 +1,5 @@
 ﻿#include "Npc.h"
+#include "GameRandom.h"
 
 USING_NS_CC;
 
@@ -30,7 +31,7 @@ bool Npc::init(const std::string& name, const std::string& spriteFile, NpcType t
 std::string Npc::getDialogue() const {
     if (dialogues_.empty()) return "...";
     // Random dialogue
-    int idx = cocos2d::random(0, static_cast<int>(dialogues_.size()) - 1);
+    int idx = GameRandom::getInstance()->nextInt(0, static_cast<int>(dialogues_.size()) - 1);
     return dialogues_[idx];
 }
 
@@ -171,6 +171,7 @@ bool Player::init()
     isExhausted_ = false;
 
     this->scheduleUpdate();
+    this->scheduleFixedUpdate();
 
     return true;
 }
@@ -577,10 +578,21 @@ void Player::stopFishingAnimation()
 
 void Player::update(float delta)
 {
+    updateAnimationState();
+
+    // 显示位置在最近两个模拟步之间插值；直接调用基类的浮点版本，不经过会重置模拟状态的重写
+    Vec2 displayPosition = body_.lerp(_scheduler->getFixedStepAlpha());
+    Sprite::setPosition(displayPosition.x, displayPosition.y);
+}
+
+void Player::fixedUpdate(float step)
+{
+    body_.beginStep();
+
     // 更新无敌时间
     if (isInvulnerable_)
     {
-        invulnerableTimer_ -= delta;
+        invulnerableTimer_ -= step;
         if (invulnerableTimer_ <= 0)
         {
             isInvulnerable_ = false;
@@ -589,6 +601,28 @@ void Player::update(float delta)
         }
     }
 
+    // 攻击和钓鱼动画期间不移动
+    if (isMoving_ && !isAttacking_ && !isFishingAnim_)
+    {
+        updateMovement(step);
+    }
+}
+
+// Node::setPosition(Vec2) 会转调虚函数 setPosition(x, y)，两个重写都只调用基类的浮点版本
+void Player::setPosition(const Vec2& position)
+{
+    body_.snap(position);
+    Sprite::setPosition(position.x, position.y);
+}
+
+void Player::setPosition(float x, float y)
+{
+    body_.snap(Vec2(x, y));
+    Sprite::setPosition(x, y);
+}
+
+void Player::updateAnimationState()
+{
     // ========== 攻击状态优先级最高 ==========
     // 如果正在攻击，不处理移动
     if (isFishingAnim_) {
@@ -646,8 +680,7 @@ void Player::update(float delta)
             playAnimation((dir.x > 0) ? PlayerState::WALK_RIGHT : PlayerState::WALK_LEFT);
         }
 
-        // 执行物理移动
-        updateMovement(delta);
+        // 物理移动在 fixedUpdate 中执行
     }
     else
     {
@@ -658,7 +691,7 @@ void Player::update(float delta)
 
 void Player::updateMovement(float delta)
 {
-    Vec2 currentPos = this->getPosition();
+    Vec2 currentPos = body_.current;
     Vec2 direction = moveDirection_;
     if (direction.lengthSquared() > 0)
         direction.normalize();
@@ -680,7 +713,7 @@ void Player::updateMovement(float delta)
                 if (farmManager_->getStorageChestAt(tileCoord)) {
                     // 【修复】如果不允许穿过，那如果自己就在箱子里（刚放置时），会被卡死
                     // 解决方案：如果当前位置也在也就是同一个箱子里，允许移动（为了能走出来）
-                    Vec2 currentTile = mapLayer_->positionToTileCoord(this->getPosition());
+                    Vec2 currentTile = mapLayer_->positionToTileCoord(body_.current);
                     currentTile.x = std::round(currentTile.x);
                     currentTile.y = std::round(currentTile.y);
                     
@@ -696,7 +729,7 @@ void Player::updateMovement(float delta)
         // 1. 尝试直接移动到目标位置
         if (checkCollision(nextPos))
         {
-            this->setPosition(nextPos);
+            body_.current = nextPos;
         }
         else
         {
@@ -705,7 +738,7 @@ void Player::updateMovement(float delta)
             Vec2 nextPosX = currentPos + Vec2(direction.x * moveSpeed_ * delta, 0);
             if (checkCollision(nextPosX) && std::abs(direction.x) > 0.1f)
             {
-                this->setPosition(nextPosX);
+                body_.current = nextPosX;
             }
             else
             {
@@ -713,7 +746,7 @@ void Player::updateMovement(float delta)
                 Vec2 nextPosY = currentPos + Vec2(0, direction.y * moveSpeed_ * delta);
                 if (checkCollision(nextPosY) && std::abs(direction.y) > 0.1f)
                 {
-                    this->setPosition(nextPosY);
+                    body_.current = nextPosY;
                 }
             }
         }
@@ -721,7 +754,7 @@ void Player::updateMovement(float delta)
     else
     {
         // 如果没有地图层，直接移动不检测碰撞
-        this->setPosition(nextPos);
+        body_.current = nextPos;
     }
 }
 
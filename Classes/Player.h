@@ -3,6 +3,7 @@
 
 #include "cocos2d.h"
 #include "InventoryManager.h"
+#include "InterpolatedPosition.h"
 #include <functional>
 
 // 前向声明，告诉编译器 MapLayer 类的存在
@@ -22,9 +23,23 @@ public:
     // 析构函数：用于清理 retain 的动画对象
     virtual ~Player();
 
-    // 每帧更新
+    // 每帧更新：输入、动画和插值后的显示位置
     virtual void update(float delta) override;
 
+    // 固定步长更新：移动和无敌计时
+    virtual void fixedUpdate(float step) override;
+
+    /**
+     * @brief 设置位置（传送），同时重置模拟位置，不做插值
+     */
+    virtual void setPosition(const cocos2d::Vec2& position) override;
+    virtual void setPosition(float x, float y) override;
+
+    /**
+     * @brief 获取模拟位置（最近一个模拟步的结果，显示位置可能落后不到一步）
+     */
+    const cocos2d::Vec2& getSimulationPosition() const { return body_.current; }
+
     /**
      * @brief 启用/禁用键盘控制
      */
@@ -192,6 +207,11 @@ private:
 
     // 物理移动计算
     void updateMovement(float delta);
+
+    // 输入和动画状态机
+    void updateAnimationState();
+
+    InterpolatedPosition body_;          // 模拟位置
 };
 
 #endif // __PLAYER_H__
@@ -1,4 +1,5 @@
 #include "QuantityPopup.h"
+#include "GameFont.h"
 
 USING_NS_CC;
 
@@ -53,21 +54,21 @@ void QuantityPopup::createUI()
     panel->setPosition(center);
     this->addChild(panel);
 
-    titleLabel_ = Label::createWithSystemFont("Enter Quantity", "Arial", 20);
+    titleLabel_ = GameFont::createLabel("Enter Quantity", 20);
     titleLabel_->setPosition(Vec2(center.x, center.y + 60));
     this->addChild(titleLabel_);
 
-    auto subTitle = Label::createWithSystemFont(StringUtils::format("(Max: %d)", maxVal_), "Arial", 14);
+    auto subTitle = GameFont::createLabel(StringUtils::format("(Max: %d)", maxVal_), 14);
     subTitle->setPosition(Vec2(center.x, center.y + 35));
     subTitle->setColor(Color3B::GRAY);
     this->addChild(subTitle);
 
-    inputLabel_ = Label::createWithSystemFont(inputText_, "Arial", 32);
+    inputLabel_ = GameFont::createLabel(inputText_, 32);
     inputLabel_->setPosition(center);
     inputLabel_->setColor(Color3B::YELLOW);
     this->addChild(inputLabel_);
 
-    auto hint = Label::createWithSystemFont("Press ENTER to Confirm\nESC to Cancel", "Arial", 12);
+    auto hint = GameFont::createLabel("Press ENTER to Confirm\nESC to Cancel", 12);
     hint->setPosition(Vec2(center.x, center.y - 60));
     hint->setAlignment(TextHAlignment::CENTER);
     this->addChild(hint);
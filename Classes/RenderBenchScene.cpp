@@ -0,0 +1,126 @@
+#include "RenderBenchScene.h"
+#include "GameFont.h"
+#include "MenuScene.h"
+#include <chrono>
+
+USING_NS_CC;
+
+namespace {
+    const int kCommandCount = 20000;   // 每帧提交的命令数
+    const int kFrameCount = 200;       // 每种模式模拟的帧数
+
+    // 与游戏中实际使用的 globalZ 一致，另加少量负值与小数 Z
+    const float kGlobalZOrders[] = { 1000.0f, 1100.0f, 2000.0f, 2200.0f, 3000.0f, -1.0f, -10.0f, 0.5f };
+
+    /**
+     * @brief 只有一种整数 Z 再混入小数 Z（5, 5.5, 5）的队列也必须排序
+     */
+    bool checkSingleIntegerZWithFraction()
+    {
+        std::vector<CustomCommand> commands(3);
+        commands[0].init(5.0f);
+        commands[1].init(5.5f);
+        commands[2].init(5.0f);
+
+        RenderQueue queue;
+        queue.setZOrderBucketing(true);
+        for (auto& command : commands)
+            queue.push_back(&command);
+        queue.sort();
+
+        return queue.size() == 3 && queue[0] == &commands[0] && queue[1] == &commands[2] && queue[2] == &commands[1];
+    }
+}
+
+Scene* RenderBenchScene::createScene()
+{
+    return RenderBenchScene::create();
+}
+
+bool RenderBenchScene::init()
+{
+    if (!Scene::init())
+        return false;
+
+    auto visibleSize = Director::getInstance()->getVisibleSize();
+    Vec2 origin = Director::getInstance()->getVisibleOrigin();
+
+    resultLabel_ = GameFont::createLabel("Running render benchmark...", 24);
+    resultLabel_->setPosition(Vec2(origin.x + visibleSize.width * 0.5f, origin.y + visibleSize.height * 0.5f));
+    this->addChild(resultLabel_);
+
+    auto listener = EventListenerKeyboard::create();
+    listener->onKeyPressed = [](EventKeyboard::KeyCode keyCode, Event*) {
+        if (keyCode == EventKeyboard::KeyCode::KEY_ESCAPE)
+            Director::getInstance()->replaceScene(MenuScene::createScene());
+    };
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
+
+    // 让标签先显示一帧再开始测试
+    this->scheduleOnce([this](float) { runBenchmark(); }, 0.1f, "render_bench");
+
+    return true;
+}
+
+double RenderBenchScene::runPass(bool bucketing, std::vector<RenderCommand*>& order)
+{
+    RenderQueue queue;
+    queue.setZOrderBucketing(bucketing);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kFrameCount; ++frame)
+    {
+        queue.clear();
+        for (auto& command : commands_)
+            queue.push_back(&command);
+        queue.sort();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    order.clear();
+    for (ssize_t i = 0; i < queue.size(); ++i)
+        order.push_back(queue[i]);
+
+    return std::chrono::duration<double, std::micro>(elapsed).count() / kFrameCount;
+}
+
+void RenderBenchScene::runBenchmark()
+{
+    // 固定种子，保证两次运行的数据相同
+    std::srand(20251218);
+    commands_ = std::vector<CustomCommand>(kCommandCount);
+    const int zCount = sizeof(kGlobalZOrders) / sizeof(kGlobalZOrders[0]);
+    for (auto& command : commands_)
+    {
+        // 大部分命令是 globalZ = 0 的地图/作物精灵
+        float z = (std::rand() % 4 == 0) ? kGlobalZOrders[std::rand() % zCount] : 0.0f;
+        command.init(z);
+    }
+
+    // 全整数 Z 与混入小数 Z 两种情况各跑一遍
+    std::vector<RenderCommand*> sortedOrder, bucketedOrder;
+    double sortedUs = runPass(false, sortedOrder);
+    double bucketedUs = runPass(true, bucketedOrder);
+    bool sameOrder = sortedOrder == bucketedOrder;
+
+    for (auto& command : commands_)
+    {
+        if (command.getGlobalOrder() == 0.5f)
+            command.init(0.0f);
+    }
+    std::vector<RenderCommand*> sortedIntOrder, bucketedIntOrder;
+    double sortedIntUs = runPass(false, sortedIntOrder);
+    double bucketedIntUs = runPass(true, bucketedIntOrder);
+    sameOrder = sameOrder && sortedIntOrder == bucketedIntOrder;
+    sameOrder = sameOrder && checkSingleIntegerZWithFraction();
+
+    auto text = StringUtils::format(
+        "%d commands x %d frames\n"
+        "mixed Z    stable_sort: %.1f us/frame  bucketed: %.1f us/frame\n"
+        "integer Z  stable_sort: %.1f us/frame  bucketed: %.1f us/frame\n"
+        "order %s\n\nESC: back to menu",
+        kCommandCount, kFrameCount, sortedUs, bucketedUs, sortedIntUs, bucketedIntUs,
+        sameOrder ? "identical" : "MISMATCH");
+    resultLabel_->setString(text);
+    CCLOG("Render benchmark:\n%s", text.c_str());
+}
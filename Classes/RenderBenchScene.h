@@ -0,0 +1,38 @@
+#ifndef __RENDER_BENCH_SCENE_H__
+#define __RENDER_BENCH_SCENE_H__
+
+#include "cocos2d.h"
+
+/**
+ * @brief 渲染提交基准测试场景
+ *
+ * 用与游戏相同的 globalZ 分布（UI 层 1000/1100、电梯 2000、商店 2200、弹窗 3000 等）
+ * 构造大量 RenderCommand，分别用 stable_sort 和 z-order 分桶两种模式
+ * 执行 push_back + sort，比较每帧的提交耗时，并校验两种模式的顺序一致。
+ *
+ * 在 AppDelegate 中定义 RUN_RENDER_BENCHMARK 即可作为启动场景运行。
+ */
+class RenderBenchScene : public cocos2d::Scene
+{
+public:
+    static cocos2d::Scene* createScene();
+    virtual bool init() override;
+
+    CREATE_FUNC(RenderBenchScene);
+
+private:
+    /**
+     * @brief 执行一轮基准测试
+     * @param bucketing 是否启用 z-order 分桶
+     * @param order 输出排序后的命令顺序（用于校验）
+     * @return 平均每帧耗时（微秒）
+     */
+    double runPass(bool bucketing, std::vector<cocos2d::RenderCommand*>& order);
+
+    void runBenchmark();
+
+    std::vector<cocos2d::CustomCommand> commands_;
+    cocos2d::Label* resultLabel_{ nullptr };
+};
+
+#endif // __RENDER_BENCH_SCENE_H__
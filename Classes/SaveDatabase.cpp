@@ -0,0 +1,501 @@
+#include "SaveDatabase.h"
+
+#if SAVE_USE_SQLITE
+
+#include <sqlite3.h>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <utility>
+
+USING_NS_CC;
+
+namespace {
+    // 表结构版本，写在 PRAGMA user_version 里
+    const int kSchemaVersion = 2;
+
+    const char* const kCreateTables =
+        "CREATE TABLE IF NOT EXISTS meta(key TEXT PRIMARY KEY, value REAL NOT NULL);"
+        "CREATE TABLE IF NOT EXISTS inventory_slots(slot INTEGER PRIMARY KEY, type INTEGER NOT NULL, count INTEGER NOT NULL);"
+        "CREATE TABLE IF NOT EXISTS farm_tiles(x INTEGER NOT NULL, y INTEGER NOT NULL,"
+        " tilled INTEGER NOT NULL, watered INTEGER NOT NULL, has_crop INTEGER NOT NULL,"
+        " crop_id INTEGER NOT NULL, stage INTEGER NOT NULL, progress_days INTEGER NOT NULL,"
+        " PRIMARY KEY(x, y));"
+        "CREATE TABLE IF NOT EXISTS chests(x INTEGER NOT NULL, y INTEGER NOT NULL, PRIMARY KEY(x, y));"
+        "CREATE TABLE IF NOT EXISTS chest_slots(chest_x INTEGER NOT NULL, chest_y INTEGER NOT NULL,"
+        " slot INTEGER NOT NULL, type INTEGER NOT NULL, count INTEGER NOT NULL,"
+        " PRIMARY KEY(chest_x, chest_y, slot));"
+        "CREATE TABLE IF NOT EXISTS skills(type INTEGER PRIMARY KEY, level INTEGER NOT NULL, action_count INTEGER NOT NULL);"
+        "CREATE TABLE IF NOT EXISTS mine_floors(floor INTEGER PRIMARY KEY, chest_opened_week INTEGER NOT NULL);"
+        // base_id 为 0 的是完整快照，否则是相对该完整快照的增量
+        "CREATE TABLE IF NOT EXISTS checkpoints(id INTEGER PRIMARY KEY AUTOINCREMENT, base_id INTEGER NOT NULL,"
+        " day INTEGER NOT NULL, saved_at INTEGER NOT NULL, data BLOB NOT NULL);";
+
+    const char* const kClearTables =
+        "DELETE FROM meta;"
+        "DELETE FROM inventory_slots;"
+        "DELETE FROM farm_tiles;"
+        "DELETE FROM chests;"
+        "DELETE FROM chest_slots;"
+        "DELETE FROM skills;"
+        "DELETE FROM mine_floors;";
+
+    // 与 SaveDatabase::Statement 一一对应
+    const char* const kStatements[] = {
+        "BEGIN;",
+        "COMMIT;",
+        "ROLLBACK;",
+        "SELECT key, value FROM meta;",
+        "INSERT OR REPLACE INTO meta(key, value) VALUES(?, ?);",
+        "SELECT slot, type, count FROM inventory_slots ORDER BY slot;",
+        "INSERT OR REPLACE INTO inventory_slots(slot, type, count) VALUES(?, ?, ?);",
+        "DELETE FROM inventory_slots WHERE slot >= ?;",
+        "SELECT x, y, tilled, watered, has_crop, crop_id, stage, progress_days FROM farm_tiles;",
+        "INSERT OR REPLACE INTO farm_tiles(x, y, tilled, watered, has_crop, crop_id, stage, progress_days)"
+        " VALUES(?, ?, ?, ?, ?, ?, ?, ?);",
+        "DELETE FROM farm_tiles WHERE x = ? AND y = ?;",
+        "SELECT x, y FROM chests ORDER BY rowid;",
+        "INSERT OR IGNORE INTO chests(x, y) VALUES(?, ?);",
+        "DELETE FROM chests WHERE x = ? AND y = ?;",
+        "SELECT chest_x, chest_y, slot, type, count FROM chest_slots ORDER BY chest_x, chest_y, slot;",
+        "INSERT OR REPLACE INTO chest_slots(chest_x, chest_y, slot, type, count) VALUES(?, ?, ?, ?, ?);",
+        "DELETE FROM chest_slots WHERE chest_x = ? AND chest_y = ? AND slot >= ?;",
+        "SELECT type, level, action_count FROM skills ORDER BY type;",
+        "INSERT OR REPLACE INTO skills(type, level, action_count) VALUES(?, ?, ?);",
+        "SELECT floor, chest_opened_week FROM mine_floors ORDER BY floor;",
+        "INSERT OR REPLACE INTO mine_floors(floor, chest_opened_week) VALUES(?, ?);",
+        "DELETE FROM mine_floors WHERE floor = ?;",
+        "INSERT INTO checkpoints(base_id, day, saved_at, data) VALUES(?, ?, ?, ?);",
+        "SELECT base_id, data FROM checkpoints WHERE id = ?;",
+        "SELECT id, base_id, day, saved_at, length(data) FROM checkpoints ORDER BY id DESC;",
+        "SELECT id, (SELECT COUNT(*) FROM checkpoints AS later WHERE later.id > checkpoints.id)"
+        " FROM checkpoints WHERE base_id = 0 ORDER BY id DESC LIMIT 1;",
+        // 最新的 N 个检查点以及它们引用的完整快照都要保留，比其中最早的还旧的全部删除
+        "DELETE FROM checkpoints WHERE id < (SELECT MIN(CASE WHEN base_id = 0 THEN id ELSE base_id END)"
+        " FROM (SELECT id, base_id FROM checkpoints ORDER BY id DESC LIMIT ?));",
+    };
+}
+
+SaveDatabase::SaveDatabase()
+: db_(nullptr)
+{
+    memset(statements_, 0, sizeof(statements_));
+    static_assert(sizeof(kStatements) / sizeof(kStatements[0]) == STATEMENT_COUNT,
+                  "kStatements must match SaveDatabase::Statement");
+}
+
+SaveDatabase::~SaveDatabase()
+{
+    close();
+}
+
+bool SaveDatabase::open(const std::string& path)
+{
+    close();
+
+    if (sqlite3_open(path.c_str(), &db_) != SQLITE_OK)
+    {
+        CCLOG("SaveDatabase: failed to open %s: %s", path.c_str(), db_ ? sqlite3_errmsg(db_) : "out of memory");
+        close();
+        return false;
+    }
+
+    // WAL 模式下提交只追加日志，频繁的小存档不必每次重写整页
+    exec("PRAGMA journal_mode=WAL;");
+    exec("PRAGMA synchronous=NORMAL;");
+    if (!exec(kCreateTables))
+    {
+        close();
+        return false;
+    }
+
+    char versionSql[64];
+    snprintf(versionSql, sizeof(versionSql), "PRAGMA user_version=%d;", kSchemaVersion);
+    exec(versionSql);
+
+    for (int i = 0; i < STATEMENT_COUNT; ++i)
+    {
+        if (sqlite3_prepare_v2(db_, kStatements[i], -1, &statements_[i], nullptr) != SQLITE_OK)
+        {
+            CCLOG("SaveDatabase: failed to prepare \"%s\": %s", kStatements[i], sqlite3_errmsg(db_));
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void SaveDatabase::close()
+{
+    for (auto& stmt : statements_)
+    {
+        if (stmt)
+        {
+            sqlite3_finalize(stmt);
+            stmt = nullptr;
+        }
+    }
+    if (db_)
+    {
+        sqlite3_close(db_);
+        db_ = nullptr;
+    }
+}
+
+bool SaveDatabase::exec(const char* sql)
+{
+    char* error = nullptr;
+    if (sqlite3_exec(db_, sql, nullptr, nullptr, &error) != SQLITE_OK)
+    {
+        CCLOG("SaveDatabase: %s", error ? error : "unknown error");
+        sqlite3_free(error);
+        return false;
+    }
+    return true;
+}
+
+sqlite3_stmt* SaveDatabase::prepared(Statement statement)
+{
+    sqlite3_stmt* stmt = statements_[statement];
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return stmt;
+}
+
+bool SaveDatabase::run(sqlite3_stmt* stmt)
+{
+    int result = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    if (result != SQLITE_DONE)
+    {
+        CCLOG("SaveDatabase: \"%s\" failed: %s", sqlite3_sql(stmt), sqlite3_errmsg(db_));
+        return false;
+    }
+    return true;
+}
+
+bool SaveDatabase::hasSave()
+{
+    // 每次保存都会写入天数
+    sqlite3_stmt* stmt = prepared(SELECT_META);
+    bool found = false;
+    while (!found && sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        const char* key = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        found = key && strcmp(key, "day_count") == 0;
+    }
+    sqlite3_reset(stmt);
+    return found;
+}
+
+bool SaveDatabase::readAll(SaveManager::SaveData& data)
+{
+    sqlite3_stmt* stmt = prepared(SELECT_META);
+    data.playerPosition = Vec2::ZERO;
+    data.inventory.money = 0;
+    data.dayCount = 1;
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        const char* key = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        double value = sqlite3_column_double(stmt, 1);
+        if (!key) continue;
+        if (strcmp(key, "player_x") == 0) data.playerPosition.x = (float)value;
+        else if (strcmp(key, "player_y") == 0) data.playerPosition.y = (float)value;
+        else if (strcmp(key, "money") == 0) data.inventory.money = (int)value;
+        else if (strcmp(key, "day_count") == 0) data.dayCount = (int)value;
+    }
+    sqlite3_reset(stmt);
+
+    data.inventory.slots.clear();
+    stmt = prepared(SELECT_INVENTORY);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        int slot = sqlite3_column_int(stmt, 0);
+        if (slot < 0) continue;
+        // 槽位按下标保存，缺失的下标补成空槽
+        SaveManager::SaveData::InventoryData::ItemSlotData empty = { static_cast<int>(ItemType::ITEM_NONE), 0 };
+        if ((int)data.inventory.slots.size() <= slot)
+        {
+            data.inventory.slots.resize(slot + 1, empty);
+        }
+        data.inventory.slots[slot].type = sqlite3_column_int(stmt, 1);
+        data.inventory.slots[slot].count = sqlite3_column_int(stmt, 2);
+    }
+    sqlite3_reset(stmt);
+
+    data.farmTiles.clear();
+    stmt = prepared(SELECT_TILES);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        SaveManager::SaveData::FarmTileData tile;
+        tile.x = sqlite3_column_int(stmt, 0);
+        tile.y = sqlite3_column_int(stmt, 1);
+        tile.tilled = sqlite3_column_int(stmt, 2) != 0;
+        tile.watered = sqlite3_column_int(stmt, 3) != 0;
+        tile.hasCrop = sqlite3_column_int(stmt, 4) != 0;
+        tile.cropId = sqlite3_column_int(stmt, 5);
+        tile.stage = sqlite3_column_int(stmt, 6);
+        tile.progressDays = sqlite3_column_int(stmt, 7);
+        data.farmTiles.push_back(tile);
+    }
+    sqlite3_reset(stmt);
+
+    data.storageChests.clear();
+    std::map<std::pair<int, int>, size_t> chestIndex;
+    stmt = prepared(SELECT_CHESTS);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        SaveManager::SaveData::StorageChestData chest;
+        chest.x = sqlite3_column_int(stmt, 0);
+        chest.y = sqlite3_column_int(stmt, 1);
+        chestIndex[std::make_pair(chest.x, chest.y)] = data.storageChests.size();
+        data.storageChests.push_back(chest);
+    }
+    sqlite3_reset(stmt);
+
+    stmt = prepared(SELECT_CHEST_SLOTS);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        auto it = chestIndex.find(std::make_pair(sqlite3_column_int(stmt, 0), sqlite3_column_int(stmt, 1)));
+        int slot = sqlite3_column_int(stmt, 2);
+        if (it == chestIndex.end() || slot < 0) continue;
+
+        auto& slots = data.storageChests[it->second].slots;
+        SaveManager::SaveData::StorageChestData::SlotData empty = { static_cast<int>(ItemType::ITEM_NONE), 0 };
+        if ((int)slots.size() <= slot)
+        {
+            slots.resize(slot + 1, empty);
+        }
+        slots[slot].type = sqlite3_column_int(stmt, 3);
+        slots[slot].count = sqlite3_column_int(stmt, 4);
+    }
+    sqlite3_reset(stmt);
+
+    data.skills.clear();
+    stmt = prepared(SELECT_SKILLS);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        SaveManager::SaveData::SkillData skill;
+        skill.type = sqlite3_column_int(stmt, 0);
+        skill.level = sqlite3_column_int(stmt, 1);
+        skill.actionCount = sqlite3_column_int(stmt, 2);
+        data.skills.push_back(skill);
+    }
+    sqlite3_reset(stmt);
+
+    data.mineFloors.clear();
+    stmt = prepared(SELECT_MINE_FLOORS);
+    int result;
+    while ((result = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        SaveManager::SaveData::MineFloorData floor;
+        floor.floor = sqlite3_column_int(stmt, 0);
+        floor.chestOpenedWeek = sqlite3_column_int(stmt, 1);
+        data.mineFloors.push_back(floor);
+    }
+    sqlite3_reset(stmt);
+
+    if (result != SQLITE_DONE)
+    {
+        CCLOG("SaveDatabase: failed to read save: %s", sqlite3_errmsg(db_));
+        return false;
+    }
+    return true;
+}
+
+bool SaveDatabase::beginTransaction()
+{
+    return run(prepared(BEGIN));
+}
+
+bool SaveDatabase::commit()
+{
+    return run(prepared(COMMIT));
+}
+
+void SaveDatabase::rollback()
+{
+    run(prepared(ROLLBACK));
+}
+
+bool SaveDatabase::clearAll()
+{
+    return exec(kClearTables);
+}
+
+bool SaveDatabase::writeMeta(const char* key, double value)
+{
+    sqlite3_stmt* stmt = prepared(REPLACE_META);
+    sqlite3_bind_text(stmt, 1, key, -1, SQLITE_STATIC);
+    sqlite3_bind_double(stmt, 2, value);
+    return run(stmt);
+}
+
+bool SaveDatabase::writeInventorySlot(int slot, const SaveManager::SaveData::InventoryData::ItemSlotData& data)
+{
+    sqlite3_stmt* stmt = prepared(REPLACE_INVENTORY);
+    sqlite3_bind_int(stmt, 1, slot);
+    sqlite3_bind_int(stmt, 2, data.type);
+    sqlite3_bind_int(stmt, 3, data.count);
+    return run(stmt);
+}
+
+bool SaveDatabase::deleteInventorySlotsFrom(int slot)
+{
+    sqlite3_stmt* stmt = prepared(DELETE_INVENTORY_FROM);
+    sqlite3_bind_int(stmt, 1, slot);
+    return run(stmt);
+}
+
+bool SaveDatabase::writeFarmTile(const SaveManager::SaveData::FarmTileData& tile)
+{
+    sqlite3_stmt* stmt = prepared(REPLACE_TILE);
+    sqlite3_bind_int(stmt, 1, tile.x);
+    sqlite3_bind_int(stmt, 2, tile.y);
+    sqlite3_bind_int(stmt, 3, tile.tilled ? 1 : 0);
+    sqlite3_bind_int(stmt, 4, tile.watered ? 1 : 0);
+    sqlite3_bind_int(stmt, 5, tile.hasCrop ? 1 : 0);
+    sqlite3_bind_int(stmt, 6, tile.cropId);
+    sqlite3_bind_int(stmt, 7, tile.stage);
+    sqlite3_bind_int(stmt, 8, tile.progressDays);
+    return run(stmt);
+}
+
+bool SaveDatabase::deleteFarmTile(int x, int y)
+{
+    sqlite3_stmt* stmt = prepared(DELETE_TILE);
+    sqlite3_bind_int(stmt, 1, x);
+    sqlite3_bind_int(stmt, 2, y);
+    return run(stmt);
+}
+
+bool SaveDatabase::writeChest(int x, int y)
+{
+    sqlite3_stmt* stmt = prepared(INSERT_CHEST);
+    sqlite3_bind_int(stmt, 1, x);
+    sqlite3_bind_int(stmt, 2, y);
+    return run(stmt);
+}
+
+bool SaveDatabase::deleteChest(int x, int y)
+{
+    sqlite3_stmt* stmt = prepared(DELETE_CHEST);
+    sqlite3_bind_int(stmt, 1, x);
+    sqlite3_bind_int(stmt, 2, y);
+    return run(stmt) && deleteChestSlotsFrom(x, y, 0);
+}
+
+bool SaveDatabase::writeChestSlot(int x, int y, int slot, const SaveManager::SaveData::StorageChestData::SlotData& data)
+{
+    sqlite3_stmt* stmt = prepared(REPLACE_CHEST_SLOT);
+    sqlite3_bind_int(stmt, 1, x);
+    sqlite3_bind_int(stmt, 2, y);
+    sqlite3_bind_int(stmt, 3, slot);
+    sqlite3_bind_int(stmt, 4, data.type);
+    sqlite3_bind_int(stmt, 5, data.count);
+    return run(stmt);
+}
+
+bool SaveDatabase::deleteChestSlotsFrom(int x, int y, int slot)
+{
+    sqlite3_stmt* stmt = prepared(DELETE_CHEST_SLOTS_FROM);
+    sqlite3_bind_int(stmt, 1, x);
+    sqlite3_bind_int(stmt, 2, y);
+    sqlite3_bind_int(stmt, 3, slot);
+    return run(stmt);
+}
+
+bool SaveDatabase::writeSkill(const SaveManager::SaveData::SkillData& skill)
+{
+    sqlite3_stmt* stmt = prepared(REPLACE_SKILL);
+    sqlite3_bind_int(stmt, 1, skill.type);
+    sqlite3_bind_int(stmt, 2, skill.level);
+    sqlite3_bind_int(stmt, 3, skill.actionCount);
+    return run(stmt);
+}
+
+bool SaveDatabase::writeMineFloor(const SaveManager::SaveData::MineFloorData& floor)
+{
+    sqlite3_stmt* stmt = prepared(REPLACE_MINE_FLOOR);
+    sqlite3_bind_int(stmt, 1, floor.floor);
+    sqlite3_bind_int(stmt, 2, floor.chestOpenedWeek);
+    return run(stmt);
+}
+
+bool SaveDatabase::deleteMineFloor(int floor)
+{
+    sqlite3_stmt* stmt = prepared(DELETE_MINE_FLOOR);
+    sqlite3_bind_int(stmt, 1, floor);
+    return run(stmt);
+}
+
+bool SaveDatabase::writeCheckpoint(long long baseId, int dayCount, const std::string& blob, long long& id)
+{
+    sqlite3_stmt* stmt = prepared(INSERT_CHECKPOINT);
+    sqlite3_bind_int64(stmt, 1, baseId);
+    sqlite3_bind_int(stmt, 2, dayCount);
+    sqlite3_bind_int64(stmt, 3, static_cast<sqlite3_int64>(time(nullptr)));
+    sqlite3_bind_blob(stmt, 4, blob.data(), (int)blob.size(), SQLITE_STATIC);
+    if (!run(stmt))
+    {
+        return false;
+    }
+    id = sqlite3_last_insert_rowid(db_);
+    return true;
+}
+
+bool SaveDatabase::readCheckpoint(long long id, long long& baseId, std::string& blob)
+{
+    sqlite3_stmt* stmt = prepared(SELECT_CHECKPOINT);
+    sqlite3_bind_int64(stmt, 1, id);
+    bool found = sqlite3_step(stmt) == SQLITE_ROW;
+    if (found)
+    {
+        baseId = sqlite3_column_int64(stmt, 0);
+        const void* data = sqlite3_column_blob(stmt, 1);
+        blob.assign(static_cast<const char*>(data), data ? sqlite3_column_bytes(stmt, 1) : 0);
+    }
+    sqlite3_reset(stmt);
+    return found;
+}
+
+bool SaveDatabase::readLatestBase(long long& id, int& checkpointsSince)
+{
+    sqlite3_stmt* stmt = prepared(SELECT_LATEST_BASE);
+    bool found = sqlite3_step(stmt) == SQLITE_ROW;
+    if (found)
+    {
+        id = sqlite3_column_int64(stmt, 0);
+        checkpointsSince = sqlite3_column_int(stmt, 1);
+    }
+    sqlite3_reset(stmt);
+    return found;
+}
+
+bool SaveDatabase::listCheckpoints(std::vector<SaveManager::CheckpointInfo>& checkpoints)
+{
+    checkpoints.clear();
+    sqlite3_stmt* stmt = prepared(SELECT_CHECKPOINTS);
+    int result;
+    while ((result = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        SaveManager::CheckpointInfo info;
+        info.id = sqlite3_column_int64(stmt, 0);
+        info.full = sqlite3_column_int64(stmt, 1) == 0;
+        info.dayCount = sqlite3_column_int(stmt, 2);
+        info.savedAt = sqlite3_column_int64(stmt, 3);
+        info.bytes = sqlite3_column_int(stmt, 4);
+        checkpoints.push_back(info);
+    }
+    sqlite3_reset(stmt);
+    return result == SQLITE_DONE;
+}
+
+bool SaveDatabase::pruneCheckpoints(int keep)
+{
+    sqlite3_stmt* stmt = prepared(PRUNE_CHECKPOINTS);
+    sqlite3_bind_int(stmt, 1, keep);
+    return run(stmt);
+}
+
+#endif // SAVE_USE_SQLITE
@@ -0,0 +1,164 @@
+#ifndef __SAVE_DATABASE_H__
+#define __SAVE_DATABASE_H__
+
+#include "SaveManager.h"
+
+#if SAVE_USE_SQLITE
+
+#include <string>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+/**
+ * @brief SQLite 存档数据库
+ *
+ * 表结构：
+ * - meta：玩家位置、金币、天数等单个数值
+ * - inventory_slots：背包槽位
+ * - farm_tiles：有状态的农田瓦片，以坐标为主键
+ * - chests / chest_slots：储物箱及其槽位，以箱子坐标关联
+ * - skills：技能等级
+ * - mine_floors：矿洞各层状态（本周宝箱是否已开）
+ * - checkpoints：存档检查点，每次保存追加一个完整或增量快照（见 SaveSnapshot）
+ *
+ * 所有语句在打开数据库时预编译，之后只绑定参数执行。
+ * 写入方法不自己开事务，由调用者用 beginTransaction() / commit() 把一次保存包起来。
+ */
+class SaveDatabase
+{
+public:
+    SaveDatabase();
+    ~SaveDatabase();
+
+    /**
+     * @brief 打开（不存在则创建）数据库并建表、预编译语句
+     */
+    bool open(const std::string& path);
+
+    void close();
+
+    /**
+     * @brief 数据库里是否已经有存档
+     */
+    bool hasSave();
+
+    /**
+     * @brief 读出整份存档
+     */
+    bool readAll(SaveManager::SaveData& data);
+
+    bool beginTransaction();
+    bool commit();
+    void rollback();
+
+    /**
+     * @brief 清空所有表
+     */
+    bool clearAll();
+
+    bool writeMeta(const char* key, double value);
+
+    bool writeInventorySlot(int slot, const SaveManager::SaveData::InventoryData::ItemSlotData& data);
+    /**
+     * @brief 删除下标不小于 slot 的背包槽位
+     */
+    bool deleteInventorySlotsFrom(int slot);
+
+    bool writeFarmTile(const SaveManager::SaveData::FarmTileData& tile);
+    bool deleteFarmTile(int x, int y);
+
+    bool writeChest(int x, int y);
+    /**
+     * @brief 删除储物箱及其全部槽位
+     */
+    bool deleteChest(int x, int y);
+    bool writeChestSlot(int x, int y, int slot, const SaveManager::SaveData::StorageChestData::SlotData& data);
+    bool deleteChestSlotsFrom(int x, int y, int slot);
+
+    bool writeSkill(const SaveManager::SaveData::SkillData& skill);
+
+    bool writeMineFloor(const SaveManager::SaveData::MineFloorData& floor);
+    bool deleteMineFloor(int floor);
+
+    /**
+     * @brief 追加一个检查点
+     * @param baseId 增量快照所基于的完整快照，完整快照传 0
+     * @param id 输出参数，新检查点的 id
+     */
+    bool writeCheckpoint(long long baseId, int dayCount, const std::string& blob, long long& id);
+
+    /**
+     * @brief 读取检查点的快照数据和基准快照 id
+     */
+    bool readCheckpoint(long long id, long long& baseId, std::string& blob);
+
+    /**
+     * @brief 查找最新的完整快照，以及在它之后追加的检查点个数
+     * @return 还没有完整快照时返回 false
+     */
+    bool readLatestBase(long long& id, int& checkpointsSince);
+
+    /**
+     * @brief 列出全部检查点，从新到旧
+     */
+    bool listCheckpoints(std::vector<SaveManager::CheckpointInfo>& checkpoints);
+
+    /**
+     * @brief 只保留最新的 keep 个检查点（以及它们引用的完整快照）
+     */
+    bool pruneCheckpoints(int keep);
+
+private:
+    enum Statement
+    {
+        BEGIN,
+        COMMIT,
+        ROLLBACK,
+        SELECT_META,
+        REPLACE_META,
+        SELECT_INVENTORY,
+        REPLACE_INVENTORY,
+        DELETE_INVENTORY_FROM,
+        SELECT_TILES,
+        REPLACE_TILE,
+        DELETE_TILE,
+        SELECT_CHESTS,
+        INSERT_CHEST,
+        DELETE_CHEST,
+        SELECT_CHEST_SLOTS,
+        REPLACE_CHEST_SLOT,
+        DELETE_CHEST_SLOTS_FROM,
+        SELECT_SKILLS,
+        REPLACE_SKILL,
+        SELECT_MINE_FLOORS,
+        REPLACE_MINE_FLOOR,
+        DELETE_MINE_FLOOR,
+        INSERT_CHECKPOINT,
+        SELECT_CHECKPOINT,
+        SELECT_CHECKPOINTS,
+        SELECT_LATEST_BASE,
+        PRUNE_CHECKPOINTS,
+        STATEMENT_COUNT
+    };
+
+    /**
+     * @brief 取出预编译语句，重置后供绑定参数
+     */
+    sqlite3_stmt* prepared(Statement statement);
+
+    /**
+     * @brief 执行一条不返回行的语句
+     */
+    bool run(sqlite3_stmt* stmt);
+
+    bool exec(const char* sql);
+
+    sqlite3* db_;
+    sqlite3_stmt* statements_[STATEMENT_COUNT];
+};
+
+#endif // SAVE_USE_SQLITE
+
+#endif // __SAVE_DATABASE_H__
@@ -4,17 +4,53 @@
 #include "json/prettywriter.h"
 #include "platform/CCFileUtils.h"
 #include "SkillManager.h"
+#include "SaveDatabase.h"
+#include "SaveSnapshot.h"
+#include <unordered_map>
 
 USING_NS_CC;
 
 SaveManager* SaveManager::instance_ = nullptr;
 
+namespace {
+    /**
+     * @brief 槽位 0 沿用原来的文件名，其余槽位加上编号
+     */
+    std::string slotFileName(const char* name, const char* extension, int slot)
+    {
+        std::string fileName = name;
+        if (slot > 0)
+        {
+            fileName += "_" + std::to_string(slot);
+        }
+        return fileName + extension;
+    }
+}
+
+#if SAVE_USE_SQLITE
+struct SaveManager::CheckpointBase
+{
+    long long id;
+    size_t bytes;          // 完整快照编码后的大小
+    int checkpointsSince;  // 之后追加的增量检查点个数
+    SaveSnapshot::Records records;
+};
+#endif
+
 SaveManager::SaveManager()
+    : activeSlot_(0)
+#if SAVE_USE_SQLITE
+    , database_(nullptr)
+    , hasSavedData_(false)
+#endif
 {
 }
 
 SaveManager::~SaveManager()
 {
+#if SAVE_USE_SQLITE
+    delete database_;
+#endif
 }
 
 SaveManager* SaveManager::getInstance()
@@ -30,17 +66,41 @@ std::string SaveManager::getSaveFilePath() const
 {
     // 将存档保存在可写目录
     std::string writablePath = FileUtils::getInstance()->getWritablePath();
-    return writablePath + "savegame.json";
+    return writablePath + slotFileName("savegame", ".json", activeSlot_);
 }
 
 bool SaveManager::hasSaveFile() const
 {
+#if SAVE_USE_SQLITE
+    if (FileUtils::getInstance()->isFileExist(getDatabasePath()))
+    {
+        SaveDatabase* db = openDatabase();
+        if (db && db->hasSave())
+        {
+            return true;
+        }
+    }
+#endif
+    // 旧版 JSON 存档，加载时导入数据库
     std::string path = getSaveFilePath();
     return FileUtils::getInstance()->isFileExist(path);
 }
 
 void SaveManager::deleteSaveFile()
 {
+#if SAVE_USE_SQLITE
+    // 先关闭数据库再删文件，WAL 日志和共享内存文件一起删除
+    closeDatabase();
+    std::string dbPath = getDatabasePath();
+    for (const char* suffix : { "", "-wal", "-shm" })
+    {
+        if (FileUtils::getInstance()->isFileExist(dbPath + suffix))
+        {
+            FileUtils::getInstance()->removeFile(dbPath + suffix);
+        }
+    }
+#endif
+
     std::string path = getSaveFilePath();
     if (FileUtils::getInstance()->isFileExist(path))
     {
@@ -49,6 +109,30 @@ void SaveManager::deleteSaveFile()
     }
 }
 
+bool SaveManager::setActiveSlot(int slot)
+{
+    if (slot < 0 || slot >= kSlotCount)
+    {
+        CCLOG("Error: Invalid save slot %d", slot);
+        return false;
+    }
+    if (slot == activeSlot_)
+    {
+        return true;
+    }
+#if SAVE_USE_SQLITE
+    closeDatabase();
+#endif
+    activeSlot_ = slot;
+    CCLOG("Switched to save slot %d", slot);
+    return true;
+}
+
+int SaveManager::getActiveSlot() const
+{
+    return activeSlot_;
+}
+
 rapidjson::Document SaveManager::serializeToJson(const SaveData& data)
 {
     rapidjson::Document doc;
@@ -136,6 +220,17 @@ rapidjson::Document SaveManager::serializeToJson(const SaveData& data)
     }
     doc.AddMember("skills", skillsArray, allocator);
 
+    // 保存矿洞楼层数据
+    rapidjson::Value mineFloorsArray(rapidjson::kArrayType);
+    for (const auto& floor : data.mineFloors)
+    {
+        rapidjson::Value floorObj(rapidjson::kObjectType);
+        floorObj.AddMember("floor", floor.floor, allocator);
+        floorObj.AddMember("chestOpenedWeek", floor.chestOpenedWeek, allocator);
+        mineFloorsArray.PushBack(floorObj, allocator);
+    }
+    doc.AddMember("mineFloors", mineFloorsArray, allocator);
+
     return doc;
 }
 
@@ -260,6 +355,21 @@ bool SaveManager::deserializeFromJson(const rapidjson::Document& doc, SaveData&
              }
         }
 
+        // 加载矿洞楼层数据
+        data.mineFloors.clear();
+        if (doc.HasMember("mineFloors") && doc["mineFloors"].IsArray())
+        {
+            const auto& floorsArray = doc["mineFloors"].GetArray();
+            for (rapidjson::SizeType i = 0; i < floorsArray.Size(); i++)
+            {
+                const auto& floorObj = floorsArray[i];
+                SaveData::MineFloorData floor;
+                floor.floor = floorObj["floor"].GetInt();
+                floor.chestOpenedWeek = floorObj["chestOpenedWeek"].GetInt();
+                data.mineFloors.push_back(floor);
+            }
+        }
+
         // 树木存档已禁用（避免崩溃）
 
         return true;
@@ -277,6 +387,429 @@ bool SaveManager::deserializeFromJson(const rapidjson::Document& doc, SaveData&
 }
 
 bool SaveManager::saveGame(const SaveData& data)
+{
+#if SAVE_USE_SQLITE
+    return saveToDatabase(data);
+#else
+    return saveToJson(data);
+#endif
+}
+
+bool SaveManager::loadGame(SaveData& data)
+{
+#if SAVE_USE_SQLITE
+    SaveDatabase* db = openDatabase();
+    if (!db)
+    {
+        return false;
+    }
+
+    if (db->hasSave())
+    {
+        CCLOG("Loading game from: %s", getDatabasePath().c_str());
+        if (!db->readAll(data))
+        {
+            CCLOG("Error: Failed to read save database");
+            hasSavedData_ = false;
+            return false;
+        }
+        savedData_ = data;
+        hasSavedData_ = true;
+        CCLOG("Game loaded successfully!");
+        return true;
+    }
+
+    // 数据库里还没有存档：导入旧版 JSON 存档
+    if (!loadFromJson(data))
+    {
+        return false;
+    }
+    if (saveToDatabase(data))
+    {
+        CCLOG("Imported %s into the save database", getSaveFilePath().c_str());
+    }
+    return true;
+#else
+    return loadFromJson(data);
+#endif
+}
+
+#if SAVE_USE_SQLITE
+
+std::string SaveManager::getDatabasePath() const
+{
+    return FileUtils::getInstance()->getWritablePath() + slotFileName("savegame", ".db", activeSlot_);
+}
+
+void SaveManager::closeDatabase()
+{
+    delete database_;
+    database_ = nullptr;
+    hasSavedData_ = false;
+    checkpointBase_.reset();
+}
+
+SaveDatabase* SaveManager::openDatabase() const
+{
+    if (!database_)
+    {
+        database_ = new SaveDatabase();
+        if (!database_->open(getDatabasePath()))
+        {
+            CCLOG("Error: Failed to open save database: %s", getDatabasePath().c_str());
+            delete database_;
+            database_ = nullptr;
+        }
+    }
+    return database_;
+}
+
+namespace {
+    typedef SaveManager::SaveData SaveData;
+
+    // 每隔这么多个增量检查点写一次完整快照，按每小时自动存档约一天一次
+    const int kFullSnapshotInterval = 24;
+    // 每个槽位保留的检查点个数
+    const int kMaxCheckpoints = 72;
+
+    long long tileKey(int x, int y)
+    {
+        return (static_cast<long long>(x) << 32) | static_cast<unsigned int>(y);
+    }
+
+    bool isPersistedTile(const SaveData::FarmTileData& tile)
+    {
+        // 只保存有状态的瓦片（耕地或有作物）
+        return tile.tilled || tile.hasCrop;
+    }
+
+    bool sameTile(const SaveData::FarmTileData& a, const SaveData::FarmTileData& b)
+    {
+        return a.tilled == b.tilled && a.watered == b.watered && a.hasCrop == b.hasCrop
+            && a.cropId == b.cropId && a.stage == b.stage && a.progressDays == b.progressDays;
+    }
+
+    /**
+     * @brief 写入与 previous 相比变化的槽位，并删除多出来的槽位
+     */
+    template <typename Slot, typename WriteFunc, typename DeleteFunc>
+    bool writeSlotChanges(const std::vector<Slot>& slots, const std::vector<Slot>& previous,
+                          int& rows, WriteFunc write, DeleteFunc deleteFrom)
+    {
+        for (size_t i = 0; i < slots.size(); ++i)
+        {
+            if (i < previous.size() && slots[i].type == previous[i].type && slots[i].count == previous[i].count)
+            {
+                continue;
+            }
+            if (!write((int)i, slots[i])) return false;
+            ++rows;
+        }
+        if (previous.size() > slots.size())
+        {
+            if (!deleteFrom((int)slots.size())) return false;
+            rows += (int)(previous.size() - slots.size());
+        }
+        return true;
+    }
+
+    /**
+     * @brief 按行比较两份存档，只写入变化的行，返回写入（含删除）的行数，失败返回 -1
+     */
+    int writeChanges(SaveDatabase* db, const SaveData& data, const SaveData& previous, bool full)
+    {
+        int rows = 0;
+
+        // 元数据
+        struct MetaValue { const char* key; double value; double previous; };
+        const MetaValue meta[] = {
+            { "player_x", data.playerPosition.x, previous.playerPosition.x },
+            { "player_y", data.playerPosition.y, previous.playerPosition.y },
+            { "money", (double)data.inventory.money, (double)previous.inventory.money },
+            { "day_count", (double)data.dayCount, (double)previous.dayCount },
+        };
+        for (const auto& value : meta)
+        {
+            if (!full && value.value == value.previous) continue;
+            if (!db->writeMeta(value.key, value.value)) return -1;
+            ++rows;
+        }
+
+        // 背包槽位
+        if (!writeSlotChanges(data.inventory.slots, previous.inventory.slots, rows,
+                [db](int slot, const SaveData::InventoryData::ItemSlotData& s) { return db->writeInventorySlot(slot, s); },
+                [db](int slot) { return db->deleteInventorySlotsFrom(slot); }))
+        {
+            return -1;
+        }
+
+        // 农田瓦片：以坐标为键比较
+        std::unordered_map<long long, const SaveData::FarmTileData*> oldTiles;
+        for (const auto& tile : previous.farmTiles)
+        {
+            if (isPersistedTile(tile)) oldTiles[tileKey(tile.x, tile.y)] = &tile;
+        }
+        for (const auto& tile : data.farmTiles)
+        {
+            if (!isPersistedTile(tile)) continue;
+            auto it = oldTiles.find(tileKey(tile.x, tile.y));
+            bool unchanged = it != oldTiles.end() && sameTile(*it->second, tile);
+            if (it != oldTiles.end()) oldTiles.erase(it);
+            if (unchanged) continue;
+            if (!db->writeFarmTile(tile)) return -1;
+            ++rows;
+        }
+        for (const auto& it : oldTiles)
+        {
+            if (!db->deleteFarmTile(it.second->x, it.second->y)) return -1;
+            ++rows;
+        }
+
+        // 储物箱：以坐标为键，新箱子插入，槽位逐个比较
+        std::unordered_map<long long, const SaveData::StorageChestData*> oldChests;
+        for (const auto& chest : previous.storageChests)
+        {
+            oldChests[tileKey(chest.x, chest.y)] = &chest;
+        }
+        static const std::vector<SaveData::StorageChestData::SlotData> noSlots;
+        for (const auto& chest : data.storageChests)
+        {
+            auto it = oldChests.find(tileKey(chest.x, chest.y));
+            const auto* oldChest = it != oldChests.end() ? it->second : nullptr;
+            if (it != oldChests.end()) oldChests.erase(it);
+            if (!oldChest)
+            {
+                if (!db->writeChest(chest.x, chest.y)) return -1;
+                ++rows;
+            }
+            int x = chest.x;
+            int y = chest.y;
+            if (!writeSlotChanges(chest.slots, oldChest ? oldChest->slots : noSlots, rows,
+                    [db, x, y](int slot, const SaveData::StorageChestData::SlotData& s) { return db->writeChestSlot(x, y, slot, s); },
+                    [db, x, y](int slot) { return db->deleteChestSlotsFrom(x, y, slot); }))
+            {
+                return -1;
+            }
+        }
+        for (const auto& it : oldChests)
+        {
+            if (!db->deleteChest(it.second->x, it.second->y)) return -1;
+            ++rows;
+        }
+
+        // 技能
+        std::unordered_map<int, const SaveData::SkillData*> oldSkills;
+        for (const auto& skill : previous.skills)
+        {
+            oldSkills[skill.type] = &skill;
+        }
+        for (const auto& skill : data.skills)
+        {
+            auto it = oldSkills.find(skill.type);
+            if (it != oldSkills.end() && it->second->level == skill.level && it->second->actionCount == skill.actionCount)
+            {
+                continue;
+            }
+            if (!db->writeSkill(skill)) return -1;
+            ++rows;
+        }
+
+        // 矿洞楼层
+        std::unordered_map<int, const SaveData::MineFloorData*> oldFloors;
+        for (const auto& floor : previous.mineFloors)
+        {
+            oldFloors[floor.floor] = &floor;
+        }
+        for (const auto& floor : data.mineFloors)
+        {
+            auto it = oldFloors.find(floor.floor);
+            bool unchanged = it != oldFloors.end() && it->second->chestOpenedWeek == floor.chestOpenedWeek;
+            if (it != oldFloors.end()) oldFloors.erase(it);
+            if (unchanged) continue;
+            if (!db->writeMineFloor(floor)) return -1;
+            ++rows;
+        }
+        for (const auto& it : oldFloors)
+        {
+            if (!db->deleteMineFloor(it.first)) return -1;
+            ++rows;
+        }
+
+        return rows;
+    }
+}
+
+bool SaveManager::saveToDatabase(const SaveData& data, bool recordCheckpoint)
+{
+    SaveDatabase* db = openDatabase();
+    if (!db)
+    {
+        return false;
+    }
+
+    if (!db->beginTransaction())
+    {
+        return false;
+    }
+
+    // 不知道数据库里现有内容时（新游戏或上次保存失败）整份重写
+    bool full = !hasSavedData_;
+    SaveData empty = SaveData();
+    int rows = -1;
+    if (!full || db->clearAll())
+    {
+        rows = writeChanges(db, data, full ? empty : savedData_, full);
+    }
+
+    // 存档没有变化时不追加检查点，上一个检查点就是当前状态
+    bool checkpointed = recordCheckpoint && rows > 0;
+    if (rows < 0 || (checkpointed && !appendCheckpoint(db, data)) || !db->commit())
+    {
+        CCLOG("Error: Failed to write save database, rolling back");
+        db->rollback();
+        hasSavedData_ = false;
+        checkpointBase_.reset();
+        return false;
+    }
+
+    savedData_ = data;
+    hasSavedData_ = true;
+    CCLOG("Game saved successfully! (%d rows written%s)", rows, full ? ", full save" : "");
+    return true;
+}
+
+bool SaveManager::appendCheckpoint(SaveDatabase* db, const SaveData& data)
+{
+    if (!checkpointBase_)
+    {
+        // 本次运行第一次保存：读出最新的完整快照作为增量的基准
+        std::unique_ptr<CheckpointBase> base(new CheckpointBase());
+        long long unused = 0;
+        std::string blob;
+        if (db->readLatestBase(base->id, base->checkpointsSince)
+            && db->readCheckpoint(base->id, unused, blob)
+            && SaveSnapshot::decode(blob, base->records))
+        {
+            base->bytes = blob.size();
+            checkpointBase_ = std::move(base);
+        }
+    }
+
+    SaveSnapshot::Records records = SaveSnapshot::flatten(data);
+    std::string blob;
+    bool fullSnapshot = !checkpointBase_ || checkpointBase_->checkpointsSince >= kFullSnapshotInterval;
+    if (!fullSnapshot)
+    {
+        blob = SaveSnapshot::encodeDelta(checkpointBase_->records, records);
+        // 增量接近完整快照的大小时不如重新写一个基准
+        fullSnapshot = blob.size() * 2 > checkpointBase_->bytes;
+    }
+    if (fullSnapshot)
+    {
+        blob = SaveSnapshot::encodeFull(records);
+    }
+
+    long long id = 0;
+    if (!db->writeCheckpoint(fullSnapshot ? 0 : checkpointBase_->id, data.dayCount, blob, id))
+    {
+        return false;
+    }
+    if (fullSnapshot)
+    {
+        checkpointBase_.reset(new CheckpointBase());
+        checkpointBase_->id = id;
+        checkpointBase_->bytes = blob.size();
+        checkpointBase_->checkpointsSince = 0;
+        checkpointBase_->records = std::move(records);
+    }
+    else
+    {
+        ++checkpointBase_->checkpointsSince;
+    }
+    CCLOG("Checkpoint %lld written (%s, %zu bytes)", id, fullSnapshot ? "full" : "delta", blob.size());
+    return db->pruneCheckpoints(kMaxCheckpoints);
+}
+
+#endif // SAVE_USE_SQLITE
+
+std::vector<SaveManager::CheckpointInfo> SaveManager::listCheckpoints()
+{
+    std::vector<CheckpointInfo> checkpoints;
+#if SAVE_USE_SQLITE
+    SaveDatabase* db = openDatabase();
+    if (db && !db->listCheckpoints(checkpoints))
+    {
+        CCLOG("Error: Failed to list checkpoints");
+    }
+#endif
+    return checkpoints;
+}
+
+bool SaveManager::loadCheckpoint(long long id, SaveData& data)
+{
+#if SAVE_USE_SQLITE
+    SaveDatabase* db = openDatabase();
+    if (!db)
+    {
+        return false;
+    }
+
+    long long baseId = 0;
+    std::string blob;
+    if (!db->readCheckpoint(id, baseId, blob))
+    {
+        CCLOG("Error: Checkpoint %lld not found", id);
+        return false;
+    }
+
+    SaveSnapshot::Records records;
+    if (baseId != 0)
+    {
+        // 增量快照先还原它的完整快照，最新的那个已经在内存里
+        if (checkpointBase_ && checkpointBase_->id == baseId)
+        {
+            records = checkpointBase_->records;
+        }
+        else
+        {
+            long long unused = 0;
+            std::string baseBlob;
+            if (!db->readCheckpoint(baseId, unused, baseBlob) || !SaveSnapshot::decode(baseBlob, records))
+            {
+                CCLOG("Error: Base snapshot %lld of checkpoint %lld is missing or corrupted", baseId, id);
+                return false;
+            }
+        }
+    }
+    if (!SaveSnapshot::decode(blob, records))
+    {
+        CCLOG("Error: Checkpoint %lld is corrupted", id);
+        return false;
+    }
+    SaveSnapshot::unflatten(records, data);
+    return true;
+#else
+    CCLOG("Error: Checkpoints are not supported on this platform");
+    return false;
+#endif
+}
+
+bool SaveManager::restoreCheckpoint(long long id, SaveData& data)
+{
+#if SAVE_USE_SQLITE
+    if (!loadCheckpoint(id, data) || !saveToDatabase(data, false))
+    {
+        return false;
+    }
+    CCLOG("Restored checkpoint %lld (day %d)", id, data.dayCount);
+    return true;
+#else
+    CCLOG("Error: Checkpoints are not supported on this platform");
+    return false;
+#endif
+}
+
+bool SaveManager::saveToJson(const SaveData& data)
 {
     try
     {
@@ -325,7 +858,7 @@ bool SaveManager::saveGame(const SaveData& data)
     }
 }
 
-bool SaveManager::loadGame(SaveData& data)
+bool SaveManager::loadFromJson(SaveData& data)
 {
     try
     {
@@ -4,9 +4,20 @@
 #include "cocos2d.h"
 #include "InventoryManager.h"
 #include "json/document.h"
+#include <memory>
 #include <string>
 #include <vector>
 
+// 引擎在 Windows/Linux 链接 SQLite，macOS/iOS 由 CMakeLists.txt 链接系统自带的 libsqlite3；
+// Android 版没有 SQLite，仍使用 JSON 存档
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_ANDROID)
+#define SAVE_USE_SQLITE 1
+#else
+#define SAVE_USE_SQLITE 0
+#endif
+
+class SaveDatabase;
+
 /**
  * @brief 存档管理器
  *
@@ -14,6 +25,15 @@
  * - 保存和加载游戏存档
  * - 管理存档文件
  * - 序列化和反序列化游戏数据
+ *
+ * 存档写入可写目录下的 SQLite 数据库（savegame.db），每类数据一张表。
+ * 管理器记住数据库里当前的存档内容，保存时只写入与之相比变化的行，
+ * 整次保存在一个事务里完成；旧版的 savegame.json 在第一次加载时导入数据库。
+ *
+ * 存档槽位：每个槽位一个数据库（槽位 0 为 savegame.db，其余为 savegame_<n>.db）。
+ * 检查点：每次保存在同一事务里追加一个快照，平时是相对最新完整快照的增量，
+ * 每隔一天左右的自动存档（或增量过大时）写一次完整快照，只保留最近的若干个检查点。
+ * 读取任一检查点最多解码一个完整快照加一个增量，不需要依次重放。
  */
 class SaveManager
 {
@@ -77,8 +97,30 @@ public:
             int actionCount;
         };
         std::vector<SkillData> skills;
+
+        // 矿洞楼层数据
+        struct MineFloorData
+        {
+            int floor;
+            int chestOpenedWeek;  // 该层宝箱被打开的那一周（每周重置）
+        };
+        std::vector<MineFloorData> mineFloors;
+    };
+
+    /**
+     * @brief 检查点摘要
+     */
+    struct CheckpointInfo
+    {
+        long long id;
+        bool full;          // 完整快照还是增量快照
+        int dayCount;
+        long long savedAt;  // 保存时的 Unix 时间
+        int bytes;          // 快照编码后的大小
     };
 
+    static const int kSlotCount = 3;
+
     /**
      * @brief 获取单例实例
      */
@@ -109,17 +151,83 @@ public:
      */
     void deleteSaveFile();
 
+    /**
+     * @brief 切换存档槽位，之后的保存、加载和检查点都针对该槽位
+     * @param slot 0 ~ kSlotCount - 1
+     */
+    bool setActiveSlot(int slot);
+    int getActiveSlot() const;
+
+    /**
+     * @brief 列出当前槽位的检查点，从新到旧
+     */
+    std::vector<CheckpointInfo> listCheckpoints();
+
+    /**
+     * @brief 读取某个检查点的存档数据
+     */
+    bool loadCheckpoint(long long id, SaveData& data);
+
+    /**
+     * @brief 回滚到某个检查点：把它写回当前存档（不追加新检查点），并输出其数据供场景应用
+     */
+    bool restoreCheckpoint(long long id, SaveData& data);
+
 private:
     SaveManager();
     ~SaveManager();
 
     static SaveManager* instance_;
 
+    int activeSlot_;
+
     /**
-     * @brief 获取存档文件路径
+     * @brief 获取 JSON 存档文件路径
      */
     std::string getSaveFilePath() const;
 
+    /**
+     * @brief 以 JSON 文件保存 / 加载（Android，以及导入旧存档）
+     */
+    bool saveToJson(const SaveData& data);
+    bool loadFromJson(SaveData& data);
+
+#if SAVE_USE_SQLITE
+    /**
+     * @brief 获取存档数据库路径
+     */
+    std::string getDatabasePath() const;
+
+    /**
+     * @brief 打开存档数据库（首次调用时打开），失败返回 nullptr
+     */
+    SaveDatabase* openDatabase() const;
+
+    /**
+     * @brief 在一个事务里写入与数据库现有内容相比变化的行
+     */
+    bool saveToDatabase(const SaveData& data, bool recordCheckpoint = true);
+
+    /**
+     * @brief 在当前事务里追加一个检查点
+     */
+    bool appendCheckpoint(SaveDatabase* db, const SaveData& data);
+
+    /**
+     * @brief 关闭数据库并丢弃缓存的存档内容（删除存档或切换槽位时）
+     */
+    void closeDatabase();
+
+    mutable SaveDatabase* database_;
+    // 数据库中当前的存档内容，保存时据此只写变化的行
+    SaveData savedData_;
+    bool hasSavedData_;
+
+    // 最新的完整快照，增量检查点相对它编码；为空表示还没从数据库读出
+    struct CheckpointBase;
+    std::unique_ptr<CheckpointBase> checkpointBase_;
+#endif
+
     /**
      * @brief 序列化存档数据为 JSON
      */
@@ -0,0 +1,425 @@
+#include "SaveSnapshot.h"
+#include <zlib.h>
+#include <cstring>
+#include <utility>
+
+USING_NS_CC;
+
+namespace {
+    typedef SaveManager::SaveData SaveData;
+
+    const unsigned char kFormatVersion = 1;
+    const unsigned char kFlagDelta = 0x01;
+    const unsigned char kFlagCompressed = 0x02;
+    // 太短的编码压缩后反而变长
+    const size_t kMinCompressSize = 64;
+    // 解压前检查记录的原始大小，损坏的快照不能让我们分配任意大的内存：
+    // 存档远小于这个上限，deflate 的压缩比也不会超过 1032:1
+    const unsigned int kMaxRawSize = 64u * 1024 * 1024;
+    const unsigned int kMaxDeflateRatio = 1032;
+
+    enum RecordType
+    {
+        META,
+        INVENTORY_SLOT,
+        FARM_TILE,
+        CHEST,
+        CHEST_SLOT,
+        SKILL,
+        MINE_FLOOR,
+        RECORD_TYPE_COUNT
+    };
+
+    // 各类记录键（不含类型）和值的字段数
+    const int kKeyFields[RECORD_TYPE_COUNT] = { 1, 1, 2, 2, 3, 1, 1 };
+    const int kValueFields[RECORD_TYPE_COUNT] = { 1, 2, 4, 0, 2, 2, 1 };
+
+    enum MetaId
+    {
+        META_PLAYER_X,
+        META_PLAYER_Y,
+        META_MONEY,
+        META_DAY_COUNT
+    };
+
+    enum TileFlag
+    {
+        TILE_TILLED = 1 << 0,
+        TILE_WATERED = 1 << 1,
+        TILE_HAS_CROP = 1 << 2
+    };
+
+    int floatBits(float value)
+    {
+        int bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float bitsToFloat(int bits)
+    {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void writeVarint(std::string& out, unsigned int value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    // zigzag：绝对值小的负数也只占一两个字节
+    void writeInt(std::string& out, int value)
+    {
+        writeVarint(out, (static_cast<unsigned int>(value) << 1) ^ static_cast<unsigned int>(value >> 31));
+    }
+
+    struct Reader
+    {
+        const unsigned char* pos;
+        const unsigned char* end;
+
+        bool readVarint(unsigned int& value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 35; shift += 7)
+            {
+                if (pos == end) return false;
+                unsigned char byte = *pos++;
+                value |= static_cast<unsigned int>(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+
+        bool readInt(int& value)
+        {
+            unsigned int raw;
+            if (!readVarint(raw)) return false;
+            value = static_cast<int>((raw >> 1) ^ (0u - (raw & 1)));
+            return true;
+        }
+    };
+
+    void writeKey(std::string& out, const SaveSnapshot::RecordKey& key)
+    {
+        for (int field : key)
+        {
+            writeInt(out, field);
+        }
+    }
+
+    void writeRecord(std::string& out, const SaveSnapshot::RecordKey& key, const SaveSnapshot::RecordValue& value)
+    {
+        writeKey(out, key);
+        for (int field : value)
+        {
+            writeInt(out, field);
+        }
+    }
+
+    bool readKey(Reader& reader, SaveSnapshot::RecordKey& key)
+    {
+        int type;
+        if (!reader.readInt(type) || type < 0 || type >= RECORD_TYPE_COUNT) return false;
+        key.assign(1 + kKeyFields[type], 0);
+        key[0] = type;
+        for (int i = 1; i <= kKeyFields[type]; ++i)
+        {
+            if (!reader.readInt(key[i])) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 加上头部，编码够大且压缩有收益时用 zlib 压缩
+     */
+    std::string finish(const std::string& payload, bool delta)
+    {
+        std::string blob;
+        blob.push_back(static_cast<char>(kFormatVersion));
+        if (payload.size() >= kMinCompressSize)
+        {
+            uLongf packedSize = compressBound(static_cast<uLong>(payload.size()));
+            std::string packed(packedSize, '\0');
+            if (compress2(reinterpret_cast<Bytef*>(&packed[0]), &packedSize,
+                          reinterpret_cast<const Bytef*>(payload.data()), static_cast<uLong>(payload.size()),
+                          Z_BEST_COMPRESSION) == Z_OK
+                && packedSize < payload.size())
+            {
+                blob.push_back(static_cast<char>((delta ? kFlagDelta : 0) | kFlagCompressed));
+                writeVarint(blob, static_cast<unsigned int>(payload.size()));
+                blob.append(packed.data(), packedSize);
+                return blob;
+            }
+        }
+        blob.push_back(static_cast<char>(delta ? kFlagDelta : 0));
+        blob += payload;
+        return blob;
+    }
+}
+
+SaveSnapshot::Records SaveSnapshot::flatten(const SaveData& data)
+{
+    Records records;
+    records[{ META, META_PLAYER_X }] = { floatBits(data.playerPosition.x) };
+    records[{ META, META_PLAYER_Y }] = { floatBits(data.playerPosition.y) };
+    records[{ META, META_MONEY }] = { data.inventory.money };
+    records[{ META, META_DAY_COUNT }] = { data.dayCount };
+
+    for (size_t i = 0; i < data.inventory.slots.size(); ++i)
+    {
+        const auto& slot = data.inventory.slots[i];
+        records[{ INVENTORY_SLOT, (int)i }] = { slot.type, slot.count };
+    }
+
+    for (const auto& tile : data.farmTiles)
+    {
+        // 只保存有状态的瓦片（耕地或有作物）
+        if (!tile.tilled && !tile.hasCrop) continue;
+        int flags = (tile.tilled ? TILE_TILLED : 0) | (tile.watered ? TILE_WATERED : 0) | (tile.hasCrop ? TILE_HAS_CROP : 0);
+        records[{ FARM_TILE, tile.x, tile.y }] = { flags, tile.cropId, tile.stage, tile.progressDays };
+    }
+
+    for (const auto& chest : data.storageChests)
+    {
+        records[{ CHEST, chest.x, chest.y }] = RecordValue();
+        for (size_t i = 0; i < chest.slots.size(); ++i)
+        {
+            const auto& slot = chest.slots[i];
+            records[{ CHEST_SLOT, chest.x, chest.y, (int)i }] = { slot.type, slot.count };
+        }
+    }
+
+    for (const auto& skill : data.skills)
+    {
+        records[{ SKILL, skill.type }] = { skill.level, skill.actionCount };
+    }
+
+    for (const auto& floor : data.mineFloors)
+    {
+        records[{ MINE_FLOOR, floor.floor }] = { floor.chestOpenedWeek };
+    }
+    return records;
+}
+
+void SaveSnapshot::unflatten(const Records& records, SaveData& data)
+{
+    data.playerPosition = Vec2::ZERO;
+    data.inventory.slots.clear();
+    data.inventory.money = 0;
+    data.dayCount = 1;
+    data.farmTiles.clear();
+    data.storageChests.clear();
+    data.skills.clear();
+    data.mineFloors.clear();
+
+    // 记录按类型排序，储物箱总在它的槽位之前
+    std::map<std::pair<int, int>, size_t> chestIndex;
+    for (const auto& record : records)
+    {
+        const RecordKey& key = record.first;
+        const RecordValue& value = record.second;
+        switch (key[0])
+        {
+        case META:
+            if (key[1] == META_PLAYER_X) data.playerPosition.x = bitsToFloat(value[0]);
+            else if (key[1] == META_PLAYER_Y) data.playerPosition.y = bitsToFloat(value[0]);
+            else if (key[1] == META_MONEY) data.inventory.money = value[0];
+            else if (key[1] == META_DAY_COUNT) data.dayCount = value[0];
+            break;
+        case INVENTORY_SLOT:
+        {
+            if (key[1] < 0) break;
+            // 槽位按下标保存，缺失的下标补成空槽
+            SaveData::InventoryData::ItemSlotData empty = { static_cast<int>(ItemType::ITEM_NONE), 0 };
+            if ((int)data.inventory.slots.size() <= key[1])
+            {
+                data.inventory.slots.resize(key[1] + 1, empty);
+            }
+            data.inventory.slots[key[1]].type = value[0];
+            data.inventory.slots[key[1]].count = value[1];
+            break;
+        }
+        case FARM_TILE:
+        {
+            SaveData::FarmTileData tile;
+            tile.x = key[1];
+            tile.y = key[2];
+            tile.tilled = (value[0] & TILE_TILLED) != 0;
+            tile.watered = (value[0] & TILE_WATERED) != 0;
+            tile.hasCrop = (value[0] & TILE_HAS_CROP) != 0;
+            tile.cropId = value[1];
+            tile.stage = value[2];
+            tile.progressDays = value[3];
+            data.farmTiles.push_back(tile);
+            break;
+        }
+        case CHEST:
+        {
+            SaveData::StorageChestData chest;
+            chest.x = key[1];
+            chest.y = key[2];
+            chestIndex[std::make_pair(chest.x, chest.y)] = data.storageChests.size();
+            data.storageChests.push_back(chest);
+            break;
+        }
+        case CHEST_SLOT:
+        {
+            auto it = chestIndex.find(std::make_pair(key[1], key[2]));
+            if (it == chestIndex.end() || key[3] < 0) break;
+            auto& slots = data.storageChests[it->second].slots;
+            SaveData::StorageChestData::SlotData empty = { static_cast<int>(ItemType::ITEM_NONE), 0 };
+            if ((int)slots.size() <= key[3])
+            {
+                slots.resize(key[3] + 1, empty);
+            }
+            slots[key[3]].type = value[0];
+            slots[key[3]].count = value[1];
+            break;
+        }
+        case SKILL:
+        {
+            SaveData::SkillData skill;
+            skill.type = key[1];
+            skill.level = value[0];
+            skill.actionCount = value[1];
+            data.skills.push_back(skill);
+            break;
+        }
+        case MINE_FLOOR:
+        {
+            SaveData::MineFloorData floor;
+            floor.floor = key[1];
+            floor.chestOpenedWeek = value[0];
+            data.mineFloors.push_back(floor);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+std::string SaveSnapshot::encodeFull(const Records& records)
+{
+    std::string payload;
+    writeVarint(payload, static_cast<unsigned int>(records.size()));
+    for (const auto& record : records)
+    {
+        writeRecord(payload, record.first, record.second);
+    }
+    return finish(payload, false);
+}
+
+std::string SaveSnapshot::encodeDelta(const Records& base, const Records& records)
+{
+    // 两份记录都按键排序，一次归并找出修改和删除
+    std::string upserts;
+    std::string deletes;
+    unsigned int upsertCount = 0;
+    unsigned int deleteCount = 0;
+    auto oldIt = base.begin();
+    for (const auto& record : records)
+    {
+        while (oldIt != base.end() && oldIt->first < record.first)
+        {
+            writeKey(deletes, oldIt->first);
+            ++deleteCount;
+            ++oldIt;
+        }
+        if (oldIt != base.end() && oldIt->first == record.first)
+        {
+            bool unchanged = oldIt->second == record.second;
+            ++oldIt;
+            if (unchanged) continue;
+        }
+        writeRecord(upserts, record.first, record.second);
+        ++upsertCount;
+    }
+    for (; oldIt != base.end(); ++oldIt)
+    {
+        writeKey(deletes, oldIt->first);
+        ++deleteCount;
+    }
+
+    std::string payload;
+    writeVarint(payload, upsertCount);
+    payload += upserts;
+    writeVarint(payload, deleteCount);
+    payload += deletes;
+    return finish(payload, true);
+}
+
+bool SaveSnapshot::decode(const std::string& blob, Records& records)
+{
+    if (blob.size() < 2 || static_cast<unsigned char>(blob[0]) != kFormatVersion)
+    {
+        CCLOG("SaveSnapshot: unknown snapshot format");
+        return false;
+    }
+    unsigned char flags = static_cast<unsigned char>(blob[1]);
+    Reader reader = { reinterpret_cast<const unsigned char*>(blob.data()) + 2,
+                      reinterpret_cast<const unsigned char*>(blob.data()) + blob.size() };
+
+    std::string inflated;
+    if (flags & kFlagCompressed)
+    {
+        unsigned int rawSize;
+        if (!reader.readVarint(rawSize)) return false;
+        size_t compressedSize = static_cast<size_t>(reader.end - reader.pos);
+        if (rawSize > kMaxRawSize || rawSize > compressedSize * kMaxDeflateRatio)
+        {
+            CCLOG("SaveSnapshot: implausible raw size %u for %zu compressed bytes", rawSize, compressedSize);
+            return false;
+        }
+        inflated.resize(rawSize);
+        uLongf inflatedSize = rawSize;
+        if (rawSize == 0
+            || uncompress(reinterpret_cast<Bytef*>(&inflated[0]), &inflatedSize,
+                          reader.pos, static_cast<uLong>(reader.end - reader.pos)) != Z_OK
+            || inflatedSize != rawSize)
+        {
+            CCLOG("SaveSnapshot: failed to inflate snapshot");
+            return false;
+        }
+        reader.pos = reinterpret_cast<const unsigned char*>(inflated.data());
+        reader.end = reader.pos + inflated.size();
+    }
+
+    if (!(flags & kFlagDelta))
+    {
+        records.clear();
+    }
+
+    unsigned int count;
+    if (!reader.readVarint(count)) return false;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        RecordKey key;
+        if (!readKey(reader, key)) return false;
+        RecordValue value(kValueFields[key[0]]);
+        for (int& field : value)
+        {
+            if (!reader.readInt(field)) return false;
+        }
+        records[key] = std::move(value);
+    }
+
+    if (flags & kFlagDelta)
+    {
+        if (!reader.readVarint(count)) return false;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            RecordKey key;
+            if (!readKey(reader, key)) return false;
+            records.erase(key);
+        }
+    }
+    return reader.pos == reader.end;
+}
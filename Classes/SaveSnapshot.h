@@ -0,0 +1,51 @@
+#ifndef __SAVE_SNAPSHOT_H__
+#define __SAVE_SNAPSHOT_H__
+
+#include "SaveManager.h"
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 存档检查点的二进制编码
+ *
+ * 存档先展开成一组按键排序的记录：键是 [记录类型, 坐标/下标...]，值是该行的各个整数字段
+ * （元数据、背包槽位、农田瓦片、储物箱及其槽位、技能、矿洞楼层各一类）。
+ * 完整快照保存全部记录；增量快照只保存相对基准快照新增或修改的记录，以及被删除的键。
+ * 整数按 zigzag 变长编码，编码结果够大时再用 zlib 压缩，每小时一次的自动存档通常只有几十到几百字节。
+ */
+class SaveSnapshot
+{
+public:
+    typedef std::vector<int> RecordKey;
+    typedef std::vector<int> RecordValue;
+    typedef std::map<RecordKey, RecordValue> Records;
+
+    /**
+     * @brief 把存档展开成记录
+     */
+    static Records flatten(const SaveManager::SaveData& data);
+
+    /**
+     * @brief 由记录还原存档
+     */
+    static void unflatten(const Records& records, SaveManager::SaveData& data);
+
+    /**
+     * @brief 编码完整快照
+     */
+    static std::string encodeFull(const Records& records);
+
+    /**
+     * @brief 编码 records 相对 base 的增量快照
+     */
+    static std::string encodeDelta(const Records& base, const Records& records);
+
+    /**
+     * @brief 解码快照并应用到 records：完整快照替换全部记录，增量快照在基准记录上修改
+     * @return 数据损坏时返回 false，records 内容不确定
+     */
+    static bool decode(const std::string& blob, Records& records);
+};
+
+#endif // __SAVE_SNAPSHOT_H__
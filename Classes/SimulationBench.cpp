@@ -0,0 +1,320 @@
+#include "SimulationBench.h"
+#include "FarmManager.h"
+#include "MiningManager.h"
+#include "InventoryManager.h"
+#include "SkillManager.h"
+#include "TimeManager.h"
+#include "GameRandom.h"
+#include "cocos2d.h"
+#include <chrono>
+#include <cstdio>
+
+USING_NS_CC;
+
+namespace {
+SimulationBench::AllocationCounter s_allocationCounter = nullptr;
+
+// 模拟时钟的固定步长，与 60 FPS 下的帧间隔一致
+const float kFixedTimestep = 1.0f / 60.0f;
+
+// 挖矿测试使用的矿物 GID：石头、铜、铁、银、金、钻石
+const int kBenchMineralGids[] = { 138, 875, 885, 910, 700, 805 };
+
+const int kCropCount = 6;
+
+uint64_t currentAllocations()
+{
+    return s_allocationCounter ? s_allocationCounter() : 0;
+}
+
+// FNV-1a，用于把模拟结果折叠成一个校验值
+void mixChecksum(uint32_t& checksum, int value)
+{
+    uint32_t v = static_cast<uint32_t>(value);
+    for (int i = 0; i < 4; ++i)
+    {
+        checksum ^= (v >> (i * 8)) & 0xFF;
+        checksum *= 16777619u;
+    }
+}
+
+/**
+ * @brief 计时和分配统计，构造时开始，finish() 时写入结果
+ */
+class BenchTimer
+{
+public:
+    BenchTimer()
+        : start_(std::chrono::steady_clock::now())
+        , startAllocations_(currentAllocations())
+    {
+    }
+
+    void finish(SimulationBench::Result& result) const
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        result.seconds = std::chrono::duration<double>(elapsed).count();
+        result.allocations = currentAllocations() - startAllocations_;
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    uint64_t startAllocations_;
+};
+
+ItemType getItemTypeForCropId(int cropId)
+{
+    return static_cast<ItemType>(static_cast<int>(ItemType::Turnip) + cropId);
+}
+}
+
+void SimulationBench::setAllocationCounter(AllocationCounter counter)
+{
+    s_allocationCounter = counter;
+}
+
+SimulationBench::Result SimulationBench::runFarmYear(int days, int width, int height)
+{
+    Result result{ "farm_year", 0, 0.0, 0, 2166136261u };
+
+    // 节点都是 autorelease 的，没有主循环时由局部池在结束时释放
+    AutoreleasePool pool;
+    TimeManager::destroyInstance();
+    auto timeManager = TimeManager::getInstance();
+    auto farm = FarmManager::createHeadless(Size(width, height));
+    auto inventory = InventoryManager::create(30);
+    auto random = GameRandom::getInstance();
+    if (!farm || !inventory)
+        return result;
+
+    BenchTimer timer;
+    for (int day = 0; day < days; ++day)
+    {
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                Vec2 tileCoord(x, y);
+                if (farm->tillTile(tileCoord).success)
+                    result.operations++;
+                if (farm->plantSeed(tileCoord, random->nextInt(kCropCount)).success)
+                    result.operations++;
+                auto harvest = farm->harvestTile(tileCoord);
+                if (harvest.success)
+                {
+                    inventory->addItem(getItemTypeForCropId(harvest.cropId));
+                    result.operations++;
+                }
+                // 随机漏浇一部分，让作物生长速度不一致
+                if (random->nextInt(10) != 0 && farm->waterTile(tileCoord).success)
+                    result.operations++;
+            }
+
+            // 每处理完一行就卖掉收获，避免背包装满
+            for (int cropId = 0; cropId < kCropCount; ++cropId)
+            {
+                ItemType crop = getItemTypeForCropId(cropId);
+                int count = inventory->getItemCount(crop);
+                if (count > 0 && inventory->removeItem(crop, count))
+                    inventory->addMoney(count * ItemRegistry::get(crop).basePrice);
+            }
+        }
+
+        // 固定步长推进时钟直到午夜，然后结算一天
+        while (!timeManager->isMidnight())
+            timeManager->update(kFixedTimestep);
+        timeManager->advanceToNextDay();
+        farm->simulateDay();
+    }
+    timer.finish(result);
+
+    mixChecksum(result.checksum, inventory->getMoney());
+    mixChecksum(result.checksum, timeManager->getDay());
+    // 按行遍历整张地图（包括空瓦片），校验值与存储布局无关
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            FarmTile tile = farm->getTiles().get(x, y);
+            mixChecksum(result.checksum, tile.cropId);
+            mixChecksum(result.checksum, tile.stage * 64 + tile.progressDays);
+        }
+    }
+    return result;
+}
+
+SimulationBench::Result SimulationBench::runMining(int hits)
+{
+    Result result{ "mining", 0, 0.0, 0, 2166136261u };
+
+    const int width = 40;
+    const int height = 40;
+    const int gidCount = sizeof(kBenchMineralGids) / sizeof(kBenchMineralGids[0]);
+
+    AutoreleasePool pool;
+    SkillManager::destroyInstance();
+    auto inventory = InventoryManager::create(30);
+    auto mining = inventory ? MiningManager::createHeadless(Size(width, height), inventory) : nullptr;
+    auto random = GameRandom::getInstance();
+    if (!mining)
+        return result;
+
+    // 随机生成一层矿，被挖掉的格子重新长出矿物
+    std::vector<int> floor(static_cast<size_t>(width * height));
+    for (auto& gid : floor)
+        gid = kBenchMineralGids[random->nextInt(gidCount)];
+
+    BenchTimer timer;
+    int broken = 0;
+    for (int i = 0; i < hits; ++i)
+    {
+        int x = random->nextInt(width);
+        int y = random->nextInt(height);
+        int& gid = floor[static_cast<size_t>(y * width + x)];
+
+        int expBefore = mining->getMiningExp();
+        auto hit = mining->simulateHit(Vec2(x, y), gid);
+        if (hit.success)
+            result.operations++;
+        if (mining->getMiningExp() != expBefore)
+        {
+            broken++;
+            gid = kBenchMineralGids[random->nextInt(gidCount)];
+        }
+
+        // 最后一格也被占用时清空背包，保证掉落路径一直被执行
+        if (!inventory->getAllSlots().back().isEmpty())
+            inventory->clear();
+    }
+    timer.finish(result);
+
+    mixChecksum(result.checksum, broken);
+    mixChecksum(result.checksum, mining->getMiningExp());
+    for (const auto& slot : inventory->getAllSlots())
+    {
+        mixChecksum(result.checksum, static_cast<int>(slot.type));
+        mixChecksum(result.checksum, slot.count);
+    }
+    return result;
+}
+
+SimulationBench::Result SimulationBench::runInventory(int operations)
+{
+    Result result{ "inventory", 0, 0.0, 0, 2166136261u };
+
+    // 可堆叠物品：种子、木头、作物和矿石
+    const ItemType items[] = {
+        ItemType::SeedTurnip, ItemType::SeedCorn, ItemType::Wood, ItemType::Turnip,
+        ItemType::Potato, ItemType::Pumpkin, ItemType::CopperOre, ItemType::GoldOre
+    };
+    const int itemCount = sizeof(items) / sizeof(items[0]);
+
+    AutoreleasePool pool;
+    auto inventory = InventoryManager::create(30);
+    auto random = GameRandom::getInstance();
+    if (!inventory)
+        return result;
+
+    BenchTimer timer;
+    for (int i = 0; i < operations; ++i)
+    {
+        ItemType item = items[random->nextInt(itemCount)];
+        int count = 1 + random->nextInt(8);
+        bool ok = false;
+        switch (random->nextInt(5))
+        {
+        case 0:
+        case 1:
+            ok = inventory->addItem(item, count);
+            break;
+        case 2:
+            ok = inventory->removeItem(item, count);
+            break;
+        case 3:
+            ok = inventory->hasItem(item, count);
+            break;
+        default:
+            inventory->swapSlots(random->nextInt(inventory->getSlotCount()), random->nextInt(inventory->getSlotCount()));
+            ok = true;
+            break;
+        }
+        if (ok)
+            result.operations++;
+    }
+    timer.finish(result);
+
+    for (int i = 0; i < itemCount; ++i)
+        mixChecksum(result.checksum, inventory->getItemCount(items[i]));
+    mixChecksum(result.checksum, static_cast<int>(result.operations));
+    return result;
+}
+
+SimulationBench::Result SimulationBench::runSceneTransforms(int frames, int width, int height)
+{
+    Result result{ "transforms", 0, 0.0, 0, 2166136261u };
+
+    // 与作物层相同的结构：叶子节点都挂在一个开启并行变换的层下
+    AutoreleasePool pool;
+    auto layer = Node::create();
+    if (!layer)
+        return result;
+    layer->setParallelTransformEnabled(true);
+    const float tileSize = 16.0f;
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            auto leaf = Node::create();
+            leaf->setPosition(x * tileSize, y * tileSize);
+            layer->addChild(leaf);
+        }
+    }
+
+    auto renderer = Director::getInstance()->getRenderer();
+    BenchTimer timer;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        // 移动层让所有叶子的世界变换失效，相当于镜头跟随玩家
+        layer->setPosition(static_cast<float>(frame % 64), static_cast<float>(frame % 48));
+        layer->visit(renderer, Mat4::IDENTITY, Node::FLAGS_TRANSFORM_DIRTY);
+        result.operations += width * height;
+    }
+    timer.finish(result);
+
+    const auto& leaves = layer->getChildren();
+    for (ssize_t i = 0; i < leaves.size(); i += 97)
+    {
+        Vec2 world = leaves.at(i)->convertToWorldSpace(Vec2::ZERO);
+        mixChecksum(result.checksum, static_cast<int>(world.x));
+        mixChecksum(result.checksum, static_cast<int>(world.y));
+    }
+    return result;
+}
+
+std::vector<SimulationBench::Result> SimulationBench::runAll(uint32_t seed)
+{
+    std::vector<Result> results;
+
+    // 每项测试都从同一种子开始，单独运行某一项时结果也一致
+    GameRandom::getInstance()->setSeed(seed);
+    results.push_back(runFarmYear());
+    GameRandom::getInstance()->setSeed(seed);
+    results.push_back(runMining());
+    GameRandom::getInstance()->setSeed(seed);
+    results.push_back(runInventory());
+    GameRandom::getInstance()->setSeed(seed);
+    results.push_back(runSceneTransforms());
+    return results;
+}
+
+void SimulationBench::printResult(const Result& result)
+{
+    double opsPerSecond = result.seconds > 0.0 ? result.operations / result.seconds : 0.0;
+    printf("%-10s %10lld ops %9.3f ms %12.0f ops/s %10llu allocs  checksum %08x\n",
+        result.name.c_str(),
+        static_cast<long long>(result.operations),
+        result.seconds * 1000.0,
+        opsPerSecond,
+        static_cast<unsigned long long>(result.allocations),
+        result.checksum);
+}
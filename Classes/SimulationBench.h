@@ -0,0 +1,85 @@
+#ifndef __SIMULATION_BENCH_H__
+#define __SIMULATION_BENCH_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 无界面游戏逻辑基准测试
+ *
+ * 不创建窗口和 OpenGL 上下文，直接驱动农场、挖矿和背包的逻辑代码：
+ * - 整片农田模拟 365 天（耕地、播种、浇水、收获、出售），时间按固定步长推进
+ * - 随机矿层上 10000 次挖掘
+ * - 100 万次背包操作
+ * - 农田大小的节点层每帧移动后重新计算世界变换（并行变换）
+ *
+ * 随机数全部来自 GameRandom，同一种子下每项的校验值必须一致，
+ * 可以用来比较优化前后的结果是否改变。入口见 proj.headless/main.cpp。
+ */
+class SimulationBench
+{
+public:
+    /**
+     * @brief 单项测试结果
+     */
+    struct Result
+    {
+        std::string name;          // 测试名称
+        int64_t operations;        // 执行的操作数
+        double seconds;            // 耗时（秒）
+        uint64_t allocations;      // 期间的堆分配次数，未设置计数器时为 0
+        uint32_t checksum;         // 结果校验值（确定性检查）
+    };
+
+    /**
+     * @brief 堆分配计数函数，返回进程启动以来的分配次数
+     */
+    typedef uint64_t (*AllocationCounter)();
+
+    /**
+     * @brief 设置堆分配计数函数（由入口程序替换全局 operator new 后提供）
+     */
+    static void setAllocationCounter(AllocationCounter counter);
+
+    /**
+     * @brief 农场全年模拟
+     * @param days 模拟天数
+     * @param width 农田宽度（瓦片）
+     * @param height 农田高度（瓦片）
+     */
+    static Result runFarmYear(int days = 365, int width = 40, int height = 30);
+
+    /**
+     * @brief 挖矿模拟
+     * @param hits 敲击次数
+     */
+    static Result runMining(int hits = 10000);
+
+    /**
+     * @brief 背包操作模拟
+     * @param operations 操作次数
+     */
+    static Result runInventory(int operations = 1000000);
+
+    /**
+     * @brief 场景变换模拟：一个开启并行变换的层下挂 width * height 个节点，每帧移动该层后遍历
+     * @param frames 帧数
+     * @param width 每行节点数
+     * @param height 行数
+     */
+    static Result runSceneTransforms(int frames = 1000, int width = 40, int height = 30);
+
+    /**
+     * @brief 按默认参数执行全部测试
+     * @param seed 随机种子
+     */
+    static std::vector<Result> runAll(uint32_t seed);
+
+    /**
+     * @brief 输出一项结果到标准输出
+     */
+    static void printResult(const Result& result);
+};
+
+#endif // __SIMULATION_BENCH_H__
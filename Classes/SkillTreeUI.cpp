@@ -1,4 +1,5 @@
 #include "SkillTreeUI.h"
+#include "GameFont.h"
 
 USING_NS_CC;
 
@@ -41,7 +42,7 @@ bool SkillTreeUI::init()
     border->setLineWidth(3.0f);
     panel_->addChild(border, 0);
 
-    auto title = Label::createWithSystemFont("Skill Tree (E to close)", "Arial", 24);
+    auto title = GameFont::createLabel("Skill Tree (E to close)", 24);
     title->setPosition(Vec2(panel_->getContentSize().width / 2, panel_->getContentSize().height - 30));
     title->setColor(Color3B(255, 235, 200));
     panel_->addChild(title, 1);
@@ -83,7 +84,7 @@ void SkillTreeUI::buildLayout()
         row.type = list[i].type;
         row.barWidth = barWidth;
 
-        row.nameLabel = Label::createWithSystemFont("", "Arial", 20);
+        row.nameLabel = GameFont::createLabel("", 20);
         row.nameLabel->setAnchorPoint(Vec2(0, 0.5f));
         row.nameLabel->setPosition(Vec2(leftX, y));
         row.nameLabel->setColor(Color3B(230, 220, 200));
@@ -101,13 +102,13 @@ void SkillTreeUI::buildLayout()
         row.barFill->setPosition(Vec2(0, barHeight / 2));
         barBg->addChild(row.barFill, 1);
 
-        row.levelLabel = Label::createWithSystemFont("", "Arial", 18);
+        row.levelLabel = GameFont::createLabel("", 18);
         row.levelLabel->setAnchorPoint(Vec2(0, 0.5f));
         row.levelLabel->setPosition(Vec2(barX + barWidth + 20.0f, y));
         row.levelLabel->setColor(Color3B(200, 200, 200));
         panel_->addChild(row.levelLabel, 1);
 
-        row.countLabel = Label::createWithSystemFont("", "Arial", 16);
+        row.countLabel = GameFont::createLabel("", 16);
         row.countLabel->setAnchorPoint(Vec2(0, 0.5f));
         row.countLabel->setPosition(Vec2(leftX, y - 22.0f));
         row.countLabel->setColor(Color3B(160, 160, 160));
@@ -1,4 +1,5 @@
 #include "Slime.h"
+#include "GameFont.h"
 
 USING_NS_CC;
 
@@ -101,7 +102,7 @@ void Slime::initDisplay()
     }
 
     // 血条显示
-    hpLabel_ = Label::createWithSystemFont("", "Arial", 10);
+    hpLabel_ = GameFont::createLabel("", 10);
     hpLabel_->setPosition(Vec2(0, 15));
     hpLabel_->setColor(Color3B::RED);
     this->addChild(hpLabel_, 1);
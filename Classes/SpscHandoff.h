@@ -0,0 +1,100 @@
+#ifndef __SPSC_HANDOFF_H__
+#define __SPSC_HANDOFF_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 单生产者/单消费者无锁环形队列
+ *
+ * 一个线程只调用 push()，另一个线程只调用 pop()。
+ * 队列满时 push() 返回 false，由调用方决定重试或走其他通道。
+ * @tparam Capacity 容量，必须是 2 的幂
+ */
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool push(const T& item)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == Capacity)
+            return false;
+        items_[head & (Capacity - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire))
+            return false;
+        item = items_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isLockFree() const { return head_.is_lock_free() && tail_.is_lock_free(); }
+
+private:
+    T items_[Capacity];
+    alignas(64) std::atomic<size_t> head_{ 0 };    // 生产者写入位置
+    alignas(64) std::atomic<size_t> tail_{ 0 };    // 消费者读取位置
+};
+
+/**
+ * @brief 单生产者/单消费者快照三缓冲
+ *
+ * 生产者在 writeBuffer() 上写完整个快照后 publish()，消费者用 acquire()
+ * 取最新的一份；消费者来不及读的旧快照直接被覆盖，双方都不会阻塞。
+ * 三份缓冲都会被反复复用，快照里的 vector 容量稳定后不再分配内存。
+ */
+template <typename T>
+class SnapshotBuffer
+{
+public:
+    /**
+     * @brief 生产者：当前可写的缓冲
+     */
+    T& writeBuffer() { return buffers_[writeIndex_]; }
+
+    /**
+     * @brief 生产者：发布刚写好的缓冲
+     */
+    void publish()
+    {
+        uint8_t previous = middle_.exchange(static_cast<uint8_t>(writeIndex_ | kFreshBit), std::memory_order_acq_rel);
+        writeIndex_ = previous & kIndexMask;
+    }
+
+    /**
+     * @brief 消费者：取最新发布的快照，没有新快照时返回 nullptr
+     *
+     * 返回的指针在下一次 acquire() 之前有效
+     */
+    const T* acquire()
+    {
+        if ((middle_.load(std::memory_order_acquire) & kFreshBit) == 0)
+            return nullptr;
+        uint8_t previous = middle_.exchange(readIndex_, std::memory_order_acq_rel);
+        readIndex_ = previous & kIndexMask;
+        return &buffers_[readIndex_];
+    }
+
+    bool isLockFree() const { return middle_.is_lock_free(); }
+
+private:
+    static const uint8_t kIndexMask = 0x3;
+    static const uint8_t kFreshBit = 0x4;
+
+    T buffers_[3];
+    std::atomic<uint8_t> middle_{ 1 };     // 中间缓冲下标，kFreshBit 表示消费者还没取走
+    uint8_t writeIndex_{ 0 };              // 只由生产者访问
+    uint8_t readIndex_{ 2 };               // 只由消费者访问
+};
+
+#endif // __SPSC_HANDOFF_H__
@@ -0,0 +1,102 @@
+#include "TexturePreloader.h"
+#include "tinyxml2/tinyxml2.h"
+#include <cstring>
+#include <unordered_map>
+
+USING_NS_CC;
+
+namespace {
+    // 每张地图的图块集图片路径；同一张地图（如每层矿洞都会预加载的农场）只扫描一次
+    std::unordered_map<std::string, std::vector<std::string>> s_tilesetImages;
+
+    bool parseXml(const std::string& fullPath, tinyxml2::XMLDocument& doc)
+    {
+        std::string content = FileUtils::getInstance()->getStringFromFile(fullPath);
+        return !content.empty() && doc.Parse(content.c_str(), content.size()) == tinyxml2::XML_SUCCESS;
+    }
+
+    /**
+     * @brief 取 tileset 元素下 <image source> 的路径，与 TMXMapInfo 一样相对地图所在目录
+     */
+    void collectImage(const tinyxml2::XMLElement* tileset, const std::string& dir, std::vector<std::string>& files)
+    {
+        const tinyxml2::XMLElement* image = tileset->FirstChildElement("image");
+        const char* source = image ? image->Attribute("source") : nullptr;
+        if (source && *source)
+        {
+            files.push_back(dir + source);
+        }
+    }
+
+    /**
+     * @brief 只读取 <tileset> 的图片属性，不解码图层的图块数据
+     */
+    bool scanTilesetImages(const std::string& tmxFile, std::vector<std::string>& files)
+    {
+        std::string fullPath = FileUtils::getInstance()->fullPathForFilename(tmxFile);
+        tinyxml2::XMLDocument doc;
+        if (fullPath.empty() || !parseXml(fullPath, doc))
+        {
+            return false;
+        }
+        const tinyxml2::XMLElement* map = doc.RootElement();
+        if (!map || strcmp(map->Name(), "map") != 0)
+        {
+            return false;
+        }
+
+        std::string dir = fullPath.substr(0, fullPath.find_last_of('/') + 1);
+        for (auto tileset = map->FirstChildElement("tileset"); tileset; tileset = tileset->NextSiblingElement("tileset"))
+        {
+            const char* external = tileset->Attribute("source");
+            if (external && *external)
+            {
+                // 外部图块集（.tsx）的图片路径同样按地图所在目录解析
+                tinyxml2::XMLDocument tsx;
+                if (parseXml(FileUtils::getInstance()->fullPathForFilename(dir + external), tsx) && tsx.RootElement())
+                {
+                    collectImage(tsx.RootElement(), dir, files);
+                }
+                continue;
+            }
+            collectImage(tileset, dir, files);
+        }
+        return true;
+    }
+}
+
+void TexturePreloader::preloadMap(const std::string& tmxFile, Priority priority, const std::string& group)
+{
+    auto it = s_tilesetImages.find(tmxFile);
+    if (it == s_tilesetImages.end())
+    {
+        std::vector<std::string> files;
+        if (!scanTilesetImages(tmxFile, files))
+        {
+            CCLOG("TexturePreloader: failed to parse %s", tmxFile.c_str());
+            return;
+        }
+        it = s_tilesetImages.emplace(tmxFile, std::move(files)).first;
+    }
+    preloadFiles(it->second, priority, group);
+}
+
+void TexturePreloader::preloadFiles(const std::vector<std::string>& files, Priority priority, const std::string& group)
+{
+    auto textureCache = Director::getInstance()->getTextureCache();
+    for (const auto& file : files)
+    {
+        // 已缓存的纹理会立即返回，不会重复解码
+        textureCache->addImageAsync(file, nullptr, group, priority);
+    }
+}
+
+void TexturePreloader::cancel(const std::string& group)
+{
+    Director::getInstance()->getTextureCache()->cancelImageAsync(group);
+}
+
+std::string TexturePreloader::groupFor(const void* owner)
+{
+    return StringUtils::format("preload_%p", owner);
+}
@@ -0,0 +1,44 @@
+#ifndef __TEXTURE_PRELOADER_H__
+#define __TEXTURE_PRELOADER_H__
+
+#include "cocos2d.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief 场景纹理预加载
+ *
+ * 通过 TextureCache 的异步管线提前解码下一张地图或下一批精灵的纹理：
+ * 解码分散在多个工作线程上，上传按每帧预算分摊，切换场景时不再集中卡顿。
+ * 每批请求属于一个分组，场景放弃时用 cancel() 取消该分组里还没完成的请求。
+ */
+class TexturePreloader
+{
+public:
+    using Priority = cocos2d::TextureCache::LoadPriority;
+
+    /**
+     * @brief 预加载 TMX 地图的所有图块集纹理
+     * @param tmxFile 地图文件
+     * @param priority 加载优先级
+     * @param group 分组，用于取消
+     */
+    static void preloadMap(const std::string& tmxFile, Priority priority, const std::string& group);
+
+    /**
+     * @brief 预加载一组纹理
+     */
+    static void preloadFiles(const std::vector<std::string>& files, Priority priority, const std::string& group);
+
+    /**
+     * @brief 取消分组中尚未完成的预加载
+     */
+    static void cancel(const std::string& group);
+
+    /**
+     * @brief 为某个对象生成唯一的分组名
+     */
+    static std::string groupFor(const void* owner);
+};
+
+#endif // __TEXTURE_PRELOADER_H__
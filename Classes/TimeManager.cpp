@@ -1,4 +1,5 @@
 #include "TimeManager.h"
+#include <algorithm>
 #include <cmath>
 
 TimeManager* TimeManager::instance_ = nullptr;
@@ -25,8 +26,11 @@ TimeManager::TimeManager()
     : dayTimer_(0.0f)
     , dayCount_(1)
     , lastFarmUpdateDay_(0)
+    , currentMinute_(0)
+    , nextTimerId_(1)
 {
     startNewDay();
+    currentMinute_ = getAbsoluteMinute();
 }
 
 TimeManager::~TimeManager()
@@ -45,6 +49,7 @@ void TimeManager::advanceToNextDay()
 {
     dayCount_++;
     startNewDay();
+    advanceClock();
 }
 
 void TimeManager::skipToNextMorning()
@@ -56,12 +61,14 @@ void TimeManager::skipToNextMorning()
     
     // Set slightly before to ensure update loop catches the trigger point
     dayTimer_ = nextMorning - 0.2f; 
+    advanceClock();
 }
 
 
 void TimeManager::update(float dt)
 {
     dayTimer_ += dt;
+    advanceClock();
 }
 
 int TimeManager::getHour() const
@@ -91,6 +98,8 @@ float TimeManager::getDayProgress() const
 void TimeManager::setDayCount(int day)
 {
     dayCount_ = day;
+    // Loading a save is not time passing: move the wheel without firing anything
+    rebaseClock();
 }
 
 bool TimeManager::isMidnight() const
@@ -103,3 +112,192 @@ bool TimeManager::isMidnight() const
     // So if timer >= SECONDS_PER_DAY, it is midnight.
     return dayTimer_ >= SECONDS_PER_DAY;
 }
+
+int TimeManager::getAbsoluteMinute() const
+{
+    return (dayCount_ - 1) * MINUTES_PER_DAY + static_cast<int>(dayTimer_ / SECONDS_PER_DAY * MINUTES_PER_DAY);
+}
+
+// ========== Timers ==========
+
+TimeManager::TimerId TimeManager::scheduleAt(int day, int hour, int minute, const TimerCallback& callback)
+{
+    return addTimer((day - 1) * MINUTES_PER_DAY + hour * 60 + minute, 0, callback);
+}
+
+TimeManager::TimerId TimeManager::scheduleEvery(int day, int hour, int minute, int intervalDays, const TimerCallback& callback)
+{
+    return addTimer((day - 1) * MINUTES_PER_DAY + hour * 60 + minute, std::max(intervalDays, 1) * MINUTES_PER_DAY, callback);
+}
+
+TimeManager::TimerId TimeManager::scheduleDaily(int hour, int minute, const TimerCallback& callback)
+{
+    int due = currentMinute_ - currentMinute_ % MINUTES_PER_DAY + hour * 60 + minute;
+    if (due <= currentMinute_)
+        due += MINUTES_PER_DAY;
+    return addTimer(due, MINUTES_PER_DAY, callback);
+}
+
+TimeManager::TimerId TimeManager::scheduleHourly(int minute, const TimerCallback& callback)
+{
+    int due = currentMinute_ - currentMinute_ % 60 + minute;
+    if (due <= currentMinute_)
+        due += 60;
+    return addTimer(due, 60, callback);
+}
+
+void TimeManager::cancelTimer(TimerId id)
+{
+    // The id stays in its wheel slot and is skipped when the slot comes up
+    timers_.erase(id);
+}
+
+bool TimeManager::isTimerPending(TimerId id) const
+{
+    return id != 0 && timers_.count(id) > 0;
+}
+
+TimeManager::TimerId TimeManager::addTimer(int due, int interval, const TimerCallback& callback)
+{
+    if (!callback)
+        return 0;
+
+    // Never insert into the slot that is being processed: past times fire on the next minute,
+    // repeating timers skip to their next occurrence
+    if (due <= currentMinute_)
+    {
+        if (interval > 0)
+            due += ((currentMinute_ - due) / interval + 1) * interval;
+        else
+            due = currentMinute_ + 1;
+    }
+
+    TimerId id = nextTimerId_++;
+    if (nextTimerId_ == 0)
+        nextTimerId_ = 1;
+
+    timers_[id] = { due, interval, callback };
+    insertTimer(id, due);
+    return id;
+}
+
+void TimeManager::insertTimer(TimerId id, int due)
+{
+    const int mask = WHEEL_SIZE - 1;
+    int delta = due - currentMinute_;
+    if (delta < WHEEL_SIZE)
+        wheel_[0][due & mask].push_back(id);
+    else if (delta < (1 << (2 * WHEEL_BITS)))
+        wheel_[1][(due >> WHEEL_BITS) & mask].push_back(id);
+    else if (delta < (1 << (3 * WHEEL_BITS)))
+        wheel_[2][(due >> (2 * WHEEL_BITS)) & mask].push_back(id);
+    else
+        overflow_.push_back(id);
+}
+
+void TimeManager::cascade(std::vector<TimerId>& slot)
+{
+    std::vector<TimerId> ids;
+    ids.swap(slot);
+    for (TimerId id : ids)
+    {
+        auto it = timers_.find(id);
+        if (it != timers_.end())
+            insertTimer(id, it->second.due);
+    }
+}
+
+void TimeManager::advanceClock()
+{
+    int target = getAbsoluteMinute();
+    if (target > currentMinute_)
+        advanceTo(target);
+    else if (target < currentMinute_)
+        rebaseClock();
+}
+
+void TimeManager::advanceTo(int minute)
+{
+    const int mask = WHEEL_SIZE - 1;
+    while (currentMinute_ < minute)
+    {
+        if (timers_.empty())
+        {
+            // Nothing pending: drop cancelled ids and jump straight to the target
+            for (auto& level : wheel_)
+                for (auto& slot : level)
+                    slot.clear();
+            overflow_.clear();
+            currentMinute_ = minute;
+            break;
+        }
+
+        ++currentMinute_;
+        int index = currentMinute_ & mask;
+        if (index == 0)
+        {
+            // Lower level wrapped: pull the next block of timers down one level
+            int index1 = (currentMinute_ >> WHEEL_BITS) & mask;
+            if (index1 == 0)
+            {
+                int index2 = (currentMinute_ >> (2 * WHEEL_BITS)) & mask;
+                if (index2 == 0)
+                    cascade(overflow_);
+                cascade(wheel_[2][index2]);
+            }
+            cascade(wheel_[1][index1]);
+        }
+
+        std::vector<TimerId> due;
+        due.swap(wheel_[0][index]);
+        for (TimerId id : due)
+        {
+            auto it = timers_.find(id);
+            if (it == timers_.end())
+                continue; // cancelled
+
+            Timer& timer = it->second;
+            if (timer.due > currentMinute_)
+            {
+                insertTimer(id, timer.due);
+                continue;
+            }
+
+            // Copy first: the callback may cancel this timer or schedule new ones
+            TimerCallback callback = timer.callback;
+            if (timer.interval > 0)
+            {
+                timer.due += timer.interval;
+                insertTimer(id, timer.due);
+            }
+            else
+            {
+                timers_.erase(it);
+            }
+            callback(currentMinute_ / MINUTES_PER_DAY + 1);
+        }
+    }
+}
+
+void TimeManager::rebaseClock()
+{
+    currentMinute_ = getAbsoluteMinute();
+
+    for (auto& level : wheel_)
+        for (auto& slot : level)
+            slot.clear();
+    overflow_.clear();
+
+    for (auto& entry : timers_)
+    {
+        Timer& timer = entry.second;
+        if (timer.due <= currentMinute_)
+        {
+            if (timer.interval > 0)
+                timer.due += ((currentMinute_ - timer.due) / timer.interval + 1) * timer.interval;
+            else
+                timer.due = currentMinute_ + 1;
+        }
+        insertTimer(entry.first, timer.due);
+    }
+}
@@ -1,9 +1,27 @@
 #ifndef __TIME_MANAGER_H__
 #define __TIME_MANAGER_H__
 
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Game clock plus a hierarchical timing wheel for in-game timers.
+ *
+ * Systems register callbacks at an in-game time (day/hour/minute) instead of
+ * polling the clock every frame. Time is tracked as an absolute game minute,
+ * (day - 1) * 24 * 60 + minute of day; because the day starts at 6:00 AM and
+ * runs past midnight, 0:00 after day N is the same instant as day N + 1 0:00.
+ * Only timers that are due fire when the clock advances.
+ */
 class TimeManager
 {
 public:
+    typedef unsigned int TimerId;                       // 0 is never a valid id
+    typedef std::function<void(int day)> TimerCallback; // day: calendar day the timer fired on
+
+    static const int MINUTES_PER_DAY = 24 * 60;
+
     static TimeManager* getInstance();
     static void destroyInstance();
 
@@ -29,16 +47,68 @@ public:
     // State checks
     bool isMidnight() const;
 
+    // Timers
+    int getAbsoluteMinute() const;
+
+    /**
+     * Fire once at the given in-game time. Times that already passed fire on the next update.
+     */
+    TimerId scheduleAt(int day, int hour, int minute, const TimerCallback& callback);
+
+    /**
+     * Fire at the given in-game time, then every intervalDays days.
+     */
+    TimerId scheduleEvery(int day, int hour, int minute, int intervalDays, const TimerCallback& callback);
+
+    /**
+     * Fire every day at hour:minute, starting with the next occurrence.
+     */
+    TimerId scheduleDaily(int hour, int minute, const TimerCallback& callback);
+
+    /**
+     * Fire every in-game hour at the given minute, starting with the next occurrence.
+     */
+    TimerId scheduleHourly(int minute, const TimerCallback& callback);
+
+    void cancelTimer(TimerId id);
+    bool isTimerPending(TimerId id) const;
+
 private:
     TimeManager();
     ~TimeManager();
     
     static TimeManager* instance_;
 
+    struct Timer
+    {
+        int due;            // absolute game minute
+        int interval;       // minutes between repeats, 0 = one shot
+        TimerCallback callback;
+    };
+
+    // Wheel geometry: 64 one-minute slots, 64 slots of 64 minutes, 64 slots of 4096 minutes.
+    // Anything further away (about 180 days) waits in overflow_.
+    static const int WHEEL_BITS = 6;
+    static const int WHEEL_SIZE = 1 << WHEEL_BITS;
+    static const int WHEEL_LEVELS = 3;
+
+    TimerId addTimer(int due, int interval, const TimerCallback& callback);
+    void insertTimer(TimerId id, int due);
+    void cascade(std::vector<TimerId>& slot);
+    void advanceClock();
+    void advanceTo(int minute);
+    void rebaseClock();
+
     float dayTimer_;      // Current seconds passed in day
     int dayCount_;        // Current day number
     int lastFarmUpdateDay_; // Track when farm was last updated
 
+    int currentMinute_;   // Absolute game minute the wheel has processed up to
+    TimerId nextTimerId_;
+    std::unordered_map<TimerId, Timer> timers_;
+    std::vector<TimerId> wheel_[WHEEL_LEVELS][WHEEL_SIZE];
+    std::vector<TimerId> overflow_;
+
     
     // Constants
     const float SECONDS_PER_DAY = 300.0f; // 5 minutes real time = 1 day
@@ -1,5 +1,7 @@
 #include "TreasureChest.h"
+#include "GameFont.h"
 #include "Weapon.h"
+#include "GameRandom.h"
 #include <cstdlib>
 
 USING_NS_CC;
@@ -70,7 +72,7 @@ void TreasureChest::initDisplay()
     this->addChild(displayNode_, 0);
 
     // 标签 (?)
-    label_ = Label::createWithSystemFont("?", "Arial", 12);
+    label_ = GameFont::createLabel("?", 12);
     label_->setPosition(Vec2(0, 24));
     label_->setColor(Color3B::YELLOW);
     // 浮动动画
@@ -100,7 +102,7 @@ TreasureChest::LootResult TreasureChest::generateLoot()
 
     // 根据楼层生成掉落物品
     // 楼层越深，掉落越好
-    int roll = rand() % 100;
+    int roll = GameRandom::getInstance()->nextInt(100);
 
     // 武器掉落概率：楼层1: 5%, 楼层2: 10%, 楼层3: 15%, 楼层4: 25%
     int weaponChance = 5 + (floorLevel_ - 1) * 5 + (floorLevel_ >= 3 ? 5 : 0);
@@ -108,7 +110,7 @@ TreasureChest::LootResult TreasureChest::generateLoot()
     if (roll < weaponChance)
     {
         // 掉落武器
-        int weaponRoll = rand() % 100;
+        int weaponRoll = GameRandom::getInstance()->nextInt(100);
 
         if (floorLevel_ >= 4 && weaponRoll < 20)
         {
@@ -135,32 +137,32 @@ TreasureChest::LootResult TreasureChest::generateLoot()
     else
     {
         // 掉落矿石或金币
-        int resourceRoll = rand() % 100;
+        int resourceRoll = GameRandom::getInstance()->nextInt(100);
 
         if (floorLevel_ >= 3 && resourceRoll < 30)
         {
             // 金矿
             result.item = ItemType::GoldOre;
-            result.count = 1 + rand() % 2;  // 1-2个
+            result.count = 1 + GameRandom::getInstance()->nextInt(2);  // 1-2个
             result.message = StringUtils::format("Found %d Gold Ore!", result.count);
         }
         else if (floorLevel_ >= 2 && resourceRoll < 60)
         {
             // 银矿
             result.item = ItemType::SilverOre;
-            result.count = 1 + rand() % 3;  // 1-3个
+            result.count = 1 + GameRandom::getInstance()->nextInt(3);  // 1-3个
             result.message = StringUtils::format("Found %d Silver Ore!", result.count);
         }
         else
         {
             // 铜矿
             result.item = ItemType::CopperOre;
-            result.count = 2 + rand() % 4;  // 2-5个
+            result.count = 2 + GameRandom::getInstance()->nextInt(4);  // 2-5个
             result.message = StringUtils::format("Found %d Copper Ore!", result.count);
         }
     }
 
-    CCLOG("Chest opened: %s x%d", InventoryManager::getItemName(result.item).c_str(), result.count);
+    CCLOG("Chest opened: %s x%d", InventoryManager::getItemName(result.item), result.count);
 
     return result;
 }
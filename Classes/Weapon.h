@@ -19,12 +19,13 @@ public:
     virtual ~Weapon() = default;
 
     // ========== 属性获取 ==========
+    // 数值来自 ItemRegistry，子类只需给出物品类型
 
-    virtual std::string getName() const = 0;
-    virtual int getAttackPower() const = 0;
-    virtual float getAttackRange() const = 0;
-    virtual float getAttackSpeed() const = 0;
-    virtual int getPrice() const = 0;
+    virtual std::string getName() const { return ItemRegistry::get(getItemType()).name; }
+    virtual int getAttackPower() const { return getWeaponAttackPower(getItemType()); }
+    virtual float getAttackRange() const { return getWeaponAttackRange(getItemType()); }
+    virtual float getAttackSpeed() const { return getWeaponAttackSpeed(getItemType()); }
+    virtual int getPrice() const { return getWeaponPrice(getItemType()); }
 
     /**
      * @brief 获取对应的物品类型
@@ -34,7 +35,7 @@ public:
     /**
      * @brief 获取贴图路径（预留）
      */
-    virtual std::string getSpritePath() const { return ""; }
+    virtual std::string getSpritePath() const { return ItemRegistry::get(getItemType()).weapon.spritePath; }
 
     /**
      * @brief 根据物品类型获取武器数据
@@ -51,13 +52,7 @@ public:
 class WoodenSword : public Weapon
 {
 public:
-    std::string getName() const override { return "Wooden Sword"; }
-    int getAttackPower() const override { return 10; }
-    float getAttackRange() const override { return 50.0f; }
-    float getAttackSpeed() const override { return 1.0f; }
-    int getPrice() const override { return 50; }
     ItemType getItemType() const override { return ItemType::ITEM_WoodenSword; }
-    std::string getSpritePath() const override { return "weapons/wooden_sword.png"; }
 };
 
 /**
@@ -66,13 +61,7 @@ public:
 class IronSword : public Weapon
 {
 public:
-    std::string getName() const override { return "Iron Sword"; }
-    int getAttackPower() const override { return 25; }
-    float getAttackRange() const override { return 55.0f; }
-    float getAttackSpeed() const override { return 0.9f; }
-    int getPrice() const override { return 150; }
     ItemType getItemType() const override { return ItemType::ITEM_IronSword; }
-    std::string getSpritePath() const override { return "weapons/iron_sword.png"; }
 };
 
 /**
@@ -81,13 +70,7 @@ public:
 class GoldSword : public Weapon
 {
 public:
-    std::string getName() const override { return "Gold Sword"; }
-    int getAttackPower() const override { return 40; }
-    float getAttackRange() const override { return 60.0f; }
-    float getAttackSpeed() const override { return 0.8f; }
-    int getPrice() const override { return 400; }
     ItemType getItemType() const override { return ItemType::ITEM_GoldSword; }
-    std::string getSpritePath() const override { return "weapons/gold_sword.png"; }
 };
 
 /**
@@ -96,13 +79,7 @@ public:
 class DiamondSword : public Weapon
 {
 public:
-    std::string getName() const override { return "Diamond Sword"; }
-    int getAttackPower() const override { return 60; }
-    float getAttackRange() const override { return 65.0f; }
-    float getAttackSpeed() const override { return 0.7f; }
-    int getPrice() const override { return 1000; }
     ItemType getItemType() const override { return ItemType::ITEM_DiamondSword; }
-    std::string getSpritePath() const override { return "weapons/diamond_sword.png"; }
 };
 
 #endif // __WEAPON_H__
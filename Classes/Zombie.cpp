@@ -1,4 +1,5 @@
 #include "Zombie.h"
+#include "GameFont.h"
 
 USING_NS_CC;
 
@@ -95,7 +96,7 @@ void Zombie::initDisplay()
     }
 
     // 血条显示
-    hpLabel_ = Label::createWithSystemFont("", "Arial", 10);
+    hpLabel_ = GameFont::createLabel("", 10);
     hpLabel_->setPosition(Vec2(0, 22));
     hpLabel_->setColor(Color3B::RED);
     this->addChild(hpLabel_, 1);
@@ -25,6 +25,8 @@
  ****************************************************************************/
 
 #include "2d/CCFontAtlas.h"
+#include <algorithm>
+#include <cmath>
 #if CC_TARGET_PLATFORM != CC_PLATFORM_WIN32 && CC_TARGET_PLATFORM != CC_PLATFORM_WINRT && CC_TARGET_PLATFORM != CC_PLATFORM_ANDROID
 #include <iconv.h>
 #elif CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
@@ -49,10 +51,11 @@ FontAtlas::FontAtlas(Font &theFont)
 , _fontFreeType(nullptr)
 , _iconv(nullptr)
 , _currentPageData(nullptr)
+, _dirtyMinY(0)
+, _dirtyMaxY(0)
 , _fontAscender(0)
 , _rendererRecreatedListener(nullptr)
 , _antialiasEnabled(true)
-, _currLineHeight(0)
 {
     _font->retain();
 
@@ -62,8 +65,6 @@ FontAtlas::FontAtlas(Font &theFont)
         _lineHeight = _font->getFontMaxHeight();
         _fontAscender = _fontFreeType->getFontAscender();
         _currentPage = 0;
-        _currentPageOrigX = 0;
-        _currentPageOrigY = 0;
         _letterEdgeExtend = 2;
         _letterPadding = 0;
 
@@ -111,6 +112,10 @@ void FontAtlas::reinit()
     
     addTexture(texture,0);
     texture->release();
+
+    _skyline.assign(1, SkylineNode{0, 0, CacheTextureWidth});
+    _dirtyMinY = CacheTextureHeight;
+    _dirtyMaxY = 0;
 }
 
 FontAtlas::~FontAtlas()
@@ -142,10 +147,7 @@ void FontAtlas::reset()
 {
     releaseTextures();
     
-    _currLineHeight = 0;
     _currentPage = 0;
-    _currentPageOrigX = 0;
-    _currentPageOrigY = 0;
     _letterDefinitions.clear();
     
     reinit();
@@ -355,14 +357,14 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
     int adjustForExtend = _letterEdgeExtend / 2;
     long bitmapWidth;
     long bitmapHeight;
+    int glyphWidth;
     int glyphHeight;
+    int glyphX;
+    int glyphY;
     Rect tempRect;
     FontLetterDefinition tempDef;
 
     auto scaleFactor = CC_CONTENT_SCALE_FACTOR();
-    auto  pixelFormat = _fontFreeType->getOutlineSize() > 0 ? Texture2D::PixelFormat::AI88 : Texture2D::PixelFormat::A8;
-
-    float startY = _currentPageOrigY;
 
     for (auto&& it : codeMapOfNewChar)
     {
@@ -375,56 +377,29 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
             tempDef.offsetX = tempRect.origin.x - adjustForDistanceMap - adjustForExtend;
             tempDef.offsetY = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
 
-            if (_currentPageOrigX + tempDef.width > CacheTextureWidth)
+            // one pixel of gap on the right and bottom keeps linear filtering from bleeding into neighbours
+            glyphWidth = static_cast<int>(std::ceil(tempDef.width)) + 1;
+            glyphHeight = std::max(static_cast<int>(std::ceil(tempDef.height)),
+                static_cast<int>(bitmapHeight) + _letterPadding + _letterEdgeExtend) + 1;
+            if (!allocateGlyphRect(glyphWidth, glyphHeight, glyphX, glyphY))
             {
-                _currentPageOrigY += _currLineHeight;
-                _currLineHeight = 0;
-                _currentPageOrigX = 0;
-                if (_currentPageOrigY + _lineHeight + _letterPadding + _letterEdgeExtend >= CacheTextureHeight)
+                addNewPage();
+                if (!allocateGlyphRect(glyphWidth, glyphHeight, glyphX, glyphY))
                 {
-                    unsigned char *data = nullptr;
-                    if (pixelFormat == Texture2D::PixelFormat::AI88)
-                    {
-                        data = _currentPageData + CacheTextureWidth * (int)startY * 2;
-                    }
-                    else
-                    {
-                        data = _currentPageData + CacheTextureWidth * (int)startY;
-                    }
-                    _atlasTextures[_currentPage]->updateWithData(data, 0, startY,
-                        CacheTextureWidth, CacheTextureHeight - startY);
-
-                    startY = 0.0f;
-
-                    _currentPageOrigY = 0;
-                    memset(_currentPageData, 0, _currentPageDataSize);
-                    _currentPage++;
-                    auto tex = new (std::nothrow) Texture2D;
-                    if (_antialiasEnabled)
-                    {
-                        tex->setAntiAliasTexParameters();
-                    }
-                    else
-                    {
-                        tex->setAliasTexParameters();
-                    }
-                    tex->initWithData(_currentPageData, _currentPageDataSize,
-                        pixelFormat, CacheTextureWidth, CacheTextureHeight, Size(CacheTextureWidth, CacheTextureHeight));
-                    addTexture(tex, _currentPage);
-                    tex->release();
+                    CCLOG("FontAtlas::prepareLetterDefinitions: glyph %u does not fit in an atlas page", (unsigned int)it.first);
+                    // renderCharAt owns the bitmap of outlined glyphs, it is released here instead
+                    if (_fontFreeType->getOutlineSize() > 0)
+                        delete[] bitmap;
+                    tempDef.validDefinition = false;
+                    _letterDefinitions[it.first] = tempDef;
+                    continue;
                 }
             }
-            glyphHeight = static_cast<int>(bitmapHeight) + _letterPadding + _letterEdgeExtend;
-            if (glyphHeight > _currLineHeight)
-            {
-                _currLineHeight = glyphHeight;
-            }
-            _fontFreeType->renderCharAt(_currentPageData, _currentPageOrigX + adjustForExtend, _currentPageOrigY + adjustForExtend, bitmap, bitmapWidth, bitmapHeight);
+            _fontFreeType->renderCharAt(_currentPageData, glyphX + adjustForExtend, glyphY + adjustForExtend, bitmap, bitmapWidth, bitmapHeight);
 
-            tempDef.U = _currentPageOrigX;
-            tempDef.V = _currentPageOrigY;
+            tempDef.U = glyphX;
+            tempDef.V = glyphY;
             tempDef.textureID = _currentPage;
-            _currentPageOrigX += tempDef.width + 1;
             // take from pixels to points
             tempDef.width = tempDef.width / scaleFactor;
             tempDef.height = tempDef.height / scaleFactor;
@@ -446,26 +421,142 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
             tempDef.offsetX = 0;
             tempDef.offsetY = 0;
             tempDef.textureID = 0;
-            _currentPageOrigX += 1;
         }
 
         _letterDefinitions[it.first] = tempDef;
     }
 
-    unsigned char *data = nullptr;
-    if (pixelFormat == Texture2D::PixelFormat::AI88)
+    uploadDirtyRows();
+
+    return true;
+}
+
+std::u32string FontAtlas::getPreparedCharacters() const
+{
+    std::u32string characters;
+    characters.reserve(_letterDefinitions.size());
+    for (const auto& item : _letterDefinitions)
     {
-        data = _currentPageData + CacheTextureWidth * (int)startY * 2;
+        characters.push_back(item.first);
     }
-    else
+    return characters;
+}
+
+bool FontAtlas::allocateGlyphRect(int width, int height, int& outX, int& outY)
+{
+    // Bottom-left rule: the position whose top edge is lowest wins, ties go to the narrowest segment
+    int bestIndex = -1;
+    int bestBottom = CacheTextureHeight + 1;
+    int bestWidth = CacheTextureWidth + 1;
+    int bestY = 0;
+    const int count = static_cast<int>(_skyline.size());
+    for (int i = 0; i < count; ++i)
     {
-        data = _currentPageData + CacheTextureWidth * (int)startY;
+        const int x = _skyline[i].x;
+        if (x + width > CacheTextureWidth)
+            break;
+
+        // the glyph rests on the highest segment it spans
+        int y = 0;
+        int widthLeft = width;
+        for (int j = i; widthLeft > 0 && j < count; ++j)
+        {
+            y = std::max(y, _skyline[j].y);
+            widthLeft -= _skyline[j].width;
+        }
+        if (y + height > CacheTextureHeight)
+            continue;
+
+        if (y + height < bestBottom || (y + height == bestBottom && _skyline[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestBottom = y + height;
+            bestWidth = _skyline[i].width;
+            bestY = y;
+        }
     }
-    _atlasTextures[_currentPage]->updateWithData(data, 0, startY, CacheTextureWidth, _currentPageOrigY - startY + _currLineHeight);
 
+    if (bestIndex < 0)
+        return false;
+
+    outX = _skyline[bestIndex].x;
+    outY = bestY;
+
+    // raise the skyline over the glyph and trim the segments it covers
+    _skyline.insert(_skyline.begin() + bestIndex, SkylineNode{outX, bestBottom, width});
+    const int right = outX + width;
+    size_t i = bestIndex + 1;
+    while (i < _skyline.size() && _skyline[i].x < right)
+    {
+        const int segmentRight = _skyline[i].x + _skyline[i].width;
+        if (segmentRight <= right)
+        {
+            _skyline.erase(_skyline.begin() + i);
+        }
+        else
+        {
+            _skyline[i].width = segmentRight - right;
+            _skyline[i].x = right;
+            break;
+        }
+    }
+
+    // neighbours at the same height are merged, so the skyline stays short
+    for (size_t j = 0; j + 1 < _skyline.size();)
+    {
+        if (_skyline[j].y == _skyline[j + 1].y)
+        {
+            _skyline[j].width += _skyline[j + 1].width;
+            _skyline.erase(_skyline.begin() + j + 1);
+        }
+        else
+        {
+            ++j;
+        }
+    }
+
+    _dirtyMinY = std::min(_dirtyMinY, outY);
+    _dirtyMaxY = std::max(_dirtyMaxY, bestBottom);
     return true;
 }
 
+void FontAtlas::uploadDirtyRows()
+{
+    if (_dirtyMinY >= _dirtyMaxY)
+        return;
+
+    int bytesPerPixel = _fontFreeType->getOutlineSize() > 0 ? 2 : 1;
+    unsigned char *data = _currentPageData + CacheTextureWidth * _dirtyMinY * bytesPerPixel;
+    _atlasTextures[_currentPage]->updateWithData(data, 0, _dirtyMinY, CacheTextureWidth, _dirtyMaxY - _dirtyMinY);
+
+    _dirtyMinY = CacheTextureHeight;
+    _dirtyMaxY = 0;
+}
+
+void FontAtlas::addNewPage()
+{
+    uploadDirtyRows();
+
+    auto  pixelFormat = _fontFreeType->getOutlineSize() > 0 ? Texture2D::PixelFormat::AI88 : Texture2D::PixelFormat::A8;
+    memset(_currentPageData, 0, _currentPageDataSize);
+    _currentPage++;
+    auto tex = new (std::nothrow) Texture2D;
+    if (_antialiasEnabled)
+    {
+        tex->setAntiAliasTexParameters();
+    }
+    else
+    {
+        tex->setAliasTexParameters();
+    }
+    tex->initWithData(_currentPageData, _currentPageDataSize,
+        pixelFormat, CacheTextureWidth, CacheTextureHeight, Size(CacheTextureWidth, CacheTextureHeight));
+    addTexture(tex, _currentPage);
+    tex->release();
+
+    _skyline.assign(1, SkylineNode{0, 0, CacheTextureWidth});
+}
+
 void FontAtlas::addTexture(Texture2D *texture, int slot)
 {
     texture->retain();
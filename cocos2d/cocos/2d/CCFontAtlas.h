@@ -31,6 +31,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "platform/CCPlatformMacros.h"
 #include "base/CCRef.h"
@@ -79,6 +80,11 @@ public:
     
     bool prepareLetterDefinitions(const std::u32string& utf16String);
 
+    /** Characters that have a letter definition in this atlas, in no particular order.
+     * @since v3.17
+     */
+    std::u32string getPreparedCharacters() const;
+
     const std::unordered_map<ssize_t, Texture2D*>& getTextures() const { return _atlasTextures; }
     void  addTexture(Texture2D *texture, int slot);
     float getLineHeight() const { return _lineHeight; }
@@ -127,6 +133,27 @@ protected:
      */
     void scaleFontLetterDefinition(float scaleFactor);
 
+    /**
+     * Finds room for a glyph on the current page with a bottom-left skyline packer.
+     *
+     * @return False if the page is full, the caller should start a new page.
+     */
+    bool allocateGlyphRect(int width, int height, int& outX, int& outY);
+
+    /** Uploads the rows of the current page touched since the last upload. */
+    void uploadDirtyRows();
+
+    /** Uploads the current page and starts an empty one. */
+    void addNewPage();
+
+    /** A horizontal segment of the skyline, the top edge of the glyphs packed below it. */
+    struct SkylineNode
+    {
+        int x;
+        int y;
+        int width;
+    };
+
     std::unordered_map<ssize_t, Texture2D*> _atlasTextures;
     std::unordered_map<char32_t, FontLetterDefinition> _letterDefinitions;
     float _lineHeight;
@@ -138,15 +165,15 @@ protected:
     int _currentPage;
     unsigned char *_currentPageData;
     int _currentPageDataSize;
-    float _currentPageOrigX;
-    float _currentPageOrigY;
+    std::vector<SkylineNode> _skyline;
+    int _dirtyMinY;
+    int _dirtyMaxY;
     int _letterPadding;
     int _letterEdgeExtend;
 
     int _fontAscender;
     EventListenerCustom* _rendererRecreatedListener;
     bool _antialiasEnabled;
-    int _currLineHeight;
 
     friend class Label;
 };
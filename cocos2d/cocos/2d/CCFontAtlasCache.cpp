@@ -32,10 +32,12 @@
 #include "2d/CCFontCharMap.h"
 #include "2d/CCLabel.h"
 #include "platform/CCFileUtils.h"
+#include "base/ccUTF8.h"
 
 NS_CC_BEGIN
 
 std::unordered_map<std::string, FontAtlas *> FontAtlasCache::_atlasMap;
+std::unordered_map<std::string, FontAtlasCache::GlyphCacheConfig> FontAtlasCache::_glyphCacheConfigs;
 #define ATLAS_MAP_KEY_BUFFER 255
 
 void FontAtlasCache::purgeCachedData()
@@ -49,6 +51,7 @@ void FontAtlasCache::purgeCachedData()
             atlas.second->purgeTexturesAtlas();
     }
     _atlasMap.clear();
+    _glyphCacheConfigs.clear();
 }
 
 FontAtlas* FontAtlasCache::getFontAtlasTTF(const _ttfConfig* config)
@@ -60,12 +63,15 @@ FontAtlas* FontAtlasCache::getFontAtlasTTF(const _ttfConfig* config)
         useDistanceField = false;
     }
 
+    // distance fields scale to any size, so all sizes share the atlas rasterized at one size
+    float fontSize = useDistanceField ? Label::DistanceFieldFontSize : config->fontSize;
+
     char tmp[ATLAS_MAP_KEY_BUFFER];
     if (useDistanceField) {
-        snprintf(tmp, ATLAS_MAP_KEY_BUFFER, "df %.2f %d %s", config->fontSize, config->outlineSize,
+        snprintf(tmp, ATLAS_MAP_KEY_BUFFER, "df %.2f %d %s", fontSize, config->outlineSize,
                  realFontFilename.c_str());
     } else {
-        snprintf(tmp, ATLAS_MAP_KEY_BUFFER, "%.2f %d %s", config->fontSize, config->outlineSize,
+        snprintf(tmp, ATLAS_MAP_KEY_BUFFER, "%.2f %d %s", fontSize, config->outlineSize,
                  realFontFilename.c_str());
     }
     std::string atlasName = tmp;
@@ -74,7 +80,7 @@ FontAtlas* FontAtlasCache::getFontAtlasTTF(const _ttfConfig* config)
 
     if ( it == _atlasMap.end() )
     {
-        auto font = FontFreeType::create(realFontFilename, config->fontSize, config->glyphs,
+        auto font = FontFreeType::create(realFontFilename, fontSize, config->glyphs,
             config->customGlyphs, useDistanceField, config->outlineSize);
         if (font)
         {
@@ -82,6 +88,11 @@ FontAtlas* FontAtlasCache::getFontAtlasTTF(const _ttfConfig* config)
             if (tempAtlas)
             {
                 _atlasMap[atlasName] = tempAtlas;
+                if (config->glyphs == GlyphCollection::DYNAMIC)
+                {
+                    GlyphCacheConfig cacheConfig = { realFontFilename, fontSize, config->outlineSize, useDistanceField };
+                    _glyphCacheConfigs[atlasName] = cacheConfig;
+                }
                 return _atlasMap[atlasName];
             }
         }
@@ -209,6 +220,7 @@ bool FontAtlasCache::releaseFontAtlas(FontAtlas *atlas)
             {
                 if (atlas->getReferenceCount() == 1)
                 {
+                  _glyphCacheConfigs.erase(item.first);
                   _atlasMap.erase(item.first);
                 }
                 
@@ -255,6 +267,7 @@ void FontAtlasCache::unloadFontAtlasTTF(const std::string& fontFileName)
         if (item->first.find(fontFileName) != std::string::npos)
         {
             CC_SAFE_RELEASE_NULL(item->second);
+            _glyphCacheConfigs.erase(item->first);
             item = _atlasMap.erase(item);
         }
         else
@@ -262,4 +275,104 @@ void FontAtlasCache::unloadFontAtlasTTF(const std::string& fontFileName)
     }
 }
 
+bool FontAtlasCache::preloadFontAtlasTTF(const _ttfConfig* config, const std::string& utf8Text)
+{
+    auto atlas = getFontAtlasTTF(config);
+    if (!atlas)
+        return false;
+
+    std::u32string utf32Text;
+    if (StringUtils::UTF8ToUTF32(utf8Text, utf32Text))
+    {
+        atlas->prepareLetterDefinitions(utf32Text);
+    }
+    return true;
+}
+
+int FontAtlasCache::saveGlyphCache(const std::string& fullPath)
+{
+    std::string content;
+    int count = 0;
+    char prefix[ATLAS_MAP_KEY_BUFFER];
+    for (const auto& item : _glyphCacheConfigs)
+    {
+        auto it = _atlasMap.find(item.first);
+        if (it == _atlasMap.end())
+            continue;
+
+        // control characters would break the line format and have no glyphs anyway
+        std::u32string characters;
+        for (auto character : it->second->getPreparedCharacters())
+        {
+            if (character >= 0x20 && character != 0x7f)
+                characters.push_back(character);
+        }
+        std::string utf8Characters;
+        if (characters.empty() || !StringUtils::UTF32ToUTF8(characters, utf8Characters))
+            continue;
+
+        const GlyphCacheConfig& config = item.second;
+        snprintf(prefix, ATLAS_MAP_KEY_BUFFER, "%.2f\t%d\t%d\t", config.fontSize, config.outlineSize, config.distanceFieldEnabled ? 1 : 0);
+        content += prefix;
+        content += config.fontFilePath;
+        content += '\t';
+        content += utf8Characters;
+        content += '\n';
+        ++count;
+    }
+
+    if (!FileUtils::getInstance()->writeStringToFile(content, fullPath))
+    {
+        CCLOG("FontAtlasCache::saveGlyphCache: can not write %s", fullPath.c_str());
+        return -1;
+    }
+    return count;
+}
+
+int FontAtlasCache::loadGlyphCache(const std::string& filename)
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(filename))
+        return 0;
+
+    std::string content = fileUtils->getStringFromFile(filename);
+    int count = 0;
+    size_t lineStart = 0;
+    while (lineStart < content.size())
+    {
+        size_t lineEnd = content.find('\n', lineStart);
+        if (lineEnd == std::string::npos)
+            lineEnd = content.size();
+        std::string line = content.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        size_t fields[4];
+        size_t position = 0;
+        bool valid = true;
+        for (auto& field : fields)
+        {
+            position = line.find('\t', position);
+            if (position == std::string::npos)
+            {
+                valid = false;
+                break;
+            }
+            field = position++;
+        }
+        if (!valid)
+            continue;
+
+        TTFConfig config(line.substr(fields[2] + 1, fields[3] - fields[2] - 1),
+            static_cast<float>(atof(line.c_str())));
+        config.outlineSize = atoi(line.c_str() + fields[0] + 1);
+        config.distanceFieldEnabled = config.outlineSize <= 0 && atoi(line.c_str() + fields[1] + 1) != 0;
+        if (config.fontSize <= 0 || !fileUtils->isFileExist(config.fontFilePath))
+            continue;
+
+        if (preloadFontAtlasTTF(&config, line.substr(fields[3] + 1)))
+            ++count;
+    }
+    return count;
+}
+
 NS_CC_END
@@ -67,8 +67,39 @@ public:
     */
     static void unloadFontAtlasTTF(const std::string& fontFileName);
 
+    /** Creates the TTF atlas of a config if needed and rasterizes the glyphs of a text into it,
+     so labels created later find them in the atlas.
+     @return False if the font could not be loaded.
+     @since v3.17
+     */
+    static bool preloadFontAtlasTTF(const _ttfConfig* config, const std::string& utf8Text);
+
+    /** Writes the fonts, sizes and characters of all dynamic TTF atlases to a glyph cache file.
+     Each line holds "<font size>\t<outline size>\t<distance field>\t<font file>\t<UTF-8 characters>".
+     @param fullPath Full path of the file to write, usually in the writable path.
+     @return The number of atlases written, or -1 if the file could not be written.
+     @since v3.17
+     */
+    static int saveGlyphCache(const std::string& fullPath);
+
+    /** Rebuilds the atlases listed in a glyph cache file written by saveGlyphCache().
+     @return The number of atlases preloaded.
+     @since v3.17
+     */
+    static int loadGlyphCache(const std::string& filename);
+
 private:
+    struct GlyphCacheConfig
+    {
+        std::string fontFilePath;
+        float fontSize;
+        int outlineSize;
+        bool distanceFieldEnabled;
+    };
+
     static std::unordered_map<std::string, FontAtlas *> _atlasMap;
+    // configs of the dynamic TTF atlases in _atlasMap, by the same key, for saveGlyphCache()
+    static std::unordered_map<std::string, GlyphCacheConfig> _glyphCacheConfigs;
 };
 
 NS_CC_END
@@ -27,6 +27,8 @@
 #include "2d/CCLabel.h"
 
 #include <algorithm>
+#include <map>
+#include <tuple>
 
 #include "2d/CCFont.h"
 #include "2d/CCFontAtlasCache.h"
@@ -38,15 +40,20 @@
 #include "base/ccUTF8.h"
 #include "platform/CCFileUtils.h"
 #include "renderer/CCRenderer.h"
+#include "renderer/CCGLProgramCache.h"
 #include "renderer/ccGLStateCache.h"
 #include "base/CCDirector.h"
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventCustom.h"
 #include "2d/CCFontFNT.h"
+#include "2d/CCFontFreeType.h"
+#include "platform/CCGLView.h"
 
 NS_CC_BEGIN
 
+const float Label::DistanceFieldFontSize = 32.f;
+
 /**
  * LabelLetter used to update the quad in texture atlas without SpriteBatchNode.
  */
@@ -510,6 +517,8 @@ void Label::reset()
     _uniformEffectColor = -1;
     _uniformEffectType = -1;
     _uniformTextColor = -1;
+    _uniformSmoothing = -1;
+    _uniformOutlineEdge = -1;
 
     _useDistanceField = false;
     _useA8Shader = false;
@@ -563,7 +572,13 @@ void Label::updateShaderProgram()
 
         break;
     case cocos2d::LabelEffect::OUTLINE: 
-        setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_LABEL_OUTLINE));
+        if (_useDistanceField)
+        {
+            setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_OUTLINE));
+            _uniformOutlineEdge = glGetUniformLocation(getGLProgram()->getProgram(), "u_outlineEdge");
+        }
+        else
+            setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_LABEL_OUTLINE));
         _uniformEffectColor = glGetUniformLocation(getGLProgram()->getProgram(), "u_effectColor");
         _uniformEffectType = glGetUniformLocation(getGLProgram()->getProgram(), "u_effectType");
         break;
@@ -579,6 +594,7 @@ void Label::updateShaderProgram()
     }
     
     _uniformTextColor = glGetUniformLocation(getGLProgram()->getProgram(), "u_textColor");
+    _uniformSmoothing = _useDistanceField ? glGetUniformLocation(getGLProgram()->getProgram(), "u_smoothing") : -1;
 }
 
 void Label::setFontAtlas(FontAtlas* atlas,bool distanceFieldEnabled /* = false */, bool useA8Shader /* = false */)
@@ -984,6 +1000,8 @@ bool Label::setTTFConfigInternal(const TTFConfig& ttfConfig)
     setFontAtlas(newAtlas,ttfConfig.distanceFieldEnabled,true);
 
     _fontConfig = ttfConfig;
+    // distance field sizes share one atlas, so a new size may not have changed the atlas
+    _contentDirty = true;
 
     if (_fontConfig.outlineSize > 0)
     {
@@ -1025,7 +1043,14 @@ void Label::scaleFontSizeDown(float fontSize)
     if(_currentLabelType == LabelType::TTF){
         auto ttfConfig = this->getTTFConfig();
         ttfConfig.fontSize = fontSize;
+        auto effect = _currLabelEffect;
         this->setTTFConfigInternal(ttfConfig);
+        // distance field effects are drawn by the shader, they survive a change of size
+        if (_useDistanceField && effect != _currLabelEffect)
+        {
+            _currLabelEffect = effect;
+            updateShaderProgram();
+        }
     }else if(_currentLabelType == LabelType::BMFONT){
         if (std::abs(fontSize) < FLT_EPSILON) {
             fontSize = 0.1f;
@@ -1068,7 +1093,23 @@ void Label::enableOutline(const Color4B& outlineColor,int outlineSize /* = -1 */
 
     if (outlineSize > 0 || _currLabelEffect == LabelEffect::OUTLINE)
     {
-        if (_currentLabelType == LabelType::TTF)
+        if (_currentLabelType == LabelType::TTF && _useDistanceField)
+        {
+            _effectColorF.r = outlineColor.r / 255.0f;
+            _effectColorF.g = outlineColor.g / 255.0f;
+            _effectColorF.b = outlineColor.b / 255.0f;
+            _effectColorF.a = outlineColor.a / 255.0f;
+
+            // keep the distance field atlas, the shader draws the outline
+            if (_currLabelEffect != LabelEffect::OUTLINE)
+            {
+                _currLabelEffect = LabelEffect::OUTLINE;
+                updateShaderProgram();
+            }
+            if (outlineSize <= 0)
+                outlineSize = static_cast<int>(_outlineSize);
+        }
+        else if (_currentLabelType == LabelType::TTF)
         {
             _effectColorF.r = outlineColor.r / 255.0f;
             _effectColorF.g = outlineColor.g / 255.0f;
@@ -1194,12 +1235,16 @@ void Label::disableEffect(LabelEffect effect)
         case cocos2d::LabelEffect::OUTLINE:
             if (_currLabelEffect == LabelEffect::OUTLINE)
             {
-                if (_currentLabelType == LabelType::TTF)
+                if (_currentLabelType == LabelType::TTF && !_useDistanceField)
                 {
                     _fontConfig.outlineSize = 0;
                     setTTFConfig(_fontConfig);
                 }
                 _currLabelEffect = LabelEffect::NORMAL;
+                if (_useDistanceField)
+                {
+                    updateShaderProgram();
+                }
                 _contentDirty = true;
             }
             break;
@@ -1530,6 +1575,11 @@ void Label::onDraw(const Mat4& transform, bool /*transformUpdated*/)
     glprogram->use();
     GL::blendFunc(_blendFunc.src, _blendFunc.dst);
 
+    if (_useDistanceField && _currentLabelType == LabelType::TTF)
+    {
+        updateDistanceFieldUniforms(glprogram, transform);
+    }
+
     if (_shadowEnabled)
     {
         if (_boldEnabled)
@@ -1548,6 +1598,15 @@ void Label::onDraw(const Mat4& transform, bool /*transformUpdated*/)
     {
         switch (_currLabelEffect) {
         case LabelEffect::OUTLINE:
+            if (_useDistanceField)
+            {
+                // the distance field shader draws outline and text in one pass
+                glprogram->setUniformLocationWith1i(_uniformEffectType, 0);
+                glprogram->setUniformLocationWith4f(_uniformEffectColor,
+                    _effectColorF.r, _effectColorF.g, _effectColorF.b, _effectColorF.a);
+                glprogram->setUniformLocationWith4f(_uniformTextColor, _textColorF.r, _textColorF.g, _textColorF.b, _textColorF.a);
+                break;
+            }
             // draw outline of text
             glprogram->setUniformLocationWith1i(_uniformEffectType, 1); // 1: outline
             glprogram->setUniformLocationWith4f(_uniformEffectColor,
@@ -1579,6 +1638,118 @@ void Label::onDraw(const Mat4& transform, bool /*transformUpdated*/)
     }
 }
 
+float Label::getDistanceFieldSmoothing(const Mat4& transform) const
+{
+    // texels are 0.5 on the glyph edge and change by 16/255 per atlas pixel, see makeDistanceMap()
+    const float distancePerTexel = 16.f / 255.f;
+
+    // atlas pixels covered by one screen pixel, with font size, node scale and view scale applied
+    float nodeScale = std::sqrt(transform.m[0] * transform.m[0] + transform.m[1] * transform.m[1]);
+    auto glView = Director::getInstance()->getOpenGLView();
+    float viewScale = glView ? glView->getScaleX() : 1.f;
+    float screenScale = _bmfontScale * nodeScale * viewScale;
+    float texelsPerPixel = screenScale > FLT_EPSILON ? CC_CONTENT_SCALE_FACTOR() / screenScale : 1.f;
+
+    // soften the edge over about one screen pixel
+    return clampf(0.5f * texelsPerPixel * distancePerTexel, 0.005f, 0.25f);
+}
+
+void Label::updateDistanceFieldUniforms(GLProgram* glProgram, const Mat4& transform)
+{
+    const float distancePerTexel = 16.f / 255.f;
+    glProgram->setUniformLocationWith1f(_uniformSmoothing, getDistanceFieldSmoothing(transform));
+
+    if (_currLabelEffect == LabelEffect::OUTLINE)
+    {
+        // the outline size is in points of the label, the field only reaches DistanceMapSpread texels out
+        float outlineTexels = _bmfontScale > FLT_EPSILON ? _outlineSize * CC_CONTENT_SCALE_FACTOR() / _bmfontScale : 0.f;
+        outlineTexels = std::min(outlineTexels, static_cast<float>(FontFreeType::DistanceMapSpread));
+        glProgram->setUniformLocationWith1f(_uniformOutlineEdge, 0.5f - outlineTexels * distancePerTexel);
+    }
+}
+
+bool Label::canBatchTTF() const
+{
+    // effects and shadows need several passes with different uniforms, and a
+    // QuadCommand draws a single texture, so only one atlas page can be batched
+    if (_currentLabelType != LabelType::TTF || _currLabelEffect != LabelEffect::NORMAL
+        || _shadowEnabled || _batchNodes.size() != 1 || !_glProgramState)
+    {
+        return false;
+    }
+
+    // labels with a custom shader keep the custom draw path
+    const char* builtinProgram = _useDistanceField ? GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL
+        : _useA8Shader ? GLProgram::SHADER_NAME_LABEL_NORMAL
+        : GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP;
+    return _glProgramState->getGLProgram() == GLProgramCache::getInstance()->getGLProgram(builtinProgram);
+}
+
+GLProgramState* Label::getBatchGLProgramState(const Mat4& transform) const
+{
+    if (!_useDistanceField && !_useA8Shader)
+    {
+        // vertex colors only: the label's own no-MVP state batches like a sprite's
+        return _glProgramState;
+    }
+
+    // the renderer transforms batched vertices, so the no-MVP label programs are used.
+    // Uniforms live in the state, so labels only share one when the text color and the
+    // quantized smoothing match as well
+    typedef std::tuple<GLProgram*, uint32_t, int> BatchStateKey;
+    struct BatchState
+    {
+        GLProgramState* state;
+        unsigned int lastFrame;
+    };
+    static std::map<BatchStateKey, BatchState> s_batchStates;
+    // states not used in the current frame are released once the cache holds this many
+    const size_t maxBatchStates = 64;
+
+    auto glProgram = GLProgramCache::getInstance()->getGLProgram(_useDistanceField
+        ? GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL_NO_MVP
+        : GLProgram::SHADER_NAME_LABEL_NORMAL_NO_MVP);
+    const float smoothingSteps = 1024.f;
+    int smoothing = _useDistanceField ? static_cast<int>(std::lround(getDistanceFieldSmoothing(transform) * smoothingSteps)) : 0;
+    uint32_t textColor = (static_cast<uint32_t>(_textColor.r) << 24) | (_textColor.g << 16) | (_textColor.b << 8) | _textColor.a;
+    BatchStateKey key(glProgram, textColor, smoothing);
+    unsigned int frame = Director::getInstance()->getTotalFrames();
+
+    auto it = s_batchStates.find(key);
+    if (it != s_batchStates.end())
+    {
+        it->second.lastFrame = frame;
+        return it->second.state;
+    }
+
+    if (s_batchStates.size() >= maxBatchStates)
+    {
+        // commands queued this frame still point at the states used in it
+        for (auto stateIt = s_batchStates.begin(); stateIt != s_batchStates.end();)
+        {
+            if (stateIt->second.lastFrame != frame)
+            {
+                stateIt->second.state->release();
+                stateIt = s_batchStates.erase(stateIt);
+            }
+            else
+            {
+                ++stateIt;
+            }
+        }
+    }
+
+    auto state = GLProgramState::create(glProgram);
+    state->setUniformVec4("u_textColor", Vec4(_textColorF.r, _textColorF.g, _textColorF.b, _textColorF.a));
+    if (_useDistanceField)
+    {
+        state->setUniformFloat("u_smoothing", smoothing / smoothingSteps);
+    }
+    state->retain();
+    s_batchStates.emplace(key, BatchState{ state, frame });
+    return state;
+}
+
 void Label::draw(Renderer *renderer, const Mat4 &transform, uint32_t flags)
 {
     if (_batchNodes.empty() || _lengthOfString <= 0)
@@ -1614,6 +1785,19 @@ void Label::draw(Renderer *renderer, const Mat4 &transform, uint32_t flags)
                 _blendFunc, textureAtlas->getQuads(), textureAtlas->getTotalQuads(), transform, flags);
             renderer->addCommand(&_quadCommand);
         }
+        else if (canBatchTTF())
+        {
+            // labels on the same atlas page with the same text color and scale share
+            // a program state, so consecutive ones are drawn in one batch
+            for (auto&& it : _letters)
+            {
+                it.second->updateTransform();
+            }
+            auto textureAtlas = _batchNodes.at(0)->getTextureAtlas();
+            _quadCommand.init(_globalZOrder, textureAtlas->getTexture(), getBatchGLProgramState(transform),
+                _blendFunc, textureAtlas->getQuads(), textureAtlas->getTotalQuads(), transform, flags);
+            renderer->addCommand(&_quadCommand);
+        }
         else
         {
             _customCommand.init(_globalZOrder, transform, flags);
@@ -2196,7 +2380,8 @@ Label::Overflow Label::getOverflow()const
 
 void Label::updateLetterSpriteScale(Sprite* sprite)
 {
-    if (_currentLabelType == LabelType::BMFONT && _bmFontSize > 0)
+    if ((_currentLabelType == LabelType::BMFONT && _bmFontSize > 0)
+        || (_currentLabelType == LabelType::TTF && _useDistanceField))
     {
         sprite->setScale(_bmfontScale);
     }
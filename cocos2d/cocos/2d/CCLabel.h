@@ -123,6 +123,15 @@ public:
          */
         RESIZE_HEIGHT
     };
+
+    /**
+     * Font size, in points, at which distance field glyphs are rasterized.
+     * Distance field labels of every size share the atlas of this size and are scaled when drawn,
+     * so changing the font size, content scale or zoom of such a label rasterizes no new glyphs.
+     * @since v3.17
+     */
+    static const float DistanceFieldFontSize;
+
     /// @name Creators
     /// @{
 
@@ -337,6 +346,8 @@ public:
 
     /**
      * Enable outline effect to Label.
+     * Distance field labels draw the outline in the shader, without a new atlas. Their outline is limited
+     * to the distance field spread, about 3 pixels of the glyph rasterized at DistanceFieldFontSize.
      * @warning Limiting use to only when the Label created with true type font or system font.
      */
     virtual void enableOutline(const Color4B& outlineColor,int outlineSize = -1);
@@ -639,6 +650,12 @@ protected:
 
     void onDraw(const Mat4& transform, bool transformUpdated);
     void onDrawShadow(GLProgram* glProgram, const Color4F& shadowColor);
+    void updateDistanceFieldUniforms(GLProgram* glProgram, const Mat4& transform);
+    float getDistanceFieldSmoothing(const Mat4& transform) const;
+    /** Whether the label can be sent as a QuadCommand and batched with other labels on the same atlas page */
+    bool canBatchTTF() const;
+    /** Program state shared by batched TTF labels with the same program, text color and smoothing */
+    GLProgramState* getBatchGLProgramState(const Mat4& transform) const;
     void drawSelf(bool visibleByCamera, Renderer* renderer, uint32_t flags);
 
     bool multilineTextWrapByChar();
@@ -736,6 +753,8 @@ protected:
     GLint _uniformEffectColor;
     GLint _uniformEffectType; // 0: None, 1: Outline, 2: Shadow; Only used when outline is enabled.
     GLint _uniformTextColor;
+    GLint _uniformSmoothing; // edge softness of distance field shaders
+    GLint _uniformOutlineEdge; // distance value of the outer outline edge, distance field outline only
     bool _useDistanceField;
     bool _useA8Shader;
 
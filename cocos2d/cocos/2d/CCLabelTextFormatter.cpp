@@ -142,6 +142,9 @@ void Label::updateBMFontScale()
         FontFNT *bmFont = (FontFNT*)font;
         float originalFontSize = bmFont->getOriginalFontSize();
         _bmfontScale = _bmFontSize * CC_CONTENT_SCALE_FACTOR() / originalFontSize;
+    }else if (_currentLabelType == LabelType::TTF && _useDistanceField) {
+        // the atlas holds glyphs rasterized at DistanceFieldFontSize
+        _bmfontScale = _fontConfig.fontSize / DistanceFieldFontSize;
     }else{
         _bmfontScale = 1.0f;
     }
@@ -233,7 +236,7 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
             if (nextChangeSize)
             {
                 if (_horizontalKernings && letterIndex < textLen - 1)
-                    nextLetterX += _horizontalKernings[letterIndex + 1];
+                    nextLetterX += _horizontalKernings[letterIndex + 1] * _bmfontScale;
                 nextLetterX += letterDef.xAdvance * _bmfontScale + _additionalKerning;
 
                 if (tokenLen != 1 || !StringUtils::isUnicodeSpace(character))
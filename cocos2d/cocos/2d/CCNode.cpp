@@ -41,6 +41,7 @@ THE SOFTWARE.
 #include "2d/CCActionManager.h"
 #include "2d/CCScene.h"
 #include "2d/CCComponent.h"
+#include "2d/CCParallelTransformPass.h"
 #include "renderer/CCGLProgram.h"
 #include "renderer/CCGLProgramState.h"
 #include "renderer/CCMaterial.h"
@@ -111,6 +112,10 @@ Node::Node()
 , _cascadeColorEnabled(false)
 , _cascadeOpacityEnabled(false)
 , _cameraMask(1)
+, _parallelTransformEnabled(false)
+, _parallelTransformPass(0)
+, _parallelTransformFlags(0)
+, _parallelTransformParentFlags(0)
 #if CC_USE_PHYSICS
 , _physicsBody(nullptr)
 #endif
@@ -699,8 +704,7 @@ const std::string& Node::getName() const
 void Node::setName(const std::string& name)
 {
     _name = name;
-    std::hash<std::string> h;
-    _hashOfName = h(name);
+    _hashOfName = StringId::hashOf(name);
 }
 
 /// userData setter
@@ -806,8 +810,7 @@ Node* Node::getChildByName(const std::string& name) const
 {
     CCASSERT(!name.empty(), "Invalid name");
     
-    std::hash<std::string> h;
-    size_t hash = h(name);
+    size_t hash = StringId::hashOf(name);
     
     for (const auto& child : _children)
     {
@@ -818,6 +821,20 @@ Node* Node::getChildByName(const std::string& name) const
     return nullptr;
 }
 
+Node* Node::getChildByName(const StringId& name) const
+{
+    CCASSERT(name.c_str()[0] != '\0', "Invalid name");
+    
+    size_t hash = name.getHash();
+    
+    for (const auto& child : _children)
+    {
+        if(child->_hashOfName == hash && child->_name.compare(name.c_str()) == 0)
+            return child;
+    }
+    return nullptr;
+}
+
 void Node::enumerateChildren(const std::string &name, std::function<bool (Node *)> callback) const
 {
     CCASSERT(!name.empty(), "Invalid name");
@@ -1204,6 +1221,32 @@ void Node::visit()
 }
 
 uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
+{
+    uint32_t flags;
+
+    // Use the result of the parallel transform pass unless the node or its parent changed since then
+    if (_parallelTransformPass != 0 && _parallelTransformPass == ParallelTransformPass::getActivePass()
+        && parentFlags == _parallelTransformParentFlags
+        && !_transformDirty && !_additionalTransformDirty && !_normalizedPositionDirty)
+    {
+        flags = _parallelTransformFlags;
+    }
+    else
+    {
+        flags = applyParentTransform(parentTransform, parentFlags);
+    }
+    _parallelTransformPass = 0;
+
+    if (isVisitableByVisitingCamera())
+    {
+        _transformUpdated = false;
+        _contentSizeDirty = false;
+    }
+
+    return flags;
+}
+
+uint32_t Node::applyParentTransform(const Mat4& parentTransform, uint32_t parentFlags)
 {
     if(_usingNormalizedPosition)
     {
@@ -1230,9 +1273,6 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
 
     if(flags & FLAGS_DIRTY_MASK)
         _modelViewTransform = this->transform(parentTransform);
-    
-    _transformUpdated = false;
-    _contentSizeDirty = false;
 
     return flags;
 }
@@ -1262,6 +1302,10 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
     
     bool visibleByCamera = isVisitableByVisitingCamera();
 
+    bool parallelTransform = _parallelTransformEnabled && !_children.empty() && ParallelTransformPass::getActivePass() == 0;
+    if (parallelTransform)
+        ParallelTransformPass::getInstance()->run(this, flags);
+
     int i = 0;
 
     if(!_children.empty())
@@ -1289,6 +1333,9 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
         this->draw(renderer, _modelViewTransform, flags);
     }
 
+    if (parallelTransform)
+        ParallelTransformPass::getInstance()->end();
+
     _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
     
     // FIX ME: Why need to set _orderOfArrival to 0??
@@ -1564,6 +1611,16 @@ void Node::unscheduleUpdate()
 #endif
 }
 
+void Node::scheduleFixedUpdate()
+{
+    _scheduler->scheduleFixedUpdate(this, !_running);
+}
+
+void Node::unscheduleFixedUpdate()
+{
+    _scheduler->unscheduleFixedUpdate(this);
+}
+
 void Node::schedule(SEL_SCHEDULE selector)
 {
     this->schedule(selector, 0.0f, CC_REPEAT_FOREVER, 0.0f);
@@ -1669,6 +1726,10 @@ void Node::update(float fDelta)
     }
 }
 
+void Node::fixedUpdate(float /*step*/)
+{
+}
+
 // MARK: coordinates
 
 AffineTransform Node::getNodeToParentAffineTransform() const
@@ -35,6 +35,7 @@
 #include "base/CCVector.h"
 #include "base/CCProtocols.h"
 #include "base/CCScriptSupport.h"
+#include "base/CCStringId.h"
 #include "math/CCAffineTransform.h"
 #include "math/CCMath.h"
 #include "2d/CCComponentContainer.h"
@@ -807,6 +808,39 @@ public:
     */
     template <typename T>
     T getChildByName(const std::string& name) const { return static_cast<T>(getChildByName(name)); }
+    /**
+     * Gets a child from the container with a pre-hashed name.
+     * Children are compared by hash first; a candidate is confirmed with one string comparison.
+     *
+     * @param name   An identifier to find the child node.
+     *
+     * @return a Node object whose name equals to the input parameter.
+     *
+     * @since v3.17
+     */
+    virtual Node* getChildByName(const StringId& name) const;
+    /**
+     * Gets a child from the container with a pre-hashed name that can be cast to Type T.
+     *
+     * @since v3.17
+     */
+    template <typename T>
+    T getChildByName(const StringId& name) const { return static_cast<T>(getChildByName(name)); }
+    /**
+     * Gets a child from the container with a string literal name.
+     * The hash of the literal is computed at compile time.
+     *
+     * @since v3.17
+     */
+    template <size_t N>
+    Node* getChildByName(const char (&name)[N]) const { return getChildByName(StringId(name)); }
+    /**
+     * Gets a child from the container with a string literal name that can be cast to Type T.
+     *
+     * @since v3.17
+     */
+    template <typename T, size_t N>
+    T getChildByName(const char (&name)[N]) const { return static_cast<T>(getChildByName(StringId(name))); }
     /** Search the children of the receiving node to perform processing for nodes which share a name.
      *
      * @param name The name to search for, supports c++11 regular expression.
@@ -1383,6 +1417,25 @@ public:
      */
     void unscheduleUpdate(void);
 
+    /**
+     * Schedules the "fixedUpdate" method.
+     *
+     * fixedUpdate is called with the scheduler's constant step (Scheduler::setFixedTimeStep()),
+     * zero or more times per frame, before the per frame "update" methods.
+     * Only one "fixedUpdate" method could be scheduled per node.
+     * @lua NA
+     * @since v3.17
+     */
+    void scheduleFixedUpdate();
+
+    /**
+     * Unschedules the "fixedUpdate" method.
+     * @see scheduleFixedUpdate();
+     * @lua NA
+     * @since v3.17
+     */
+    void unscheduleFixedUpdate();
+
     /**
      * Schedules a custom selector.
      *
@@ -1526,6 +1579,14 @@ public:
      */
     virtual void update(float delta);
 
+    /**
+     * Fixed step simulation method, called automatically if "scheduleFixedUpdate" is called, and the node is "live".
+     * @param step The scheduler's fixed time step, in seconds.
+     * @lua NA
+     * @since v3.17
+     */
+    virtual void fixedUpdate(float step);
+
     /// @} end of Scheduler and Timer
 
     /// @{
@@ -1857,6 +1918,22 @@ public:
      */
     virtual void setCameraMask(unsigned short mask, bool applyChildren = true);
 
+    /**
+     * Computes the world transforms of this node's descendants on worker threads before they are visited.
+     * Useful for large subtrees like a layer holding hundreds of sprites. Only the transforms are computed in
+     * parallel: draw() is still called on the cocos thread, in the same order, so the render commands don't change.
+     * It is ignored when an ancestor already uses it, and it only works for nodes using Node::visit().
+     *
+     * @param enabled Whether the parallel transform pass is used.
+     */
+    void setParallelTransformEnabled(bool enabled) { _parallelTransformEnabled = enabled; }
+    /**
+     * Whether the parallel transform pass is used for the descendants of this node.
+     *
+     * @return True if it is used.
+     */
+    bool isParallelTransformEnabled() const { return _parallelTransformEnabled; }
+
 CC_CONSTRUCTOR_ACCESS:
     // Nodes should be created using create();
     Node();
@@ -1879,6 +1956,8 @@ protected:
 
     Mat4 transform(const Mat4 &parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
+    /// Updates _modelViewTransform and returns the flags for the children, without clearing the dirty flags.
+    uint32_t applyParentTransform(const Mat4& parentTransform, uint32_t parentFlags);
 
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
@@ -1969,7 +2048,7 @@ protected:
     int _tag;                       ///< a tag. Can be any number you assigned just to identify this node
     
     std::string _name;              ///<a string label, an user defined string to identify this node
-    size_t _hashOfName;             ///<hash value of _name, used for speed in getChildByName
+    size_t _hashOfName;             ///<StringId hash of _name, used for speed in getChildByName
 
     void *_userData;                ///< A user assigned void pointer, Can be point to any cpp object
     Ref *_userObject;               ///< A user assigned Object
@@ -2010,6 +2089,12 @@ protected:
 
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
+
+    // parallel transform pass, see ParallelTransformPass
+    bool _parallelTransformEnabled;
+    unsigned int _parallelTransformPass;    ///< id of the pass that computed _parallelTransformFlags
+    uint32_t _parallelTransformFlags;
+    uint32_t _parallelTransformParentFlags;
     
     std::function<void()> _onEnterCallback;
     std::function<void()> _onExitCallback;
@@ -2034,6 +2119,8 @@ public:
     friend class PhysicsBody;
 #endif
 
+    friend class ParallelTransformPass;
+
     static int __attachedNodeCount;
     
 private:
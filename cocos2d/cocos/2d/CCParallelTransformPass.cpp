@@ -0,0 +1,233 @@
+/****************************************************************************
+Copyright (c) 2013-2016 Chukong Technologies Inc.
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "2d/CCParallelTransformPass.h"
+
+#include <algorithm>
+
+#include "2d/CCNode.h"
+
+NS_CC_BEGIN
+
+unsigned int ParallelTransformPass::s_activePass = 0;
+unsigned int ParallelTransformPass::s_lastPass = 0;
+ParallelTransformPass* ParallelTransformPass::s_instance = nullptr;
+
+ParallelTransformPass* ParallelTransformPass::getInstance()
+{
+    if (!s_instance)
+    {
+        s_instance = new (std::nothrow) ParallelTransformPass();
+    }
+    return s_instance;
+}
+
+void ParallelTransformPass::destroyInstance()
+{
+    delete s_instance;
+    s_instance = nullptr;
+}
+
+ParallelTransformPass::ParallelTransformPass()
+: _generation(0)
+, _quit(false)
+, _pendingTasks(0)
+{
+    // the cocos thread works too, leave one core to it
+    unsigned int cores = std::thread::hardware_concurrency();
+    int workerCount = cores > 1 ? std::min(static_cast<int>(cores) - 1, 3) : 0;
+
+    for (int i = 0; i <= workerCount; ++i)
+    {
+        _queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+    }
+    for (int i = 1; i <= workerCount; ++i)
+    {
+        _workers.push_back(std::thread(&ParallelTransformPass::workerLoop, this, i));
+    }
+}
+
+ParallelTransformPass::~ParallelTransformPass()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _quit = true;
+    }
+    _wakeCondition.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+void ParallelTransformPass::run(Node* root, uint32_t rootFlags)
+{
+    CCASSERT(s_activePass == 0, "ParallelTransformPass::run() can't be nested");
+
+    // never hand out 0, it means "no pass"
+    if (++s_lastPass == 0)
+        ++s_lastPass;
+    s_activePass = s_lastPass;
+
+    if (_workers.empty())
+    {
+        processTask(0, { root, rootFlags, 0, static_cast<int>(root->_children.size()) });
+        return;
+    }
+
+    pushChildren(0, root, rootFlags);
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        ++_generation;
+    }
+    _wakeCondition.notify_all();
+
+    drainTasks(0);
+}
+
+void ParallelTransformPass::end()
+{
+    s_activePass = 0;
+}
+
+void ParallelTransformPass::workerLoop(int queueIndex)
+{
+    unsigned int seenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wakeCondition.wait(lock, [&]{ return _quit || _generation != seenGeneration; });
+            if (_quit)
+                return;
+            seenGeneration = _generation;
+        }
+        drainTasks(queueIndex);
+    }
+}
+
+void ParallelTransformPass::drainTasks(int queueIndex)
+{
+    // a task is only counted as done after the tasks it spawned were pushed,
+    // so the counter can't reach 0 while work is left
+    Task task;
+    while (_pendingTasks.load() > 0)
+    {
+        if (popTask(queueIndex, task))
+        {
+            processTask(queueIndex, task);
+            _pendingTasks.fetch_sub(1);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool ParallelTransformPass::popTask(int queueIndex, Task& task)
+{
+    // newest task of the own queue first, it is the most likely to be in cache
+    {
+        auto& queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // then steal the oldest task of another queue, it is the biggest subtree left
+    const int queueCount = static_cast<int>(_queues.size());
+    for (int i = 1; i < queueCount; ++i)
+    {
+        auto& queue = *_queues[(queueIndex + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ParallelTransformPass::pushChildren(int queueIndex, Node* parent, uint32_t flags)
+{
+    // a few tasks per thread so stealing can even out the work, but never below MIN_TASK_SIZE siblings
+    const int childCount = static_cast<int>(parent->_children.size());
+    const int targetTasks = static_cast<int>(_queues.size()) * 4;
+    const int taskSize = std::max(static_cast<int>(MIN_TASK_SIZE), (childCount + targetTasks - 1) / targetTasks);
+    const int taskCount = (childCount + taskSize - 1) / taskSize;
+    _pendingTasks.fetch_add(taskCount);
+
+    auto& queue = *_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    for (int first = 0; first < childCount; first += taskSize)
+    {
+        queue.tasks.push_back({ parent, flags, first, std::min(taskSize, childCount - first) });
+    }
+}
+
+void ParallelTransformPass::processTask(int queueIndex, const Task& task)
+{
+    const auto& children = task.parent->_children;
+    const Mat4& parentTransform = task.parent->_modelViewTransform;
+    for (int i = task.first, last = task.first + task.count; i < last; ++i)
+    {
+        processNode(queueIndex, children.at(i), parentTransform, task.parentFlags);
+    }
+}
+
+void ParallelTransformPass::processNode(int queueIndex, Node* node, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    // same early out as Node::visit()
+    if (!node->_visible)
+        return;
+
+    uint32_t flags = node->applyParentTransform(parentTransform, parentFlags);
+    node->_parallelTransformFlags = flags;
+    node->_parallelTransformParentFlags = parentFlags;
+    node->_parallelTransformPass = s_activePass;
+
+    const auto& children = node->_children;
+    if (children.size() >= SPLIT_THRESHOLD && !_workers.empty())
+    {
+        pushChildren(queueIndex, node, flags);
+    }
+    else
+    {
+        for (const auto& child : children)
+        {
+            processNode(queueIndex, child, node->_modelViewTransform, flags);
+        }
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,137 @@
+/****************************************************************************
+Copyright (c) 2013-2016 Chukong Technologies Inc.
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCPARALLEL_TRANSFORM_PASS_H__
+#define __CCPARALLEL_TRANSFORM_PASS_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "platform/CCPlatformMacros.h"
+#include "math/CCMath.h"
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+NS_CC_BEGIN
+
+class Node;
+
+/// @cond DO_NOT_SHOW
+
+/**
+ * @brief Computes the world transforms of a node's subtree on a small work-stealing thread pool.
+ *
+ * Node::visit() runs it for nodes with setParallelTransformEnabled(true) before their children are visited.
+ * Every thread owns a task queue; the children of a node with many children are split into tasks of
+ * consecutive siblings, and idle threads steal tasks from the other queues. run() blocks until the whole subtree is done, so the following
+ * serial visit, and therefore the order of the emitted render commands, is unchanged: it only picks up the
+ * precomputed flags and transforms in Node::processParentFlags().
+ * Only transforms are computed in parallel, draw() and any other callback always run on the cocos thread.
+ */
+class CC_DLL ParallelTransformPass
+{
+public:
+    /** Children count from which a node's children are pushed as separate tasks */
+    static const int SPLIT_THRESHOLD = 64;
+    /** Minimum number of siblings per task, a task per leaf costs more in queue locking than the leaf itself */
+    static const int MIN_TASK_SIZE = 32;
+
+    static ParallelTransformPass* getInstance();
+    static void destroyInstance();
+
+    /** Id of the running pass, 0 if no pass is running. */
+    static unsigned int getActivePass() { return s_activePass; }
+
+    /**
+     * Computes the transforms of all the descendants of root and blocks until they are done.
+     * The pass stays active until end() is called, nested calls are not allowed.
+     *
+     * @param root The node whose descendants are processed, its own transform must be up to date.
+     * @param rootFlags The flags returned by root's processParentFlags().
+     */
+    void run(Node* root, uint32_t rootFlags);
+
+    /** Ends the active pass, flags computed by it are not used any more. */
+    void end();
+
+    ~ParallelTransformPass();
+
+private:
+    // children [first, first + count) of parent
+    struct Task
+    {
+        Node* parent;
+        uint32_t parentFlags;
+        int first;
+        int count;
+    };
+
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    ParallelTransformPass();
+
+    void workerLoop(int queueIndex);
+    void drainTasks(int queueIndex);
+    bool popTask(int queueIndex, Task& task);
+    void pushChildren(int queueIndex, Node* parent, uint32_t flags);
+    void processTask(int queueIndex, const Task& task);
+    void processNode(int queueIndex, Node* node, const Mat4& parentTransform, uint32_t parentFlags);
+
+    std::vector<std::thread> _workers;
+    // queue 0 belongs to the thread that calls run()
+    std::vector<std::unique_ptr<TaskQueue>> _queues;
+
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+    unsigned int _generation;
+    bool _quit;
+
+    std::atomic<int> _pendingTasks;
+
+    static unsigned int s_activePass;
+    static unsigned int s_lastPass;
+    static ParallelTransformPass* s_instance;
+};
+
+/// @endcond
+
+NS_CC_END
+
+// end of _2d group
+/// @}
+
+#endif // __CCPARALLEL_TRANSFORM_PASS_H__
@@ -29,10 +29,19 @@ THE SOFTWARE.
 #include "2d/CCTMXLayer.h"
 #include "2d/CCTMXTiledMap.h"
 #include "2d/CCSprite.h"
+#include "2d/CCCamera.h"
 #include "base/CCDirector.h"
 #include "base/ccUTF8.h"
 #include "renderer/CCTextureCache.h"
 #include "renderer/CCGLProgram.h"
+#include "renderer/CCGLProgramState.h"
+#include "renderer/CCRenderer.h"
+#include "renderer/ccGLStateCache.h"
+#include "base/CCEventDispatcher.h"
+#include "base/CCEventListenerCustom.h"
+#include "base/CCEventType.h"
+
+#include <algorithm>
 
 NS_CC_BEGIN
 
@@ -69,7 +78,7 @@ bool TMXLayer::initWithTilesetInfo(TMXTilesetInfo *tilesetInfo, TMXLayerInfo *la
     if (SpriteBatchNode::initWithTexture(texture, static_cast<ssize_t>(capacity)))
     {
         // layerInfo
-        _layerName = layerInfo->_name;
+        setLayerName(layerInfo->_name);
         _layerSize = size;
         _tiles = layerInfo->_tiles;
         _opacity = layerInfo->_opacity;
@@ -119,6 +128,7 @@ bool TMXLayer::initWithTilesetInfo(TMXTilesetInfo *tilesetInfo, TMXLayerInfo *la
 
 TMXLayer::TMXLayer()
 :_layerName("")
+,_layerNameHash(StringId::hashOf("", 0))
 ,_opacity(0)
 ,_vertexZvalue(0)
 ,_useAutomaticVertexZ(false)
@@ -133,10 +143,18 @@ TMXLayer::TMXLayer()
 ,_staggerAxis(TMXStaggerAxis_Y)
 ,_staggerIndex(TMXStaggerIndex_Even)
 ,_hexSideLength(0)
+,_staticChunkMode(false)
+,_staticChunksWide(0)
+,_staticChunksHigh(0)
+,_staticChunkIndexVBO(0)
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+,_staticChunkRecreatedListener(nullptr)
+#endif
 {}
 
 TMXLayer::~TMXLayer()
 {
+    releaseStaticChunks();
     CC_SAFE_RELEASE(_tileSet);
     CC_SAFE_RELEASE(_reusedTile);
 
@@ -357,6 +375,13 @@ Sprite * TMXLayer::getTileAt(const Vec2& pos)
     // if GID == 0, then no tile is present
     if (gid) 
     {
+        // the returned sprite may be moved/rotated, which static chunks can't follow
+        if (_staticChunkMode)
+        {
+            CCLOG("cocos2d: TMXLayer: getTileAt() disables the static chunk mode of layer %s", _layerName.c_str());
+            setStaticChunkMode(false);
+        }
+
         int z = (int)(pos.x + pos.y * _layerSize.width);
         tile = static_cast<Sprite*>(this->getChildByTag(z));
 
@@ -616,6 +641,8 @@ void TMXLayer::setTileGID(uint32_t gid, const Vec2& pos, TMXTileFlags flags)
                 updateTileForGID(gidAndFlags, pos);
             }
         }
+
+        markStaticChunkDirty(pos);
     }
 }
 
@@ -680,7 +707,242 @@ void TMXLayer::removeTileAt(const Vec2& pos)
                 }
             }
         }
+
+        markStaticChunkDirty(pos);
+    }
+}
+
+// TMXLayer - static chunk mode
+void TMXLayer::setStaticChunkMode(bool enabled)
+{
+    if (enabled == _staticChunkMode)
+        return;
+
+    if (enabled && _layerOrientation == TMXOrientationHex && _staggerAxis == TMXStaggerAxis_X)
+    {
+        CCLOG("cocos2d: TMXLayer: static chunk mode is not supported on hexagonal layers staggered along X");
+        return;
+    }
+
+    // tile sprites made by getTileAt() are drawn from their own transforms, which the chunks would ignore
+    if (enabled && !_children.empty())
+    {
+        CCLOG("cocos2d: TMXLayer: layer %s has tile sprites from getTileAt(), it keeps the dynamic path", _layerName.c_str());
+        return;
+    }
+
+    releaseStaticChunks();
+    _staticChunkMode = enabled;
+    if (!enabled)
+        return;
+
+    _staticChunksWide = ((int)_layerSize.width + STATIC_CHUNK_SIZE - 1) / STATIC_CHUNK_SIZE;
+    _staticChunksHigh = ((int)_layerSize.height + STATIC_CHUNK_SIZE - 1) / STATIC_CHUNK_SIZE;
+
+    StaticChunk emptyChunk = { 0, 0, true, Rect::ZERO };
+    _staticChunks.resize(_staticChunksWide * _staticChunksHigh, emptyChunk);
+    _staticChunkCommands.resize(_staticChunks.size());
+    for (size_t i = 0; i < _staticChunkCommands.size(); ++i)
+    {
+        _staticChunkCommands[i].func = std::bind(&TMXLayer::onDrawStaticChunk, this, (int)i);
+    }
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    /** listen the event that renderer was recreated on Android/WP8, the buffers are gone with the old context */
+    _staticChunkRecreatedListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom* /*event*/){
+        for (auto& chunk : _staticChunks)
+        {
+            chunk.vbo = 0;
+            chunk.dirty = true;
+        }
+        _staticChunkIndexVBO = 0;
+    });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_staticChunkRecreatedListener, -1);
+#endif
+}
+
+void TMXLayer::releaseStaticChunks()
+{
+    for (auto& chunk : _staticChunks)
+    {
+        if (chunk.vbo)
+        {
+            glDeleteBuffers(1, &chunk.vbo);
+        }
+    }
+    _staticChunks.clear();
+    _staticChunkCommands.clear();
+
+    if (_staticChunkIndexVBO)
+    {
+        glDeleteBuffers(1, &_staticChunkIndexVBO);
+        _staticChunkIndexVBO = 0;
+    }
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    if (_staticChunkRecreatedListener)
+    {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_staticChunkRecreatedListener);
+        _staticChunkRecreatedListener = nullptr;
+    }
+#endif
+}
+
+void TMXLayer::markStaticChunkDirty(const Vec2& pos)
+{
+    if (!_staticChunkMode)
+        return;
+
+    int chunkIndex = (int)pos.x / STATIC_CHUNK_SIZE + ((int)pos.y / STATIC_CHUNK_SIZE) * _staticChunksWide;
+    _staticChunks[chunkIndex].dirty = true;
+}
+
+static inline bool compareAtlasZ(void* a, void* b)
+{
+    return (intptr_t)a < (intptr_t)b;
+}
+
+void TMXLayer::rebuildStaticChunk(int chunkIndex)
+{
+    auto& chunk = _staticChunks[chunkIndex];
+    const int width = (int)_layerSize.width;
+    const int x0 = (chunkIndex % _staticChunksWide) * STATIC_CHUNK_SIZE;
+    const int y0 = (chunkIndex / _staticChunksWide) * STATIC_CHUNK_SIZE;
+    const int x1 = std::min(x0 + STATIC_CHUNK_SIZE, width);
+    const int y1 = std::min(y0 + STATIC_CHUNK_SIZE, (int)_layerSize.height);
+
+    // The atlas already holds the transformed quads, ordered by z = x + y * width.
+    // Each row of the chunk is a contiguous z range of it.
+    std::vector<V3F_C4B_T2F_Quad> quads;
+    quads.reserve(STATIC_CHUNK_SIZE * STATIC_CHUNK_SIZE);
+    const V3F_C4B_T2F_Quad* atlasQuads = _textureAtlas->getQuads();
+    void** first = _atlasIndexArray->arr;
+    void** last = first + _atlasIndexArray->num;
+    void** it = first;
+    for (int y = y0; y < y1; ++y)
+    {
+        intptr_t zBegin = x0 + y * width;
+        intptr_t zEnd = x1 + y * width;
+        it = std::lower_bound(it, last, (void*)zBegin, compareAtlasZ);
+        for (; it != last && (intptr_t)*it < zEnd; ++it)
+        {
+            quads.push_back(atlasQuads[it - first]);
+        }
+    }
+
+    chunk.quadCount = (int)quads.size();
+    chunk.dirty = false;
+    chunk.bounds = Rect::ZERO;
+    if (quads.empty())
+        return;
+
+    // tiles taller than the map grid overflow their cell, so the bounds come from the quads themselves
+    float minX = quads[0].bl.vertices.x, maxX = minX;
+    float minY = quads[0].bl.vertices.y, maxY = minY;
+    for (const auto& quad : quads)
+    {
+        for (const V3F_C4B_T2F* v : { &quad.tl, &quad.bl, &quad.tr, &quad.br })
+        {
+            minX = std::min(minX, v->vertices.x);
+            maxX = std::max(maxX, v->vertices.x);
+            minY = std::min(minY, v->vertices.y);
+            maxY = std::max(maxY, v->vertices.y);
+        }
+    }
+    chunk.bounds.setRect(minX, minY, maxX - minX, maxY - minY);
+
+    if (!chunk.vbo)
+    {
+        glGenBuffers(1, &chunk.vbo);
     }
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quads[0]) * quads.size(), quads.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    CHECK_GL_ERROR_DEBUG();
+}
+
+void TMXLayer::draw(Renderer *renderer, const Mat4 &transform, uint32_t flags)
+{
+    if (!_staticChunkMode)
+    {
+        SpriteBatchNode::draw(renderer, transform, flags);
+        return;
+    }
+
+    const Rect cameraRect = getCameraRectInLayerSpace(transform);
+    for (size_t i = 0; i < _staticChunks.size(); ++i)
+    {
+        if (_staticChunks[i].dirty)
+        {
+            rebuildStaticChunk((int)i);
+        }
+        if (_staticChunks[i].quadCount == 0 || !cameraRect.intersectsRect(_staticChunks[i].bounds))
+            continue;
+
+        auto& cmd = _staticChunkCommands[i];
+        cmd.init(_globalZOrder, transform, flags);
+        renderer->addCommand(&cmd);
+    }
+}
+
+Rect TMXLayer::getCameraRectInLayerSpace(const Mat4& transform) const
+{
+    // same visible rectangle as FastTMXLayer::draw() uses
+    auto camera = Camera::getVisitingCamera();
+    Size s = Director::getInstance()->getVisibleSize();
+    Rect rect(camera->getPositionX() - s.width * 0.5f,
+              camera->getPositionY() - s.height * 0.5f,
+              s.width,
+              s.height);
+
+    Mat4 inv = transform;
+    inv.inverse();
+    return RectApplyTransform(rect, inv);
+}
+
+void TMXLayer::onDrawStaticChunk(int chunkIndex)
+{
+    const auto& chunk = _staticChunks[chunkIndex];
+
+    if (!_staticChunkIndexVBO)
+    {
+        // same layout as TextureAtlas::setupIndices()
+        const int quadCount = STATIC_CHUNK_SIZE * STATIC_CHUNK_SIZE;
+        std::vector<GLushort> indices(quadCount * 6);
+        for (int i = 0; i < quadCount; ++i)
+        {
+            indices[i*6+0] = (GLushort)(i*4+0);
+            indices[i*6+1] = (GLushort)(i*4+1);
+            indices[i*6+2] = (GLushort)(i*4+2);
+            indices[i*6+3] = (GLushort)(i*4+3);
+            indices[i*6+4] = (GLushort)(i*4+2);
+            indices[i*6+5] = (GLushort)(i*4+1);
+        }
+        glGenBuffers(1, &_staticChunkIndexVBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _staticChunkIndexVBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * indices.size(), indices.data(), GL_STATIC_DRAW);
+    }
+
+    getGLProgramState()->apply(_modelViewTransform);
+    GL::blendFunc(_blendFunc.src, _blendFunc.dst);
+    GL::bindTexture2D(_textureAtlas->getTexture()->getName());
+
+    GL::bindVAO(0);
+    GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof(V3F_C4B_T2F, vertices));
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof(V3F_C4B_T2F, colors));
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof(V3F_C4B_T2F, texCoords));
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _staticChunkIndexVBO);
+    glDrawElements(GL_TRIANGLES, (GLsizei)chunk.quadCount * 6, GL_UNSIGNED_SHORT, (GLvoid*)0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, chunk.quadCount * 4);
+    CHECK_GL_ERROR_DEBUG();
 }
 
 //CCTMXLayer - obtaining positions, offset
@@ -31,9 +31,11 @@ THE SOFTWARE.
 #include "2d/CCSpriteBatchNode.h"
 #include "2d/CCTMXXMLParser.h"
 #include "base/ccCArray.h"
+#include "renderer/CCCustomCommand.h"
 NS_CC_BEGIN
 
 class TMXMapInfo;
+class EventListenerCustom;
 class TMXLayerInfo;
 class TMXTilesetInfo;
 struct _ccCArray;
@@ -61,6 +63,9 @@ struct _ccCArray;
  * @since v0.8.1
  * Tiles can have tile flags for additional properties. At the moment only flip horizontal and flip vertical are used. These bit flags are defined in TMXXMLParser.h.
  * @since 1.1
+ * In static chunk mode (see setStaticChunkMode) the layer is split into square chunks whose geometry lives in
+ * GPU buffers, so drawing the layer no longer depends on the number of tiles. Chunks outside of the visiting
+ * camera's view are culled before any render command is generated.
  */
 
 class CC_DLL TMXLayer : public SpriteBatchNode
@@ -181,6 +186,27 @@ public:
 
     /** Creates the tiles. */
     void setupTiles();
+
+    /** Size, in tiles, of the square chunks used by the static chunk mode. */
+    static const int STATIC_CHUNK_SIZE = 32;
+
+    /** Enables/Disables the static chunk mode.
+     * The layer is split into STATIC_CHUNK_SIZE x STATIC_CHUNK_SIZE tile chunks. The quads of each chunk are
+     * uploaded once to a vertex buffer of their own and drawn with one draw call per frame. setTileGID() and
+     * removeTileAt() only re-upload the chunk they touch.
+     * Tiles returned by getTileAt() are sprites that can be transformed freely, so getTileAt() turns the mode off,
+     * and it can't be turned on while the layer holds such tile sprites.
+     * Not supported on hexagonal layers staggered along the X axis.
+     *
+     * @param enabled Whether the static chunk mode is used.
+     */
+    void setStaticChunkMode(bool enabled);
+
+    /** Whether the static chunk mode is used.
+     *
+     * @return True if the layer is drawn from static chunks.
+     */
+    bool isStaticChunkMode() const { return _staticChunkMode; }
     
     /** Get the layer name. 
      *
@@ -192,7 +218,14 @@ public:
      *
      * @param layerName The layer name.
      */
-    void setLayerName(const std::string& layerName) { _layerName = layerName; }
+    void setLayerName(const std::string& layerName) { _layerName = layerName; _layerNameHash = StringId::hashOf(layerName); }
+
+    /** Get the StringId hash of the layer name.
+     *
+     * @return The hash of the layer name.
+     * @since v3.17
+     */
+    StringId::HashType getLayerNameHash() const { return _layerNameHash; }
 
     /** Size of the layer in tiles.
      *
@@ -293,8 +326,25 @@ public:
     * @js NA
     */
     virtual std::string getDescription() const override;
+    virtual void draw(Renderer *renderer, const Mat4 &transform, uint32_t flags) override;
 
 protected:
+    /** A STATIC_CHUNK_SIZE x STATIC_CHUNK_SIZE block of tiles drawn from its own vertex buffer */
+    struct StaticChunk
+    {
+        GLuint vbo;
+        int quadCount;
+        bool dirty;
+        /** bounding box of the chunk's quads, in layer space */
+        Rect bounds;
+    };
+
+    void markStaticChunkDirty(const Vec2& tileCoordinate);
+    void rebuildStaticChunk(int chunkIndex);
+    void releaseStaticChunks();
+    void onDrawStaticChunk(int chunkIndex);
+    Rect getCameraRectInLayerSpace(const Mat4& transform) const;
+
     Vec2 getPositionForIsoAt(const Vec2& pos);
     Vec2 getPositionForOrthoAt(const Vec2& pos);
     Vec2 getPositionForHexAt(const Vec2& pos);
@@ -321,6 +371,8 @@ protected:
 
     //! name of the layer
     std::string _layerName;
+    //! StringId hash of _layerName, compared first in TMXTiledMap::getLayer
+    StringId::HashType _layerNameHash;
     //! TMX Layer supports opacity
     unsigned char _opacity;
     
@@ -353,6 +405,18 @@ protected:
     int _hexSideLength;
     /** properties from the layer. They can be added using Tiled */
     ValueMap _properties;
+
+    //! static chunk mode
+    bool _staticChunkMode;
+    int _staticChunksWide;
+    int _staticChunksHigh;
+    std::vector<StaticChunk> _staticChunks;
+    std::vector<CustomCommand> _staticChunkCommands;
+    //! indices shared by all chunks, for STATIC_CHUNK_SIZE * STATIC_CHUNK_SIZE quads
+    GLuint _staticChunkIndexVBO;
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    EventListenerCustom* _staticChunkRecreatedListener;
+#endif
 };
 
 // end of tilemap_parallax_nodes group
@@ -221,6 +221,24 @@ TMXLayer * TMXTiledMap::getLayer(const std::string& layerName) const
     return nullptr;
 }
 
+TMXLayer * TMXTiledMap::getLayer(const StringId& layerName) const
+{
+    CCASSERT(layerName.c_str()[0] != '\0', "Invalid layer name!");
+    
+    StringId::HashType hash = layerName.getHash();
+    for (auto& child : _children)
+    {
+        TMXLayer* layer = dynamic_cast<TMXLayer*>(child);
+        if(layer && layer->getLayerNameHash() == hash && layer->getLayerName().compare(layerName.c_str()) == 0)
+        {
+            return layer;
+        }
+    }
+
+    // layer not found
+    return nullptr;
+}
+
 TMXObjectGroup * TMXTiledMap::getObjectGroup(const std::string& groupName) const
 {
     CCASSERT(groupName.size() > 0, "Invalid group name!");
@@ -156,6 +156,20 @@ public:
      * @return The TMXLayer for the specific layer.
      */
     TMXLayer* getLayer(const std::string& layerName) const;
+    /** Return the TMXLayer for a pre-hashed layer name.
+     * Layers are compared by hash first; a candidate is confirmed with one string comparison.
+     *
+     * @param layerName A specific layer.
+     * @return The TMXLayer for the specific layer.
+     * @since v3.17
+     */
+    TMXLayer* getLayer(const StringId& layerName) const;
+    /** Return the TMXLayer for a string literal layer name, hashed at compile time.
+     *
+     * @since v3.17
+     */
+    template <size_t N>
+    TMXLayer* getLayer(const char (&layerName)[N]) const { return getLayer(StringId(layerName)); }
     /**
      * @js NA
      * @lua NA
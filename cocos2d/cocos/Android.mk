@@ -64,6 +64,7 @@ cocos2d.cpp \
 2d/CCNode.cpp \
 2d/CCNodeGrid.cpp \
 2d/CCParallaxNode.cpp \
+2d/CCParallelTransformPass.cpp \
 2d/CCParticleBatchNode.cpp \
 2d/CCParticleExamples.cpp \
 2d/CCParticleSystem.cpp \
@@ -92,6 +93,7 @@ cocos2d.cpp \
 platform/CCFileUtils.cpp \
 platform/CCGLView.cpp \
 platform/CCImage.cpp \
+platform/CCResourceArchive.cpp \
 platform/CCSAXParser.cpp \
 platform/CCThread.cpp \
 $(MATHNEONFILE) \
@@ -138,6 +140,7 @@ base/CCProfiling.cpp \
 base/CCProperties.cpp \
 base/CCRef.cpp \
 base/CCScheduler.cpp \
+base/CCStringId.cpp \
 base/CCScriptSupport.cpp \
 base/CCTouch.cpp \
 base/CCUserDefault-android.cpp \
@@ -27,6 +27,7 @@
  */
 #include <cstring>
 #include <cstdint>
+#include <climits>
 #include "audio/linux/AudioEngine-linux.h"
 
 #include "base/CCDirector.h"
@@ -38,6 +39,17 @@ using namespace cocos2d::experimental;
 
 AudioEngineImpl * g_AudioEngineImpl = nullptr;
 
+// Files larger than this are streamed from disk instead of being decoded into memory
+static const long STREAM_FILE_SIZE_THRESHOLD = 256 * 1024;
+// Compressed data read ahead from disk by each stream
+static const unsigned int STREAM_FILE_BUFFER_BYTES = 64 * 1024;
+// Decode ring buffer of each stream, in PCM samples (about 370ms at 44.1kHz)
+static const unsigned int STREAM_DECODE_BUFFER_SAMPLES = 16 * 1024;
+// Decoded effects kept in memory
+static const unsigned int SAMPLE_CACHE_BUDGET_BYTES = 16 * 1024 * 1024;
+// Audio IDs are serial * MAX_AUDIOINSTANCES + voice slot
+static const int SERIAL_LIMIT = INT_MAX / MAX_AUDIOINSTANCES;
+
 void ERRCHECKWITHEXIT(FMOD_RESULT result)
 {
     if (result != FMOD_OK) {
@@ -59,18 +71,25 @@ FMOD_RESULT F_CALLBACK channelCallback(FMOD_CHANNELCONTROL *channelcontrol,
                                        FMOD_CHANNELCONTROL_CALLBACK_TYPE callbacktype,
                                        void *commandData1, void *commandData2)
 {
-    if (controltype == FMOD_CHANNELCONTROL_CHANNEL && callbacktype == FMOD_CHANNELCONTROL_CALLBACK_END) {
+    if (controltype == FMOD_CHANNELCONTROL_CHANNEL && callbacktype == FMOD_CHANNELCONTROL_CALLBACK_END
+        && g_AudioEngineImpl) {
         g_AudioEngineImpl->onSoundFinished((FMOD::Channel *)channelcontrol);
     }
     return FMOD_OK;
 }
 
 AudioEngineImpl::AudioEngineImpl()
+: _nextSerial(0)
+, _sampleCacheBytes(0)
+, pSystem(nullptr)
 {
 }
 
 AudioEngineImpl::~AudioEngineImpl()
 {
+    // channels ending while the system closes must not reach the released voices
+    g_AudioEngineImpl = nullptr;
+
     FMOD_RESULT result;
     result = pSystem->close();
     ERRCHECKWITHEXIT(result);
@@ -90,11 +109,16 @@ bool AudioEngineImpl::init()
     result = pSystem->setOutput(FMOD_OUTPUTTYPE_AUTODETECT);
     ERRCHECKWITHEXIT(result);
 
-    result = pSystem->init(32, FMOD_INIT_NORMAL, 0);
+    result = pSystem->setStreamBufferSize(STREAM_FILE_BUFFER_BYTES, FMOD_TIMEUNIT_RAWBYTES);
     ERRCHECKWITHEXIT(result);
 
-    mapChannelInfo.clear();
-    mapSound.clear();
+    // one FMOD channel per voice, FMOD never has to steal a channel
+    result = pSystem->init(MAX_AUDIOINSTANCES, FMOD_INIT_NORMAL, 0);
+    ERRCHECKWITHEXIT(result);
+
+    _sounds.clear();
+    _sampleLru.clear();
+    _sampleCacheBytes = 0;
 
     auto scheduler = cocos2d::Director::getInstance()->getScheduler();
     scheduler->schedule(schedule_selector(AudioEngineImpl::update), this, 0.05f, false);
@@ -106,238 +130,228 @@ bool AudioEngineImpl::init()
 
 int AudioEngineImpl::play2d(const std::string &fileFullPath, bool loop, float volume)
 {
-    int id = preload(fileFullPath, nullptr);
-    if (id >= 0) {
-        mapChannelInfo[id].loop=loop;
-        mapChannelInfo[id].channel->setPaused(true);
-        mapChannelInfo[id].volume = volume;
-        AudioEngine::_audioIDInfoMap[id].state = AudioEngine::AudioState::PAUSED;
-        resume(id);
-    }
-    return id;
+    SoundInfo * info = loadSound(fileFullPath);
+    if (!info) {
+        return AudioEngine::INVALID_AUDIO_ID;
+    }
+
+    // a stream has a single file handle and decode buffer, so it plays on one voice at a time
+    if (info->streamed && info->voiceCount > 0) {
+        for (auto& voice : _voices) {
+            if (voice.sound == info) {
+                int audioID = voice.id;
+                releaseVoice(voice);
+                AudioEngine::remove(audioID);
+            }
+        }
+    }
+
+    int slot = 0;
+    while (slot < MAX_AUDIOINSTANCES && _voices[slot].id != AudioEngine::INVALID_AUDIO_ID) {
+        ++slot;
+    }
+    if (slot == MAX_AUDIOINSTANCES) {
+        printf("AudioEngineImpl::play2d: no free voice for %s\n", fileFullPath.c_str());
+        return AudioEngine::INVALID_AUDIO_ID;
+    }
+    Voice & voice = _voices[slot];
+
+    FMOD::Channel *channel = nullptr;
+    //starts the sound in pause mode, use the channel to unpause
+    FMOD_RESULT result = pSystem->playSound(info->sound, nullptr, true, &channel);
+    if (ERRCHECK(result)) {
+        return AudioEngine::INVALID_AUDIO_ID;
+    }
+    channel->setMode(loop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF);
+    channel->setLoopCount(loop ? -1 : 0);
+    channel->setVolume(volume);
+    channel->setUserData(&voice);
+    channel->setCallback(channelCallback);
+
+    _nextSerial = (_nextSerial + 1) % SERIAL_LIMIT;
+    voice.id = _nextSerial * MAX_AUDIOINSTANCES + slot;
+    voice.sound = info;
+    voice.channel = channel;
+    ++info->voiceCount;
+    if (!info->streamed) {
+        _sampleLru.splice(_sampleLru.begin(), _sampleLru, info->lruIter);
+    }
+
+    channel->setPaused(false);
+    AudioEngine::_audioIDInfoMap[voice.id].state = AudioEngine::AudioState::PLAYING;
+    return voice.id;
 }
 
 void AudioEngineImpl::setVolume(int audioID, float volume)
 {
-    try {
-        mapChannelInfo[audioID].channel->setVolume(volume);
-    }
-    catch (const std::out_of_range& oor) {
+    Voice * voice = findVoice(audioID);
+    if (!voice) {
         printf("AudioEngineImpl::setVolume: invalid audioID: %d\n", audioID);
+        return;
     }
+    voice->channel->setVolume(volume);
 }
 
 void AudioEngineImpl::setLoop(int audioID, bool loop)
 {
-    try {
-        mapChannelInfo[audioID].channel->setLoopCount(loop ? -1 : 0);
-    }
-    catch (const std::out_of_range& oor) {
+    Voice * voice = findVoice(audioID);
+    if (!voice) {
         printf("AudioEngineImpl::setLoop: invalid audioID: %d\n", audioID);
+        return;
     }
+    voice->channel->setMode(loop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF);
+    voice->channel->setLoopCount(loop ? -1 : 0);
 }
 
 bool AudioEngineImpl::pause(int audioID)
 {
-    try {
-        mapChannelInfo[audioID].channel->setPaused(true);
-        AudioEngine::_audioIDInfoMap[audioID].state = AudioEngine::AudioState::PAUSED;
-        return true;
-    }
-    catch (const std::out_of_range& oor) {
+    Voice * voice = findVoice(audioID);
+    if (!voice) {
         printf("AudioEngineImpl::pause: invalid audioID: %d\n", audioID);
         return false;
     }
+    voice->channel->setPaused(true);
+    AudioEngine::_audioIDInfoMap[audioID].state = AudioEngine::AudioState::PAUSED;
+    return true;
 }
 
 bool AudioEngineImpl::resume(int audioID)
 {
-    try {
-        if (!mapChannelInfo[audioID].channel) {
-            FMOD::Channel *channel = nullptr;
-            FMOD::ChannelGroup *channelgroup = nullptr;
-            //starts the sound in pause mode, use the channel to unpause
-            FMOD_RESULT result = pSystem->playSound(mapChannelInfo[audioID].sound, channelgroup, true, &channel);
-            if (ERRCHECK(result)) {
-                return false;
-            }
-            channel->setMode(mapChannelInfo[audioID].loop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF);
-            channel->setLoopCount(mapChannelInfo[audioID].loop ? -1 : 0);
-            channel->setVolume(mapChannelInfo[audioID].volume);
-            channel->setUserData(reinterpret_cast<void *>(static_cast<std::intptr_t>(mapChannelInfo[audioID].id)));
-            mapChannelInfo[audioID].channel = channel;
-        }
-
-        mapChannelInfo[audioID].channel->setPaused(false);
-        AudioEngine::_audioIDInfoMap[audioID].state = AudioEngine::AudioState::PLAYING;
-
-        return true;
-    }
-    catch (const std::out_of_range& oor) {
+    Voice * voice = findVoice(audioID);
+    if (!voice) {
         printf("AudioEngineImpl::resume: invalid audioID: %d\n", audioID);
         return false;
     }
+    voice->channel->setPaused(false);
+    AudioEngine::_audioIDInfoMap[audioID].state = AudioEngine::AudioState::PLAYING;
+    return true;
 }
 
 bool AudioEngineImpl::stop(int audioID)
 {
-    try {
-        mapChannelInfo[audioID].channel->stop();
-        mapChannelInfo[audioID].channel = nullptr;
-        return true;
-    }
-    catch (const std::out_of_range& oor) {
+    Voice * voice = findVoice(audioID);
+    if (!voice) {
         printf("AudioEngineImpl::stop: invalid audioID: %d\n", audioID);
         return false;
     }
+    releaseVoice(*voice);
+    return true;
 }
 
 void AudioEngineImpl::stopAll()
 {
-    for (auto& it : mapChannelInfo) {
-        ChannelInfo & audioRef = it.second;
-        audioRef.channel->stop();
-        audioRef.channel = nullptr;
+    for (auto& voice : _voices) {
+        releaseVoice(voice);
     }
 }
 
 float AudioEngineImpl::getDuration(int audioID)
 {
-    try {
-        FMOD::Sound * sound = mapChannelInfo[audioID].sound;
-        unsigned int length;
-        FMOD_RESULT result = sound->getLength(&length, FMOD_TIMEUNIT_MS);
-        ERRCHECK(result);
-        float duration = (float)length / 1000.0f;
-        return duration;
-    }
-    catch (const std::out_of_range& oor) {
+    Voice * voice = findVoice(audioID);
+    if (!voice) {
         printf("AudioEngineImpl::getDuration: invalid audioID: %d\n", audioID);
         return AudioEngine::TIME_UNKNOWN;
     }
+    unsigned int length;
+    FMOD_RESULT result = voice->sound->sound->getLength(&length, FMOD_TIMEUNIT_MS);
+    if (ERRCHECK(result)) {
+        return AudioEngine::TIME_UNKNOWN;
+    }
+    return (float)length / 1000.0f;
 }
 
 float AudioEngineImpl::getCurrentTime(int audioID)
 {
-    try {
-        unsigned int position;
-        FMOD_RESULT result = mapChannelInfo[audioID].channel->getPosition(&position, FMOD_TIMEUNIT_MS);
-        ERRCHECK(result);
-        float currenttime = position /1000.0f;
-        return currenttime;
-    }
-    catch (const std::out_of_range& oor) {
+    Voice * voice = findVoice(audioID);
+    if (!voice) {
         printf("AudioEngineImpl::getCurrentTime: invalid audioID: %d\n", audioID);
         return AudioEngine::TIME_UNKNOWN;
     }
+    unsigned int position;
+    FMOD_RESULT result = voice->channel->getPosition(&position, FMOD_TIMEUNIT_MS);
+    if (ERRCHECK(result)) {
+        return AudioEngine::TIME_UNKNOWN;
+    }
+    return position / 1000.0f;
 }
 
 bool AudioEngineImpl::setCurrentTime(int audioID, float time)
 {
-    bool ret = false;
-    try {
-        unsigned int position = (unsigned int)(time * 1000.0f);
-        FMOD_RESULT result = mapChannelInfo[audioID].channel->setPosition(position, FMOD_TIMEUNIT_MS);
-        ret = !ERRCHECK(result);
-    }
-    catch (const std::out_of_range& oor) {
+    Voice * voice = findVoice(audioID);
+    if (!voice) {
         printf("AudioEngineImpl::setCurrentTime: invalid audioID: %d\n", audioID);
+        return false;
     }
-    return ret;
+    unsigned int position = (unsigned int)(time * 1000.0f);
+    FMOD_RESULT result = voice->channel->setPosition(position, FMOD_TIMEUNIT_MS);
+    return !ERRCHECK(result);
 }
 
 void AudioEngineImpl::setFinishCallback(int audioID, const std::function<void (int, const std::string &)> &callback)
 {
-    try {
-        FMOD::Channel * channel = mapChannelInfo[audioID].channel;
-        mapChannelInfo[audioID].callback = callback;
-        FMOD_RESULT result = channel->setCallback(channelCallback);
-        ERRCHECK(result);
-    }
-    catch (const std::out_of_range& oor) {
+    Voice * voice = findVoice(audioID);
+    if (!voice) {
         printf("AudioEngineImpl::setFinishCallback: invalid audioID: %d\n", audioID);
+        return;
     }
+    voice->callback = callback;
 }
 
 void AudioEngineImpl::onSoundFinished(FMOD::Channel * channel)
 {
-    int id = 0;
-    try {
-        void * data;
-        channel->getUserData(&data);
-        id = static_cast<int>(reinterpret_cast<std::intptr_t>(data));
-        if (mapChannelInfo[id].callback) {
-            mapChannelInfo[id].callback(id, mapChannelInfo[id].path);
+    void * data = nullptr;
+    channel->getUserData(&data);
+    Voice * voice = static_cast<Voice *>(data);
+    // stopped voices detach from their channel first, and a voice may have been reused since
+    if (!voice || voice->channel != channel) {
+        return;
+    }
+
+    int audioID = voice->id;
+    std::function<void (int, const std::string &)> callback;
+    callback.swap(voice->callback);
+    // the channel has already ended, there is nothing to stop
+    voice->channel = nullptr;
+    releaseVoice(*voice);
+
+    std::string filePath;
+    if (callback) {
+        auto it = AudioEngine::_audioIDInfoMap.find(audioID);
+        if (it != AudioEngine::_audioIDInfoMap.end() && it->second.filePath) {
+            filePath = *it->second.filePath;
         }
-        mapChannelInfo[id].channel = nullptr;
     }
-    catch (const std::out_of_range& oor) {
-        printf("AudioEngineImpl::onSoundFinished: invalid audioID: %d\n", id);
+    AudioEngine::remove(audioID);
+
+    if (callback) {
+        callback(audioID, filePath);
     }
 }
 
 void AudioEngineImpl::uncache(const std::string& path)
 {
-    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
-    std::map<std::string, FMOD::Sound *>::const_iterator it = mapSound.find(fullPath);
-    if (it!=mapSound.end()) {
-        FMOD::Sound * sound = it->second;
-        if (sound) {
-            sound->release();
-        }
-        mapSound.erase(it);
+    auto it = _sounds.find(path);
+    if (it != _sounds.end()) {
+        releaseSound(it);
     }
-    if (mapId.find(path) != mapId.end())
-        mapId.erase(path);
 }
 
 void AudioEngineImpl::uncacheAll()
 {
-    for (const auto& it : mapSound) {
-        auto sound = it.second;
-        if (sound) {
-            sound->release();
-        }
+    while (!_sounds.empty()) {
+        releaseSound(_sounds.begin());
     }
-    mapSound.clear();
-    mapId.clear();
 }
 
-int AudioEngineImpl::preload(const std::string& filePath, std::function<void(bool isSuccess)> callback)
+void AudioEngineImpl::preload(const std::string& filePath, std::function<void(bool isSuccess)> callback)
 {
-    FMOD::Sound * sound = findSound(filePath);
-    if (!sound) {
-        std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-        FMOD_RESULT result = pSystem->createSound(fullPath.c_str(), FMOD_LOOP_OFF, 0, &sound);
-        if (ERRCHECK(result)) {
-            printf("sound effect in %s could not be preload\n", filePath.c_str());
-            if (callback) {
-                callback(false);
-            }
-            return -1;
-        }
-        mapSound[fullPath] = sound;
+    bool success = loadSound(filePath) != nullptr;
+    if (!success) {
+        printf("sound effect in %s could not be preload\n", filePath.c_str());
     }
-
-    int id = static_cast<int>(mapChannelInfo.size()) + 1;
-    if (mapId.find(filePath) == mapId.end())
-        mapId.insert({filePath, id});
-    else
-        id = mapId.at(filePath);
-
-    auto& chanelInfo = mapChannelInfo[id];
-    chanelInfo.sound = sound;
-    chanelInfo.id = id;
-    chanelInfo.channel = nullptr;
-    chanelInfo.callback = nullptr;
-    chanelInfo.path = filePath;
-    //we are going to use UserData to store pointer to Channel when playing
-    chanelInfo.sound->setUserData(reinterpret_cast<void *>(static_cast<std::intptr_t>(id)));
-
     if (callback) {
-        callback(true);
+        callback(success);
     }
-    return id;
 }
 
 void AudioEngineImpl::update(float dt)
@@ -345,17 +359,109 @@ void AudioEngineImpl::update(float dt)
     pSystem->update();
 }
 
-FMOD::Sound * AudioEngineImpl::findSound(const std::string &path)
+AudioEngineImpl::SoundInfo * AudioEngineImpl::loadSound(const std::string &path)
+{
+    auto it = _sounds.find(path);
+    if (it != _sounds.end()) {
+        return &it->second;
+    }
+
+    auto fileUtils = FileUtils::getInstance();
+    std::string fullPath = fileUtils->fullPathForFilename(path);
+    if (fullPath.empty()) {
+        return nullptr;
+    }
+
+    bool streamed = fileUtils->getFileSize(fullPath) > STREAM_FILE_SIZE_THRESHOLD;
+    FMOD::Sound * sound = nullptr;
+    FMOD_RESULT result;
+    if (streamed) {
+        FMOD_CREATESOUNDEXINFO exinfo;
+        memset(&exinfo, 0, sizeof(exinfo));
+        exinfo.cbsize = sizeof(exinfo);
+        exinfo.decodebuffersize = STREAM_DECODE_BUFFER_SAMPLES;
+        // created looping so the start of the track is decoded ahead, each channel sets its own loop mode
+        result = pSystem->createSound(fullPath.c_str(), FMOD_CREATESTREAM | FMOD_LOOP_NORMAL, &exinfo, &sound);
+    }
+    else {
+        result = pSystem->createSound(fullPath.c_str(), FMOD_CREATESAMPLE | FMOD_LOOP_OFF, nullptr, &sound);
+    }
+    if (ERRCHECK(result)) {
+        printf("AudioEngineImpl: %s could not be loaded\n", path.c_str());
+        return nullptr;
+    }
+
+    unsigned int pcmBytes = 0;
+    if (!streamed) {
+        sound->getLength(&pcmBytes, FMOD_TIMEUNIT_PCMBYTES);
+        trimSampleCache(pcmBytes < SAMPLE_CACHE_BUDGET_BYTES ? SAMPLE_CACHE_BUDGET_BYTES - pcmBytes : 0);
+    }
+
+    auto inserted = _sounds.emplace(path, SoundInfo()).first;
+    SoundInfo & info = inserted->second;
+    info.sound = sound;
+    info.streamed = streamed;
+    info.pcmBytes = pcmBytes;
+    info.voiceCount = 0;
+    if (!streamed) {
+        _sampleLru.push_front(&inserted->first);
+        info.lruIter = _sampleLru.begin();
+        _sampleCacheBytes += pcmBytes;
+    }
+    return &info;
+}
+
+AudioEngineImpl::Voice * AudioEngineImpl::findVoice(int audioID)
+{
+    if (audioID < 0) {
+        return nullptr;
+    }
+    Voice & voice = _voices[audioID % MAX_AUDIOINSTANCES];
+    return (voice.id == audioID && voice.channel) ? &voice : nullptr;
+}
+
+void AudioEngineImpl::releaseVoice(Voice & voice)
 {
-    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(path);
-    std::map<std::string, FMOD::Sound *>::const_iterator it = mapSound.find(fullPath);
-    return (it != mapSound.end()) ? (it->second) : nullptr;
+    if (voice.channel) {
+        // the end callback of a stopped channel must not finish the voice a second time
+        voice.channel->setUserData(nullptr);
+        voice.channel->stop();
+        voice.channel = nullptr;
+    }
+    if (voice.sound) {
+        --voice.sound->voiceCount;
+        voice.sound = nullptr;
+    }
+    voice.callback = nullptr;
+    voice.id = AudioEngine::INVALID_AUDIO_ID;
+}
+
+void AudioEngineImpl::trimSampleCache(unsigned int budget)
+{
+    auto it = _sampleLru.end();
+    while (_sampleCacheBytes > budget && it != _sampleLru.begin()) {
+        --it;
+        auto soundIt = _sounds.find(**it);
+        if (soundIt != _sounds.end() && soundIt->second.voiceCount == 0) {
+            // releaseSound erases this node, step past it first
+            ++it;
+            releaseSound(soundIt);
+        }
+    }
 }
 
-FMOD::Channel * AudioEngineImpl::getChannel(FMOD::Sound *sound)
+void AudioEngineImpl::releaseSound(std::unordered_map<std::string, SoundInfo>::iterator it)
 {
-    void * data;
-    sound->getUserData(&data);
-    int id = static_cast<int>(reinterpret_cast<std::intptr_t>(data));
-    return mapChannelInfo[id].channel;
+    SoundInfo & info = it->second;
+    for (auto& voice : _voices) {
+        if (voice.sound == &info) {
+            releaseVoice(voice);
+        }
+    }
+    if (!info.streamed) {
+        _sampleCacheBytes -= info.pcmBytes;
+        _sampleLru.erase(info.lruIter);
+    }
+    info.sound->release();
+    _sounds.erase(it);
 }
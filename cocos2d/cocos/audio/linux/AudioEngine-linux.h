@@ -31,7 +31,9 @@
 
 #include <functional>
 #include <iostream>
-#include <map>
+#include <list>
+#include <string>
+#include <unordered_map>
 #include "fmod.hpp"
 #include "fmod_errors.h"
 #include "audio/include/AudioEngine.h"
@@ -42,6 +44,18 @@ NS_CC_BEGIN
     namespace experimental{
 #define MAX_AUDIOINSTANCES 32
 
+/**
+ * FMOD backend.
+ *
+ * Files larger than a threshold (background music) are streamed: only a fixed file buffer and a
+ * fixed decode ring buffer are kept in memory, whatever the length of the track. Smaller files
+ * (effects) are decoded once to PCM and kept in a cache bounded by a byte budget; the least
+ * recently played samples that are not playing are released first.
+ *
+ * Playback goes through MAX_AUDIOINSTANCES voices allocated up front, one per FMOD channel, so
+ * playing a cached effect again opens no file and allocates nothing. An audio ID encodes its voice
+ * slot and a serial number, so a stale ID never reaches a voice that has been reused.
+ */
 class CC_DLL AudioEngineImpl : public cocos2d::Ref
 {
 public:
@@ -65,7 +79,7 @@ public:
     void uncacheAll();
     
 
-    int preload(const std::string& filePath, std::function<void(bool isSuccess)> callback);
+    void preload(const std::string& filePath, std::function<void(bool isSuccess)> callback);
     
     void update(float dt);
     
@@ -75,30 +89,48 @@ public:
     void onSoundFinished(FMOD::Channel * channel); 
     
 private:
-  
-    /**
-    * returns null if a sound with the given path is not found
-    */
-    FMOD::Sound * findSound(const std::string &path);
-  
-    FMOD::Channel * getChannel(FMOD::Sound *);
-  
-    struct ChannelInfo{
-        int id;
-        std::string path; 
+    struct SoundInfo{
         FMOD::Sound * sound;
-        FMOD::Channel * channel; 
-        bool loop; 
-        float volume; 
+        bool streamed;
+        /** decoded size counted against the sample cache, 0 for streams */
+        unsigned int pcmBytes;
+        /** number of voices playing the sound, it is not evicted while in use */
+        int voiceCount;
+        std::list<const std::string *>::iterator lruIter;
+    };
+
+    struct Voice{
+        int id = AudioEngine::INVALID_AUDIO_ID;
+        SoundInfo * sound = nullptr;
+        FMOD::Channel * channel = nullptr;
         std::function<void (int, const std::string &)> callback;
     };
-    
-    std::map<int, ChannelInfo> mapChannelInfo;
 
-    std::map<std::string, int> mapId;
-    
-    std::map<std::string, FMOD::Sound *> mapSound;  
-    
+    /**
+     * returns the cached sound, creating it on a cache miss; null if the file can not be opened
+     */
+    SoundInfo * loadSound(const std::string &path);
+
+    /** returns null if the ID is invalid or its voice has finished */
+    Voice * findVoice(int audioID);
+
+    /** detaches the voice from its channel and sound, the channel is stopped if still playing */
+    void releaseVoice(Voice & voice);
+
+    /** releases the least recently used samples that are not playing until the cache fits in budget */
+    void trimSampleCache(unsigned int budget);
+
+    void releaseSound(std::unordered_map<std::string, SoundInfo>::iterator it);
+
+    Voice _voices[MAX_AUDIOINSTANCES];
+    int _nextSerial;
+
+    /** sounds by the path they were requested with */
+    std::unordered_map<std::string, SoundInfo> _sounds;
+    /** decoded samples, most recently played first */
+    std::list<const std::string *> _sampleLru;
+    unsigned int _sampleCacheBytes;
+
     FMOD::System* pSystem;
     
 };
@@ -44,6 +44,7 @@ Configuration::Configuration()
 , _maxModelviewStackDepth(0)
 , _supportsPVRTC(false)
 , _supportsETC1(false)
+, _supportsETC2(false)
 , _supportsS3TC(false)
 , _supportsATITC(false)
 , _supportsNPOT(false)
@@ -53,6 +54,7 @@ Configuration::Configuration()
 , _supportsOESDepth24(false)
 , _supportsOESPackedDepthStencil(false)
 , _supportsOESMapBuffer(false)
+, _supportsMapBufferRange(false)
 , _maxSamplesAllowed(0)
 , _maxTextureUnits(0)
 , _glExtensions(nullptr)
@@ -132,6 +134,12 @@ void Configuration::gatherGPUInfo()
     
     _supportsETC1 = checkForGLExtension("GL_OES_compressed_ETC1_RGB8_texture");
     _valueDict["gl.supports_ETC1"] = Value(_supportsETC1);
+
+    // ETC2 is core in OpenGL ES 3.x and in desktop GL through ES3 compatibility
+    const char* glVersion = (const char*)glGetString(GL_VERSION);
+    _supportsETC2 = checkForGLExtension("GL_ARB_ES3_compatibility")
+                 || (glVersion && strstr(glVersion, "OpenGL ES 3") != nullptr);
+    _valueDict["gl.supports_ETC2"] = Value(_supportsETC2);
     
     _supportsS3TC = checkForGLExtension("GL_EXT_texture_compression_s3tc");
     _valueDict["gl.supports_S3TC"] = Value(_supportsS3TC);
@@ -161,6 +169,9 @@ void Configuration::gatherGPUInfo()
     _supportsOESMapBuffer = checkForGLExtension("GL_OES_mapbuffer");
     _valueDict["gl.supports_OES_map_buffer"] = Value(_supportsOESMapBuffer);
 
+    _supportsMapBufferRange = checkForGLExtension("GL_ARB_map_buffer_range") || checkForGLExtension("GL_EXT_map_buffer_range");
+    _valueDict["gl.supports_map_buffer_range"] = Value(_supportsMapBufferRange);
+
     _supportsOESDepth24 = checkForGLExtension("GL_OES_depth24");
     _valueDict["gl.supports_OES_depth24"] = Value(_supportsOESDepth24);
 
@@ -245,6 +256,11 @@ bool Configuration::supportsETC() const
 #endif
 }
 
+bool Configuration::supportsETC2() const
+{
+    return _supportsETC2;
+}
+
 bool Configuration::supportsS3TC() const
 {
 #ifdef GL_EXT_texture_compression_s3tc
@@ -295,6 +311,16 @@ bool Configuration::supportsMapBuffer() const
 #endif
 }
 
+bool Configuration::supportsMapBufferRange() const
+{
+    // glMapBufferRange() is only resolved through GLEW on Linux and Windows
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX || CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    return _supportsMapBufferRange && glMapBufferRange != nullptr;
+#else
+    return false;
+#endif
+}
+
 bool Configuration::supportsOESDepth24() const
 {
     return _supportsOESDepth24;
@@ -114,6 +114,13 @@ public:
      * @return Is true if supports ETC Texture Compressed.
      */
     bool supportsETC() const;
+
+    /** Whether or not ETC2/EAC Texture Compressed is supported.
+     *
+     * @return Is true if supports ETC2 Texture Compressed.
+     * @since v3.17
+     */
+    bool supportsETC2() const;
     
     /** Whether or not S3TC Texture Compressed is supported.
      *
@@ -171,6 +178,15 @@ public:
      */
     bool supportsMapBuffer() const;
 
+    /** Whether or not glMapBufferRange() can be used to stream vertex data.
+     *
+     * Checks for `GL_ARB_map_buffer_range` or `GL_EXT_map_buffer_range`.
+     * Always `false` on platforms where the renderer does not load the entry point.
+     *
+     * @return Whether or not `glMapBufferRange()` is supported.
+     */
+    bool supportsMapBufferRange() const;
+
     
     /** Max support directional light in shader, for Sprite3D.
      *
@@ -252,6 +268,7 @@ protected:
     GLint           _maxModelviewStackDepth;
     bool            _supportsPVRTC;
     bool            _supportsETC1;
+    bool            _supportsETC2;
     bool            _supportsS3TC;
     bool            _supportsATITC;
     bool            _supportsNPOT;
@@ -259,6 +276,7 @@ protected:
     bool            _supportsDiscardFramebuffer;
     bool            _supportsShareableVAO;
     bool            _supportsOESMapBuffer;
+    bool            _supportsMapBufferRange;
     bool            _supportsOESDepth24;
     bool            _supportsOESPackedDepthStencil;
     
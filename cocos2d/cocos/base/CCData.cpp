@@ -26,6 +26,7 @@
 
 #include "base/CCData.h"
 #include "base/CCConsole.h"
+#include "base/ccMacros.h"
 
 NS_CC_BEGIN
 
@@ -51,7 +52,10 @@ _bytes(nullptr),
 _size(0)
 {
     CCLOGINFO("In the copy constructor of Data.");
-    copy(other._bytes, other._size);
+    if (other.isView())
+        setView(other._bytes, other._size, other._owner);
+    else
+        copy(other._bytes, other._size);
 }
 
 Data::~Data()
@@ -63,7 +67,12 @@ Data::~Data()
 Data& Data::operator= (const Data& other)
 {
     CCLOGINFO("In the copy assignment of Data.");
-    copy(other._bytes, other._size);
+    if (this == &other)
+        return *this;
+    if (other.isView())
+        setView(other._bytes, other._size, other._owner);
+    else
+        copy(other._bytes, other._size);
     return *this;
 }
 
@@ -80,6 +89,7 @@ void Data::move(Data& other)
     
     _bytes = other._bytes;
     _size = other._size;
+    _owner = std::move(other._owner);
 
     other._bytes = nullptr;
     other._size = 0;
@@ -114,19 +124,42 @@ void Data::copy(const unsigned char* bytes, const ssize_t size)
 
 void Data::fastSet(unsigned char* bytes, const ssize_t size)
 {
+    _owner.reset();
     _bytes = bytes;
     _size = size;
 }
 
+void Data::setView(const unsigned char* bytes, const ssize_t size, const std::shared_ptr<const void>& owner)
+{
+    CCASSERT(owner != nullptr, "Data::setView: a view needs an owner");
+    clear();
+
+    _bytes = const_cast<unsigned char*>(bytes);
+    _size = size;
+    _owner = owner;
+}
+
 void Data::clear()
 {
-    free(_bytes);
+    // a view only drops its reference, the owner releases the memory
+    if (_owner)
+        _owner.reset();
+    else
+        free(_bytes);
     _bytes = nullptr;
     _size = 0;
 }
 
 unsigned char* Data::takeBuffer(ssize_t* size)
 {
+    if (isView())
+    {
+        // the caller frees the returned buffer, so hand out a copy
+        Data owned;
+        owned.copy(_bytes, _size);
+        *this = std::move(owned);
+    }
+
     auto buffer = getBytes();
     if (size)
         *size = getSize();
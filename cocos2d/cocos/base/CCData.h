@@ -30,6 +30,7 @@
 #include "platform/CCPlatformMacros.h"
 #include <stdint.h> // for ssize_t on android
 #include <string>   // for ssize_t on linux
+#include <memory>
 #include "platform/CCStdC.h" // for ssize_t on window
 
 /**
@@ -109,6 +110,24 @@ public:
      */
     void fastSet(unsigned char* bytes, const ssize_t size);
 
+    /** Makes the Data a read-only view of memory it does not own, e.g. a memory-mapped file.
+     *  @param bytes The first byte of the view.
+     *  @param size The size of the view.
+     *  @param owner Keeps the memory alive; the view and every copy of it hold a reference.
+     *  @note Copying a view shares the memory instead of copying it. takeBuffer() returns a malloc'ed copy.
+     *        The memory must not be written to.
+     *  @since v3.17
+     */
+    void setView(const unsigned char* bytes, const ssize_t size, const std::shared_ptr<const void>& owner);
+
+    /**
+     * Check whether the data is a view of memory it does not own.
+     *
+     * @return True if the Data was set with setView().
+     * @since v3.17
+     */
+    bool isView() const { return _owner != nullptr; }
+
     /**
      * Clears data, free buffer and reset data size.
      */
@@ -148,6 +167,7 @@ private:
 private:
     unsigned char* _bytes;
     ssize_t _size;
+    std::shared_ptr<const void> _owner;
 };
 
 
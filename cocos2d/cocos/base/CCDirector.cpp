@@ -51,6 +51,7 @@ THE SOFTWARE.
 #include "renderer/CCRenderState.h"
 #include "renderer/CCFrameBuffer.h"
 #include "2d/CCCamera.h"
+#include "2d/CCParallelTransformPass.h"
 #include "base/CCUserDefault.h"
 #include "base/ccFPSImages.h"
 #include "base/CCScheduler.h"
@@ -1138,6 +1139,7 @@ void Director::reset()
     GLProgramStateCache::destroyInstance();
     FileUtils::destroyInstance();
     AsyncTaskPool::destroyInstance();
+    ParallelTransformPass::destroyInstance();
     
     // cocos2d-x specific data structures
     UserDefault::destroyInstance();
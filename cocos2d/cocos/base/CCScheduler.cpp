@@ -33,6 +33,8 @@ THE SOFTWARE.
 #include "base/ccCArray.h"
 #include "base/CCScriptSupport.h"
 
+#include <algorithm>
+
 NS_CC_BEGIN
 
 // data structures
@@ -57,6 +59,15 @@ typedef struct _hashUpdateEntry
     UT_hash_handle      hh;
 } tHashUpdateEntry;
 
+// Entry used for "fixed updates"
+typedef struct _fixedEntry
+{
+    ccSchedulerFunc     callback;
+    void                *target;
+    bool                paused;
+    bool                markedForDeletion; // selector will no longer be called and entry will be removed at end of the tick
+} tFixedEntry;
+
 // Hash Element used for "selectors with interval"
 typedef struct _hashSelectorEntry
 {
@@ -260,6 +271,10 @@ Scheduler::Scheduler(void)
 , _currentTarget(nullptr)
 , _currentTargetSalvaged(false)
 , _updateHashLocked(false)
+, _fixedTimeStep(1.0f / 60.0f)
+, _fixedAccumulator(0.0f)
+, _fixedStepAlpha(0.0f)
+, _maxFixedStepsPerFrame(5)
 #if CC_ENABLE_SCRIPT_BINDING
 , _scriptHandlerEntries(20)
 #endif
@@ -570,6 +585,105 @@ void Scheduler::unscheduleUpdate(void *target)
         this->removeUpdateFromHash(element->entry);
 }
 
+void Scheduler::scheduleFixedStep(const ccSchedulerFunc& callback, void *target, bool paused)
+{
+    CCASSERT(target, "Argument target must be non-nullptr");
+
+    for (auto entry : _fixedUpdates)
+    {
+        if (entry->target == target && !entry->markedForDeletion)
+        {
+            entry->callback = callback;
+            entry->paused = paused;
+            return;
+        }
+    }
+
+    tFixedEntry *entry = new (std::nothrow) tFixedEntry();
+    entry->callback = callback;
+    entry->target = target;
+    entry->paused = paused;
+    entry->markedForDeletion = false;
+    _fixedUpdates.push_back(entry);
+}
+
+void Scheduler::unscheduleFixedUpdate(void *target)
+{
+    if (target == nullptr)
+    {
+        return;
+    }
+
+    for (auto it = _fixedUpdates.begin(); it != _fixedUpdates.end(); ++it)
+    {
+        tFixedEntry *entry = *it;
+        if (entry->target == target && !entry->markedForDeletion)
+        {
+            if (_updateHashLocked)
+            {
+                // removed (and its callback destroyed) at the end of the tick; the
+                // callback may be the one currently running
+                entry->markedForDeletion = true;
+            }
+            else
+            {
+                _fixedUpdates.erase(it);
+                delete entry;
+            }
+            return;
+        }
+    }
+}
+
+void Scheduler::setFixedTimeStep(float step)
+{
+    CCASSERT(step > 0.0f, "Fixed time step must be positive");
+    _fixedTimeStep = step;
+}
+
+void Scheduler::setMaxFixedStepsPerFrame(int steps)
+{
+    CCASSERT(steps > 0, "At least one fixed step per frame is required");
+    _maxFixedStepsPerFrame = steps;
+}
+
+void Scheduler::updateFixedSteps(float dt)
+{
+    if (_fixedUpdates.empty())
+    {
+        _fixedAccumulator = 0.0f;
+        _fixedStepAlpha = 0.0f;
+        return;
+    }
+
+    _fixedAccumulator += dt;
+
+    int steps = 0;
+    while (_fixedAccumulator >= _fixedTimeStep && steps < _maxFixedStepsPerFrame)
+    {
+        // entries scheduled inside a callback start on the next step
+        for (size_t i = 0, count = _fixedUpdates.size(); i < count; ++i)
+        {
+            tFixedEntry *entry = _fixedUpdates[i];
+            if (!entry->paused && !entry->markedForDeletion)
+            {
+                entry->callback(_fixedTimeStep);
+            }
+        }
+        _fixedAccumulator -= _fixedTimeStep;
+        ++steps;
+    }
+
+    // keep at most one burst of backlog for the next frames
+    float maxBacklog = _fixedTimeStep * _maxFixedStepsPerFrame;
+    if (_fixedAccumulator > maxBacklog)
+    {
+        _fixedAccumulator = maxBacklog;
+    }
+
+    _fixedStepAlpha = std::min(_fixedAccumulator / _fixedTimeStep, 1.0f);
+}
+
 void Scheduler::unscheduleAll(void)
 {
     unscheduleAllWithMinPriority(PRIORITY_SYSTEM);
@@ -617,6 +731,15 @@ void Scheduler::unscheduleAllWithMinPriority(int minPriority)
             unscheduleUpdate(entry->target);
         }
     }
+    // Fixed updates are user callbacks with priority 0
+    if(minPriority <= 0)
+    {
+        std::vector<tFixedEntry *> fixedUpdates(_fixedUpdates);
+        for (auto entry : fixedUpdates)
+        {
+            unscheduleFixedUpdate(entry->target);
+        }
+    }
 #if CC_ENABLE_SCRIPT_BINDING
     _scriptHandlerEntries.clear();
 #endif
@@ -656,6 +779,9 @@ void Scheduler::unscheduleAllForTarget(void *target)
 
     // update selector
     unscheduleUpdate(target);
+
+    // fixed update selector
+    unscheduleFixedUpdate(target);
 }
 
 #if CC_ENABLE_SCRIPT_BINDING
@@ -701,6 +827,15 @@ void Scheduler::resumeTarget(void *target)
         CCASSERT(elementUpdate->entry != nullptr, "elementUpdate's entry can't be nullptr!");
         elementUpdate->entry->paused = false;
     }
+
+    // fixed update selector
+    for (auto entry : _fixedUpdates)
+    {
+        if (entry->target == target)
+        {
+            entry->paused = false;
+        }
+    }
 }
 
 void Scheduler::pauseTarget(void *target)
@@ -723,6 +858,15 @@ void Scheduler::pauseTarget(void *target)
         CCASSERT(elementUpdate->entry != nullptr, "elementUpdate's entry can't be nullptr!");
         elementUpdate->entry->paused = true;
     }
+
+    // fixed update selector
+    for (auto entry : _fixedUpdates)
+    {
+        if (entry->target == target)
+        {
+            entry->paused = true;
+        }
+    }
 }
 
 bool Scheduler::isTargetPaused(void *target)
@@ -744,6 +888,14 @@ bool Scheduler::isTargetPaused(void *target)
     {
         return elementUpdate->entry->paused;
     }
+
+    for (auto entry : _fixedUpdates)
+    {
+        if (entry->target == target && !entry->markedForDeletion)
+        {
+            return entry->paused;
+        }
+    }
     
     return false;  // should never get here
 }
@@ -797,6 +949,15 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
         }
     }
 
+    if(minPriority <= 0)
+    {
+        for (auto fixedEntry : _fixedUpdates)
+        {
+            fixedEntry->paused = true;
+            idsWithSelectors.insert(fixedEntry->target);
+        }
+    }
+
     return idsWithSelectors;
 }
 
@@ -829,6 +990,12 @@ void Scheduler::update(float dt)
         dt *= _timeScale;
     }
 
+    //
+    // Fixed step callbacks, before the per frame updates so those see the newest simulation state
+    //
+
+    updateFixedSteps(dt);
+
     //
     // Selector callbacks
     //
@@ -910,6 +1077,15 @@ void Scheduler::update(float dt)
 
     _updateDeleteVector.clear();
 
+    _fixedUpdates.erase(std::remove_if(_fixedUpdates.begin(), _fixedUpdates.end(), [](tFixedEntry *entry) {
+        if (entry->markedForDeletion)
+        {
+            delete entry;
+            return true;
+        }
+        return false;
+    }), _fixedUpdates.end());
+
     _updateHashLocked = false;
     _currentTarget = nullptr;
 
@@ -151,10 +151,12 @@ class SchedulerScriptHandlerEntry;
 /** @brief Scheduler is responsible for triggering the scheduled callbacks.
 You should not use system timer for your game logic. Instead, use this class.
 
-There are 2 different types of callbacks (selectors):
+There are 3 different types of callbacks (selectors):
 
 - update selector: the 'update' selector will be called every frame. You can customize the priority.
 - custom selector: A custom selector will be called every frame, or with a custom interval of time
+- fixed update selector: the 'fixedUpdate' selector will be called with a constant step, zero or more
+  times per frame, so that simulation does not depend on the frame rate
 
 The 'custom selectors' should be avoided when possible. It is faster, and consumes less memory to use the 'update selector'.
 
@@ -284,6 +286,56 @@ public:
         }, target, priority, paused);
     }
 
+    /** Schedules the 'fixedUpdate' selector for a given target.
+     The 'fixedUpdate' selector is called with a constant step (see setFixedTimeStep()) as many times
+     as needed to consume the elapsed time, before the per frame updates of the same frame.
+     Renderers can interpolate between the last two simulation states with getFixedStepAlpha().
+     @since v3.17
+     @lua NA
+     */
+    template <class T>
+    void scheduleFixedUpdate(T *target, bool paused)
+    {
+        this->scheduleFixedStep([target](float step){
+            target->fixedUpdate(step);
+        }, target, paused);
+    }
+
+    /** Schedules the 'callback' function for a given target with a fixed step.
+     Only one fixed step callback can be scheduled per target; scheduling again replaces it.
+     @since v3.17
+     @js NA
+     */
+    void scheduleFixedStep(const ccSchedulerFunc& callback, void *target, bool paused);
+
+    /** Sets the simulation step used by fixed updates, in seconds. Default is 1/60.
+     @since v3.17
+     */
+    void setFixedTimeStep(float step);
+
+    /** Gets the simulation step used by fixed updates, in seconds.
+     @since v3.17
+     */
+    float getFixedTimeStep() const { return _fixedTimeStep; }
+
+    /** Sets how many fixed steps can run in one frame. Default is 5.
+     Time that could not be simulated is kept for the next frames up to this many steps, older
+     backlog is dropped so a slow frame cannot make every following frame slower.
+     @since v3.17
+     */
+    void setMaxFixedStepsPerFrame(int steps);
+
+    /** Gets how many fixed steps can run in one frame.
+     @since v3.17
+     */
+    int getMaxFixedStepsPerFrame() const { return _maxFixedStepsPerFrame; }
+
+    /** Returns how far the current frame is between the last two fixed steps, in [0, 1].
+     Use it to interpolate rendered state: previous + (current - previous) * alpha.
+     @since v3.17
+     */
+    float getFixedStepAlpha() const { return _fixedStepAlpha; }
+
 #if CC_ENABLE_SCRIPT_BINDING
     // Schedule for script bindings.
     /** The scheduled script callback will be called every 'interval' seconds.
@@ -322,9 +374,15 @@ public:
      @since v0.99.3
      */
     void unscheduleUpdate(void *target);
+
+    /** Unschedules the fixed update selector for a given target
+     @param target The target to be unscheduled.
+     @since v3.17
+     */
+    void unscheduleFixedUpdate(void *target);
     
     /** Unschedules all selectors for a given target.
-     This also includes the "update" selector.
+     This also includes the "update" and "fixedUpdate" selectors.
      @param target The target to be unscheduled.
      @since v0.99.3
      @lua NA
@@ -508,6 +566,7 @@ protected:
     void schedulePerFrame(const ccSchedulerFunc& callback, void *target, int priority, bool paused);
     
     void removeHashElement(struct _hashSelectorEntry *element);
+    void updateFixedSteps(float dt);
     void removeUpdateFromHash(struct _listEntry *entry);
 
     // update specific
@@ -527,6 +586,13 @@ protected:
     struct _hashUpdateEntry *_hashForUpdates; // hash used to fetch quickly the list entries for pause,delete,etc
     std::vector<struct _listEntry *> _updateDeleteVector; // the vector holds list entries that needs to be deleted after update
 
+    // "fixed updates" stuff
+    std::vector<struct _fixedEntry *> _fixedUpdates;
+    float _fixedTimeStep;
+    float _fixedAccumulator;
+    float _fixedStepAlpha;
+    int _maxFixedStepsPerFrame;
+
     // Used for "selectors with interval"
     struct _hashSelectorEntry *_hashForTimers;
     struct _hashSelectorEntry *_currentTarget;
@@ -0,0 +1,75 @@
+/****************************************************************************
+Copyright (c) 2013-2016 Chukong Technologies Inc.
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CCStringId.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#include "base/ccMacros.h"
+
+NS_CC_BEGIN
+
+namespace
+{
+    // Pooled strings, keyed by hash. Node-based map: element addresses are stable.
+    std::unordered_map<StringId::HashType, std::string>& stringPool()
+    {
+        static std::unordered_map<StringId::HashType, std::string> pool;
+        return pool;
+    }
+
+    std::mutex& stringPoolMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+}
+
+StringId::StringId(const std::string& str)
+: StringId(intern(str))
+{
+}
+
+StringId StringId::intern(const std::string& str)
+{
+    HashType hash = hashOf(str);
+
+    std::lock_guard<std::mutex> lock(stringPoolMutex());
+    auto& pool = stringPool();
+    auto it = pool.find(hash);
+    if (it == pool.end())
+    {
+        it = pool.emplace(hash, str).first;
+    }
+    else if (it->second != str)
+    {
+        CCLOG("StringId: hash collision between \"%s\" and \"%s\"", it->second.c_str(), str.c_str());
+        CCASSERT(false, "StringId hash collision");
+    }
+    return StringId(hash, it->second.c_str(), PooledTag());
+}
+
+NS_CC_END
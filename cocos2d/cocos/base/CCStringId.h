@@ -0,0 +1,119 @@
+/****************************************************************************
+Copyright (c) 2013-2016 Chukong Technologies Inc.
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCSTRING_ID_H__
+#define __CCSTRING_ID_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "platform/CCPlatformMacros.h"
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+NS_CC_BEGIN
+
+/**
+ * @class StringId
+ * @brief A string identified by its 32-bit FNV-1a hash.
+ *
+ * Built from a string literal the hash is computed at compile time, so a
+ * lookup such as `node->getChildByName("EnergyBar")` only compares integers
+ * until a candidate matches. Runtime strings go through StringId::intern(),
+ * which keeps one pooled copy of each distinct string (so c_str() stays
+ * valid for the lifetime of the program) and asserts on hash collisions.
+ *
+ * Lookups that accept a StringId still confirm the match with one string
+ * comparison, so a collision can never return the wrong object.
+ * @since v3.17
+ */
+class CC_DLL StringId
+{
+public:
+    typedef uint32_t HashType;
+
+    /** An empty id. Its hash is the hash of the empty string. */
+    constexpr StringId()
+    : _hash(hashOf("", 0))
+    , _str("")
+    {}
+
+    /** Builds an id from a character array. Stops at the first '\0'. */
+    template <size_t N>
+    constexpr StringId(const char (&literal)[N])
+    : _hash(hashOf(literal, lengthOf(literal, N)))
+    , _str(literal)
+    {}
+
+    /** Builds an id from a runtime string. The string is interned. */
+    explicit StringId(const std::string& str);
+
+    /**
+     * Returns the pooled id for a runtime string.
+     * Thread safe; the returned c_str() never dangles.
+     */
+    static StringId intern(const std::string& str);
+
+    /** FNV-1a over `length` bytes. Usable in constant expressions. */
+    static constexpr HashType hashOf(const char* str, size_t length, HashType hash = 2166136261u)
+    {
+        return length == 0 ? hash : hashOf(str + 1, length - 1, (hash ^ static_cast<unsigned char>(*str)) * 16777619u);
+    }
+
+    static HashType hashOf(const std::string& str) { return hashOf(str.c_str(), str.size()); }
+
+    constexpr HashType getHash() const { return _hash; }
+    constexpr const char* c_str() const { return _str; }
+
+    bool operator==(const StringId& other) const { return _hash == other._hash; }
+    bool operator!=(const StringId& other) const { return _hash != other._hash; }
+
+private:
+    struct PooledTag {};
+
+    StringId(HashType hash, const char* pooled, PooledTag)
+    : _hash(hash)
+    , _str(pooled)
+    {}
+
+    static constexpr size_t lengthOf(const char* str, size_t capacity)
+    {
+        return (capacity == 0 || *str == '\0') ? 0 : 1 + lengthOf(str + 1, capacity - 1);
+    }
+
+    HashType _hash;
+    const char* _str;
+};
+
+NS_CC_END
+
+// end of base group
+/** @} */
+
+#endif // __CCSTRING_ID_H__
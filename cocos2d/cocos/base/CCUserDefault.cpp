@@ -24,6 +24,10 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "base/CCUserDefault.h"
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <zlib.h>
 #include "platform/CCCommon.h"
 #include "platform/CCFileUtils.h"
 #include "tinyxml2.h"
@@ -35,123 +39,431 @@ THE SOFTWARE.
 // root name of xml
 #define USERDEFAULT_ROOT_NAME    "userDefaultRoot"
 
+// values saved by earlier versions, imported once when there is no log yet
 #define XML_FILE_NAME "UserDefault.xml"
 
+#define LOG_FILE_NAME "UserDefault.bin"
+
 using namespace std;
 
 NS_CC_BEGIN
 
 /**
- * define the functions here because we don't want to
- * export xmlNodePtr and other types in "CCUserDefault.h"
+ * Values are kept in a hash map in memory and persisted to an append-only log:
+ *
+ *     header  "CCUD", uint32 version
+ *     record  uint32 crc32 of the rest of the record, uint8 type, uint8 reserved,
+ *             uint16 key length, uint32 value length, key bytes, value bytes
+ *
+ * Integers are little endian, as on all supported targets. Setting a value appends one record and
+ * deleting one appends a DELETED record; the last record of a key wins. Once superseded records
+ * take up more than half of the log, it is rewritten with the live values only.
+ *
+ * Loading stops at the first truncated or damaged record, which a crash while appending may leave,
+ * and the log is then rewritten without it.
  */
-
-static tinyxml2::XMLElement* getXMLNodeForKey(const char* pKey, tinyxml2::XMLElement** rootNode, tinyxml2::XMLDocument **doc)
+namespace
 {
-    tinyxml2::XMLElement* curNode = nullptr;
-
-    // check the key value
-    if (! pKey)
+    enum class ValueType : uint8_t
     {
-        return nullptr;
-    }
-
-    do 
+        DELETED = 0,
+        BOOL = 1,
+        INTEGER = 2,
+        DOUBLE = 3,
+        STRING = 4,
+        DATA = 5,
+    };
+
+    const char LOG_MAGIC[4] = { 'C', 'C', 'U', 'D' };
+    const uint32_t LOG_VERSION = 1;
+    const size_t LOG_HEADER_SIZE = 8;
+    const size_t RECORD_HEADER_SIZE = 12;
+    // Logs smaller than this are not worth compacting
+    const size_t COMPACT_MIN_SIZE = 16 * 1024;
+
+    struct StoredValue
     {
-        tinyxml2::XMLDocument* xmlDoc = new (std::nothrow) tinyxml2::XMLDocument();
-        *doc = xmlDoc;
-        *rootNode = nullptr;
+        ValueType type = ValueType::DELETED;
+        union
+        {
+            bool boolValue;
+            int intValue;
+            double doubleValue;
+        };
+        // STRING and DATA values
+        std::string bytes;
 
-        std::string xmlBuffer = FileUtils::getInstance()->getStringFromFile(UserDefault::getInstance()->getXMLFilePath());
+        StoredValue() : doubleValue(0.0) {}
 
-        if (!xmlBuffer.empty())
+        size_t encodedSize() const
         {
-            xmlDoc->Parse(xmlBuffer.c_str(), xmlBuffer.size());
+            switch (type)
+            {
+            case ValueType::BOOL: return 1;
+            case ValueType::INTEGER: return sizeof(int32_t);
+            case ValueType::DOUBLE: return sizeof(double);
+            case ValueType::STRING:
+            case ValueType::DATA: return bytes.size();
+            default: return 0;
+            }
+        }
 
-            // get root node
-            *rootNode = xmlDoc->RootElement();
+        const void* encodedBytes() const
+        {
+            switch (type)
+            {
+            case ValueType::BOOL: return &boolValue;
+            case ValueType::INTEGER: return &intValue;
+            case ValueType::DOUBLE: return &doubleValue;
+            default: return bytes.data();
+            }
         }
 
-        if (nullptr == *rootNode)
+        bool decode(ValueType valueType, const unsigned char* data, size_t size)
         {
-            // try to insert xml declaration
-            if (!xmlDoc->FirstChild())
+            type = valueType;
+            switch (type)
             {
-                tinyxml2::XMLDeclaration *xmlDeclaration = xmlDoc->NewDeclaration(nullptr);
-                if (nullptr != xmlDeclaration)
-                {
-                    xmlDoc->LinkEndChild(xmlDeclaration);
-                }
+            case ValueType::BOOL:
+                boolValue = (size == 1 && data[0] != 0);
+                return size == 1;
+            case ValueType::INTEGER:
+                if (size != sizeof(int32_t))
+                    return false;
+                memcpy(&intValue, data, size);
+                return true;
+            case ValueType::DOUBLE:
+                if (size != sizeof(double))
+                    return false;
+                memcpy(&doubleValue, data, size);
+                return true;
+            case ValueType::STRING:
+            case ValueType::DATA:
+                bytes.assign(reinterpret_cast<const char*>(data), size);
+                return true;
+            default:
+                return size == 0;
             }
+        }
 
-            // create root element
-            tinyxml2::XMLElement *rootEle = xmlDoc->NewElement(USERDEFAULT_ROOT_NAME);
-            if (nullptr == rootEle)
-                break;
+        bool operator==(const StoredValue& other) const
+        {
+            return type == other.type && encodedSize() == other.encodedSize()
+                && memcmp(encodedBytes(), other.encodedBytes(), encodedSize()) == 0;
+        }
+    };
 
-            xmlDoc->LinkEndChild(rootEle);
-            *rootNode = rootEle;
+    template <typename T>
+    T readValue(const unsigned char* bytes)
+    {
+        T value;
+        memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void appendValue(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    class UserDefaultLog
+    {
+    public:
+        ~UserDefaultLog()
+        {
+            if (_file)
+                fclose(_file);
         }
 
-        // find the node
-        curNode = (*rootNode)->FirstChildElement();
-        while (nullptr != curNode)
+        /** Loads the log, or creates it with the values of the xml file if it is missing. */
+        bool open(const std::string& path, const std::string& xmlPath);
+
+        const StoredValue* find(const char* key) const
         {
-            const char* nodeName = curNode->Value();
-            if (!strcmp(nodeName, pKey))
-            {
-                break;
-            }
+            auto it = _values.find(key);
+            return it == _values.end() ? nullptr : &it->second;
+        }
 
-            curNode = curNode->NextSiblingElement();
+        void set(const char* key, StoredValue& value);
+        void remove(const char* key);
+
+    private:
+        static size_t recordSize(const std::string& key, const StoredValue& value)
+        {
+            return RECORD_HEADER_SIZE + key.size() + value.encodedSize();
         }
-    } while (0);
 
-    return curNode;
+        void encodeRecord(const std::string& key, const StoredValue& value, std::string& out) const;
+        void append(const std::string& key, const StoredValue& value);
+        void importXML(const std::string& xmlPath);
+        // rewrites the log with the live values, returns false if the old log is kept
+        bool compact();
+
+        std::unordered_map<std::string, StoredValue> _values;
+        std::string _path;
+        FILE* _file = nullptr;
+        // bytes in the log, and bytes the live values would take in a compacted log
+        size_t _logSize = 0;
+        size_t _liveSize = LOG_HEADER_SIZE;
+        // reused to encode records
+        std::string _record;
+    };
+
+    UserDefaultLog* s_log = nullptr;
+
+    UserDefaultLog* getLog()
+    {
+        if (!s_log)
+        {
+            s_log = new (std::nothrow) UserDefaultLog();
+            std::string xmlPath = FileUtils::getInstance()->getWritablePath() + XML_FILE_NAME;
+            if (s_log && !s_log->open(UserDefault::getXMLFilePath(), xmlPath))
+            {
+                CC_SAFE_DELETE(s_log);
+            }
+        }
+        return s_log;
+    }
 }
 
-static void setValueForKey(const char* pKey, const char* pValue)
+bool UserDefaultLog::open(const std::string& path, const std::string& xmlPath)
 {
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    // check the params
-    if (! pKey || ! pValue)
+    _path = path;
+    auto fileUtils = FileUtils::getInstance();
+
+    std::string contents;
+    FILE* file = fopen(fileUtils->getSuitableFOpen(path).c_str(), "rb");
+    if (file)
     {
-        return;
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size > 0)
+        {
+            contents.resize(static_cast<size_t>(size));
+            contents.resize(fread(&contents[0], 1, contents.size(), file));
+        }
+        fclose(file);
+    }
+    else
+    {
+        importXML(xmlPath);
+        compact();
+        return _file != nullptr;
+    }
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(contents.data());
+    const size_t size = contents.size();
+    if (size < LOG_HEADER_SIZE || memcmp(bytes, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0
+        || readValue<uint32_t>(bytes + 4) != LOG_VERSION)
+    {
+        CCLOG("UserDefault: %s is not a valid log, it is reset", path.c_str());
+        compact();
+        return _file != nullptr;
     }
-    // find the node
-    node = getXMLNodeForKey(pKey, &rootNode, &doc);
-    // if node exist, change the content
-    if (node)
+
+    size_t offset = LOG_HEADER_SIZE;
+    while (offset + RECORD_HEADER_SIZE <= size)
     {
-        if (node->FirstChild())
+        const unsigned char* record = bytes + offset;
+        const size_t keyLength = readValue<uint16_t>(record + 6);
+        const size_t valueLength = readValue<uint32_t>(record + 8);
+        if (keyLength > size - offset - RECORD_HEADER_SIZE || valueLength > size - offset - RECORD_HEADER_SIZE - keyLength)
+            break;
+
+        const size_t length = RECORD_HEADER_SIZE + keyLength + valueLength;
+        const uLong crc = crc32(0L, record + 4, static_cast<uInt>(length - 4));
+        if (crc != readValue<uint32_t>(record))
+            break;
+
+        std::string key(reinterpret_cast<const char*>(record + RECORD_HEADER_SIZE), keyLength);
+        const ValueType type = static_cast<ValueType>(record[4]);
+        if (type == ValueType::DELETED)
         {
-            node->FirstChild()->SetValue(pValue);
+            _values.erase(key);
         }
         else
         {
-            tinyxml2::XMLText* content = doc->NewText(pValue);
-            node->LinkEndChild(content);
+            StoredValue value;
+            if (!value.decode(type, record + RECORD_HEADER_SIZE + keyLength, valueLength))
+                break;
+            _values[key] = std::move(value);
         }
+        offset += length;
+    }
+
+    _logSize = offset;
+    for (const auto& it : _values)
+    {
+        _liveSize += recordSize(it.first, it.second);
+    }
+
+    if (offset != size)
+    {
+        CCLOG("UserDefault: dropping %d damaged bytes at the end of %s", static_cast<int>(size - offset), path.c_str());
+        compact();
+        return _file != nullptr;
+    }
+
+    _file = fopen(fileUtils->getSuitableFOpen(path).c_str(), "ab");
+    if (!_file)
+    {
+        CCLOG("UserDefault: can not open %s for writing", path.c_str());
+        return false;
+    }
+    if (_logSize > COMPACT_MIN_SIZE && _logSize > 2 * _liveSize)
+    {
+        compact();
+    }
+    return true;
+}
+
+void UserDefaultLog::set(const char* key, StoredValue& value)
+{
+    auto it = _values.find(key);
+    if (it != _values.end())
+    {
+        // setting the value a key already has costs nothing
+        if (it->second == value)
+            return;
+        _liveSize -= recordSize(it->first, it->second);
+        it->second = std::move(value);
     }
     else
     {
-        if (rootNode)
-        {
-            tinyxml2::XMLElement* tmpNode = doc->NewElement(pKey);//new tinyxml2::XMLElement(pKey);
-            rootNode->LinkEndChild(tmpNode);
-            tinyxml2::XMLText* content = doc->NewText(pValue);//new tinyxml2::XMLText(pValue);
-            tmpNode->LinkEndChild(content);
-        }    
+        it = _values.emplace(key, std::move(value)).first;
+    }
+    _liveSize += recordSize(it->first, it->second);
+    append(it->first, it->second);
+}
+
+void UserDefaultLog::remove(const char* key)
+{
+    auto it = _values.find(key);
+    if (it == _values.end())
+        return;
+
+    _liveSize -= recordSize(it->first, it->second);
+    std::string removedKey = it->first;
+    _values.erase(it);
+    append(removedKey, StoredValue());
+}
+
+void UserDefaultLog::encodeRecord(const std::string& key, const StoredValue& value, std::string& out) const
+{
+    const size_t start = out.size();
+    appendValue<uint32_t>(out, 0);
+    appendValue<uint8_t>(out, static_cast<uint8_t>(value.type));
+    appendValue<uint8_t>(out, 0);
+    appendValue<uint16_t>(out, static_cast<uint16_t>(key.size()));
+    appendValue<uint32_t>(out, static_cast<uint32_t>(value.encodedSize()));
+    out.append(key);
+    out.append(static_cast<const char*>(value.encodedBytes()), value.encodedSize());
+
+    unsigned char* record = reinterpret_cast<unsigned char*>(&out[start]);
+    const uint32_t crc = static_cast<uint32_t>(crc32(0L, record + 4, static_cast<uInt>(out.size() - start - 4)));
+    memcpy(record, &crc, sizeof(crc));
+}
+
+void UserDefaultLog::append(const std::string& key, const StoredValue& value)
+{
+    if (key.size() > UINT16_MAX)
+    {
+        CCLOG("UserDefault: key %.32s... is too long to be saved", key.c_str());
+        return;
+    }
+
+    // the rewritten log already holds the new value; if it could not be rewritten,
+    // the record is appended to the old log as usual
+    if (_logSize > COMPACT_MIN_SIZE && _logSize > 2 * _liveSize && compact())
+    {
+        return;
     }
 
-    // save file and free doc
-    if (doc)
+    _record.clear();
+    encodeRecord(key, value, _record);
+    if (!_file || fwrite(_record.data(), 1, _record.size(), _file) != _record.size())
     {
-        doc->SaveFile(FileUtils::getInstance()->getSuitableFOpen(UserDefault::getInstance()->getXMLFilePath()).c_str());
-        delete doc;
+        CCLOG("UserDefault: failed to append to %s", _path.c_str());
+        return;
     }
+    // the record reaches the OS now, like the xml file that was saved on every set
+    fflush(_file);
+    _logSize += _record.size();
+}
+
+void UserDefaultLog::importXML(const std::string& xmlPath)
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(xmlPath))
+        return;
+
+    std::string xmlBuffer = fileUtils->getStringFromFile(xmlPath);
+    tinyxml2::XMLDocument doc;
+    if (xmlBuffer.empty() || doc.Parse(xmlBuffer.c_str(), xmlBuffer.size()) != tinyxml2::XML_SUCCESS)
+        return;
+
+    tinyxml2::XMLElement* root = doc.RootElement();
+    for (auto node = root ? root->FirstChildElement() : nullptr; node; node = node->NextSiblingElement())
+    {
+        // the xml file kept every value as text, the getters convert it as before
+        StoredValue value;
+        value.type = ValueType::STRING;
+        if (node->GetText())
+            value.bytes = node->GetText();
+        _values[node->Value()] = std::move(value);
+    }
+    CCLOG("UserDefault: imported %d values from %s", static_cast<int>(_values.size()), xmlPath.c_str());
+}
+
+bool UserDefaultLog::compact()
+{
+    auto fileUtils = FileUtils::getInstance();
+    const std::string tmpPath = _path + ".tmp";
+
+    _record.clear();
+    _record.append(LOG_MAGIC, sizeof(LOG_MAGIC));
+    appendValue<uint32_t>(_record, LOG_VERSION);
+    for (const auto& it : _values)
+    {
+        if (it.first.size() <= UINT16_MAX)
+            encodeRecord(it.first, it.second, _record);
+    }
+
+    FILE* file = fopen(fileUtils->getSuitableFOpen(tmpPath).c_str(), "wb");
+    if (!file)
+    {
+        CCLOG("UserDefault: can not write %s", tmpPath.c_str());
+        return false;
+    }
+    const bool written = fwrite(_record.data(), 1, _record.size(), file) == _record.size();
+    fclose(file);
+
+    if (_file)
+    {
+        fclose(_file);
+        _file = nullptr;
+    }
+    // the log is replaced in one step, a crash leaves either the old or the new one
+    const bool replaced = written && fileUtils->renameFile(tmpPath, _path);
+    if (!replaced)
+    {
+        CCLOG("UserDefault: failed to compact %s", _path.c_str());
+        fileUtils->removeFile(tmpPath);
+    }
+    else
+    {
+        _logSize = _record.size();
+        _liveSize = _record.size();
+    }
+
+    _file = fopen(fileUtils->getSuitableFOpen(_path).c_str(), "ab");
+    if (!_file)
+    {
+        CCLOG("UserDefault: can not open %s for writing", _path.c_str());
+    }
+    return replaced && _file != nullptr;
 }
 
 /**
@@ -177,27 +489,21 @@ bool UserDefault::getBoolForKey(const char* pKey)
 
 bool UserDefault::getBoolForKey(const char* pKey, bool defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
+    auto log = getLog();
+    const StoredValue* value = (log && pKey) ? log->find(pKey) : nullptr;
+    if (!value)
     {
-        value = (const char*)(node->FirstChild()->Value());
+        return defaultValue;
     }
 
-    bool ret = defaultValue;
-
-    if (value)
+    switch (value->type)
     {
-        ret = (! strcmp(value, "true"));
+    case ValueType::BOOL: return value->boolValue;
+    case ValueType::INTEGER: return value->intValue != 0;
+    case ValueType::DOUBLE: return value->doubleValue != 0.0;
+    case ValueType::STRING: return value->bytes == "true";
+    default: return defaultValue;
     }
-
-    if (doc) delete doc;
-
-    return ret;
 }
 
 int UserDefault::getIntegerForKey(const char* pKey)
@@ -207,31 +513,21 @@ int UserDefault::getIntegerForKey(const char* pKey)
 
 int UserDefault::getIntegerForKey(const char* pKey, int defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
+    auto log = getLog();
+    const StoredValue* value = (log && pKey) ? log->find(pKey) : nullptr;
+    if (!value)
     {
-        value = (const char*)(node->FirstChild()->Value());
+        return defaultValue;
     }
 
-    int ret = defaultValue;
-
-    if (value)
+    switch (value->type)
     {
-        ret = atoi(value);
+    case ValueType::BOOL: return value->boolValue ? 1 : 0;
+    case ValueType::INTEGER: return value->intValue;
+    case ValueType::DOUBLE: return static_cast<int>(value->doubleValue);
+    case ValueType::STRING: return atoi(value->bytes.c_str());
+    default: return defaultValue;
     }
-
-    if(doc)
-    {
-        delete doc;
-    }
-
-
-    return ret;
 }
 
 float UserDefault::getFloatForKey(const char* pKey)
@@ -253,27 +549,21 @@ double  UserDefault::getDoubleForKey(const char* pKey)
 
 double UserDefault::getDoubleForKey(const char* pKey, double defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
+    auto log = getLog();
+    const StoredValue* value = (log && pKey) ? log->find(pKey) : nullptr;
+    if (!value)
     {
-        value = (const char*)(node->FirstChild()->Value());
+        return defaultValue;
     }
 
-    double ret = defaultValue;
-
-    if (value)
+    switch (value->type)
     {
-        ret = utils::atof(value);
+    case ValueType::BOOL: return value->boolValue ? 1.0 : 0.0;
+    case ValueType::INTEGER: return value->intValue;
+    case ValueType::DOUBLE: return value->doubleValue;
+    case ValueType::STRING: return utils::atof(value->bytes.c_str());
+    default: return defaultValue;
     }
-
-    if (doc) delete doc;
-
-    return ret;
 }
 
 std::string UserDefault::getStringForKey(const char* pKey)
@@ -283,27 +573,30 @@ std::string UserDefault::getStringForKey(const char* pKey)
 
 string UserDefault::getStringForKey(const char* pKey, const std::string & defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
+    auto log = getLog();
+    const StoredValue* value = (log && pKey) ? log->find(pKey) : nullptr;
+    if (!value)
     {
-        value = (const char*)(node->FirstChild()->Value());
+        return defaultValue;
     }
 
-    string ret = defaultValue;
-
-    if (value)
+    char tmp[50];
+    switch (value->type)
     {
-        ret = string(value);
+    case ValueType::BOOL:
+        return value->boolValue ? "true" : "false";
+    case ValueType::INTEGER:
+        snprintf(tmp, sizeof(tmp), "%d", value->intValue);
+        return tmp;
+    case ValueType::DOUBLE:
+        snprintf(tmp, sizeof(tmp), "%f", value->doubleValue);
+        return tmp;
+    case ValueType::STRING:
+    case ValueType::DATA:
+        return value->bytes;
+    default:
+        return defaultValue;
     }
-
-    if (doc) delete doc;
-
-    return ret;
 }
 
 Data UserDefault::getDataForKey(const char* pKey)
@@ -313,63 +606,55 @@ Data UserDefault::getDataForKey(const char* pKey)
 
 Data UserDefault::getDataForKey(const char* pKey, const Data& defaultValue)
 {
-    const char* encodedData = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
+    auto log = getLog();
+    const StoredValue* value = (log && pKey) ? log->find(pKey) : nullptr;
+
+    Data ret = defaultValue;
+    if (value && value->type == ValueType::DATA)
     {
-        encodedData = (const char*)(node->FirstChild()->Value());
+        ret.copy(reinterpret_cast<const unsigned char*>(value->bytes.data()), static_cast<ssize_t>(value->bytes.size()));
     }
-    
-    Data ret = defaultValue;
-    
-    if (encodedData)
+    else if (value && value->type == ValueType::STRING)
     {
+        // data imported from the xml file is base64 encoded
         unsigned char * decodedData = nullptr;
-        int decodedDataLen = base64Decode((unsigned char*)encodedData, (unsigned int)strlen(encodedData), &decodedData);
-        
+        int decodedDataLen = base64Decode((const unsigned char*)value->bytes.c_str(), (unsigned int)value->bytes.size(), &decodedData);
+
         if (decodedData) {
             ret.fastSet(decodedData, decodedDataLen);
         }
     }
-    
-    if (doc) delete doc;
-    
-    return ret;    
+
+    return ret;
 }
 
 
 void UserDefault::setBoolForKey(const char* pKey, bool value)
 {
-    // save bool value as string
-
-    if (true == value)
+    auto log = getLog();
+    if (! pKey || ! log)
     {
-        setStringForKey(pKey, "true");
-    }
-    else
-    {
-        setStringForKey(pKey, "false");
+        return;
     }
+
+    StoredValue newValue;
+    newValue.type = ValueType::BOOL;
+    newValue.boolValue = value;
+    log->set(pKey, newValue);
 }
 
 void UserDefault::setIntegerForKey(const char* pKey, int value)
 {
-    // check key
-    if (! pKey)
+    auto log = getLog();
+    if (! pKey || ! log)
     {
         return;
     }
 
-    // format the value
-    char tmp[50];
-    memset(tmp, 0, 50);
-    sprintf(tmp, "%d", value);
-
-    setValueForKey(pKey, tmp);
+    StoredValue newValue;
+    newValue.type = ValueType::INTEGER;
+    newValue.intValue = value;
+    log->set(pKey, newValue);
 }
 
 void UserDefault::setFloatForKey(const char* pKey, float value)
@@ -379,46 +664,43 @@ void UserDefault::setFloatForKey(const char* pKey, float value)
 
 void UserDefault::setDoubleForKey(const char* pKey, double value)
 {
-    // check key
-    if (! pKey)
+    auto log = getLog();
+    if (! pKey || ! log)
     {
         return;
     }
 
-    // format the value
-    char tmp[50];
-    memset(tmp, 0, 50);
-    sprintf(tmp, "%f", value);
-
-    setValueForKey(pKey, tmp);
+    StoredValue newValue;
+    newValue.type = ValueType::DOUBLE;
+    newValue.doubleValue = value;
+    log->set(pKey, newValue);
 }
 
 void UserDefault::setStringForKey(const char* pKey, const std::string & value)
 {
-    // check key
-    if (! pKey)
+    auto log = getLog();
+    if (! pKey || ! log)
     {
         return;
     }
 
-    setValueForKey(pKey, value.c_str());
+    StoredValue newValue;
+    newValue.type = ValueType::STRING;
+    newValue.bytes = value;
+    log->set(pKey, newValue);
 }
 
 void UserDefault::setDataForKey(const char* pKey, const Data& value) {
-    // check key
-    if (! pKey)
+    auto log = getLog();
+    if (! pKey || ! log)
     {
         return;
     }
 
-    char *encodedData = nullptr;
-    
-    base64Encode(value.getBytes(), static_cast<unsigned int>(value.getSize()), &encodedData);
-        
-    setValueForKey(pKey, encodedData);
-    
-    if (encodedData)
-        free(encodedData);
+    StoredValue newValue;
+    newValue.type = ValueType::DATA;
+    newValue.bytes.assign(reinterpret_cast<const char*>(value.getBytes()), static_cast<size_t>(value.getSize()));
+    log->set(pKey, newValue);
 }
 
 UserDefault* UserDefault::getInstance()
@@ -427,7 +709,7 @@ UserDefault* UserDefault::getInstance()
     {
         initXMLFilePath();
 
-        // only create xml file one time
+        // only create the log one time
         // the file exists after the program exit
         if ((!isXMLFileExist()) && (!createXMLFile()))
         {
@@ -443,6 +725,7 @@ UserDefault* UserDefault::getInstance()
 void UserDefault::destroyInstance()
 {
     CC_SAFE_DELETE(_userDefault);
+    CC_SAFE_DELETE(s_log);
 }
 
 void UserDefault::setDelegate(UserDefault *delegate)
@@ -475,39 +758,15 @@ void UserDefault::initXMLFilePath()
 {
     if (! _isFilePathInitialized)
     {
-        _filePath += FileUtils::getInstance()->getWritablePath() + XML_FILE_NAME;
+        _filePath += FileUtils::getInstance()->getWritablePath() + LOG_FILE_NAME;
         _isFilePathInitialized = true;
     }    
 }
 
-// create new xml file
+// create the log, with the values of the xml file of earlier versions
 bool UserDefault::createXMLFile()
 {
-    bool bRet = false;  
-    tinyxml2::XMLDocument *pDoc = new (std::nothrow) tinyxml2::XMLDocument(); 
-    if (nullptr==pDoc)  
-    {  
-        return false;  
-    }  
-    tinyxml2::XMLDeclaration *pDeclaration = pDoc->NewDeclaration(nullptr);  
-    if (nullptr==pDeclaration)  
-    {
-        delete pDoc;
-        return false;  
-    }  
-    pDoc->LinkEndChild(pDeclaration); 
-    tinyxml2::XMLElement *pRootEle = pDoc->NewElement(USERDEFAULT_ROOT_NAME);  
-    if (nullptr==pRootEle)  
-    {
-        delete pDoc;
-        return false;  
-    }  
-    pDoc->LinkEndChild(pRootEle);  
-    bRet = tinyxml2::XML_SUCCESS == pDoc->SaveFile(FileUtils::getInstance()->getSuitableFOpen(_filePath).c_str());
-
-    delete pDoc;
-
-    return bRet;
+    return getLog() != nullptr;
 }
 
 const string& UserDefault::getXMLFilePath()
@@ -521,10 +780,6 @@ void UserDefault::flush()
 
 void UserDefault::deleteValueForKey(const char* key)
 {
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-
     // check the params
     if (!key)
     {
@@ -532,22 +787,10 @@ void UserDefault::deleteValueForKey(const char* key)
         return;
     }
 
-    // find the node
-    node = getXMLNodeForKey(key, &rootNode, &doc);
-
-    // if node not exist, don't need to delete
-    if (!node)
-    {
-        CC_SAFE_DELETE(doc);
-        return;
-    }
-
-    // save file and free doc
-    if (doc)
+    auto log = getLog();
+    if (log)
     {
-        doc->DeleteNode(node);
-        doc->SaveFile(FileUtils::getInstance()->getSuitableFOpen(UserDefault::getInstance()->getXMLFilePath()).c_str());
-        delete doc;
+        log->remove(key);
     }
 
     flush();
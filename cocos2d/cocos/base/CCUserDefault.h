@@ -45,8 +45,9 @@ NS_CC_BEGIN
  * It supports the following base types:
  * bool, int, float, double, string
  *
- * @warning: On windows, linux, use XML to store data, which means there are some limitations of
- * the key string, for example, `/` is not valid.
+ * On windows and linux, values are kept in memory and each set appends a small binary record to a
+ * log in the writable path, which is compacted when it grows. Values of an existing UserDefault.xml
+ * are imported the first time.
  */
 class CC_DLL UserDefault
 {
@@ -244,7 +245,8 @@ public:
      * @js NA
      */
     CC_DEPRECATED_ATTRIBUTE static void purgeSharedUserDefault();
-    /** All supported platforms other iOS & Android use xml file to save values. This function is return the file path of the xml path.
+    /** All supported platforms other iOS & Android save values to a file. This function returns the path of that file,
+     * which is a binary log on windows and linux.
      * @js NA
      */
     static const std::string& getXMLFilePath();
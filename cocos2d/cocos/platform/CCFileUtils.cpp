@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "base/ccMacros.h"
 #include "base/CCDirector.h"
 #include "platform/CCSAXParser.h"
+#include "platform/CCResourceArchive.h"
 //#include "base/ccUtils.h"
 
 #include "tinyxml2/tinyxml2.h"
@@ -552,7 +553,8 @@ void FileUtils::setDelegate(FileUtils *delegate)
 }
 
 FileUtils::FileUtils()
-    : _writablePath("")
+    : _fullPathCacheGeneration(0)
+    , _writablePath("")
 {
 }
 
@@ -618,8 +620,112 @@ bool FileUtils::init()
 }
 
 void FileUtils::purgeCachedEntries()
+{
+    clearFullPathCache();
+}
+
+void FileUtils::clearFullPathCache()
 {
     _fullPathCache.clear();
+    _missingPathCache.clear();
+    ++_fullPathCacheGeneration;
+}
+
+bool FileUtils::loadAssetManifest(const std::string& filename)
+{
+    _assetManifest.clear();
+    clearFullPathCache();
+
+    std::string fullpath = fullPathForFilename(filename);
+    if (fullpath.empty())
+    {
+        CCLOG("cocos2d: FileUtils: asset manifest %s not found, falling back to search path lookups", filename.c_str());
+        return false;
+    }
+
+    // One entry per line: <relative path>\t<size>\t<crc32 in hex>. Lines starting with '#' are comments.
+    std::string content = getStringFromFile(fullpath);
+    std::unordered_map<std::string, AssetInfo> manifest;
+    size_t lineStart = 0;
+    while (lineStart < content.size())
+    {
+        size_t lineEnd = content.find('\n', lineStart);
+        if (lineEnd == std::string::npos)
+            lineEnd = content.size();
+
+        if (lineEnd > lineStart && content[lineStart] != '#')
+        {
+            size_t sizeStart = content.find('\t', lineStart);
+            size_t hashStart = sizeStart < lineEnd ? content.find('\t', sizeStart + 1) : std::string::npos;
+            if (hashStart >= lineEnd)
+            {
+                CCLOG("cocos2d: FileUtils: malformed asset manifest %s", fullpath.c_str());
+                return false;
+            }
+
+            AssetInfo info;
+            info.size = strtol(content.c_str() + sizeStart + 1, nullptr, 10);
+            info.crc32 = static_cast<uint32_t>(strtoul(content.c_str() + hashStart + 1, nullptr, 16));
+            std::string path = content.substr(lineStart, sizeStart - lineStart);
+
+            // Parent directories are listed too, so directory lookups are answered as well
+            AssetInfo directory = { -1, 0 };
+            for (size_t slash = path.find('/'); slash != std::string::npos; slash = path.find('/', slash + 1))
+            {
+                manifest.emplace(path.substr(0, slash), directory);
+            }
+            manifest[path] = info;
+        }
+        lineStart = lineEnd + 1;
+    }
+
+    _assetManifest.swap(manifest);
+    clearFullPathCache();
+    return true;
+}
+
+bool FileUtils::getAssetInfo(const std::string& filename, AssetInfo& info) const
+{
+    auto it = _assetManifest.find(filename);
+    if (it == _assetManifest.end())
+        return false;
+    info = it->second;
+    return true;
+}
+
+namespace
+{
+    // searchPath + file_path + resourceDirectory + file, relative to the default resource root.
+    // Only plain relative paths are answered; anything the platform would normalize is looked up on disk.
+    bool getRootRelativePath(const std::string& filename, const std::string& resolutionDirectory, std::string& relativePath)
+    {
+        relativePath = filename;
+        if (!resolutionDirectory.empty())
+        {
+            size_t pos = filename.find_last_of('/');
+            relativePath.insert(pos == std::string::npos ? 0 : pos + 1, resolutionDirectory);
+        }
+
+        return !(relativePath.back() == '/' || relativePath.find('\\') != std::string::npos ||
+                 relativePath.find("./") != std::string::npos || relativePath.find("//") != std::string::npos);
+    }
+}
+
+bool FileUtils::getPathFromAssetManifest(const std::string& filename, const std::string& resolutionDirectory, std::string& fullpath) const
+{
+    std::string relativePath;
+    if (!getRootRelativePath(filename, resolutionDirectory, relativePath))
+        return false;
+
+    if (_assetManifest.find(relativePath) == _assetManifest.end())
+    {
+        fullpath.clear();
+    }
+    else
+    {
+        fullpath = _defaultResRootPath + relativePath;
+    }
+    return true;
 }
 
 std::string FileUtils::getStringFromFile(const std::string& filename)
@@ -654,11 +760,59 @@ void FileUtils::getDataFromFile(const std::string& filename, std::function<void(
     }, std::move(callback));
 }
 
+bool FileUtils::addResourceArchive(const std::string& filename)
+{
+    std::string fullpath = fullPathForFilename(filename);
+    if (fullpath.empty())
+        return false;
+
+    auto archive = ResourceArchive::open(fullpath);
+    if (!archive)
+        return false;
+
+    _resourceArchives.insert(_resourceArchives.begin(), archive);
+    clearFullPathCache();
+    return true;
+}
+
+void FileUtils::removeAllResourceArchives()
+{
+    _resourceArchives.clear();
+    clearFullPathCache();
+}
+
+const ResourceArchive* FileUtils::findResourceArchive(const std::string& fullPath, std::string& relativePath) const
+{
+    if (_resourceArchives.empty() || fullPath.compare(0, _defaultResRootPath.size(), _defaultResRootPath) != 0)
+        return nullptr;
+
+    relativePath = fullPath.substr(_defaultResRootPath.size());
+    for (const auto& archive : _resourceArchives)
+    {
+        if (archive->contains(relativePath))
+            return archive.get();
+    }
+    return nullptr;
+}
+
+bool FileUtils::getContentsFromResourceArchive(const std::string& filename, ResizableBuffer* buffer) const
+{
+    if (_resourceArchives.empty())
+        return false;
+
+    std::string relativePath;
+    const ResourceArchive* archive = findResourceArchive(fullPathForFilename(filename), relativePath);
+    return archive && archive->read(relativePath, buffer);
+}
+
 FileUtils::Status FileUtils::getContents(const std::string& filename, ResizableBuffer* buffer)
 {
     if (filename.empty())
         return Status::NotExists;
 
+    if (getContentsFromResourceArchive(filename, buffer))
+        return Status::OK;
+
     auto fs = FileUtils::getInstance();
 
     std::string fullPath = fs->fullPathForFilename(filename);
@@ -825,6 +979,12 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const
         return cacheIter->second;
     }
 
+    // Known to be missing ?
+    if (_missingPathCache.find(filename) != _missingPathCache.end())
+    {
+        return "";
+    }
+
     // Get the new file name.
     const std::string newFilename( getNewFilename(filename) );
 
@@ -832,9 +992,29 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const
 
     for (const auto& searchIt : _searchPathArray)
     {
+        // The asset manifest describes the default resource root, so that search path needs no file system access.
+        bool useManifest = !_assetManifest.empty() && searchIt == _defaultResRootPath;
         for (const auto& resolutionIt : _searchResolutionsOrderArray)
         {
-            fullpath = this->getPathForFilename(newFilename, resolutionIt, searchIt);
+            if (!useManifest || !getPathFromAssetManifest(newFilename, resolutionIt, fullpath))
+            {
+                fullpath = this->getPathForFilename(newFilename, resolutionIt, searchIt);
+            }
+
+            // Files packed in a resource archive live in the default resource root too
+            std::string relativePath;
+            if (fullpath.empty() && !_resourceArchives.empty() && searchIt == _defaultResRootPath
+                && getRootRelativePath(newFilename, resolutionIt, relativePath))
+            {
+                for (const auto& archive : _resourceArchives)
+                {
+                    if (archive->contains(relativePath))
+                    {
+                        fullpath = _defaultResRootPath + relativePath;
+                        break;
+                    }
+                }
+            }
 
             if (!fullpath.empty())
             {
@@ -850,7 +1030,8 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const
         CCLOG("cocos2d: fullPathForFilename: No file found at %s. Possible missing file.", filename.c_str());
     }
 
-    // The file wasn't found, return empty string.
+    // The file wasn't found, remember the miss and return empty string.
+    _missingPathCache.insert(filename);
     return "";
 }
 
@@ -868,7 +1049,7 @@ void FileUtils::setSearchResolutionsOrder(const std::vector<std::string>& search
 
     bool existDefault = false;
 
-    _fullPathCache.clear();
+    clearFullPathCache();
     _searchResolutionsOrderArray.clear();
     for(const auto& iter : searchResolutionsOrder)
     {
@@ -934,7 +1115,7 @@ void FileUtils::setDefaultResourceRootPath(const std::string& path)
 {
     if (_defaultResRootPath != path)
     {
-        _fullPathCache.clear();
+        clearFullPathCache();
         _defaultResRootPath = path;
         if (!_defaultResRootPath.empty() && _defaultResRootPath[_defaultResRootPath.length()-1] != '/')
         {
@@ -951,7 +1132,7 @@ void FileUtils::setSearchPaths(const std::vector<std::string>& searchPaths)
     bool existDefaultRootPath = false;
     _originalSearchPaths = searchPaths;
 
-    _fullPathCache.clear();
+    clearFullPathCache();
     _searchPathArray.clear();
 
     for (const auto& path : _originalSearchPaths)
@@ -1005,7 +1186,7 @@ void FileUtils::addSearchPath(const std::string &searchpath,const bool front)
 
 void FileUtils::setFilenameLookupDictionary(const ValueMap& filenameLookupDict)
 {
-    _fullPathCache.clear();
+    clearFullPathCache();
     _filenameLookupDict = filenameLookupDict;
 }
 
@@ -1049,7 +1230,8 @@ bool FileUtils::isFileExist(const std::string& filename) const
 {
     if (isAbsolutePath(filename))
     {
-        return isFileExistInternal(filename);
+        std::string relativePath;
+        return isFileExistInternal(filename) || findResourceArchive(filename, relativePath) != nullptr;
     }
     else
     {
@@ -29,7 +29,9 @@ THE SOFTWARE.
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <type_traits>
+#include <memory>
 
 #include "platform/CCPlatformMacros.h"
 #include "base/ccTypes.h"
@@ -41,6 +43,8 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+class ResourceArchive;
+
 /**
  * @addtogroup platform
  * @{
@@ -52,6 +56,8 @@ public:
     virtual ~ResizableBuffer() {}
     virtual void resize(size_t size) = 0;
     virtual void* buffer() const = 0;
+    /** Makes the buffer a read-only view of memory kept alive by owner. Returns false if views are not supported, then the bytes are copied. */
+    virtual bool assignView(const void* /*bytes*/, size_t /*size*/, const std::shared_ptr<const void>& /*owner*/) { return false; }
 };
 
 template<typename T>
@@ -105,6 +111,13 @@ public:
     explicit ResizableBufferAdapter(BufferType* buffer) : _buffer(buffer) {}
     virtual void resize(size_t size) override {
         size_t oldSize = static_cast<size_t>(_buffer->getSize());
+        if (_buffer->isView()) {
+            // a view can't be reallocated, copy it into an owned buffer first
+            Data owned;
+            owned.copy(_buffer->getBytes(), static_cast<ssize_t>(oldSize < size ? oldSize : size));
+            *_buffer = std::move(owned);
+            oldSize = static_cast<size_t>(_buffer->getSize());
+        }
         if (oldSize != size) {
             auto old = _buffer->getBytes();
             void* buffer = realloc(old, size);
@@ -115,6 +128,10 @@ public:
     virtual void* buffer() const override {
         return _buffer->getBytes();
     }
+    virtual bool assignView(const void* bytes, size_t size, const std::shared_ptr<const void>& owner) override {
+        _buffer->setView(static_cast<const unsigned char*>(bytes), static_cast<ssize_t>(size), owner);
+        return true;
+    }
 };
 
 /** Helper class to handle file operations. */
@@ -161,9 +178,59 @@ public:
 
     /**
      *  Purges full path caches.
+     *  Call it after files are added under a search path at runtime, since failed lookups are cached too.
      */
     virtual void purgeCachedEntries();
 
+    /** Size and content checksum of a file listed in the asset manifest. Directories have a size of -1. */
+    struct AssetInfo
+    {
+        long size;
+        uint32_t crc32;
+    };
+
+    /**
+     *  Loads a prebuilt asset manifest describing every file under the default resource root.
+     *  While a manifest is loaded, lookups in the default resource root are answered from it
+     *  without touching the file system; other search paths are still searched on disk.
+     *  The manifest is a text file with one `<relative path>\t<size>\t<crc32 in hex>` line per file.
+     *
+     *  @param filename The manifest file, relative to a search path or absolute.
+     *  @return True if the manifest was loaded. On failure no manifest is used.
+     *  @since v3.17
+     */
+    bool loadAssetManifest(const std::string& filename);
+
+    /**
+     *  Gets the manifest entry of a file.
+     *
+     *  @param filename The path relative to the default resource root.
+     *  @param info Filled in when the file is listed.
+     *  @return True if the file is listed in the loaded asset manifest.
+     *  @since v3.17
+     */
+    bool getAssetInfo(const std::string& filename, AssetInfo& info) const;
+
+    /**
+     *  Mounts a packed resource archive (see ResourceArchive) over the default resource root.
+     *  Files in the archive are found by fullPathForFilename() as if they were in the default resource root,
+     *  and getContents()/getDataFromFile() read them from the memory-mapped archive: Data gets a view
+     *  into the mapping instead of a copy. The archive is checked before the file system, and archives
+     *  mounted later are checked first.
+     *  Mount archives before loading resources; mounting is not thread safe.
+     *
+     *  @param filename The archive file, relative to a search path or absolute.
+     *  @return True if the archive was mounted.
+     *  @since v3.17
+     */
+    bool addResourceArchive(const std::string& filename);
+
+    /**
+     *  Unmounts all resource archives. Data views already handed out stay valid.
+     *  @since v3.17
+     */
+    void removeAllResourceArchives();
+
     /**
      *  Gets string from a file.
      */
@@ -844,6 +911,14 @@ public:
     /** Returns the full path cache. */
     const std::unordered_map<std::string, std::string>& getFullPathCache() const { return _fullPathCache; }
 
+    /**
+     * Returns a counter that changes every time the full path cache is purged,
+     * i.e. whenever a filename may start resolving to a different full path.
+     * Caches keyed by unresolved filenames can compare it to detect staleness.
+     * @since v3.17
+     */
+    unsigned int getFullPathCacheGeneration() const { return _fullPathCacheGeneration; }
+
     /**
      *  Gets the new filename from the filename lookup dictionary.
      *  It is possible to have a override names.
@@ -893,6 +968,39 @@ protected:
      */
     virtual std::string getPathForFilename(const std::string& filename, const std::string& resolutionDirectory, const std::string& searchPath) const;
 
+    /**
+     *  Resolves a file in the default resource root from the asset manifest.
+     *
+     *  @param filename The file name.
+     *  @param resolutionDirectory The resolution directory.
+     *  @param fullpath Set to the full path, or emptied if the file is not listed.
+     *  @return False if the manifest can't answer for this name and the file system must be checked.
+     */
+    bool getPathFromAssetManifest(const std::string& filename, const std::string& resolutionDirectory, std::string& fullpath) const;
+
+    /**
+     *  Clears the full path and missing path caches.
+     */
+    void clearFullPathCache();
+
+    /**
+     *  Reads a file from the mounted resource archives.
+     *
+     *  @param filename The file name, relative or a full path in the default resource root.
+     *  @param buffer Filled with the contents of the file.
+     *  @return True if an archive holds the file and it was read.
+     */
+    bool getContentsFromResourceArchive(const std::string& filename, ResizableBuffer* buffer) const;
+
+    /**
+     *  Gets the mounted archive holding a file.
+     *
+     *  @param fullPath The full path of the file.
+     *  @param relativePath Set to the path relative to the default resource root.
+     *  @return The archive, or nullptr if no mounted archive holds the file.
+     */
+    const ResourceArchive* findResourceArchive(const std::string& fullPath, std::string& relativePath) const;
+
     /**
      *  Gets full path for the directory and the filename.
      *
@@ -946,6 +1054,26 @@ protected:
      */
     mutable std::unordered_map<std::string, std::string> _fullPathCache;
 
+    /**
+     *  Filenames that were not found in any search path, so repeated misses skip the search.
+     */
+    mutable std::unordered_set<std::string> _missingPathCache;
+
+    /**
+     * Incremented whenever _fullPathCache is cleared.
+     */
+    unsigned int _fullPathCacheGeneration;
+
+    /**
+     *  Files under the default resource root, keyed by relative path. Empty when no manifest is loaded.
+     */
+    std::unordered_map<std::string, AssetInfo> _assetManifest;
+
+    /**
+     *  Mounted resource archives, the most recently mounted first.
+     */
+    std::vector<std::shared_ptr<ResourceArchive>> _resourceArchives;
+
     /**
      * Writable path.
      */
@@ -256,6 +256,12 @@ namespace
         _pixel3_formathash::value_type(PVR3TexturePixelFormat::PVRTC4BPP_RGBA,      Texture2D::PixelFormat::PVRTC4A),
 
         _pixel3_formathash::value_type(PVR3TexturePixelFormat::ETC1,        Texture2D::PixelFormat::ETC),
+        _pixel3_formathash::value_type(PVR3TexturePixelFormat::ETC2_RGB,    Texture2D::PixelFormat::ETC2_RGB),
+        _pixel3_formathash::value_type(PVR3TexturePixelFormat::ETC2_RGBA,   Texture2D::PixelFormat::ETC2_RGBA),
+
+        _pixel3_formathash::value_type(PVR3TexturePixelFormat::DXT1,        Texture2D::PixelFormat::S3TC_DXT1),
+        _pixel3_formathash::value_type(PVR3TexturePixelFormat::DXT3,        Texture2D::PixelFormat::S3TC_DXT3),
+        _pixel3_formathash::value_type(PVR3TexturePixelFormat::DXT5,        Texture2D::PixelFormat::S3TC_DXT5),
     };
         
     static const int PVR3_MAX_TABLE_ELEMENTS = sizeof(v3_pixel_formathash_value) / sizeof(v3_pixel_formathash_value[0]);
@@ -491,6 +497,7 @@ Image::Image()
 , _renderFormat(Texture2D::PixelFormat::NONE)
 , _numberOfMipmaps(0)
 , _hasPremultipliedAlpha(false)
+, _decodePixelFormat(Texture2D::PixelFormat::NONE)
 {
 
 }
@@ -1028,6 +1035,10 @@ bool Image::initWithPngData(const unsigned char * data, ssize_t dataLen)
     png_byte        header[PNGSIGSIZE]   = {0}; 
     png_structp     png_ptr     =   0;
     png_infop       info_ptr    = 0;
+    // Row buffers are freed after the loop, so a libpng error that longjmps back to setjmp
+    // doesn't leak them. volatile: they are assigned after setjmp.
+    png_bytep* volatile row_pointers = nullptr;
+    unsigned char* volatile scratchRow = nullptr;
 
     do 
     {
@@ -1097,6 +1108,40 @@ bool Image::initWithPngData(const unsigned char * data, ssize_t dataLen)
         {
             png_set_packing(png_ptr);
         }
+
+        // decode straight into the requested texture format, see setDecodePixelFormat()
+        Texture2D::PixelFormat decodeFormat = Texture2D::PixelFormat::NONE;
+        switch (_decodePixelFormat)
+        {
+        case Texture2D::PixelFormat::RGBA8888:
+        case Texture2D::PixelFormat::RGBA4444:
+        case Texture2D::PixelFormat::RGB5A1:
+        case Texture2D::PixelFormat::RGB565:
+            decodeFormat = _decodePixelFormat;
+            break;
+        default:
+            break;
+        }
+
+        int passes = png_set_interlace_handling(png_ptr);
+        if (decodeFormat != Texture2D::PixelFormat::NONE)
+        {
+            // every row becomes 8 bit RGBA, then it is packed into the decode format
+            if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+            {
+                png_set_gray_to_rgb(png_ptr);
+            }
+            if (!(color_type & PNG_COLOR_MASK_ALPHA) && !png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
+            {
+                png_set_filler(png_ptr, 0xFF, PNG_FILLER_AFTER);
+            }
+            // interlaced rows arrive in several passes, Texture2D converts those afterwards
+            if (passes > 1)
+            {
+                decodeFormat = Texture2D::PixelFormat::RGBA8888;
+            }
+        }
+
         // update info
         png_read_update_info(png_ptr, info_ptr);
         color_type = png_get_color_type(png_ptr, info_ptr);
@@ -1119,45 +1164,77 @@ bool Image::initWithPngData(const unsigned char * data, ssize_t dataLen)
             break;
         }
 
-        // read png data
-        png_size_t rowbytes;
-        png_bytep* row_pointers = (png_bytep*)malloc( sizeof(png_bytep) * _height );
+        // premultiplied alpha for RGBA8888
+        bool premultiply = PNG_PREMULTIPLIED_ALPHA_ENABLED && color_type == PNG_COLOR_TYPE_RGB_ALPHA;
+        if (decodeFormat != Texture2D::PixelFormat::NONE)
+        {
+            _renderFormat = decodeFormat;
+        }
 
-        rowbytes = png_get_rowbytes(png_ptr, info_ptr);
+        // read png data
+        png_size_t rowbytes = png_get_rowbytes(png_ptr, info_ptr);
 
-        _dataLen = rowbytes * _height;
-        _data = static_cast<unsigned char*>(malloc(_dataLen * sizeof(unsigned char)));
-        if (!_data)
+        if (passes > 1)
         {
-            if (row_pointers != nullptr)
+            row_pointers = (png_bytep*)malloc( sizeof(png_bytep) * _height );
+
+            _dataLen = rowbytes * _height;
+            _data = static_cast<unsigned char*>(malloc(_dataLen * sizeof(unsigned char)));
+            CC_BREAK_IF(!_data || !row_pointers);
+
+            for (int i = 0; i < _height; ++i)
             {
-                free(row_pointers);
+                row_pointers[i] = _data + i*rowbytes;
             }
-            break;
-        }
+            png_read_image(png_ptr, row_pointers);
 
-        for (unsigned short i = 0; i < _height; ++i)
-        {
-            row_pointers[i] = _data + i*rowbytes;
+            png_read_end(png_ptr, nullptr);
+
+            if (premultiply)
+            {
+                premultipliedAlpha();
+            }
         }
-        png_read_image(png_ptr, row_pointers);
+        else
+        {
+            // Rows are decoded one by one into the image data. A row that is packed into 16 bit
+            // is decoded into a scratch row first, premultiplied and converted while it is still in cache.
+            bool packRows = (decodeFormat != Texture2D::PixelFormat::NONE && decodeFormat != Texture2D::PixelFormat::RGBA8888);
+            size_t dataRowBytes = packRows ? _width * 2 : rowbytes;
 
-        png_read_end(png_ptr, nullptr);
+            _dataLen = dataRowBytes * _height;
+            _data = static_cast<unsigned char*>(malloc(_dataLen * sizeof(unsigned char)));
+            scratchRow = packRows ? static_cast<unsigned char*>(malloc(rowbytes)) : nullptr;
+            CC_BREAK_IF(!_data || (packRows && !scratchRow));
 
-        // premultiplied alpha for RGBA8888
-        if (PNG_PREMULTIPLIED_ALPHA_ENABLED && color_type == PNG_COLOR_TYPE_RGB_ALPHA)
-        {
-            premultipliedAlpha();
-        }
+#if CC_ENABLE_PREMULTIPLIED_ALPHA == 0
+            premultiply = false;
+#endif
+            for (int y = 0; y < _height; ++y)
+            {
+                unsigned char* dataRow = _data + y * dataRowBytes;
+                unsigned char* row = packRows ? scratchRow : dataRow;
+                png_read_row(png_ptr, row, nullptr);
 
-        if (row_pointers != nullptr)
-        {
-            free(row_pointers);
+                if (premultiply)
+                {
+                    premultiplyRGBA8888Row(row, _width);
+                }
+                if (packRows)
+                {
+                    packRGBA8888Row(row, rowbytes, decodeFormat, dataRow);
+                }
+            }
+
+            png_read_end(png_ptr, nullptr);
+            _hasPremultipliedAlpha = premultiply;
         }
 
         ret = true;
     } while (0);
 
+    free(row_pointers);
+    free(scratchRow);
     if (png_ptr)
     {
         png_destroy_read_struct(&png_ptr, (info_ptr) ? &info_ptr : 0, 0);
@@ -1353,6 +1430,10 @@ namespace
             case PVR3TexturePixelFormat::DXT3:
             case PVR3TexturePixelFormat::DXT5:
                 return Configuration::getInstance()->supportsS3TC();
+
+            case PVR3TexturePixelFormat::ETC2_RGB:
+            case PVR3TexturePixelFormat::ETC2_RGBA:
+                return Configuration::getInstance()->supportsETC2();
                 
             case PVR3TexturePixelFormat::BGRA8888:
                 return Configuration::getInstance()->supportsBGRA8888();
@@ -1596,7 +1677,7 @@ bool Image::initWithPVRv3Data(const unsigned char * data, ssize_t dataLen)
     _width = width;
     _height = height;
     int dataOffset = 0, dataSize = 0;
-    int blockSize = 0, widthBlocks = 0, heightBlocks = 0;
+    int blockSize = 0, widthBlocks = 0, heightBlocks = 0, minBlocks = 2;
     
     _dataLen = dataLen - (sizeof(PVRv3TexHeader) + header->metadataLength);
     _data = static_cast<unsigned char*>(malloc(_dataLen * sizeof(unsigned char)));
@@ -1657,6 +1738,17 @@ bool Image::initWithPVRv3Data(const unsigned char * data, ssize_t dataLen)
                 widthBlocks = width / 4;
                 heightBlocks = height / 4;
                 break;
+            case PVR3TexturePixelFormat::DXT1:
+            case PVR3TexturePixelFormat::DXT3:
+            case PVR3TexturePixelFormat::DXT5:
+            case PVR3TexturePixelFormat::ETC2_RGB:
+            case PVR3TexturePixelFormat::ETC2_RGBA:
+                // 4x4 blocks, partial blocks are padded; testFormatForPvr3TCSupport() already required hardware support
+                blockSize = 4 * 4;
+                widthBlocks = (width + 3) / 4;
+                heightBlocks = (height + 3) / 4;
+                minBlocks = 1;
+                break;
             case PVR3TexturePixelFormat::BGRA8888:
                 if (! Configuration::getInstance()->supportsBGRA8888())
                 {
@@ -1671,13 +1763,13 @@ bool Image::initWithPVRv3Data(const unsigned char * data, ssize_t dataLen)
         }
         
         // Clamp to minimum number of blocks
-        if (widthBlocks < 2)
+        if (widthBlocks < minBlocks)
         {
-            widthBlocks = 2;
+            widthBlocks = minBlocks;
         }
-        if (heightBlocks < 2)
+        if (heightBlocks < minBlocks)
         {
-            heightBlocks = 2;
+            heightBlocks = minBlocks;
         }
         
         dataSize = widthBlocks * heightBlocks * ((blockSize  * bpp) / 8);
@@ -2124,19 +2216,21 @@ bool Image::initWithWebpData(const unsigned char * data, ssize_t dataLen)
         if (WebPGetFeatures(static_cast<const uint8_t*>(data), dataLen, &config.input) != VP8_STATUS_OK) break;
         if (config.input.width == 0 || config.input.height == 0) break;
         
-        config.output.colorspace = config.input.has_alpha?MODE_rgbA:MODE_RGB;
-        _renderFormat = config.input.has_alpha?Texture2D::PixelFormat::RGBA8888:Texture2D::PixelFormat::RGB888;
+        // opaque images decode straight to RGBA8888 when that is the decode format, so Texture2D needs no conversion
+        bool fourChannels = config.input.has_alpha || _decodePixelFormat == Texture2D::PixelFormat::RGBA8888;
+        config.output.colorspace = config.input.has_alpha?MODE_rgbA:(fourChannels?MODE_RGBA:MODE_RGB);
+        _renderFormat = fourChannels?Texture2D::PixelFormat::RGBA8888:Texture2D::PixelFormat::RGB888;
         _width    = config.input.width;
         _height   = config.input.height;
         
         //we ask webp to give data with premultiplied alpha
         _hasPremultipliedAlpha = (config.input.has_alpha != 0);
         
-        _dataLen = _width * _height * (config.input.has_alpha?4:3);
+        _dataLen = _width * _height * (fourChannels?4:3);
         _data = static_cast<unsigned char*>(malloc(_dataLen * sizeof(unsigned char)));
         
         config.output.u.RGBA.rgba = static_cast<uint8_t*>(_data);
-        config.output.u.RGBA.stride = _width * (config.input.has_alpha?4:3);
+        config.output.u.RGBA.stride = _width * (fourChannels?4:3);
         config.output.u.RGBA.size = _dataLen;
         config.output.is_external_memory = 1;
         
@@ -2445,6 +2539,37 @@ bool Image::saveImageToJPG(const std::string& filePath)
 #endif // CC_USE_JPEG
 }
 
+void Image::premultiplyRGBA8888Row(unsigned char* row, int width)
+{
+    // channel by channel with no branches, so the compiler can vectorize it
+    for (int i = 0; i < width * 4; i += 4)
+    {
+        unsigned int alpha = row[i + 3] + 1;
+        row[i]     = static_cast<unsigned char>((row[i] * alpha) >> 8);
+        row[i + 1] = static_cast<unsigned char>((row[i + 1] * alpha) >> 8);
+        row[i + 2] = static_cast<unsigned char>((row[i + 2] * alpha) >> 8);
+    }
+}
+
+void Image::packRGBA8888Row(const unsigned char* row, ssize_t rowBytes, Texture2D::PixelFormat format, unsigned char* outRow)
+{
+    switch (format)
+    {
+    case Texture2D::PixelFormat::RGBA4444:
+        Texture2D::convertRGBA8888ToRGBA4444(row, rowBytes, outRow);
+        break;
+    case Texture2D::PixelFormat::RGB5A1:
+        Texture2D::convertRGBA8888ToRGB5A1(row, rowBytes, outRow);
+        break;
+    case Texture2D::PixelFormat::RGB565:
+        Texture2D::convertRGBA8888ToRGB565(row, rowBytes, outRow);
+        break;
+    default:
+        CCASSERT(false, "Image: unsupported pack format");
+        break;
+    }
+}
+
 void Image::premultipliedAlpha()
 {
 #if CC_ENABLE_PREMULTIPLIED_ALPHA == 0
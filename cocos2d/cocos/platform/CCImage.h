@@ -116,6 +116,18 @@ public:
      */
     static void setPVRImagesHavePremultipliedAlpha(bool haveAlphaPremultiplied);
 
+    /**
+    @brief Sets the pixel format the next PNG or WebP file is decoded into.
+    PNG rows are premultiplied and converted one at a time while decoding, straight into the image data,
+    so Texture2D::initWithImage() with the same format uploads the data without another conversion pass.
+    PNG is decoded directly into RGBA8888, RGBA4444, RGB5A1 and RGB565; opaque WebP into RGBA8888.
+    Other formats, and NONE (the default), keep the file's own pixel format.
+    Interlaced PNGs are decoded to RGBA8888 and converted by Texture2D.
+    @param format Usually the format the texture will be created with.
+    @since v3.17
+    */
+    void setDecodePixelFormat(Texture2D::PixelFormat format) { _decodePixelFormat = format; }
+
     /**
     @brief Load the image from the specified path.
     @param path   the absolute file path.
@@ -183,6 +195,11 @@ protected:
     bool saveImageToJPG(const std::string& filePath);
     
     void premultipliedAlpha();
+
+    /** Premultiplies one row of RGBA8888 pixels in place, with the same rounding as premultipliedAlpha(). */
+    static void premultiplyRGBA8888Row(unsigned char* row, int width);
+    /** Packs one row of RGBA8888 pixels into RGBA4444, RGB5A1 or RGB565, like Texture2D's conversions. */
+    static void packRGBA8888Row(const unsigned char* row, ssize_t rowBytes, Texture2D::PixelFormat format, unsigned char* outRow);
     
 protected:
     /**
@@ -205,6 +222,7 @@ protected:
     int _numberOfMipmaps;
     // false if we can't auto detect the image is premultiplied or not.
     bool _hasPremultipliedAlpha;
+    Texture2D::PixelFormat _decodePixelFormat;
     std::string _filePath;
 
 
@@ -0,0 +1,259 @@
+/****************************************************************************
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/CCResourceArchive.h"
+
+#include <cstring>
+#include <zlib.h>
+
+#include "base/CCData.h"
+#include "base/ccMacros.h"
+#include "platform/CCFileUtils.h"
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include <windows.h>
+#include "platform/win32/CCUtils-win32.h"
+#define CC_RESOURCE_ARCHIVE_MAP_WIN32 1
+#elif (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CC_RESOURCE_ARCHIVE_MAP_POSIX 1
+#endif
+
+NS_CC_BEGIN
+
+namespace
+{
+    const char ARCHIVE_MAGIC[4] = { 'C', 'C', 'P', 'K' };
+    const uint32_t ARCHIVE_VERSION = 1;
+    const size_t HEADER_SIZE = 16;
+    const size_t ENTRY_SIZE = 32;
+
+    // The archive is little endian, as are all supported targets
+    template <typename T>
+    T readValue(const unsigned char* bytes)
+    {
+        T value;
+        memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+}
+
+/** The archive file in memory. Data views of entries keep it alive. */
+struct ResourceArchive::Mapping
+{
+    const unsigned char* bytes = nullptr;
+    size_t size = 0;
+
+    // Fallback when the file can not be mapped, e.g. an archive inside an APK
+    Data contents;
+
+#if CC_RESOURCE_ARCHIVE_MAP_WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#elif CC_RESOURCE_ARCHIVE_MAP_POSIX
+    void* address = MAP_FAILED;
+#endif
+
+    bool map(const std::string& fullPath);
+
+    ~Mapping()
+    {
+#if CC_RESOURCE_ARCHIVE_MAP_WIN32
+        if (bytes && contents.isNull())
+            UnmapViewOfFile(bytes);
+        if (mapping)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+#elif CC_RESOURCE_ARCHIVE_MAP_POSIX
+        if (address != MAP_FAILED)
+            munmap(address, size);
+#endif
+    }
+};
+
+bool ResourceArchive::Mapping::map(const std::string& fullPath)
+{
+#if CC_RESOURCE_ARCHIVE_MAP_WIN32
+    file = CreateFileW(StringUtf8ToWideChar(fullPath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        {
+            mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping)
+            {
+                bytes = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                size = static_cast<size_t>(fileSize.QuadPart);
+                if (bytes)
+                    return true;
+            }
+        }
+    }
+#elif CC_RESOURCE_ARCHIVE_MAP_POSIX
+    // Paths that are not on the file system (Android "assets/") are read below
+    if (!fullPath.empty() && fullPath[0] == '/')
+    {
+        int fd = ::open(fullPath.c_str(), O_RDONLY);
+        if (fd != -1)
+        {
+            struct stat statBuf;
+            if (fstat(fd, &statBuf) == 0 && statBuf.st_size > 0)
+            {
+                size = static_cast<size_t>(statBuf.st_size);
+                address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            // the mapping stays valid after the descriptor is closed
+            ::close(fd);
+            if (address != MAP_FAILED)
+            {
+                bytes = static_cast<const unsigned char*>(address);
+                return true;
+            }
+        }
+    }
+#endif
+
+    contents = FileUtils::getInstance()->getDataFromFile(fullPath);
+    bytes = contents.getBytes();
+    size = static_cast<size_t>(contents.getSize());
+    return !contents.isNull();
+}
+
+ResourceArchive::ResourceArchive()
+{
+}
+
+ResourceArchive::~ResourceArchive()
+{
+}
+
+std::shared_ptr<ResourceArchive> ResourceArchive::open(const std::string& fullPath)
+{
+    std::shared_ptr<Mapping> mapping = std::make_shared<Mapping>();
+    if (!mapping->map(fullPath))
+    {
+        CCLOG("cocos2d: ResourceArchive: can not open %s", fullPath.c_str());
+        return nullptr;
+    }
+
+    std::shared_ptr<ResourceArchive> archive(new (std::nothrow) ResourceArchive());
+    if (!archive)
+        return nullptr;
+
+    archive->_path = fullPath;
+    archive->_mapping = mapping;
+    if (!archive->parseIndex())
+    {
+        CCLOG("cocos2d: ResourceArchive: %s is not a valid archive", fullPath.c_str());
+        return nullptr;
+    }
+    return archive;
+}
+
+bool ResourceArchive::parseIndex()
+{
+    const unsigned char* bytes = _mapping->bytes;
+    const size_t size = _mapping->size;
+    if (size < HEADER_SIZE || memcmp(bytes, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0)
+        return false;
+    if (readValue<uint32_t>(bytes + 4) != ARCHIVE_VERSION)
+        return false;
+
+    const uint64_t entryCount = readValue<uint32_t>(bytes + 8);
+    const uint64_t nameTableSize = readValue<uint32_t>(bytes + 12);
+    const uint64_t nameTableOffset = HEADER_SIZE + entryCount * ENTRY_SIZE;
+    if (nameTableOffset + nameTableSize > size)
+        return false;
+
+    _entries.reserve(static_cast<size_t>(entryCount));
+    for (uint64_t i = 0; i < entryCount; ++i)
+    {
+        const unsigned char* record = bytes + HEADER_SIZE + i * ENTRY_SIZE;
+        Entry entry;
+        entry.offset = readValue<uint64_t>(record);
+        entry.size = readValue<uint64_t>(record + 8);
+        entry.storedSize = readValue<uint64_t>(record + 16);
+        uint32_t nameOffset = readValue<uint32_t>(record + 24);
+        uint16_t nameLength = readValue<uint16_t>(record + 28);
+        entry.compression = static_cast<Compression>(record[30]);
+
+        if (entry.offset > size || entry.storedSize > size - entry.offset ||
+            static_cast<uint64_t>(nameOffset) + nameLength > nameTableSize)
+            return false;
+        if (entry.compression == Compression::NONE && entry.size != entry.storedSize)
+            return false;
+        if (entry.compression != Compression::NONE && entry.compression != Compression::ZLIB)
+            return false;
+
+        const char* name = reinterpret_cast<const char*>(bytes + nameTableOffset + nameOffset);
+        _entries.emplace(std::string(name, nameLength), entry);
+    }
+    return true;
+}
+
+bool ResourceArchive::read(const std::string& name, ResizableBuffer* buffer) const
+{
+    auto it = _entries.find(name);
+    if (it == _entries.end())
+        return false;
+
+    const Entry& entry = it->second;
+    const unsigned char* bytes = _mapping->bytes + entry.offset;
+    const size_t size = static_cast<size_t>(entry.size);
+
+    if (entry.compression == Compression::NONE)
+    {
+        if (!buffer->assignView(bytes, size, _mapping))
+        {
+            buffer->resize(size);
+            if (size > 0)
+                memcpy(buffer->buffer(), bytes, size);
+        }
+        return true;
+    }
+
+    buffer->resize(size);
+    uLongf inflatedSize = static_cast<uLongf>(size);
+    if (uncompress(static_cast<Bytef*>(buffer->buffer()), &inflatedSize, bytes, static_cast<uLong>(entry.storedSize)) != Z_OK
+        || inflatedSize != size)
+    {
+        CCLOG("cocos2d: ResourceArchive: failed to inflate %s from %s", name.c_str(), _path.c_str());
+        buffer->resize(0);
+        return false;
+    }
+    return true;
+}
+
+long ResourceArchive::getSize(const std::string& name) const
+{
+    auto it = _entries.find(name);
+    return it == _entries.end() ? -1 : static_cast<long>(it->second.size);
+}
+
+NS_CC_END
@@ -0,0 +1,119 @@
+/****************************************************************************
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CC_RESOURCE_ARCHIVE_H__
+#define __CC_RESOURCE_ARCHIVE_H__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "platform/CCPlatformMacros.h"
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+NS_CC_BEGIN
+
+class ResizableBuffer;
+
+/**
+ * @class ResourceArchive
+ * @brief A packed, read-only resource archive that is memory-mapped instead of read.
+ *
+ * The archive starts with a header and an index of entries, followed by the entry names and
+ * the entry data, each entry aligned to 16 bytes:
+ *
+ *     header  "CCPK", uint32 version, uint32 entry count, uint32 name table size
+ *     entry   uint64 offset, uint64 size, uint64 stored size, uint32 name offset,
+ *             uint16 name length, uint8 compression, uint8 reserved
+ *
+ * All integers are little endian. Opening an archive maps the file and reads the index only, so
+ * entry data is not paged in until it is read. Stored entries are handed to a Data buffer as a view
+ * of the mapping, without a copy; compressed entries are inflated into the buffer.
+ *
+ * A ResourceArchive is immutable after open() and may be read from any thread.
+ * @since v3.17
+ */
+class CC_DLL ResourceArchive
+{
+public:
+    enum class Compression : uint8_t
+    {
+        NONE = 0,
+        ZLIB = 1,
+    };
+
+    /**
+     * Maps an archive.
+     * @param fullPath Full path of the archive file.
+     * @return The archive, or nullptr if the file is missing or is not a valid archive.
+     */
+    static std::shared_ptr<ResourceArchive> open(const std::string& fullPath);
+
+    ~ResourceArchive();
+
+    /** Whether the archive holds an entry, by its path relative to the resource root. */
+    bool contains(const std::string& name) const { return _entries.find(name) != _entries.end(); }
+
+    /**
+     * Reads an entry into a buffer. Buffers that accept views (Data) get one for stored entries.
+     * @return False if there is no such entry or it could not be decompressed.
+     */
+    bool read(const std::string& name, ResizableBuffer* buffer) const;
+
+    /** Uncompressed size of an entry, or -1 if there is no such entry. */
+    long getSize(const std::string& name) const;
+
+    const std::string& getPath() const { return _path; }
+    size_t getEntryCount() const { return _entries.size(); }
+
+private:
+    struct Mapping;
+
+    struct Entry
+    {
+        uint64_t offset;
+        uint64_t size;
+        uint64_t storedSize;
+        Compression compression;
+    };
+
+    ResourceArchive();
+    bool parseIndex();
+
+    std::string _path;
+    std::shared_ptr<const Mapping> _mapping;
+    std::unordered_map<std::string, Entry> _entries;
+};
+
+NS_CC_END
+
+// end of platform group
+/** @} */
+
+#endif // __CC_RESOURCE_ARCHIVE_H__
@@ -288,6 +288,9 @@ FileUtils::Status FileUtilsAndroid::getContents(const std::string& filename, Res
     if (filename.empty())
         return FileUtils::Status::NotExists;
 
+    if (getContentsFromResourceArchive(filename, buffer))
+        return FileUtils::Status::OK;
+
     string fullPath = fullPathForFilename(filename);
 
     if (fullPath[0] == '/')
@@ -170,6 +170,9 @@ FileUtils::Status FileUtilsWin32::getContents(const std::string& filename, Resiz
     if (filename.empty())
         return FileUtils::Status::NotExists;
 
+    if (getContentsFromResourceArchive(filename, buffer))
+        return FileUtils::Status::OK;
+
     // read the file from hardware
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
 
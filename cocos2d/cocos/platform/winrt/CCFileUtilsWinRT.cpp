@@ -149,6 +149,9 @@ FileUtils::Status CCFileUtilsWinRT::getContents(const std::string& filename, Res
     if (filename.empty())
         return FileUtils::Status::NotExists;
 
+    if (getContentsFromResourceArchive(filename, buffer))
+        return FileUtils::Status::OK;
+
     // read the file from hardware
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
 
@@ -216,6 +216,11 @@ public:
     static const char* SHADER_NAME_LABEL_OUTLINE;
     static const char* SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL;
     static const char* SHADER_NAME_LABEL_DISTANCEFIELD_GLOW;
+    /** Distance field label with outline, drawn in one pass. @since v3.17 */
+    static const char* SHADER_NAME_LABEL_DISTANCEFIELD_OUTLINE;
+    /** Label shaders for vertices already transformed by the renderer, used by batched labels. @since v3.17 */
+    static const char* SHADER_NAME_LABEL_NORMAL_NO_MVP;
+    static const char* SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL_NO_MVP;
 
     /**Built in shader used for 3D, support Position vertex attribute, with color specified by a uniform.*/
     static const char* SHADER_3D_POSITION;
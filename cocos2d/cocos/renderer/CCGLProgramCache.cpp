@@ -53,6 +53,7 @@ enum {
     kShaderType_PositionLengthTextureColor,
     kShaderType_LabelDistanceFieldNormal,
     kShaderType_LabelDistanceFieldGlow,
+    kShaderType_LabelDistanceFieldOutline,
     kShaderType_UIGrayScale,
     kShaderType_LabelNormal,
     kShaderType_LabelOutline,
@@ -76,6 +77,8 @@ enum {
     kShaderType_ETC1ASPositionTextureGray,
     kShaderType_ETC1ASPositionTextureGray_noMVP,
     kShaderType_LayerRadialGradient,
+    kShaderType_LabelNormal_noMVP,
+    kShaderType_LabelDistanceFieldNormal_noMVP,
     kShaderType_MAX,
 };
 
@@ -221,6 +224,10 @@ void GLProgramCache::loadDefaultGLPrograms()
     loadDefaultGLProgram(p, kShaderType_LabelDistanceFieldGlow);
     _programs.emplace(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_GLOW, p);
 
+    p = new (std::nothrow) GLProgram();
+    loadDefaultGLProgram(p, kShaderType_LabelDistanceFieldOutline);
+    _programs.emplace(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_OUTLINE, p);
+
     p = new (std::nothrow) GLProgram();
     loadDefaultGLProgram(p, kShaderType_UIGrayScale);
     _programs.emplace(GLProgram::SHADER_NAME_POSITION_GRAYSCALE, p);
@@ -233,6 +240,14 @@ void GLProgramCache::loadDefaultGLPrograms()
     loadDefaultGLProgram(p, kShaderType_LabelOutline);
     _programs.emplace(GLProgram::SHADER_NAME_LABEL_OUTLINE, p);
 
+    p = new (std::nothrow) GLProgram();
+    loadDefaultGLProgram(p, kShaderType_LabelNormal_noMVP);
+    _programs.emplace(GLProgram::SHADER_NAME_LABEL_NORMAL_NO_MVP, p);
+
+    p = new (std::nothrow) GLProgram();
+    loadDefaultGLProgram(p, kShaderType_LabelDistanceFieldNormal_noMVP);
+    _programs.emplace(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL_NO_MVP, p);
+
     p = new (std::nothrow) GLProgram();
     loadDefaultGLProgram(p, kShaderType_3DPosition);
     _programs.emplace(GLProgram::SHADER_3D_POSITION, p);
@@ -392,6 +407,10 @@ void GLProgramCache::reloadDefaultGLPrograms()
     p->reset();
     loadDefaultGLProgram(p, kShaderType_LabelDistanceFieldGlow);
 
+    p = getGLProgram(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_OUTLINE);
+    p->reset();
+    loadDefaultGLProgram(p, kShaderType_LabelDistanceFieldOutline);
+
     p = getGLProgram(GLProgram::SHADER_NAME_POSITION_GRAYSCALE);
     p->reset();
     loadDefaultGLProgram(p, kShaderType_UIGrayScale);
@@ -404,6 +423,14 @@ void GLProgramCache::reloadDefaultGLPrograms()
     p->reset();
     loadDefaultGLProgram(p, kShaderType_LabelOutline);
 
+    p = getGLProgram(GLProgram::SHADER_NAME_LABEL_NORMAL_NO_MVP);
+    p->reset();
+    loadDefaultGLProgram(p, kShaderType_LabelNormal_noMVP);
+
+    p = getGLProgram(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL_NO_MVP);
+    p->reset();
+    loadDefaultGLProgram(p, kShaderType_LabelDistanceFieldNormal_noMVP);
+
     p = getGLProgram(GLProgram::SHADER_3D_POSITION);
     p->reset();
     loadDefaultGLProgram(p, kShaderType_3DPosition);
@@ -548,6 +575,9 @@ void GLProgramCache::loadDefaultGLProgram(GLProgram *p, int type)
         case kShaderType_LabelDistanceFieldGlow:
             p->initWithByteArrays(ccLabel_vert, ccLabelDistanceFieldGlow_frag);
             break;
+        case kShaderType_LabelDistanceFieldOutline:
+            p->initWithByteArrays(ccLabel_vert, ccLabelDistanceFieldOutline_frag);
+            break;
         case kShaderType_UIGrayScale:
             p->initWithByteArrays(ccPositionTextureColor_noMVP_vert,
                                   ccPositionTexture_GrayScale_frag);
@@ -558,6 +588,12 @@ void GLProgramCache::loadDefaultGLProgram(GLProgram *p, int type)
         case kShaderType_LabelOutline:
             p->initWithByteArrays(ccLabel_vert, ccLabelOutline_frag);
             break;
+        case kShaderType_LabelNormal_noMVP:
+            p->initWithByteArrays(ccLabel_noMVP_vert, ccLabelNormal_frag);
+            break;
+        case kShaderType_LabelDistanceFieldNormal_noMVP:
+            p->initWithByteArrays(ccLabel_noMVP_vert, ccLabelDistanceFieldNormal_frag);
+            break;
         case kShaderType_3DPosition:
             p->initWithByteArrays(cc3D_PositionTex_vert, cc3D_Color_frag);
             break;
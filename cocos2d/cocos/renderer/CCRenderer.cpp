@@ -48,9 +48,28 @@
 #include "2d/CCCamera.h"
 #include "2d/CCScene.h"
 
+// glMapBufferRange() is only resolved through GLEW on Linux and Windows
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX || CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) && defined(GL_MAP_UNSYNCHRONIZED_BIT)
+#define CC_RENDERER_STREAMING_VBO 1
+#else
+#define CC_RENDERER_STREAMING_VBO 0
+#endif
+
 NS_CC_BEGIN
 
 // helper
+static void setTrianglesVertexAttribPointers(size_t byteOffset)
+{
+    // vertices
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) (byteOffset + offsetof(V3F_C4B_T2F, vertices)));
+
+    // colors
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) (byteOffset + offsetof(V3F_C4B_T2F, colors)));
+
+    // tex coords
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) (byteOffset + offsetof(V3F_C4B_T2F, texCoords)));
+}
+
 static bool compareRenderCommand(RenderCommand* a, RenderCommand* b)
 {
     return a->getGlobalOrder() < b->getGlobalOrder();
@@ -63,8 +82,9 @@ static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
 
 // queue
 RenderQueue::RenderQueue()
+: _zOrderBucketing(false)
 {
-    
+    resetGlobalZRanges();
 }
 
 void RenderQueue::push_back(RenderCommand* command)
@@ -73,10 +93,14 @@ void RenderQueue::push_back(RenderCommand* command)
     if(z < 0)
     {
         _commands[QUEUE_GROUP::GLOBALZ_NEG].push_back(command);
+        if (_zOrderBucketing)
+            trackGlobalZ(_zRanges[0], z);
     }
     else if(z > 0)
     {
         _commands[QUEUE_GROUP::GLOBALZ_POS].push_back(command);
+        if (_zOrderBucketing)
+            trackGlobalZ(_zRanges[1], z);
     }
     else
     {
@@ -113,8 +137,74 @@ void RenderQueue::sort()
 {
     // Don't sort _queue0, it already comes sorted
     std::stable_sort(std::begin(_commands[QUEUE_GROUP::TRANSPARENT_3D]), std::end(_commands[QUEUE_GROUP::TRANSPARENT_3D]), compare3DCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]), compareRenderCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]), compareRenderCommand);
+    if (_zOrderBucketing)
+    {
+        sortGlobalZ(QUEUE_GROUP::GLOBALZ_NEG, _zRanges[0]);
+        sortGlobalZ(QUEUE_GROUP::GLOBALZ_POS, _zRanges[1]);
+        resetGlobalZRanges();
+    }
+    else
+    {
+        std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]), compareRenderCommand);
+        std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]), compareRenderCommand);
+    }
+}
+
+void RenderQueue::trackGlobalZ(ZBucketRange& range, float z)
+{
+    // Values that do not fit exactly in an int can't be bucketed
+    if (!range.integral || fabsf(z) >= 16777216.0f || static_cast<float>(static_cast<int>(z)) != z)
+    {
+        range.integral = false;
+        return;
+    }
+
+    int iz = static_cast<int>(z);
+    range.minZ = std::min(range.minZ, iz);
+    range.maxZ = std::max(range.maxZ, iz);
+}
+
+void RenderQueue::resetGlobalZRanges()
+{
+    for (auto& range : _zRanges)
+    {
+        range.minZ = INT_MAX;
+        range.maxZ = INT_MIN;
+        range.integral = true;
+    }
+}
+
+void RenderQueue::sortGlobalZ(QUEUE_GROUP group, const ZBucketRange& range)
+{
+    auto& commands = _commands[group];
+    // A single integer Z is already in order; non-integer Z values are not tracked in minZ/maxZ
+    if (commands.size() < 2 || (range.integral && range.minZ == range.maxZ))
+        return;
+
+    if (!range.integral || range.maxZ - range.minZ >= ZBUCKET_RANGE)
+    {
+        std::stable_sort(std::begin(commands), std::end(commands), compareRenderCommand);
+        return;
+    }
+
+    // counting sort: count per z, prefix sum into offsets, then scatter in push order
+    const int bucketCount = range.maxZ - range.minZ + 1;
+    _zBucketOffsets.assign(bucketCount + 1, 0);
+    for (const auto& command : commands)
+    {
+        ++_zBucketOffsets[static_cast<int>(command->getGlobalOrder()) - range.minZ + 1];
+    }
+    for (int i = 1; i < bucketCount; ++i)
+    {
+        _zBucketOffsets[i] += _zBucketOffsets[i - 1];
+    }
+
+    _zBucketScratch.resize(commands.size());
+    for (const auto& command : commands)
+    {
+        _zBucketScratch[_zBucketOffsets[static_cast<int>(command->getGlobalOrder()) - range.minZ]++] = command;
+    }
+    commands.swap(_zBucketScratch);
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
@@ -139,6 +229,7 @@ void RenderQueue::clear()
     {
         _commands[i].clear();
     }
+    resetGlobalZRanges();
 }
 
 void RenderQueue::realloc(size_t reserveSize)
@@ -148,6 +239,19 @@ void RenderQueue::realloc(size_t reserveSize)
         _commands[i] = std::vector<RenderCommand*>();
         _commands[i].reserve(reserveSize);
     }
+    resetGlobalZRanges();
+}
+
+void RenderQueue::setZOrderBucketing(bool enabled)
+{
+    if (enabled && !_zOrderBucketing)
+    {
+        // commands pushed before enabling were not tracked, fall back to stable_sort once
+        resetGlobalZRanges();
+        _zRanges[0].integral = _commands[QUEUE_GROUP::GLOBALZ_NEG].empty();
+        _zRanges[1].integral = _commands[QUEUE_GROUP::GLOBALZ_POS].empty();
+    }
+    _zOrderBucketing = enabled;
 }
 
 void RenderQueue::saveRenderState()
@@ -204,6 +308,11 @@ Renderer::Renderer()
 ,_glViewAssigned(false)
 ,_isRendering(false)
 ,_isDepthTestFor2D(false)
+,_isZOrderBucketing(false)
+,_useStreamingVBO(false)
+,_streamingVBOAllocated(false)
+,_streamVertexOffset(0)
+,_streamIndexOffset(0)
 ,_triBatchesToDraw(nullptr)
 ,_triBatchesToDrawCapacity(-1)
 #if CC_ENABLE_CACHE_TEXTURE_DATA
@@ -263,9 +372,17 @@ void Renderer::initGLView()
 
 void Renderer::setupBuffer()
 {
+    _useStreamingVBO = false;
+    _streamingVBOAllocated = false;
+    _streamVertexOffset = 0;
+    _streamIndexOffset = 0;
+
     if(Configuration::getInstance()->supportsShareableVAO())
     {
         setupVBOAndVAO();
+#if CC_RENDERER_STREAMING_VBO
+        _useStreamingVBO = Configuration::getInstance()->supportsMapBufferRange();
+#endif
     }
     else
     {
@@ -376,6 +493,7 @@ void Renderer::popGroup()
 int Renderer::createRenderQueue()
 {
     RenderQueue newRenderQueue;
+    newRenderQueue.setZOrderBucketing(_isZOrderBucketing);
     _renderGroups.push_back(newRenderQueue);
     return (int)_renderGroups.size() - 1;
 }
@@ -706,22 +824,25 @@ void Renderer::setDepthTest(bool enable)
     CHECK_GL_ERROR_DEBUG();
 }
 
-void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd)
+void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, V3F_C4B_T2F* verts, GLushort* indices)
 {
-    memcpy(&_verts[_filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * cmd->getVertexCount());
-
-    // fill vertex, and convert them to world coordinates
+    // fill vertex, and convert them to world coordinates.
+    // verts may be a write-only mapping, so each vertex is transformed from the command
+    // and written once, never read back
     const Mat4& modelView = cmd->getModelView();
+    const V3F_C4B_T2F* cmdVertices = cmd->getVertices();
     for(ssize_t i=0; i < cmd->getVertexCount(); ++i)
     {
-        modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
+        V3F_C4B_T2F vertex = cmdVertices[i];
+        modelView.transformPoint(&vertex.vertices);
+        verts[i + _filledVertex] = vertex;
     }
 
     // fill index
-    const unsigned short* indices = cmd->getIndices();
+    const unsigned short* cmdIndices = cmd->getIndices();
     for(ssize_t i=0; i< cmd->getIndexCount(); ++i)
     {
-        _indices[_filledIndex + i] = _filledVertex + indices[i];
+        indices[_filledIndex + i] = _filledVertex + cmdIndices[i];
     }
 
     _filledVertex += cmd->getVertexCount();
@@ -735,9 +856,26 @@ void Renderer::drawBatchedTriangles()
 
     CCGL_DEBUG_INSERT_EVENT_MARKER("RENDERER_BATCH_TRIANGLES");
 
+    // processRenderCommand() accumulated the totals of the queued commands
+    const int vertexCount = _filledVertex;
+    const int indexCount = _filledIndex;
     _filledVertex = 0;
     _filledIndex = 0;
 
+    /************** 0: Pick the destination of the vertices/indices *************/
+
+    // When streaming, commands are transformed straight into the mapped GPU buffers,
+    // otherwise into the client side arrays that are uploaded below.
+    auto conf = Configuration::getInstance();
+    V3F_C4B_T2F* verts = _verts;
+    GLushort* indices = _indices;
+    bool streaming = false;
+    if (_useStreamingVBO)
+    {
+        GL::bindVAO(_buffersVAO);
+        streaming = mapStreamingBuffers(vertexCount, indexCount, &verts, &indices);
+    }
+
     /************** 1: Setup up vertices/indices *************/
 
     _triBatchesToDraw[0].offset = 0;
@@ -753,7 +891,7 @@ void Renderer::drawBatchedTriangles()
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd);
+        fillVerticesAndIndices(cmd, verts, indices);
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -790,8 +928,13 @@ void Renderer::drawBatchedTriangles()
     batchesTotal++;
 
     /************** 2: Copy vertices/indices to GL objects *************/
-    auto conf = Configuration::getInstance();
-    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+    GLsizei indexBase = 0;
+    if (streaming)
+    {
+        unmapStreamingBuffers();
+        indexBase = _streamIndexOffset;
+    }
+    else if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
     {
         //Bind VAO
         GL::bindVAO(_buffersVAO);
@@ -846,13 +989,19 @@ void Renderer::drawBatchedTriangles()
     {
         CC_ASSERT(_triBatchesToDraw[i].cmd && "Invalid batch");
         _triBatchesToDraw[i].cmd->useMaterial();
-        glDrawElements(GL_TRIANGLES, (GLsizei) _triBatchesToDraw[i].indicesToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (_triBatchesToDraw[i].offset*sizeof(_indices[0])) );
+        glDrawElements(GL_TRIANGLES, (GLsizei) _triBatchesToDraw[i].indicesToDraw, GL_UNSIGNED_SHORT, (GLvoid*) ((indexBase + _triBatchesToDraw[i].offset)*sizeof(_indices[0])) );
         _drawnBatches++;
         _drawnVertices += _triBatchesToDraw[i].indicesToDraw;
     }
 
     /************** 4: Cleanup *************/
-    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+    if (streaming)
+    {
+        _streamVertexOffset += vertexCount;
+        _streamIndexOffset += indexCount;
+        GL::bindVAO(0);
+    }
+    else if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
     {
         //Unbind VAO
         GL::bindVAO(0);
@@ -868,6 +1017,72 @@ void Renderer::drawBatchedTriangles()
     _filledIndex = 0;
 }
 
+bool Renderer::mapStreamingBuffers(int vertexCount, int indexCount, V3F_C4B_T2F** verts, GLushort** indices)
+{
+#if CC_RENDERER_STREAMING_VBO
+    // an empty flush has nothing to map, and mapping a zero length range fails
+    // without saying anything about the driver, so streaming stays enabled
+    if (vertexCount == 0 || indexCount == 0)
+    {
+        *verts = _verts;
+        *indices = _indices;
+        return false;
+    }
+
+    // expects the VAO to be bound, so binding the element buffer doesn't touch another VAO
+    glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+
+    if (!_streamingVBOAllocated || _streamVertexOffset + vertexCount > STREAM_VBO_SIZE || _streamIndexOffset + indexCount > STREAM_INDEX_VBO_SIZE)
+    {
+        // Wrap around: orphan both buffers, the driver hands out new storage
+        // while the GPU may still be reading the previous frames from the old one.
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * STREAM_VBO_SIZE, nullptr, GL_STREAM_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * STREAM_INDEX_VBO_SIZE, nullptr, GL_STREAM_DRAW);
+        _streamingVBOAllocated = true;
+        _streamVertexOffset = 0;
+        _streamIndexOffset = 0;
+    }
+
+    // The ranges past the offsets were never handed to the GPU since the last orphaning,
+    // so there is nothing to synchronize with.
+    const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+    *verts = (V3F_C4B_T2F*) glMapBufferRange(GL_ARRAY_BUFFER, sizeof(_verts[0]) * _streamVertexOffset, sizeof(_verts[0]) * vertexCount, access);
+    *indices = (GLushort*) glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _streamIndexOffset, sizeof(_indices[0]) * indexCount, access);
+    if (*verts && *indices)
+        return true;
+
+    if (*verts)
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    if (*indices)
+        glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+
+    CCLOG("cocos2d: Renderer: glMapBufferRange failed, disabling the streaming VBO");
+    // restore the attribute pointers the non streaming path expects in the VAO
+    setTrianglesVertexAttribPointers(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    _useStreamingVBO = false;
+#else
+    CC_UNUSED_PARAM(vertexCount);
+    CC_UNUSED_PARAM(indexCount);
+#endif
+    *verts = _verts;
+    *indices = _indices;
+    return false;
+}
+
+void Renderer::unmapStreamingBuffers()
+{
+#if CC_RENDERER_STREAMING_VBO
+    glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+
+    // indices are relative to the start of this flush, so point the attributes there
+    setTrianglesVertexAttribPointers(sizeof(_verts[0]) * _streamVertexOffset);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif
+}
+
 void Renderer::flush()
 {
     flush2D();
@@ -929,6 +1144,16 @@ bool Renderer::checkVisibility(const Mat4 &transform, const Size &size)
 }
 
 
+void Renderer::setZOrderBucketing(bool enable)
+{
+    CCASSERT(!_isRendering, "Cannot change z-order bucketing while rendering");
+    _isZOrderBucketing = enable;
+    for (auto& renderqueue : _renderGroups)
+    {
+        renderqueue.setZOrderBucketing(enable);
+    }
+}
+
 void Renderer::setClearColor(const Color4F &clearColor)
 {
     _clearColor = clearColor;
@@ -67,6 +67,11 @@ class MeshCommand;
  Since the commands that have `z == 0` are "pushed back" in
  the correct order, the only `RenderCommand` objects that need to be sorted,
  are the ones that have `z < 0` and `z > 0`.
+ When z-order bucketing is enabled, the integer range of the global Z values is
+ tracked at push time. If every command of a sub queue has an integer global Z
+ and the range is smaller than `ZBUCKET_RANGE`, the sub queue is ordered with a
+ stable counting sort instead of `std::stable_sort`, which gives the same order
+ in linear time.
 */
 class RenderQueue {
 public:
@@ -88,6 +93,9 @@ public:
         QUEUE_COUNT = 5,
     };
 
+    /**Largest global Z range (max - min) that is ordered by counting sort.*/
+    static const int ZBUCKET_RANGE = 4096;
+
 public:
     /**Constructor.*/
     RenderQueue();
@@ -107,6 +115,10 @@ public:
     std::vector<RenderCommand*>& getSubQueue(QUEUE_GROUP group) { return _commands[group]; }
     /**Get the number of render commands contained in a subqueue.*/
     ssize_t getSubQueueSize(QUEUE_GROUP group) const { return _commands[group].size(); }
+    /**Enable/Disable counting sort of integer global Z commands.*/
+    void setZOrderBucketing(bool enabled);
+    /**Whether integer global Z commands are ordered by counting sort.*/
+    bool isZOrderBucketing() const { return _zOrderBucketing; }
 
     /**Save the current DepthState, CullState, DepthWriteState render state.*/
     void saveRenderState();
@@ -114,8 +126,31 @@ public:
     void restoreRenderState();
     
 protected:
+    /**Global Z range of the commands pushed into GLOBALZ_NEG or GLOBALZ_POS since the last sort.*/
+    struct ZBucketRange
+    {
+        int minZ;
+        int maxZ;
+        bool integral;
+    };
+
+    /**Update the tracked global Z range of a sub queue.*/
+    void trackGlobalZ(ZBucketRange& range, float z);
+    /**Reset the tracked global Z range of both sorted sub queues.*/
+    void resetGlobalZRanges();
+    /**Sort a global Z sub queue, by counting sort when its range allows it.*/
+    void sortGlobalZ(QUEUE_GROUP group, const ZBucketRange& range);
+
     /**The commands in the render queue.*/
     std::vector<RenderCommand*> _commands[QUEUE_COUNT];
+
+    /**Whether integer global Z commands are ordered by counting sort.*/
+    bool _zOrderBucketing;
+    /**Tracked global Z range, 0: GLOBALZ_NEG  1: GLOBALZ_POS.*/
+    ZBucketRange _zRanges[2];
+    /**Bucket offsets and scratch storage reused by the counting sort.*/
+    std::vector<int> _zBucketOffsets;
+    std::vector<RenderCommand*> _zBucketScratch;
     
     /**Cull state.*/
     bool _isCullEnabled;
@@ -145,6 +180,10 @@ public:
     static const int VBO_SIZE = 65536;
     /**The max number of indices in a index buffer.*/
     static const int INDEX_VBO_SIZE = VBO_SIZE * 6 / 4;
+    /**The number of vertices in the streaming vertex ring buffer, used when glMapBufferRange is supported.*/
+    static const int STREAM_VBO_SIZE = VBO_SIZE * 2;
+    /**The number of indices in the streaming index ring buffer.*/
+    static const int STREAM_INDEX_VBO_SIZE = INDEX_VBO_SIZE * 2;
     /**The rendercommands which can be batched will be saved into a list, this is the reserved size of this list.*/
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
@@ -207,6 +246,15 @@ public:
     /** returns whether or not a rectangle is visible or not */
     bool checkVisibility(const Mat4& transform, const Size& size);
 
+    /**
+     * Enable/Disable z-order bucketing in every render queue.
+     * The global Z range of the commands is then tracked at `addCommand` time
+     * and the per-frame sort becomes a linear counting sort. Disabled by default.
+     */
+    void setZOrderBucketing(bool enable);
+    /** Whether z-order bucketing is enabled. */
+    bool isZOrderBucketing() const { return _isZOrderBucketing; }
+
 protected:
 
     //Setup VBO or VAO based on OpenGL extensions
@@ -216,6 +264,12 @@ protected:
     void mapBuffers();
     void drawBatchedTriangles();
 
+    // Map the next free range of the streaming ring buffers, orphaning them when they wrap.
+    // Returns false (and maps nothing) if the range is empty or could not be mapped;
+    // only a failed map disables streaming.
+    bool mapStreamingBuffers(int vertexCount, int indexCount, V3F_C4B_T2F** verts, GLushort** indices);
+    void unmapStreamingBuffers();
+
     //Draw the previews queued triangles and flush previous context
     void flush();
     
@@ -228,7 +282,7 @@ protected:
     void processRenderCommand(RenderCommand* command);
     void visitRenderQueue(RenderQueue& queue);
 
-    void fillVerticesAndIndices(const TrianglesCommand* cmd);
+    void fillVerticesAndIndices(const TrianglesCommand* cmd, V3F_C4B_T2F* verts, GLushort* indices);
 
 
     /* clear color set outside be used in setGLDefaultValues() */
@@ -247,6 +301,12 @@ protected:
     GLuint _buffersVAO;
     GLuint _buffersVBO[2]; //0: vertex  1: indices
 
+    // streaming ring buffers: vertices are written straight into the mapped VBO
+    bool _useStreamingVBO;
+    bool _streamingVBOAllocated;
+    int _streamVertexOffset;
+    int _streamIndexOffset;
+
     // Internal structure that has the information for the batches
     struct TriBatchToDraw {
         TrianglesCommand* cmd;  // needed for the Material
@@ -270,6 +330,8 @@ protected:
     bool _isRendering;
     
     bool _isDepthTestFor2D;
+
+    bool _isZOrderBucketing;
     
     GroupCommandManager* _groupCommandManager;
     
@@ -115,6 +115,10 @@ public:
         ATC_EXPLICIT_ALPHA,
         //! ATITC-compressed texture: ATC_INTERPOLATED_ALPHA
         ATC_INTERPOLATED_ALPHA,
+        //! ETC2-compressed texture: ETC2_RGB (opaque)
+        ETC2_RGB,
+        //! ETC2/EAC-compressed texture: ETC2_RGBA (has alpha channel)
+        ETC2_RGBA,
         //! Default texture format: AUTO
         DEFAULT = AUTO,
         
@@ -549,6 +553,7 @@ protected:
     friend class SpriteFrameCache;
     friend class TextureCache;
     friend class ui::Scale9Sprite;
+    friend class Image;
 
     bool _valid;
     std::string _filePath;
@@ -32,6 +32,9 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 
 #include "renderer/CCTexture2D.h"
 #include "base/ccMacros.h"
@@ -68,9 +71,11 @@ TextureCache * TextureCache::getInstance()
 }
 
 TextureCache::TextureCache()
-: _loadingThread(nullptr)
+: _asyncWorkerCount(std::max(std::thread::hardware_concurrency(), 2u) - 1)
+, _asyncUploadBudget(0.0f)
 , _needQuit(false)
 , _asyncRefCount(0)
+, _textureAliasGeneration(0)
 {
 }
 
@@ -81,7 +86,8 @@ TextureCache::~TextureCache()
     for (auto& texture : _textures)
         texture.second->release();
 
-    CC_SAFE_DELETE(_loadingThread);
+    for (auto& thread : _loadingThreads)
+        CC_SAFE_DELETE(thread);
 }
 
 void TextureCache::destroyInstance()
@@ -107,37 +113,42 @@ struct TextureCache::AsyncStruct
 public:
     AsyncStruct
     ( const std::string& fn,const std::function<void(Texture2D*)>& f,
-      const std::string& key )
-      : filename(fn), callback(f),callbackKey( key ),
+      const std::string& key, LoadPriority p, const std::string& decodeFn )
+      : filename(fn), decodeFilename(decodeFn), callback(f),callbackKey( key ),
         pixelFormat(Texture2D::getDefaultAlphaPixelFormat()),
-        loadSuccess(false)
+        priority(p), loadSuccess(false), cancelled(false)
     {}
 
     std::string filename;
+    std::string decodeFilename;
     std::function<void(Texture2D*)> callback;
     std::string callbackKey;
     Image image;
     Image imageAlpha;
     Texture2D::PixelFormat pixelFormat;
+    LoadPriority priority;
     bool loadSuccess;
+    std::atomic<bool> cancelled;
 };
 
 /**
  The addImageAsync logic follow the steps:
- - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL thread)
+ - find the image has been add or not, if not add an AsyncStruct to _requestQueues  (GL thread)
+ - any worker pops the highest priority AsyncStruct from _requestQueues, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueues (Load threads)
+ - on schedule callback, get AsyncStruct from _responseQueues in priority order, convert image to texture, then delete AsyncStruct (GL thread)
+   Conversion stops once the per-frame upload budget is spent; the rest waits for the next frame.
 
  the Critical Area include these members:
- - _requestQueue: locked by _requestMutex
- - _responseQueue: locked by _responseMutex
+ - _requestQueues: locked by _requestMutex
+ - _responseQueues: locked by _responseMutex
 
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
  - image data: new in Load thread, delete in GL thread(by Image instance)
 
  Note:
- - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
+ - all AsyncStruct referenced in _asyncStructQueue, for unbind and cancel function use.
+ - with several workers responses arrive out of order, so _asyncStructQueue is not a FIFO of responses.
 
  How to deal add image many times?
  - At first, this situation is abnormal, we only ensure the logic is correct.
@@ -145,12 +156,8 @@ public:
  - If the image request is in queue already, there will be more than one request in queue,
  - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
 
- Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
-
  Call unbindImageAsync(path) to prevent the call to the callback when the
- texture is loaded.
+ texture is loaded, or cancelImageAsync(path) to also skip the load.
  */
 void TextureCache::addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback)
 {
@@ -158,38 +165,17 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
 }
 
 /**
- The addImageAsync logic follow the steps:
- - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL thread)
- 
- the Critical Area include these members:
- - _requestQueue: locked by _requestMutex
- - _responseQueue: locked by _responseMutex
- 
- the object's life time:
- - AsyncStruct: construct and destruct in GL thread
- - image data: new in Load thread, delete in GL thread(by Image instance)
- 
- Note:
- - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
- 
- How to deal add image many times?
- - At first, this situation is abnormal, we only ensure the logic is correct.
- - If the image has been loaded, the after load image call will return immediately.
- - If the image request is in queue already, there will be more than one request in queue,
- - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
- 
- Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
-
  The callbackKey allows to unbind the callback in cases where the loading of
  path is requested by several sources simultaneously. Each source can then
  unbind the callback independently as needed whilst a call to
  unbindImageAsync(path) would be ambiguous.
  */
 void TextureCache::addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, const std::string& callbackKey)
+{
+    addImageAsync( path, callback, callbackKey, LoadPriority::VISIBLE );
+}
+
+void TextureCache::addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, const std::string& callbackKey, LoadPriority priority)
 {
     Texture2D *texture = nullptr;
 
@@ -212,11 +198,11 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
     }
 
     // lazy init
-    if (_loadingThread == nullptr)
+    _needQuit = false;
+    while (_loadingThreads.size() < _asyncWorkerCount)
     {
-        // create a new thread to load images
-        _needQuit = false;
-        _loadingThread = new (std::nothrow) std::thread(&TextureCache::loadImage, this);
+        // create new threads to load images
+        _loadingThreads.push_back(new (std::nothrow) std::thread(&TextureCache::loadImage, this));
     }
 
     if (0 == _asyncRefCount)
@@ -228,12 +214,12 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
 
     // generate async struct
     AsyncStruct *data =
-      new (std::nothrow) AsyncStruct(fullpath, callback, callbackKey);
+      new (std::nothrow) AsyncStruct(fullpath, callback, callbackKey, priority, getDecodePath(fullpath));
     
     // add async struct into queue
     _asyncStructQueue.push_back(data);
     std::unique_lock<std::mutex> ul(_requestMutex);
-    _requestQueue.push_back(data);
+    _requestQueues[static_cast<int>(priority)].push_back(data);
     _sleepCondition.notify_one();
 }
 
@@ -266,21 +252,95 @@ void TextureCache::unbindAllImageAsync()
     }
 }
 
+void TextureCache::cancelImageAsync(const std::string& callbackKey)
+{
+    cancelAsync([&callbackKey](const AsyncStruct* asyncStruct) { return asyncStruct->callbackKey == callbackKey; });
+}
+
+void TextureCache::cancelAllImageAsync()
+{
+    cancelAsync([](const AsyncStruct*) { return true; });
+}
+
+void TextureCache::cancelAsync(const std::function<bool(const AsyncStruct*)>& match)
+{
+    if (_asyncStructQueue.empty())
+    {
+        return;
+    }
+
+    // requests no worker has picked up yet are dropped right away
+    std::vector<AsyncStruct*> dropped;
+    {
+        std::lock_guard<std::mutex> lock(_requestMutex);
+        for (auto& queue : _requestQueues)
+        {
+            for (auto it = queue.begin(); it != queue.end(); /* nothing */)
+            {
+                if (match(*it))
+                {
+                    dropped.push_back(*it);
+                    it = queue.erase(it);
+                }
+                else
+                    ++it;
+            }
+        }
+    }
+
+    // the others are being decoded or wait for upload, they are discarded when they come back
+    for (auto& asyncStruct : _asyncStructQueue)
+    {
+        if (match(asyncStruct))
+        {
+            asyncStruct->callback = nullptr;
+            asyncStruct->cancelled = true;
+        }
+    }
+
+    for (auto& asyncStruct : dropped)
+    {
+        finishAsync(asyncStruct);
+    }
+}
+
+void TextureCache::finishAsync(AsyncStruct* asyncStruct)
+{
+    auto it = std::find(_asyncStructQueue.begin(), _asyncStructQueue.end(), asyncStruct);
+    CC_ASSERT(it != _asyncStructQueue.end());
+    _asyncStructQueue.erase(it);
+
+    // release the asyncStruct
+    delete asyncStruct;
+    --_asyncRefCount;
+
+    if (0 == _asyncRefCount)
+    {
+        Director::getInstance()->getScheduler()->unschedule(CC_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack), this);
+    }
+}
+
+void TextureCache::setAsyncWorkerCount(unsigned int count)
+{
+    _asyncWorkerCount = std::max(count, 1u);
+}
+
 void TextureCache::loadImage()
 {
     AsyncStruct *asyncStruct = nullptr;
     while (!_needQuit)
     {
         std::unique_lock<std::mutex> ul(_requestMutex);
-        // pop an AsyncStruct from request queue
-        if (_requestQueue.empty())
+        // pop the highest priority AsyncStruct from request queues
+        asyncStruct = nullptr;
+        for (auto& queue : _requestQueues)
         {
-            asyncStruct = nullptr;
-        }
-        else
-        {
-            asyncStruct = _requestQueue.front();
-            _requestQueue.pop_front();
+            if (!queue.empty())
+            {
+                asyncStruct = queue.front();
+                queue.pop_front();
+                break;
+            }
         }
 
         if (nullptr == asyncStruct) {
@@ -292,43 +352,47 @@ void TextureCache::loadImage()
         }
         ul.unlock();
 
-        // load image
-        asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
-
-        // ETC1 ALPHA supports.
-        if (asyncStruct->loadSuccess && asyncStruct->image.getFileType() == Image::Format::ETC && !s_etc1AlphaFileSuffix.empty())
-        { // check whether alpha texture exists & load it
-            auto alphaFile = asyncStruct->filename + s_etc1AlphaFileSuffix;
-            if (FileUtils::getInstance()->isFileExist(alphaFile))
-                asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
+        // load image, unless the request was cancelled meanwhile
+        if (!asyncStruct->cancelled)
+        {
+            // decode into the texture's format; nine-patch borders are parsed from RGBA8888 pixels
+            if (!NinePatchImageParser::isNinePatchImage(asyncStruct->filename))
+                asyncStruct->image.setDecodePixelFormat(asyncStruct->pixelFormat);
+            asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->decodeFilename);
+
+            // ETC1 ALPHA supports.
+            if (asyncStruct->loadSuccess && asyncStruct->image.getFileType() == Image::Format::ETC && !s_etc1AlphaFileSuffix.empty())
+            { // check whether alpha texture exists & load it
+                auto alphaFile = asyncStruct->filename + s_etc1AlphaFileSuffix;
+                if (FileUtils::getInstance()->isFileExist(alphaFile))
+                    asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
+            }
         }
         // push the asyncStruct to response queue
         _responseMutex.lock();
-        _responseQueue.push_back(asyncStruct);
+        _responseQueues[static_cast<int>(asyncStruct->priority)].push_back(asyncStruct);
         _responseMutex.unlock();
     }
 }
 
 void TextureCache::addImageAsyncCallBack(float /*dt*/)
 {
+    auto start = std::chrono::steady_clock::now();
     Texture2D *texture = nullptr;
     AsyncStruct *asyncStruct = nullptr;
     while (true)
     {
-        // pop an AsyncStruct from response queue
+        // pop the highest priority AsyncStruct from response queues
+        asyncStruct = nullptr;
         _responseMutex.lock();
-        if (_responseQueue.empty())
-        {
-            asyncStruct = nullptr;
-        }
-        else
+        for (auto& queue : _responseQueues)
         {
-            asyncStruct = _responseQueue.front();
-            _responseQueue.pop_front();
-
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            CC_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
+            if (!queue.empty())
+            {
+                asyncStruct = queue.front();
+                queue.pop_front();
+                break;
+            }
         }
         _responseMutex.unlock();
 
@@ -336,6 +400,14 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             break;
         }
 
+        if (asyncStruct->cancelled)
+        {
+            finishAsync(asyncStruct);
+            continue;
+        }
+
+        bool uploaded = false;
+
         // check the image has been convert to texture or not
         auto it = _textures.find(asyncStruct->filename);
         if (it != _textures.end())
@@ -371,6 +443,7 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
                     }
                     CC_SAFE_RELEASE(alphaTexture);
                 }
+                uploaded = true;
             }
             else {
                 texture = nullptr;
@@ -378,20 +451,25 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             }
         }
 
-        // call callback function
-        if (asyncStruct->callback)
+        // call callback function. It is moved out first: the callback may unbind or cancel
+        // async loads, which clears asyncStruct->callback and would destroy it while it runs
+        auto callback = std::move(asyncStruct->callback);
+        asyncStruct->callback = nullptr;
+        if (callback)
         {
-            (asyncStruct->callback)(texture);
+            callback(texture);
         }
 
-        // release the asyncStruct
-        delete asyncStruct;
-        --_asyncRefCount;
-    }
+        // release the asyncStruct, may unschedule this callback
+        finishAsync(asyncStruct);
 
-    if (0 == _asyncRefCount)
-    {
-        Director::getInstance()->getScheduler()->unschedule(CC_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack), this);
+        // leave the remaining uploads for the next frames once the budget is spent
+        if (uploaded && _asyncUploadBudget > 0)
+        {
+            std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= _asyncUploadBudget)
+                break;
+        }
     }
 }
 
@@ -403,7 +481,21 @@ Texture2D * TextureCache::addImage(const std::string &path)
     // MUTEX:
     // Needed since addImageAsync calls this method from a different thread
 
-    std::string fullpath = FileUtils::getInstance()->fullPathForFilename(path);
+    // A path that was already resolved skips fullPathForFilename and the full path lookup.
+    auto fileUtils = FileUtils::getInstance();
+    if (_textureAliasGeneration != fileUtils->getFullPathCacheGeneration())
+    {
+        purgeTextureAliases();
+        _textureAliasGeneration = fileUtils->getFullPathCacheGeneration();
+    }
+    StringId::HashType pathHash = StringId::hashOf(path);
+    auto alias = _textureAliases.find(pathHash);
+    if (alias != _textureAliases.end() && alias->second.path == path)
+    {
+        return alias->second.texture;
+    }
+
+    std::string fullpath = fileUtils->fullPathForFilename(path);
     if (fullpath.size() == 0)
     {
         return nullptr;
@@ -420,7 +512,9 @@ Texture2D * TextureCache::addImage(const std::string &path)
             image = new (std::nothrow) Image();
             CC_BREAK_IF(nullptr == image);
 
-            bool bRet = image->initWithImageFile(fullpath);
+            if (!NinePatchImageParser::isNinePatchImage(path))
+                image->setDecodePixelFormat(Texture2D::getDefaultAlphaPixelFormat());
+            bool bRet = image->initWithImageFile(getDecodePath(fullpath));
             CC_BREAK_IF(!bRet);
 
             texture = new (std::nothrow) Texture2D();
@@ -463,6 +557,13 @@ Texture2D * TextureCache::addImage(const std::string &path)
 
     CC_SAFE_RELEASE(image);
 
+    if (texture)
+    {
+        TextureAlias& entry = _textureAliases[pathHash];
+        entry.path = path;
+        entry.texture = texture;
+    }
+
     return texture;
 }
 
@@ -548,7 +649,8 @@ bool TextureCache::reloadTexture(const std::string& fileName)
             image = new (std::nothrow) Image();
             CC_BREAK_IF(nullptr == image);
 
-            bool bRet = image->initWithImageFile(fullpath);
+            image->setDecodePixelFormat(Texture2D::getDefaultAlphaPixelFormat());
+            bool bRet = image->initWithImageFile(getDecodePath(fullpath));
             CC_BREAK_IF(!bRet);
 
             ret = texture->initWithImage(image);
@@ -568,6 +670,7 @@ void TextureCache::removeAllTextures()
         texture.second->release();
     }
     _textures.clear();
+    purgeTextureAliases();
 }
 
 void TextureCache::removeUnusedTextures()
@@ -579,6 +682,7 @@ void TextureCache::removeUnusedTextures()
 
             tex->release();
             it = _textures.erase(it);
+            purgeTextureAliases();
         }
         else {
             ++it;
@@ -598,6 +702,7 @@ void TextureCache::removeTexture(Texture2D* texture)
         if (it->second == texture) {
             it->second->release();
             it = _textures.erase(it);
+            purgeTextureAliases();
             break;
         }
         else
@@ -618,7 +723,56 @@ void TextureCache::removeTextureForKey(const std::string &textureKeyName)
     if (it != _textures.end()) {
         it->second->release();
         _textures.erase(it);
+        purgeTextureAliases();
+    }
+}
+
+void TextureCache::purgeTextureAliases()
+{
+    _textureAliases.clear();
+}
+
+bool TextureCache::loadCompressedTextureMap(const std::string& mapFile)
+{
+    _compressedTextures.clear();
+
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(mapFile))
+    {
+        CCLOG("cocos2d: TextureCache: compressed texture map %s not found, using source images", mapFile.c_str());
+        return false;
     }
+
+    // One entry per line: <source image>\t<compressed file>. Lines starting with '#' are comments.
+    std::string content = fileUtils->getStringFromFile(mapFile);
+    size_t lineStart = 0;
+    while (lineStart < content.size())
+    {
+        size_t lineEnd = content.find('\n', lineStart);
+        if (lineEnd == std::string::npos)
+            lineEnd = content.size();
+
+        size_t tab = content.find('\t', lineStart);
+        if (lineEnd > lineStart && content[lineStart] != '#' && tab < lineEnd)
+        {
+            std::string source = fileUtils->fullPathForFilename(content.substr(lineStart, tab - lineStart));
+            std::string compressed = fileUtils->fullPathForFilename(content.substr(tab + 1, lineEnd - tab - 1));
+            if (!source.empty() && !compressed.empty())
+            {
+                _compressedTextures[source] = compressed;
+            }
+        }
+        lineStart = lineEnd + 1;
+    }
+
+    CCLOG("cocos2d: TextureCache: %d compressed textures from %s", static_cast<int>(_compressedTextures.size()), mapFile.c_str());
+    return true;
+}
+
+const std::string& TextureCache::getDecodePath(const std::string& fullpath) const
+{
+    auto it = _compressedTextures.find(fullpath);
+    return it != _compressedTextures.end() ? it->second : fullpath;
 }
 
 Texture2D* TextureCache::getTextureForKey(const std::string &textureKeyName) const
@@ -662,9 +816,12 @@ void TextureCache::waitForQuit()
     // notify sub thread to quick
     std::unique_lock<std::mutex> ul(_requestMutex);
     _needQuit = true;
-    _sleepCondition.notify_one();
+    _sleepCondition.notify_all();
     ul.unlock();
-    if (_loadingThread) _loadingThread->join();
+    for (auto& thread : _loadingThreads)
+    {
+        if (thread) thread->join();
+    }
 }
 
 std::string TextureCache::getCachedTextureInfo() const
@@ -727,6 +884,7 @@ void TextureCache::renameTextureWithKey(const std::string& srcName, const std::s
                 tex->initWithImage(image);
                 _textures.emplace(fullpath, tex);
                 _textures.erase(it);
+                purgeTextureAliases();
             }
             CC_SAFE_DELETE(image);
         }
@@ -35,9 +35,11 @@ THE SOFTWARE.
 #include <queue>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <functional>
 
 #include "base/CCRef.h"
+#include "base/CCStringId.h"
 #include "renderer/CCTexture2D.h"
 #include "platform/CCImage.h"
 
@@ -88,6 +90,16 @@ public:
     static std::string getETC1AlphaFileSuffix();
 
 public:
+    /** Priority of an asynchronous load. Requests are decoded and uploaded in priority order.
+     * @since v3.17
+     */
+    enum class LoadPriority
+    {
+        VISIBLE,    ///< Needed on screen now.
+        PREFETCH,   ///< Likely needed soon, e.g. the next map.
+        BACKGROUND, ///< Opportunistic warm-up.
+    };
+
     /**
      * @js ctor
      */
@@ -127,6 +139,16 @@ public:
     
     void addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, const std::string& callbackKey );
 
+    /** Loads a texture asynchronously with a priority.
+     * Requests without a priority are loaded as LoadPriority::VISIBLE.
+     @param path The related/absolute path of the file image.
+     @param callback A callback function would be invoked after the image is loaded. May be nullptr for a plain preload.
+     @param callbackKey The key used to unbind or cancel the request.
+     @param priority Decode and upload order relative to other pending requests.
+     @since v3.17
+    */
+    void addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, const std::string& callbackKey, LoadPriority priority);
+
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is invoked,
      * the object always need to unbind this callback manually.
@@ -140,6 +162,51 @@ public:
      */
     virtual void unbindAllImageAsync();
 
+    /** Cancels the asynchronous loads bound to a callback key.
+     * Requests that are not decoded yet are dropped, decoded ones are not uploaded, and no callback is invoked.
+     * Use it when the scene that requested the textures is abandoned.
+     * @param callbackKey The key passed to addImageAsync.
+     * @since v3.17
+     */
+    void cancelImageAsync(const std::string& callbackKey);
+
+    /** Cancels all pending asynchronous loads.
+     * @since v3.17
+     */
+    void cancelAllImageAsync();
+
+    /** Sets the number of threads decoding asynchronous loads.
+     * Defaults to one less than the number of hardware threads, and at least 1.
+     * Workers are started lazily by addImageAsync and keep running; lowering the count does not stop started workers.
+     * @since v3.17
+     */
+    void setAsyncWorkerCount(unsigned int count);
+    unsigned int getAsyncWorkerCount() const { return _asyncWorkerCount; }
+
+    /** Sets how long, in seconds, the GL thread may spend per frame turning decoded images into textures.
+     * At least one texture is uploaded per frame. 0 means no limit, which is the default.
+     * @since v3.17
+     */
+    void setAsyncUploadBudget(float seconds) { _asyncUploadBudget = seconds; }
+    float getAsyncUploadBudget() const { return _asyncUploadBudget; }
+
+    /** Loads a map of GPU-compressed replacements for image files.
+     * Each line holds a source image and its compressed file separated by a tab, both relative to the resource root;
+     * lines starting with '#' are comments. Afterwards addImage, addImageAsync and reloadTexture decode the
+     * compressed file instead of the source image, while the texture keeps being cached under the source path.
+     * Replacements whose files are missing are skipped. Loading a new map replaces the previous one.
+     * @param mapFile The map file, e.g. as written by an offline texture conversion step.
+     * @return False if the map file could not be read.
+     * @since v3.17
+     */
+    bool loadCompressedTextureMap(const std::string& mapFile);
+
+    /** Returns the full path of the file decoded for an image, which is the compressed replacement if there is one.
+     * @param fullpath The full path of the source image.
+     * @since v3.17
+     */
+    const std::string& getDecodePath(const std::string& fullpath) const;
+
     /** Returns a Texture2D object given an Image.
     * If the image was not previously loaded, it will create a new Texture2D object and it will return it.
     * Otherwise it will return a reference of a previously loaded image.
@@ -227,12 +294,19 @@ private:
 public:
 protected:
     struct AsyncStruct;
+
+    void cancelAsync(const std::function<bool(const AsyncStruct*)>& match);
+    void finishAsync(AsyncStruct* asyncStruct);
+
+    static const int LOAD_PRIORITY_COUNT = 3;
     
-    std::thread* _loadingThread;
+    std::vector<std::thread*> _loadingThreads;
+    unsigned int _asyncWorkerCount;
+    float _asyncUploadBudget;
 
     std::deque<AsyncStruct*> _asyncStructQueue;
-    std::deque<AsyncStruct*> _requestQueue;
-    std::deque<AsyncStruct*> _responseQueue;
+    std::deque<AsyncStruct*> _requestQueues[LOAD_PRIORITY_COUNT];
+    std::deque<AsyncStruct*> _responseQueues[LOAD_PRIORITY_COUNT];
 
     std::mutex _requestMutex;
     std::mutex _responseMutex;
@@ -245,6 +319,22 @@ protected:
 
     std::unordered_map<std::string, Texture2D*> _textures;
 
+    /** A path as passed to addImage() and the texture it resolved to. */
+    struct TextureAlias
+    {
+        std::string path;
+        Texture2D* texture;
+    };
+    /** addImage() lookups keyed by StringId hash of the requested path, so a hit skips path resolution. */
+    std::unordered_map<StringId::HashType, TextureAlias> _textureAliases;
+    /** FileUtils full path cache generation the aliases were resolved against. */
+    unsigned int _textureAliasGeneration;
+
+    void purgeTextureAliases();
+
+    /** Full path of a source image to the full path of its compressed replacement. */
+    std::unordered_map<std::string, std::string> _compressedTextures;
+
     static std::string s_etc1AlphaFileSuffix;
 };
 
@@ -8,6 +8,12 @@ varying vec4 v_fragmentColor;
 varying vec2 v_texCoord;
 
 uniform vec4 u_textColor;
+// half width of the anti-aliased edge in distance units, set from the label's screen scale
+#ifdef GL_ES
+uniform mediump float u_smoothing;
+#else
+uniform float u_smoothing;
+#endif
 
 void main()
 {
@@ -16,11 +22,7 @@ void main()
     //float dist = color.b+color.g/256.0;
     // the texture use single channel 8-bit output for distance_map
     float dist = color.a;
-    //TODO: Implementation 'fwidth' for glsl 1.0
-    //float width = fwidth(dist);
-    //assign width for constant will lead to a little bit fuzzy,it's temporary measure.
-    float width = 0.04;
-    float alpha = smoothstep(0.5-width, 0.5+width, dist) * u_textColor.a;
+    float alpha = smoothstep(0.5-u_smoothing, 0.5+u_smoothing, dist) * u_textColor.a;
     gl_FragColor = v_fragmentColor * vec4(u_textColor.rgb,alpha);
 }
 )";
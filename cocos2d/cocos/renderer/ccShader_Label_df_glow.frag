@@ -9,15 +9,17 @@ varying vec2 v_texCoord;
 
 uniform vec4 u_effectColor;
 uniform vec4 u_textColor;
+// half width of the anti-aliased edge in distance units, set from the label's screen scale
+#ifdef GL_ES
+uniform mediump float u_smoothing;
+#else
+uniform float u_smoothing;
+#endif
 
 void main()
 {
     float dist = texture2D(CC_Texture0, v_texCoord).a;
-    //TODO: Implementation 'fwidth' for glsl 1.0
-    //float width = fwidth(dist);
-    //assign width for constant will lead to a little bit fuzzy,it's temporary measure.
-    float width = 0.04;
-    float alpha = smoothstep(0.5-width, 0.5+width, dist);
+    float alpha = smoothstep(0.5-u_smoothing, 0.5+u_smoothing, dist);
     //glow
     float mu = smoothstep(0.5, 1.0, sqrt(dist));
     vec4 color = u_effectColor*(1.0-alpha) + u_textColor*alpha;
@@ -0,0 +1,42 @@
+const char* ccLabelDistanceFieldOutline_frag = R"(
+
+#ifdef GL_ES
+precision lowp float;
+#endif
+
+varying vec4 v_fragmentColor;
+varying vec2 v_texCoord;
+
+uniform vec4 u_effectColor;
+uniform vec4 u_textColor;
+
+#ifdef GL_ES
+uniform lowp int u_effectType; // 0: Text and outline, 2: Shadow
+// half width of the anti-aliased edge in distance units, set from the label's screen scale
+uniform mediump float u_smoothing;
+// distance value of the outer edge of the outline, below the 0.5 of the glyph edge
+uniform mediump float u_outlineEdge;
+#else
+uniform int u_effectType;
+uniform float u_smoothing;
+uniform float u_outlineEdge;
+#endif
+
+void main()
+{
+    float dist = texture2D(CC_Texture0, v_texCoord).a;
+    float textAlpha = smoothstep(0.5-u_smoothing, 0.5+u_smoothing, dist);
+    float outlineAlpha = smoothstep(u_outlineEdge-u_smoothing, u_outlineEdge+u_smoothing, dist);
+
+    if (u_effectType == 2)
+    {
+        // the shadow has the shape of text and outline
+        gl_FragColor = v_fragmentColor * vec4(u_effectColor.rgb, u_effectColor.a * outlineAlpha);
+    }
+    else
+    {
+        vec4 color = mix(u_effectColor, u_textColor, textAlpha);
+        gl_FragColor = v_fragmentColor * vec4(color.rgb, color.a * outlineAlpha);
+    }
+}
+)";
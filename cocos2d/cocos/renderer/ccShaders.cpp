@@ -74,6 +74,7 @@ NS_CC_BEGIN
 #include "renderer/ccShader_Label.vert"
 #include "renderer/ccShader_Label_df.frag"
 #include "renderer/ccShader_Label_df_glow.frag"
+#include "renderer/ccShader_Label_df_outline.frag"
 #include "renderer/ccShader_Label_normal.frag"
 #include "renderer/ccShader_Label_outline.frag"
 
@@ -323,6 +323,11 @@ Node* ScrollView::getChildByName(const std::string& name)const
     return _innerContainer->getChildByName(name);
 }
 
+Node* ScrollView::getChildByName(const StringId& name)const
+{
+    return _innerContainer->getChildByName(name);
+}
+
 void ScrollView::moveInnerContainer(const Vec2& deltaMove, bool canStartBounceBack)
 {
     Vec2 adjustedMove = flattenVectorByDirection(deltaMove);
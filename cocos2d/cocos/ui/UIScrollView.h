@@ -385,7 +385,9 @@ public:
     virtual const Vector<Node*>& getChildren() const override;
     virtual ssize_t getChildrenCount() const override;
     virtual Node * getChildByTag(int tag) const override;
+    using Layout::getChildByName;
     virtual Node* getChildByName(const std::string& name)const override;
+    virtual Node* getChildByName(const StringId& name)const override;
     //touch event callback
     virtual bool onTouchBegan(Touch *touch, Event *unusedEvent) override;
     virtual void onTouchMoved(Touch *touch, Event *unusedEvent) override;
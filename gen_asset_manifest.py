@@ -0,0 +1,58 @@
+import os
+import sys
+import zlib
+
+MANIFEST_NAME = "asset_manifest.txt"
+
+
+def crc32_of(path):
+    crc = 0
+    with open(path, "rb") as f:
+        while True:
+            block = f.read(1 << 16)
+            if not block:
+                break
+            crc = zlib.crc32(block, crc)
+    return crc & 0xFFFFFFFF
+
+
+def collect(root):
+    entries = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        for name in filenames:
+            full = os.path.join(dirpath, name)
+            rel = os.path.relpath(full, root).replace(os.sep, "/")
+            if rel == MANIFEST_NAME:
+                continue
+            entries.append((rel, os.path.getsize(full), crc32_of(full)))
+    # Sorted by UTF-8 bytes so the manifest is stable across platforms
+    entries.sort(key=lambda e: e[0].encode("utf-8"))
+    return entries
+
+
+def main():
+    if len(sys.argv) != 2:
+        print("usage: gen_asset_manifest.py <resource root>")
+        return 1
+
+    root = sys.argv[1]
+    entries = collect(root)
+    lines = ["# asset manifest v1: <path>\\t<size>\\t<crc32>\n"]
+    for rel, size, crc in entries:
+        lines.append("%s\t%d\t%08x\n" % (rel, size, crc))
+    content = "".join(lines).encode("utf-8")
+
+    # Only rewrite when something changed, so the copied resources stay up to date
+    out = os.path.join(root, MANIFEST_NAME)
+    if os.path.exists(out):
+        with open(out, "rb") as f:
+            if f.read() == content:
+                return 0
+    with open(out, "wb") as f:
+        f.write(content)
+    print("Wrote %s (%d files)" % (out, len(entries)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
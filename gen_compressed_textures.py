@@ -0,0 +1,112 @@
+import os
+import struct
+import subprocess
+import sys
+
+# Each variant maps (opaque, alpha) images to a PVRTexToolCLI format; None keeps the PNG.
+# Without block compression only opaque tiles lose precision (RGB565); 4-bit alpha bands
+# sprite edges and shadows, so images with alpha stay RGBA8888
+VARIANTS = {
+    "dxt": ("BC1,UBN,lRGB", "BC3,UBN,lRGB"),
+    "etc2": ("ETC2_RGB,UBN,lRGB", "ETC2_RGBA,UBN,lRGB"),
+    "fallback": ("r5g6b5,USN,lRGB", None),
+}
+# Block formats need dimensions that are multiples of the 4x4 block
+BLOCK_VARIANTS = ("dxt", "etc2")
+OUTPUT_DIR = "compressed"
+# Fonts are rendered as text, nine-patch images are parsed from pixels at load time
+EXCLUDED_DIRS = ("fonts",)
+EXCLUDED_SUFFIXES = (".9.png",)
+
+
+def png_info(path):
+    """Returns (width, height, has_alpha) from the PNG header, or None if the file is not a PNG."""
+    with open(path, "rb") as f:
+        if f.read(8) != b"\x89PNG\r\n\x1a\n":
+            return None
+        length, kind = struct.unpack(">I4s", f.read(8))
+        if kind != b"IHDR":
+            return None
+        width, height, depth, color_type = struct.unpack(">IIBB", f.read(10))
+        has_alpha = color_type in (4, 6)
+        f.seek(length - 10 + 4, os.SEEK_CUR)
+        # A palette or grey image is transparent if it carries a tRNS chunk before the image data
+        while not has_alpha:
+            header = f.read(8)
+            if len(header) < 8:
+                break
+            length, kind = struct.unpack(">I4s", header)
+            if kind == b"tRNS":
+                has_alpha = True
+            elif kind == b"IDAT":
+                break
+            f.seek(length + 4, os.SEEK_CUR)
+        return width, height, has_alpha
+
+
+def collect(root):
+    images = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        rel_dir = os.path.relpath(dirpath, root).replace(os.sep, "/")
+        if rel_dir == OUTPUT_DIR or rel_dir.split("/")[0] in EXCLUDED_DIRS:
+            dirnames[:] = []
+            continue
+        for name in filenames:
+            lower = name.lower()
+            if not lower.endswith(".png") or lower.endswith(EXCLUDED_SUFFIXES):
+                continue
+            full = os.path.join(dirpath, name)
+            info = png_info(full)
+            if info:
+                images.append((os.path.relpath(full, root).replace(os.sep, "/"), info))
+    images.sort()
+    return images
+
+
+def convert(tool, source, target, fmt, premultiply):
+    # Only convert when the source changed since the last run
+    if os.path.exists(target) and os.path.getmtime(target) >= os.path.getmtime(source):
+        return True
+    os.makedirs(os.path.dirname(target), exist_ok=True)
+    command = [tool, "-i", source, "-o", target, "-f", fmt]
+    if premultiply:
+        command.append("-p")
+    result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+    if result.returncode != 0:
+        print("failed to convert %s: %s" % (source, result.stderr.decode("utf-8", "replace").strip()))
+        return False
+    return True
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("usage: gen_compressed_textures.py <PVRTexToolCLI> <resource root>")
+        return 1
+
+    tool, root = sys.argv[1], sys.argv[2]
+    images = collect(root)
+    for variant, formats in VARIANTS.items():
+        lines = ["# compressed textures (%s): <source>\\t<compressed>\n" % variant]
+        for rel, (width, height, has_alpha) in images:
+            if variant in BLOCK_VARIANTS and (width % 4 or height % 4):
+                continue
+            if formats[has_alpha] is None:
+                continue
+            target_rel = "%s/%s/%s.pvr" % (OUTPUT_DIR, variant, os.path.splitext(rel)[0])
+            if convert(tool, os.path.join(root, rel), os.path.join(root, target_rel), formats[has_alpha], has_alpha):
+                lines.append("%s\t%s\n" % (rel, target_rel))
+        content = "".join(lines).encode("utf-8")
+
+        out = os.path.join(root, "compressed_textures_%s.txt" % variant)
+        if os.path.exists(out):
+            with open(out, "rb") as f:
+                if f.read() == content:
+                    continue
+        with open(out, "wb") as f:
+            f.write(content)
+        print("Wrote %s (%d textures)" % (out, len(lines) - 1))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,95 @@
+import os
+import struct
+import sys
+import zlib
+
+ARCHIVE_NAME = "resources.pak"
+MAGIC = b"CCPK"
+VERSION = 1
+HEADER = struct.Struct("<4sIII")
+ENTRY = struct.Struct("<QQQIHBB")
+ALIGNMENT = 16
+COMPRESSION_NONE = 0
+COMPRESSION_ZLIB = 1
+
+# Audio is streamed by the audio decoders straight from disk, it stays loose
+EXCLUDED_DIRS = ("MUSIC",)
+EXCLUDED_NAMES = (ARCHIVE_NAME, "asset_manifest.txt")
+# Text formats compress well; images and audio are already compressed and are stored as is
+COMPRESSED_EXTENSIONS = (".tmx", ".tsx", ".json", ".plist", ".xml", ".txt", ".fnt", ".csv")
+# Compression must save at least this much to be worth inflating at load time
+MIN_SAVING = 0.25
+
+
+def collect(root):
+    files = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        rel_dir = os.path.relpath(dirpath, root).replace(os.sep, "/")
+        if rel_dir.split("/")[0] in EXCLUDED_DIRS:
+            dirnames[:] = []
+            continue
+        for name in filenames:
+            rel = os.path.relpath(os.path.join(dirpath, name), root).replace(os.sep, "/")
+            if rel not in EXCLUDED_NAMES:
+                files.append(rel)
+    files.sort(key=lambda rel: rel.encode("utf-8"))
+    return files
+
+
+def pack(root, files):
+    names = bytearray()
+    entries = []
+    blobs = []
+    for rel in files:
+        with open(os.path.join(root, rel), "rb") as f:
+            data = f.read()
+        stored, compression = data, COMPRESSION_NONE
+        if rel.lower().endswith(COMPRESSED_EXTENSIONS):
+            deflated = zlib.compress(data, 9)
+            if len(deflated) <= len(data) * (1 - MIN_SAVING):
+                stored, compression = deflated, COMPRESSION_ZLIB
+        encoded = rel.encode("utf-8")
+        entries.append([0, len(data), len(stored), len(names), len(encoded), compression])
+        names += encoded
+        blobs.append(stored)
+
+    # Entry data is aligned so mapped views can be read with aligned loads
+    offset = HEADER.size + ENTRY.size * len(entries) + len(names)
+    for entry, blob in zip(entries, blobs):
+        offset = (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+        entry[0] = offset
+        offset += len(blob)
+
+    out = bytearray(HEADER.pack(MAGIC, VERSION, len(entries), len(names)))
+    for entry in entries:
+        out += ENTRY.pack(*entry, 0)
+    out += names
+    for entry, blob in zip(entries, blobs):
+        out += b"\0" * (entry[0] - len(out))
+        out += blob
+    return bytes(out)
+
+
+def main():
+    if len(sys.argv) != 2:
+        print("usage: gen_resource_archive.py <resource root>")
+        return 1
+
+    root = sys.argv[1]
+    files = collect(root)
+    content = pack(root, files)
+
+    # Only rewrite when something changed, so the copied resources stay up to date
+    out = os.path.join(root, ARCHIVE_NAME)
+    if os.path.exists(out) and os.path.getsize(out) == len(content):
+        with open(out, "rb") as f:
+            if f.read() == content:
+                return 0
+    with open(out, "wb") as f:
+        f.write(content)
+    print("Wrote %s (%d files, %d bytes)" % (out, len(files), len(content)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
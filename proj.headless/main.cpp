@@ -0,0 +1,84 @@
+#include "../Classes/SimulationBench.h"
+#include "../Classes/GameRandom.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/*
+ * 无界面基准测试入口
+ *
+ * 用法：Sigeluguanshou_bench [seed]
+ * 不创建窗口，直接运行 SimulationBench 的全部测试并输出吞吐量、
+ * 堆分配次数和校验值。同一种子的校验值应保持不变。
+ * 请使用 Release 构建运行，Debug 下 CCLOG 的输出会主导耗时。
+ */
+
+namespace {
+std::atomic<uint64_t> s_allocations(0);
+
+uint64_t getAllocationCount()
+{
+    return s_allocations.load(std::memory_order_relaxed);
+}
+}
+
+void* operator new(std::size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = GameRandom::kDefaultSeed;
+    if (argc > 1)
+        seed = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+
+    SimulationBench::setAllocationCounter(&getAllocationCount);
+
+    printf("simulation bench, seed %u\n", seed);
+    for (const auto& result : SimulationBench::runAll(seed))
+        SimulationBench::printResult(result);
+    return 0;
+}